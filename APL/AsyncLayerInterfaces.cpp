@@ -22,6 +22,7 @@
 #include "Exception.h"
 #include "Logger.h"
 #include "ToHex.h"
+#include "CopyableBuffer.h"
 
 namespace apl {
 
@@ -57,11 +58,24 @@ mpLowerLayer(NULL)
 void IUpperLayer::OnReceive(const apl::byte_t* apData, size_t aNumBytes)
 {
 	if(this->LogReceive()) {
-		LOG_BLOCK(LEV_COMM, RecvString() << " " << toHex(apData, aNumBytes, true));
+		LOG_BYTES(LEV_COMM, RecvString(), apData, aNumBytes);
 	}
 	this->_OnReceive(apData, aNumBytes); //call the implementation
 }
 
+void IUpperLayer::OnReceiveBuffer(CopyableBuffer& arBuffer, size_t aNumBytes)
+{
+	if(this->LogReceive()) {
+		LOG_BYTES(LEV_COMM, RecvString(), arBuffer, aNumBytes);
+	}
+	this->_OnReceiveBuffer(arBuffer, aNumBytes);
+}
+
+void IUpperLayer::_OnReceiveBuffer(CopyableBuffer& arBuffer, size_t aNumBytes)
+{
+	this->_OnReceive(arBuffer, aNumBytes);
+}
+
 void IUpperLayer::SetLowerLayer(ILowerLayer* apLowerLayer)
 {
 	assert(apLowerLayer != NULL);
@@ -91,7 +105,7 @@ mpUpperLayer(NULL)
 
 void ILowerLayer::Send(const apl::byte_t* apData, size_t aNumBytes)
 {
-	LOG_BLOCK(LEV_COMM, SendString() << " " << toHex(apData, aNumBytes, true));
+	LOG_BYTES(LEV_COMM, SendString(), apData, aNumBytes);
 	this->_Send(apData, aNumBytes);
 }
 
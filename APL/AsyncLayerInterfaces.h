@@ -57,6 +57,7 @@ class IUpDown
 
 class Logger;
 class ILowerLayer;
+class CopyableBuffer;
 
 class IUpperLayer : public IUpDown, protected virtual Loggable
 {
@@ -67,6 +68,10 @@ class IUpperLayer : public IUpDown, protected virtual Loggable
 		/// Called by 'layer down' when data arrives
 		void OnReceive(const apl::byte_t*, size_t);
 
+		/// Called by 'layer down' when data arrives in a buffer that this layer may keep by
+		/// swapping it with storage of the same size. The caller must not rely on the contents afterwards.
+		void OnReceiveBuffer(CopyableBuffer& arBuffer, size_t aNumBytes);
+
 		/// Called by 'layer down' when a previously requested send operation succeeds
 		/// Layers can only have 1 outstanding send operation. The callback is guaranteed
 		/// unless the the OnLowerLayerDown() function is called before
@@ -84,6 +89,7 @@ class IUpperLayer : public IUpDown, protected virtual Loggable
 
 		//these are the NVII delegates
 		virtual void _OnReceive(const apl::byte_t*, size_t) = 0;
+		virtual void _OnReceiveBuffer(CopyableBuffer& arBuffer, size_t aNumBytes); /// defaults to _OnReceive
 		virtual void _OnSendSuccess() = 0;
 		virtual void _OnSendFailure() = 0;
 		virtual bool LogReceive() { return true; }
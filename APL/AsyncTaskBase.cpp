@@ -43,7 +43,10 @@ mHandler(arCallback),
 mpGroup(apGroup),
 mNextRunTime(arInitialTime),
 M_INITIAL_TIME(arInitialTime),
-mFlags(0)
+mFlags(0),
+mSequence(0),
+mQueue(0),
+mQueueIndex(0)
 {
 	
 }
@@ -62,13 +65,15 @@ void AsyncTaskBase::Enable()
 
 void AsyncTaskBase::SilentEnable()
 {
+	if(mIsEnabled) return;
 	mIsEnabled = true;
+	mpGroup->OnStateChange(this);
 }
 
 void AsyncTaskBase::SilentDisable()
 {
-	this->Reset();
 	mIsEnabled = false;
+	this->Reset();
 }
 
 void AsyncTaskBase::Dispatch()
@@ -79,6 +84,7 @@ void AsyncTaskBase::Dispatch()
 	mIsRunning = true;
 	mIsComplete = false;
 	mIsExpired = false;
+	mpGroup->OnStateChange(this);
 	mHandler(this);
 }
 
@@ -91,6 +97,7 @@ void AsyncTaskBase::AddDependency(const AsyncTaskBase* apTask)
 		throw ArgumentException(LOCATION, "Circular dependencies not allowed");
 
 	mDependencies.push_back(apTask);
+	mpGroup->OnDependencyAdded(this);
 }
 
 bool AsyncTaskBase::IsDependency(const AsyncTaskBase* apTask) const
@@ -112,7 +119,8 @@ void AsyncTaskBase::OnComplete(bool aSuccess)
 	mIsRunning = false;
 
 	this->_OnComplete(aSuccess);
-	
+	mpGroup->OnStateChange(this);
+
 	mpGroup->OnCompletion();
 }
 
@@ -121,6 +129,7 @@ void AsyncTaskBase::Reset()
 	mIsComplete = mIsExpired = mIsRunning = false;
 	mNextRunTime = M_INITIAL_TIME;
 	this->_Reset();
+	mpGroup->OnStateChange(this);
 }
 
 void AsyncTaskBase::UpdateTime(const boost::posix_time::ptime& arTime)
@@ -125,6 +125,10 @@ class AsyncTaskBase : public ITask, private Uncopyable
 	boost::posix_time::ptime mNextRunTime;	/// next execution time for the task
 	const boost::posix_time::ptime M_INITIAL_TIME;
 	int mFlags;
+
+	size_t mSequence;						/// order in which the task was added to the group, breaks remaining ties
+	int mQueue;								/// which of the group's queues the task is in
+	size_t mQueueIndex;						/// position in that queue
 };
 
 }
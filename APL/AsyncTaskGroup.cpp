@@ -29,6 +29,7 @@
 
 #include <boost/foreach.hpp>
 #include <boost/bind.hpp>
+#include <algorithm>
 
 using namespace boost::posix_time;
 
@@ -38,7 +39,8 @@ AsyncTaskGroup::AsyncTaskGroup(ITimerSource* apTimerSrc, ITimeSource* apTimeSrc)
 mIsRunning(false),
 mpTimerSrc(apTimerSrc),
 mpTimeSrc(apTimeSrc),
-mpTimer(NULL)
+mpTimer(NULL),
+mNumRunning(0)
 {
 
 }
@@ -61,13 +63,19 @@ AsyncTaskBase* AsyncTaskGroup::Add(millis_t aPeriod, millis_t aRetryDelay, int a
 	else
 		pTask = new AsyncTaskNonPeriodic(aRetryDelay, aPriority, arCallback, this, arName);
 
+	pTask->mSequence = mTaskVec.size();
 	mTaskVec.push_back(pTask);
 	return pTask;
 }
 
 void AsyncTaskGroup::ResetTasks(int aMask)
 {
-	BOOST_FOREACH(AsyncTaskBase* p, mTaskVec)
+	this->ResetTasks(mTaskVec, aMask);
+}
+
+void AsyncTaskGroup::ResetTasks(const TaskVec& arTasks, int aMask)
+{
+	BOOST_FOREACH(AsyncTaskBase* p, arTasks)
 	{
 		if(!p->IsRunning() && (p->GetFlags() & aMask)) p->Reset();
 	}
@@ -76,6 +84,7 @@ void AsyncTaskGroup::ResetTasks(int aMask)
 AsyncTaskContinuous* AsyncTaskGroup::AddContinuous(int aPriority, const TaskHandler& arCallback, const std::string& arName)
 {
 	AsyncTaskContinuous* pTask = new AsyncTaskContinuous(aPriority, arCallback, this, arName);
+	pTask->mSequence = mTaskVec.size();
 	mTaskVec.push_back(pTask);
 	return pTask;
 }
@@ -94,16 +103,26 @@ void AsyncTaskGroup::Disable()
 
 void AsyncTaskGroup::Enable(int aMask)
 {
-	BOOST_FOREACH(AsyncTaskBase* p, mTaskVec)
+	this->Enable(mTaskVec, aMask);
+}
+
+void AsyncTaskGroup::Disable(int aMask)
+{
+	this->Disable(mTaskVec, aMask);
+}
+
+void AsyncTaskGroup::Enable(const TaskVec& arTasks, int aMask)
+{
+	BOOST_FOREACH(AsyncTaskBase* p, arTasks)
 	{
 		if((p->GetFlags() & aMask) != 0) p->SilentEnable();
 	}
 	this->CheckState();
 }
 
-void AsyncTaskGroup::Disable(int aMask)
+void AsyncTaskGroup::Disable(const TaskVec& arTasks, int aMask)
 {
-	BOOST_FOREACH(AsyncTaskBase* p, mTaskVec) 
+	BOOST_FOREACH(AsyncTaskBase* p, arTasks) 
 	{
 		if((p->GetFlags() & aMask) != 0) p->SilentDisable();
 	}
@@ -112,18 +131,94 @@ void AsyncTaskGroup::Disable(int aMask)
 
 AsyncTaskBase* AsyncTaskGroup::GetNext(const boost::posix_time::ptime& arTime)
 {
-	this->Update(arTime);
-	TaskVec::iterator max = max_element(mTaskVec.begin(), mTaskVec.end(), AsyncTaskBase::LessThanGroupLevel);
+	// only one task runs at a time
+	if(mNumRunning > 0) return NULL;
+
+	while(!mWaiting.Empty() && mWaiting.Top()->NextRunTime() <= arTime) {
+		AsyncTaskBase* p = mWaiting.Pop();
+		p->mQueue = Q_READY;
+		mReady.Push(p);
+	}
 
 	AsyncTaskBase* pRet = NULL;
-	if(max != mTaskVec.end()) {
-		AsyncTaskBase* p = *max;
-		if(!p->IsRunning() && p->IsEnabled()) pRet = p;
+	if(!mReady.Empty()) pRet = mReady.Top();
+	else if(!mWaiting.Empty()) pRet = mWaiting.Top();
+
+	BOOST_FOREACH(AsyncTaskBase* p, mDependents)
+	{
+		if(!p->IsEnabled() || p->IsRunning() || this->IsBlocked(p, arTime)) continue;
+		if(pRet == NULL || Precedes(p, pRet, arTime)) pRet = p;
 	}
 
+	if(pRet != NULL) pRet->UpdateTime(arTime);
 	return pRet;
 }
 
+bool AsyncTaskGroup::IsBlocked(const AsyncTaskBase* apTask, const ptime& arTime)
+{
+	BOOST_FOREACH(const AsyncTaskBase* p, apTask->mDependencies)
+	{
+		const_cast<AsyncTaskBase*>(p)->UpdateTime(arTime);
+		if(!p->IsComplete() || this->IsBlocked(p, arTime)) return true;
+	}
+	return false;
+}
+
+bool AsyncTaskGroup::Precedes(const AsyncTaskBase* l, const AsyncTaskBase* r, const ptime& arTime)
+{
+	bool l_expired = l->NextRunTime() <= arTime;
+	bool r_expired = r->NextRunTime() <= arTime;
+
+	if(l_expired != r_expired) return l_expired;
+	return l_expired ? PriorityOrder::Before(l, r) : RunTimeOrder::Before(l, r);
+}
+
+void AsyncTaskGroup::OnDependencyAdded(AsyncTaskBase* apTask)
+{
+	if(find(mDependents.begin(), mDependents.end(), apTask) == mDependents.end()) mDependents.push_back(apTask);
+	this->OnStateChange(apTask);
+}
+
+void AsyncTaskGroup::OnStateChange(AsyncTaskBase* apTask)
+{
+	switch(apTask->mQueue)
+	{
+		case(Q_WAITING): mWaiting.Erase(apTask); break;
+		case(Q_READY): mReady.Erase(apTask); break;
+		case(Q_RUNNING): --mNumRunning; break;
+		default: break;
+	}
+
+	if(apTask->IsRunning()) {
+		apTask->mQueue = Q_RUNNING;
+		++mNumRunning;
+	}
+	else if(apTask->IsEnabled() && apTask->mDependencies.empty()) {
+		// GetNext moves it along if its time has already come
+		apTask->mQueue = Q_WAITING;
+		mWaiting.Push(apTask);
+	}
+	else apTask->mQueue = Q_NONE;
+}
+
+bool AsyncTaskGroup::RunTimeOrder::Before(const AsyncTaskBase* l, const AsyncTaskBase* r)
+{
+	if(l->NextRunTime() != r->NextRunTime()) return l->NextRunTime() < r->NextRunTime();
+	return l->mSequence < r->mSequence;
+}
+
+size_t& AsyncTaskGroup::RunTimeOrder::Index(AsyncTaskBase* apTask)
+{ return apTask->mQueueIndex; }
+
+bool AsyncTaskGroup::PriorityOrder::Before(const AsyncTaskBase* l, const AsyncTaskBase* r)
+{
+	if(l->Priority() != r->Priority()) return l->Priority() > r->Priority();
+	return l->mSequence < r->mSequence;
+}
+
+size_t& AsyncTaskGroup::PriorityOrder::Index(AsyncTaskBase* apTask)
+{ return apTask->mQueueIndex; }
+
 void AsyncTaskGroup::CheckState()
 {
 	ptime now = GetUTC();
@@ -155,11 +250,6 @@ boost::posix_time::ptime AsyncTaskGroup::GetUTC() const
 	return mpTimeSrc->GetUTC();
 }
 
-void AsyncTaskGroup::Update(const boost::posix_time::ptime& arTime)
-{
-	BOOST_FOREACH(AsyncTaskBase* p, mTaskVec) { p->UpdateTime(arTime); }
-}
-
 void AsyncTaskGroup::RestartTimer(const ptime& arTime)
 {
 	if(mpTimer != NULL) {
@@ -23,6 +23,7 @@
 #include "Types.h"
 #include "AsyncTaskInterfaces.h"
 #include "Uncopyable.h"
+#include "IndexedHeap.h"
 
 #include <vector>
 #include <queue>
@@ -41,6 +42,11 @@ class ITimer;
 
 /**
  A collection of related tasks with optional dependencies
+
+ Enabled tasks that are idle wait in a heap ordered by next run time. Once their time
+ has come they move to a heap ordered by priority, so picking the next task is O(log n).
+ Tasks with dependencies are few and are checked individually because whether they're
+ blocked changes with the state of other tasks.
 */
 class AsyncTaskGroup : private Uncopyable
 {
@@ -63,10 +69,21 @@ class AsyncTaskGroup : private Uncopyable
 
 	void ResetTasks(int aMask);
 
+	typedef std::vector<AsyncTaskBase*> TaskVec;
+
+	/// Like the mask versions above, but only for arTasks, which must belong to the group.
+	/// Lets several users share a group without touching each other's tasks
+	void Enable(const TaskVec& arTasks, int aMask);
+	void Disable(const TaskVec& arTasks, int aMask);
+	void ResetTasks(const TaskVec& arTasks, int aMask);
+
 	void CheckState();
 
 	bool IsRunning() { return mIsRunning; }
 
+	/// @return the number of tasks that have been started and haven't completed yet
+	size_t NumRunning() { return mNumRunning; }
+
 	boost::posix_time::ptime GetUTC() const;
 
 	private:
@@ -74,9 +91,38 @@ class AsyncTaskGroup : private Uncopyable
 	void OnCompletion();
 	void RestartTimer(const boost::posix_time::ptime& arTime);
 	void OnTimerExpiration();
-	void Update(const boost::posix_time::ptime& arTime);
 	AsyncTaskBase* GetNext(const boost::posix_time::ptime& arTime);
 
+	/// Moves a task to the queue matching its current state, called by the task whenever its state changes
+	void OnStateChange(AsyncTaskBase* apTask);
+	void OnDependencyAdded(AsyncTaskBase* apTask);
+
+	/// @return true if any direct or indirect dependency of the task is incomplete at arTime
+	bool IsBlocked(const AsyncTaskBase* apTask, const boost::posix_time::ptime& arTime);
+
+	/// The order tasks are selected in, expired tasks by priority before waiting tasks by run time
+	static bool Precedes(const AsyncTaskBase* l, const AsyncTaskBase* r, const boost::posix_time::ptime& arTime);
+
+	enum Queue
+	{
+		Q_NONE,		/// disabled, or has dependencies
+		Q_WAITING,
+		Q_READY,
+		Q_RUNNING
+	};
+
+	struct RunTimeOrder
+	{
+		static bool Before(const AsyncTaskBase* l, const AsyncTaskBase* r);
+		static size_t& Index(AsyncTaskBase* apTask);
+	};
+
+	struct PriorityOrder
+	{
+		static bool Before(const AsyncTaskBase* l, const AsyncTaskBase* r);
+		static size_t& Index(AsyncTaskBase* apTask);
+	};
+
 	bool mIsRunning;
 	ITimerSource* mpTimerSrc;
 	ITimeSource* mpTimeSrc;
@@ -84,8 +130,12 @@ class AsyncTaskGroup : private Uncopyable
 
 	AsyncTaskGroup(ITimerSource*, ITimeSource*);
 
-	typedef std::vector<AsyncTaskBase*> TaskVec;
 	TaskVec mTaskVec;
+	TaskVec mDependents;		/// tasks with dependencies, never in the heaps
+
+	IndexedHeap<AsyncTaskBase*, RunTimeOrder> mWaiting;		/// enabled tasks whose run time hadn't come at the last check
+	IndexedHeap<AsyncTaskBase*, PriorityOrder> mReady;		/// enabled tasks whose run time has come
+	size_t mNumRunning;
 };
 
 }
@@ -46,7 +46,12 @@ AsyncTaskScheduler::~AsyncTaskScheduler()
 
 AsyncTaskGroup* AsyncTaskScheduler::NewGroup()
 {
-	AsyncTaskGroup* pGroup = new AsyncTaskGroup(mpTimerSrc, mpTimeSrc);
+	return this->NewGroup(mpTimerSrc);
+}
+
+AsyncTaskGroup* AsyncTaskScheduler::NewGroup(ITimerSource* apTimerSrc)
+{
+	AsyncTaskGroup* pGroup = new AsyncTaskGroup(apTimerSrc, mpTimeSrc);
 	mGroupSet.insert(pGroup);
 	return pGroup;
 }
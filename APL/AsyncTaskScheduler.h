@@ -44,6 +44,9 @@ class AsyncTaskScheduler
 	~AsyncTaskScheduler();
 
 	AsyncTaskGroup* NewGroup();
+
+	/// Creates a group whose timers come from a different timer source than the scheduler's, i.e. a per-port strand
+	AsyncTaskGroup* NewGroup(ITimerSource* apTimerSrc);
 	void Release(AsyncTaskGroup*);
 	AsyncTaskGroup* Sever(AsyncTaskGroup*);
 
@@ -0,0 +1,62 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __ATOMIC_OPS_H_
+#define __ATOMIC_OPS_H_
+
+#ifdef WIN32
+#include <intrin.h>
+#endif
+
+namespace apl {
+
+	/** Orders the loads and stores before the call against the ones after it. x86 doesn't
+		reorder stores with other stores or loads with other loads, so only the compiler has to
+		be held back there. Other targets get a full hardware fence.
+	*/
+	inline void OrderingBarrier()
+	{
+	#if defined(WIN32)
+		_ReadWriteBarrier();
+	#elif defined(__i386__) || defined(__x86_64__)
+		__asm__ __volatile__("" ::: "memory");
+	#else
+		__sync_synchronize();
+	#endif
+	}
+
+	/// Reads a value published by another thread with StoreRelease. Reads after it see everything written before the store
+	template <class T>
+	inline T LoadAcquire(const volatile T& arValue)
+	{
+		T value = arValue;
+		OrderingBarrier();
+		return value;
+	}
+
+	/// Publishes a value to another thread, everything written before it is visible to a LoadAcquire that sees it
+	template <class T>
+	inline void StoreRelease(volatile T& arValue, T aValue)
+	{
+		OrderingBarrier();
+		arValue = aValue;
+	}
+
+}
+
+#endif
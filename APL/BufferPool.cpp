@@ -0,0 +1,134 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include "BufferPool.h"
+
+#include "Exception.h"
+
+#include <assert.h>
+#include <sstream>
+#include <boost/foreach.hpp>
+
+namespace apl
+{
+	const size_t BufferPool::DEFAULT_BUFFERS_PER_SLAB;
+
+	BufferPool::BufferPool(size_t aBufferSize, size_t aBuffersPerSlab) :
+	mBufferSize(aBufferSize),
+	mBuffersPerSlab(aBuffersPerSlab),
+	mNumInUse(0),
+	mpRegistry(NULL),
+	mInUse(0),
+	mAllocated(0)
+	{
+		if(aBufferSize == 0) throw ArgumentException(LOCATION, "Buffer size must be greater than 0");
+		if(aBuffersPerSlab == 0) throw ArgumentException(LOCATION, "Slabs must hold at least 1 buffer");
+	}
+
+	BufferPool::~BufferPool()
+	{
+		assert(mNumInUse == 0);
+		BOOST_FOREACH(byte_t* pSlab, mSlabs) { delete[] pSlab; }
+	}
+
+	byte_t* BufferPool::Acquire()
+	{
+		CriticalSection cs(&mLock);
+		if(mFree.empty()) this->Grow();
+		byte_t* pBuffer = mFree.back();
+		mFree.pop_back();
+		++mNumInUse;
+		this->UpdateMetrics();
+		return pBuffer;
+	}
+
+	void BufferPool::Release(byte_t* apBuffer)
+	{
+		CriticalSection cs(&mLock);
+		assert(mNumInUse > 0);
+		mFree.push_back(apBuffer);
+		--mNumInUse;
+		this->UpdateMetrics();
+	}
+
+	size_t BufferPool::NumInUse()
+	{
+		CriticalSection cs(&mLock);
+		return mNumInUse;
+	}
+
+	size_t BufferPool::NumAllocated()
+	{
+		CriticalSection cs(&mLock);
+		return mSlabs.size() * mBuffersPerSlab;
+	}
+
+	void BufferPool::SetMetrics(MetricRegistry* apRegistry, const std::string& arPrefix)
+	{
+		MetricHandle in_use = apRegistry->RegisterGauge(arPrefix + ".in_use");
+		MetricHandle allocated = apRegistry->RegisterGauge(arPrefix + ".allocated");
+
+		CriticalSection cs(&mLock);
+		mpRegistry = apRegistry;
+		mInUse = in_use;
+		mAllocated = allocated;
+		this->UpdateMetrics();
+	}
+
+	void BufferPool::Grow()
+	{
+		byte_t* pSlab = new byte_t[mBufferSize * mBuffersPerSlab];
+		mSlabs.push_back(pSlab);
+		// hand out the front of the slab first
+		for(size_t i = mBuffersPerSlab; i > 0; --i) mFree.push_back(pSlab + (i - 1) * mBufferSize);
+	}
+
+	void BufferPool::UpdateMetrics()
+	{
+		if(mpRegistry == NULL) return;
+		mpRegistry->SetGauge(mInUse, mNumInUse);
+		mpRegistry->SetGauge(mAllocated, mSlabs.size() * mBuffersPerSlab);
+	}
+
+	BufferPoolSet::BufferPoolSet(MetricRegistry* apRegistry, const std::string& arPrefix) :
+	mpRegistry(apRegistry),
+	mPrefix(arPrefix)
+	{}
+
+	BufferPoolSet::~BufferPoolSet()
+	{
+		BOOST_FOREACH(PoolMap::value_type& p, mPools) { delete p.second; }
+	}
+
+	BufferPool* BufferPoolSet::Get(size_t aSize)
+	{
+		CriticalSection cs(&mLock);
+
+		PoolMap::iterator i = mPools.find(aSize);
+		if(i != mPools.end()) return i->second;
+
+		BufferPool* pPool = new BufferPool(aSize);
+		mPools[aSize] = pPool;
+		if(mpRegistry != NULL) {
+			std::ostringstream oss;
+			oss << mPrefix << "." << aSize;
+			pPool->SetMetrics(mpRegistry, oss.str());
+		}
+		return pPool;
+	}
+}
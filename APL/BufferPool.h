@@ -0,0 +1,111 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __BUFFER_POOL_H_
+#define __BUFFER_POOL_H_
+
+#include "Types.h"
+#include "Lock.h"
+#include "Uncopyable.h"
+#include "MetricRegistry.h"
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace apl
+{
+	/** Fixed size buffers shared by owners that only need them for the duration of a
+		transaction, e.g. the fragment buffers of thousands of mostly quiet stacks.
+
+		Buffers are carved out of slabs that are kept until the pool is destroyed, so the
+		pool grows to the peak number of buffers in use and Acquire/Release are a lock and
+		a vector push/pop after that. Every buffer must be released before the pool is
+		destroyed. Thread safe.
+	*/
+	class BufferPool : private Uncopyable
+	{
+		public:
+			BufferPool(size_t aBufferSize, size_t aBuffersPerSlab = DEFAULT_BUFFERS_PER_SLAB);
+			~BufferPool();
+
+			static const size_t DEFAULT_BUFFERS_PER_SLAB = 16;
+
+			size_t BufferSize() const { return mBufferSize; }
+
+			/// @return a buffer of BufferSize() bytes, contents are undefined
+			byte_t* Acquire();
+
+			/// Give back a buffer returned by Acquire()
+			void Release(byte_t* apBuffer);
+
+			/// @return number of buffers currently acquired
+			size_t NumInUse();
+
+			/// @return number of buffers carved out of slabs, in use or free
+			size_t NumAllocated();
+
+			/// Report NumInUse() and NumAllocated() as the gauges "<arPrefix>.in_use" and "<arPrefix>.allocated"
+			void SetMetrics(MetricRegistry* apRegistry, const std::string& arPrefix);
+
+		private:
+
+			void Grow();
+			void UpdateMetrics();
+
+			const size_t mBufferSize;
+			const size_t mBuffersPerSlab;
+
+			SigLock mLock;
+			std::vector<byte_t*> mSlabs;
+			std::vector<byte_t*> mFree;
+			size_t mNumInUse;
+
+			MetricRegistry* mpRegistry;
+			MetricHandle mInUse;
+			MetricHandle mAllocated;
+	};
+
+	/** BufferPools keyed by buffer size, created on first use and deleted with the set.
+		Each pool reports its occupancy as "<prefix>.<size>.in_use" and "<prefix>.<size>.allocated"
+		if a registry is supplied. Thread safe.
+	*/
+	class BufferPoolSet : private Uncopyable
+	{
+		public:
+			BufferPoolSet(MetricRegistry* apRegistry = NULL, const std::string& arPrefix = "buffer_pool");
+			~BufferPoolSet();
+
+			/// @return the pool of aSize byte buffers
+			BufferPool* Get(size_t aSize);
+
+		private:
+			MetricRegistry* mpRegistry;
+			const std::string mPrefix;
+
+			SigLock mLock;
+			typedef std::map<size_t, BufferPool*> PoolMap;
+			PoolMap mPools;
+	};
+
+	/// @return the pool of aSize byte buffers from apPools, or NULL if there is no set
+	inline BufferPool* GetPool(BufferPoolSet* apPools, size_t aSize)
+	{ return (apPools == NULL) ? NULL : apPools->Get(aSize); }
+}
+
+#endif
@@ -20,29 +20,167 @@
 #define __CHANGE_BUFFER_H_
 
 #include "DataTypes.h"
+#include "PackedDataTypes.h"
 #include "DataInterfaces.h"
 #include "TimingTools.h"
 #include "INotifier.h"
 #include "SubjectBase.h"
 
-#include <queue>
+#include <vector>
+#include <algorithm>
 
 namespace apl {
 
+	/** Ordered changes for one measurement type. When coalescing, only the latest
+		value for each index is kept, in the position of the first change to it.
+	*/
+	template <class T>
+	class ChangeQueue
+	{
+		typedef std::vector< Change< PackedPoint<T> > > ChangeVector;
+
+	public:
+
+		ChangeQueue() : mCoalesce(false) {}
+
+		void SetCoalesce(bool aCoalesce) { mCoalesce = aCoalesce; }
+
+		void Push(const T& arPoint, size_t aIndex)
+		{
+			if(mCoalesce) {
+				if(aIndex >= mPositions.size()) mPositions.resize(aIndex + 1, NPOS);
+				size_t& pos = mPositions[aIndex];
+				if(pos != NPOS) {
+					mChanges[pos].mValue = arPoint;
+					return;
+				}
+				pos = mChanges.size();
+			}
+			mChanges.push_back(Change< PackedPoint<T> >(arPoint, aIndex));
+		}
+
+		/// Empties the queue, keeping the allocated capacity
+		void Clear()
+		{
+			if(mCoalesce) {
+				for(typename ChangeVector::const_iterator i = mChanges.begin(); i != mChanges.end(); ++i)
+					mPositions[i->mIndex] = NPOS;
+			}
+			mChanges.clear();
+		}
+
+		size_t Size() const { return mChanges.size(); }
+
+		/// Changes to consecutive indices are pushed to the observer as one run
+		size_t Flush(IDataObserver* apObserver) const
+		{
+			typename ChangeVector::const_iterator i = mChanges.begin();
+			while(i != mChanges.end()) {
+				size_t start = i->mIndex;
+				mRun.clear();
+				do {
+					mRun.push_back(static_cast<T>(i->mValue));
+					++i;
+				}
+				while(i != mChanges.end() && i->mIndex == start + mRun.size());
+				apObserver->Update(&mRun[0], mRun.size(), start);
+			}
+			return mChanges.size();
+		}
+
+	private:
+
+		static const size_t NPOS = static_cast<size_t>(-1);
+
+		bool mCoalesce;
+		ChangeVector mChanges;
+		std::vector<size_t> mPositions;	/// index -> position in mChanges, only used when coalescing
+		mutable std::vector<T> mRun;	/// scratch space for Flush, keeps its capacity
+	};
+
+	template <class T>
+	const size_t ChangeQueue<T>::NPOS;
+
+	/// One of the two sets of queues a ChangeBuffer alternates between
+	class ChangeSet
+	{
+	public:
+
+		void SetCoalesce(bool aCoalesce)
+		{
+			mBinaryQueue.SetCoalesce(aCoalesce);
+			mAnalogQueue.SetCoalesce(aCoalesce);
+			mCounterQueue.SetCoalesce(aCoalesce);
+			mControlStatusQueue.SetCoalesce(aCoalesce);
+			mSetpointStatusQueue.SetCoalesce(aCoalesce);
+		}
+
+		void Push(const Binary& arPoint, size_t aIndex) { mBinaryQueue.Push(arPoint, aIndex); }
+		void Push(const Analog& arPoint, size_t aIndex) { mAnalogQueue.Push(arPoint, aIndex); }
+		void Push(const Counter& arPoint, size_t aIndex) { mCounterQueue.Push(arPoint, aIndex); }
+		void Push(const ControlStatus& arPoint, size_t aIndex) { mControlStatusQueue.Push(arPoint, aIndex); }
+		void Push(const SetpointStatus& arPoint, size_t aIndex) { mSetpointStatusQueue.Push(arPoint, aIndex); }
+
+		void Clear()
+		{
+			mBinaryQueue.Clear();
+			mAnalogQueue.Clear();
+			mCounterQueue.Clear();
+			mControlStatusQueue.Clear();
+			mSetpointStatusQueue.Clear();
+		}
+
+		bool HasChanges() const
+		{
+			return mBinaryQueue.Size() > 0 ||
+				 mAnalogQueue.Size() > 0 ||
+				 mCounterQueue.Size() > 0 ||
+				 mControlStatusQueue.Size() > 0 ||
+				 mSetpointStatusQueue.Size() > 0;
+		}
+
+		size_t Flush(IDataObserver* apObserver) const
+		{
+			size_t count = 0;
+			count += mBinaryQueue.Flush(apObserver);
+			count += mAnalogQueue.Flush(apObserver);
+			count += mCounterQueue.Flush(apObserver);
+			count += mControlStatusQueue.Flush(apObserver);
+			count += mSetpointStatusQueue.Flush(apObserver);
+			return count;
+		}
+
+	private:
+
+		ChangeQueue<Binary> mBinaryQueue;
+		ChangeQueue<Analog> mAnalogQueue;
+		ChangeQueue<Counter> mCounterQueue;
+		ChangeQueue<ControlStatus> mControlStatusQueue;
+		ChangeQueue<SetpointStatus> mSetpointStatusQueue;
+	};
+
 	/** Moves measurement data across thread boundaries.
+
+		Producers write into one ChangeSet while FlushUpdates swaps it with a second set
+		under the lock and then pushes the swapped out changes to the observer without
+		the lock held, so producers only ever wait on the swap. Both sets keep their
+		capacity, so a steady stream of updates doesn't allocate. FlushUpdates must only
+		be called from one thread at a time.
 	*/
 	template <class LockType>
 	class ChangeBuffer : public IDataObserver, public SubjectBase<NullLock>
 	{
-		typedef std::deque< Change<Binary> >BinaryQueue;
-		typedef std::deque< Change<Analog> > AnalogQueue;
-		typedef std::deque< Change<Counter> > CounterQueue;
-		typedef std::deque< Change<ControlStatus> > ControlStatusQueue;
-		typedef std::deque< Change<SetpointStatus> > SetpointStatusQueue;
-
 	public:
 
-			ChangeBuffer() : mMidFlush(false) {}
+		/// @param aCoalesce If true, only the latest value for each index is kept between flushes
+		ChangeBuffer(bool aCoalesce = false) :
+			mMidFlush(false),
+			mpProducer(&mSets[0]),
+			mpConsumer(&mSets[1])
+		{
+			mSets[0].SetCoalesce(aCoalesce);
+			mSets[1].SetCoalesce(aCoalesce);
+		}
 
 		void _Start() { mLock.Lock(); }
 		void _End()
@@ -50,64 +188,47 @@ namespace apl {
 
 			if ( mMidFlush )
 			{
-				_Clear();
+				mpProducer->Clear();
 				mMidFlush = false;
 			}
 
-			bool notify = this->HasChanges();
+			bool notify = mpProducer->HasChanges();
 			mLock.Unlock();
 			if(notify) this->NotifyAll();
 		}
 
 		void _Update(const Binary& arPoint, size_t aIndex)
-		{ mBinaryQueue.push_back(Change<Binary>(arPoint, aIndex)); }
+		{ mpProducer->Push(arPoint, aIndex); }
 		void _Update(const Analog& arPoint, size_t aIndex)
-		{  mAnalogQueue.push_back(Change<Analog>(arPoint, aIndex)); }
+		{ mpProducer->Push(arPoint, aIndex); }
 		void _Update(const Counter& arPoint, size_t aIndex)
-		{  mCounterQueue.push_back(Change<Counter>(arPoint, aIndex)); }
+		{ mpProducer->Push(arPoint, aIndex); }
 		void _Update(const ControlStatus& arPoint, size_t aIndex)
-		{ mControlStatusQueue.push_back(Change<ControlStatus>(arPoint, aIndex)); }
+		{ mpProducer->Push(arPoint, aIndex); }
 		void _Update(const SetpointStatus& arPoint, size_t aIndex)
-		{ mSetpointStatusQueue.push_back(Change<SetpointStatus>(arPoint, aIndex)); }
-
+		{ mpProducer->Push(arPoint, aIndex); }
 
+		/**
+			@param apObserver Observer to push the changes into
+			@param aClear If false, the changes are left in the buffer and are pushed
+			to the observer while holding the lock
+			@return Number of changes pushed to the observer
+		*/
 		size_t FlushUpdates(apl::IDataObserver* apObserver, bool aClear = true);
 
 		void Clear()
 		{
 			assert(this->InProgress());
-			_Clear();
+			mpProducer->Clear();
+			mpConsumer->Clear();
 		}
 
 	private:
 
-		void _Clear()
-		{
-			mBinaryQueue.clear();
-			mAnalogQueue.clear();
-			mCounterQueue.clear();
-			mControlStatusQueue.clear();
-			mSetpointStatusQueue.clear();
-		}
-
-		bool HasChanges()
-		{
-			return mBinaryQueue.size() > 0 ||
-				 mAnalogQueue.size() > 0 ||
-				 mCounterQueue.size() > 0 ||
-				 mControlStatusQueue.size() > 0 ||
-				 mSetpointStatusQueue.size() > 0;
-		}
-
-		template<class T>
-		size_t FlushUpdates(const T& arContainer, IDataObserver* apObserver);
-
 		bool mMidFlush;
-		BinaryQueue mBinaryQueue;
-		AnalogQueue mAnalogQueue;
-		CounterQueue mCounterQueue;
-		ControlStatusQueue mControlStatusQueue;
-		SetpointStatusQueue mSetpointStatusQueue;
+		ChangeSet mSets[2];
+		ChangeSet* mpProducer;	/// set that _Update writes to, only accessed under the lock
+		ChangeSet* mpConsumer;	/// set being flushed, only accessed by the flushing thread
 
 		LockType mLock;
 	};
@@ -115,33 +236,34 @@ namespace apl {
 	template <class LockType>
 	size_t ChangeBuffer<LockType>::FlushUpdates(apl::IDataObserver* apObserver, bool aClear)
 	{
-		Transaction tr(this);
-		size_t count = 0;
-		if(!this->HasChanges()) return count;
+		if(!aClear) {
+			Transaction tr(this);
+			if(!mpProducer->HasChanges()) return 0;
 
-		 {
 			Transaction t(apObserver);
 			mMidFlush = true;	// Will clear on transaction end if an observer call blows up
-			count += this->FlushUpdates(mBinaryQueue, apObserver);
-			count += this->FlushUpdates(mAnalogQueue, apObserver);
-			count += this->FlushUpdates(mCounterQueue, apObserver);
-			count += this->FlushUpdates(mControlStatusQueue, apObserver);
-			count += this->FlushUpdates(mSetpointStatusQueue, apObserver);
+			size_t count = mpProducer->Flush(apObserver);
 			mMidFlush = false;
+			return count;
 		}
 
-		if(aClear) this->Clear();
+		// only left over if an observer call blew up during the last flush
+		mpConsumer->Clear();
 
-		return count;
-	}
+		{
+			Transaction tr(this);
+			if(!mpProducer->HasChanges()) return 0;
+			std::swap(mpProducer, mpConsumer);
+		}
 
-	template <class LockType>
-	template <class T>
-	size_t ChangeBuffer<LockType>::FlushUpdates(const T& arContainer, IDataObserver* apObserver)
-	{
 		size_t count = 0;
-		for(typename T::const_iterator i = arContainer.begin(); i != arContainer.end(); ++i)
-		{ apObserver->Update(i->mValue, i->mIndex); ++count; }
+		{
+			Transaction t(apObserver);
+			count = mpConsumer->Flush(apObserver);
+		}
+
+		mpConsumer->Clear();
+
 		return count;
 	}
 
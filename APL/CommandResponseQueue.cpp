@@ -49,6 +49,20 @@ namespace apl {
 		return FindResponse(aSeq, arRsp);
 	}
 
+	bool CommandResponseQueue::Pop(CommandResponse& arRsp, int& arSequence)
+	{
+		CriticalSection cs(&mLock);
+
+		if(mResponseQueue.size() == 0) return false;
+
+		// responses are pushed onto the front, so the oldest is at the back
+		RspInfo rsp = mResponseQueue.back();
+		mResponseQueue.pop_back();
+		arRsp = rsp.mResponse;
+		arSequence = rsp.mSequence;
+		return true;
+	}
+
 	bool CommandResponseQueue::FindResponse(int aSeq, CommandResponse& arRsp)
 	{
 		while(mResponseQueue.size() > 0)
@@ -36,6 +36,10 @@ namespace apl
 			void AcceptResponse(const CommandResponse&, int aSequence);
 			bool WaitForResponse(CommandResponse&, int, millis_t aTimeout = -1);
 
+			/// Non-blocking retrieval of the oldest queued response, regardless of sequence
+			/// @return false if the queue is empty
+			bool Pop(CommandResponse& arRsp, int& arSequence);
+
 		private:
 
 			bool FindResponse(int aSeq, CommandResponse& arRsp);
@@ -18,41 +18,93 @@
 // 
 #include "CopyableBuffer.h"
 
+#include "BufferPool.h"
+#include "Exception.h"
+
 #include <memory.h>
+#include <algorithm>
 
 namespace apl {
 
 CopyableBuffer::CopyableBuffer() :
 mpBuff(NULL),
-mSize(0)
+mSize(0),
+mpPool(NULL)
 {
 
 }
 
 CopyableBuffer::CopyableBuffer(size_t aSize) :
 mpBuff(new byte_t[aSize]),
-mSize(aSize)
+mSize(aSize),
+mpPool(NULL)
 {
 	this->Zero();
 }
 
+CopyableBuffer::CopyableBuffer(size_t aSize, BufferPool* apPool) :
+mpBuff(NULL),
+mSize(aSize),
+mpPool(apPool)
+{
+	if(mpPool == NULL) {
+		mpBuff = new byte_t[aSize];
+		this->Zero();
+	}
+	else if(mpPool->BufferSize() != aSize) {
+		throw ArgumentException(LOCATION, "Size doesn't match the buffer size of the pool");
+	}
+}
+
 CopyableBuffer::CopyableBuffer(const byte_t* apData, size_t aSize) :
 mpBuff(new byte_t[aSize]),
-mSize(aSize)
+mSize(aSize),
+mpPool(NULL)
 {
 	memcpy(mpBuff, apData, mSize);
 }
 
 CopyableBuffer::CopyableBuffer(const CopyableBuffer& arBuffer) :
-mpBuff(new byte_t[arBuffer.Size()]),
-mSize(arBuffer.Size())
+mpBuff(NULL),
+mSize(arBuffer.Size()),
+mpPool(arBuffer.mpPool)
 {
-	memcpy(mpBuff, arBuffer, mSize);
+	if(mpPool == NULL) mpBuff = new byte_t[mSize];
+	else if(arBuffer.mpBuff != NULL) mpBuff = mpPool->Acquire();
+
+	if(arBuffer.mpBuff != NULL) memcpy(mpBuff, arBuffer, mSize);
 }
 
 void CopyableBuffer::Zero()
 { 
-	memset(mpBuff, 0, mSize);
+	if(mpBuff != NULL) memset(mpBuff, 0, mSize);
+}
+
+void CopyableBuffer::Swap(CopyableBuffer& arBuffer)
+{
+	std::swap(mpBuff, arBuffer.mpBuff);
+	std::swap(mSize, arBuffer.mSize);
+	std::swap(mpPool, arBuffer.mpPool);
+}
+
+void CopyableBuffer::Borrow()
+{
+	if(mpPool != NULL && mpBuff == NULL) mpBuff = mpPool->Acquire();
+}
+
+void CopyableBuffer::Return()
+{
+	if(mpPool != NULL && mpBuff != NULL) {
+		mpPool->Release(mpBuff);
+		mpBuff = NULL;
+	}
+}
+
+void CopyableBuffer::Free()
+{
+	if(mpPool == NULL) delete [] mpBuff;
+	else if(mpBuff != NULL) mpPool->Release(mpBuff);
+	mpBuff = NULL;
 }
 
 CopyableBuffer& CopyableBuffer::operator=(const CopyableBuffer& arRHS)
@@ -61,22 +113,32 @@ CopyableBuffer& CopyableBuffer::operator=(const CopyableBuffer& arRHS)
 	if(this == &arRHS) return *this;
 
 	if(arRHS.Size() != mSize) {
+		// a pooled buffer has the size of its pool's buffers, it can't take on another size
+		if(mpPool != NULL) throw ArgumentException(LOCATION, "Can't assign a buffer of another size to a pooled buffer");
+		this->Free();
 		mSize = arRHS.Size();
-		delete mpBuff; 
 		mpBuff = new byte_t[mSize];
 	}
+	else if(arRHS.mpBuff == NULL) {
+		// the right hand side is a pooled buffer without storage
+		this->Return();
+		return *this;
+	}
+	else this->Borrow();
 
-	memcpy(mpBuff, arRHS, mSize);
+	if(arRHS.mpBuff != NULL) memcpy(mpBuff, arRHS, mSize);
+	else this->Zero();
 
 	return *this;
 }
 
 CopyableBuffer::~CopyableBuffer()
-{ delete [] mpBuff; }
+{ this->Free(); }
 
 bool CopyableBuffer::operator==( const CopyableBuffer& other) const
 {
 	if(other.Size() != this->Size()) return false;
+	else if(this->mpBuff == NULL || other.mpBuff == NULL) return this->mpBuff == other.mpBuff;
 	else
 	{
 		for(size_t i=0; i<this->Size(); ++i) {
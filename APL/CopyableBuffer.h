@@ -25,9 +25,14 @@
 
 namespace apl {
 
+class BufferPool;
+
 /** Implements a dynamic buffer with a safe
 	copy constructor. This makes it easier to compose with
 	classes without requiring an explicit copy constructor
+
+	A pooled buffer has the size of its pool's buffers but only holds storage
+	between Borrow() and Return(), Buffer() is NULL the rest of the time.
 */
 class CopyableBuffer
 {
@@ -36,8 +41,11 @@ class CopyableBuffer
 		CopyableBuffer();
 		/// Construct based on starting size of buffer
 		CopyableBuffer(size_t aSize);
+		/// Construct a pooled buffer if apPool isn't NULL, aSize must match the pool's buffer size
+		CopyableBuffer(size_t aSize, BufferPool* apPool);
 		CopyableBuffer(const byte_t*, size_t aSize);
 		CopyableBuffer(const CopyableBuffer&);
+		/// Throws an ArgumentException if the buffer is pooled and the sizes differ, use Swap() to replace a pooled buffer
 		CopyableBuffer& operator=(const CopyableBuffer&);
 		~CopyableBuffer();
 
@@ -52,11 +60,25 @@ class CopyableBuffer
 		size_t Size() const { return mSize; }
 		void Zero();
 
+		/// Exchanges the underlying storage with another buffer without copying
+		void Swap(CopyableBuffer& arBuffer);
+
+		/// Take storage from the pool if the buffer is pooled and doesn't hold any
+		void Borrow();
+
+		/// Give pooled storage back to the pool, no-op for buffers that aren't pooled
+		void Return();
+
+		bool IsPooled() const { return mpPool != NULL; }
+
 	protected:
 		byte_t* mpBuff;
 
 	private:
+		void Free();
+
 		size_t mSize;
+		BufferPool* mpPool;
 };
 
 }
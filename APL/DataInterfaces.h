@@ -156,6 +156,14 @@ class IDataObserver : public ITransactable
 	void Update(const ControlStatus&, size_t aIndex);	//!< push a change to the owner of the database, must have transaction started
 	void Update(const SetpointStatus&, size_t aIndex);	//!< push a change to the owner of the database, must have transaction started
 
+	// Push aNum changes with contiguous indices starting at aStart, same as calling
+	// Update(apPoints[i], aStart + i) for each point but with a single virtual call
+	void Update(const Binary* apPoints, size_t aNum, size_t aStart);
+	void Update(const Analog* apPoints, size_t aNum, size_t aStart);
+	void Update(const Counter* apPoints, size_t aNum, size_t aStart);
+	void Update(const ControlStatus* apPoints, size_t aNum, size_t aStart);
+	void Update(const SetpointStatus* apPoints, size_t aNum, size_t aStart);
+
 	protected:
 
 	//concrete class will implement these
@@ -165,6 +173,22 @@ class IDataObserver : public ITransactable
 	virtual void _Update(const ControlStatus& arPoint, size_t) = 0;
 	virtual void _Update(const SetpointStatus& arPoint, size_t) = 0;
 
+	// concrete classes may override these to handle a run of points at once,
+	// by default each point is passed to the single point version
+	virtual void _Update(const Binary* apPoints, size_t aNum, size_t aStart) { this->UpdateEach(apPoints, aNum, aStart); }
+	virtual void _Update(const Analog* apPoints, size_t aNum, size_t aStart) { this->UpdateEach(apPoints, aNum, aStart); }
+	virtual void _Update(const Counter* apPoints, size_t aNum, size_t aStart) { this->UpdateEach(apPoints, aNum, aStart); }
+	virtual void _Update(const ControlStatus* apPoints, size_t aNum, size_t aStart) { this->UpdateEach(apPoints, aNum, aStart); }
+	virtual void _Update(const SetpointStatus* apPoints, size_t aNum, size_t aStart) { this->UpdateEach(apPoints, aNum, aStart); }
+
+	private:
+
+	template <class T>
+	void UpdateEach(const T* apPoints, size_t aNum, size_t aStart)
+	{
+		for(size_t i = 0; i < aNum; ++i) this->_Update(apPoints[i], aStart + i);
+	}
+
 
 };
 
@@ -180,6 +204,17 @@ inline void IDataObserver::Update(const ControlStatus& arPoint, size_t aIndex)
 inline void IDataObserver::Update(const SetpointStatus& arPoint, size_t aIndex)
 { assert(this->InProgress()); this->_Update(arPoint, aIndex); }
 
+inline void IDataObserver::Update(const Binary* apPoints, size_t aNum, size_t aStart)
+{ assert(this->InProgress()); this->_Update(apPoints, aNum, aStart); }
+inline void IDataObserver::Update(const Analog* apPoints, size_t aNum, size_t aStart)
+{ assert(this->InProgress()); this->_Update(apPoints, aNum, aStart); }
+inline void IDataObserver::Update(const Counter* apPoints, size_t aNum, size_t aStart)
+{ assert(this->InProgress()); this->_Update(apPoints, aNum, aStart); }
+inline void IDataObserver::Update(const ControlStatus* apPoints, size_t aNum, size_t aStart)
+{ assert(this->InProgress()); this->_Update(apPoints, aNum, aStart); }
+inline void IDataObserver::Update(const SetpointStatus* apPoints, size_t aNum, size_t aStart)
+{ assert(this->InProgress()); this->_Update(apPoints, aNum, aStart); }
+
 
 /*
 /
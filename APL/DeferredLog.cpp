@@ -0,0 +1,303 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include "DeferredLog.h"
+
+#include "AtomicOps.h"
+#include "Log.h"
+#include "Logger.h"
+#include "Thread.h"
+#include "TimingTools.h"
+#include "ToHex.h"
+
+#include <boost/foreach.hpp>
+#include <algorithm>
+#include <sstream>
+#include <string.h>
+
+namespace apl
+{
+	const size_t DeferredLog::DEFAULT_NUM_RECORDS;
+	const size_t DeferredLog::MAX_BYTES;
+
+	DeferredLog::Ring::Ring(size_t aNumRecords) :
+	mRecords((aNumRecords > 0) ? aNumRecords : 1),
+	mHead(0),
+	mTail(0),
+	mDropped(0),
+	mThreadExited(false),
+	mLogReleased(false)
+	{}
+
+	DeferredLog::Record* DeferredLog::Ring::Reserve()
+	{
+		if(mHead - LoadAcquire(mTail) == mRecords.size()) {
+			mDropped = mDropped + 1;
+			return NULL;
+		}
+		return &mRecords[mHead % mRecords.size()];
+	}
+
+	DeferredLog::Record* DeferredLog::Ring::At(size_t aOffset)
+	{
+		return &mRecords[(mHead + aOffset) % mRecords.size()];
+	}
+
+	size_t DeferredLog::Ring::NumFree() const
+	{
+		return mRecords.size() - (mHead - LoadAcquire(mTail));
+	}
+
+	void DeferredLog::Ring::Commit(size_t aNum)
+	{
+		StoreRelease(mHead, mHead + aNum);
+	}
+
+	DeferredLog::Record* DeferredLog::Ring::Front()
+	{
+		if(mTail == LoadAcquire(mHead)) return NULL;
+		return &mRecords[mTail % mRecords.size()];
+	}
+
+	void DeferredLog::Ring::Pop()
+	{
+		StoreRelease(mTail, mTail + 1);
+	}
+
+	bool DeferredLog::Ring::HasThreadExited()
+	{
+		CriticalSection cs(&mLock);
+		return mThreadExited;
+	}
+
+	void DeferredLog::Ring::Release(Ring* apRing, bool aThread)
+	{
+		bool last;
+		{
+			CriticalSection cs(&apRing->mLock);
+			if(aThread) apRing->mThreadExited = true;
+			else apRing->mLogReleased = true;
+			last = apRing->mThreadExited && apRing->mLogReleased;
+		}
+		if(last) delete apRing;
+	}
+
+	DeferredLog::DeferredLog(EventLog* apLog, size_t aNumRecords, millis_t aPeriod) :
+	mpLog(apLog),
+	mNumRecords(aNumRecords),
+	mPeriod(aPeriod),
+	mRetiredDropped(0),
+	mLocalRing(&DeferredLog::OnThreadExit),
+	mpThread(NULL)
+	{
+		mpLog->SetDeferred(this);
+		mpThread = new Thread(this);
+		mpThread->Start();
+	}
+
+	DeferredLog::~DeferredLog()
+	{
+		mpThread->RequestStop();
+		mpThread->WaitForStop();
+		delete mpThread;
+
+		mpLog->SetDeferred(NULL);
+		this->Flush();
+
+		// the rings of threads that are still running are freed when they exit
+		BOOST_FOREACH(Ring* pRing, mRings) { Ring::Release(pRing, false); }
+	}
+
+	bool DeferredLog::Push(Logger* apLogger, FilterLevel aLevel, const std::string& arLocation, const std::string& arMessage, int aErrorCode)
+	{
+		Ring* pRing = this->GetRing();
+		Record* pRecord = this->Begin(pRing, apLogger, aLevel, aErrorCode, arLocation.data(), arLocation.size());
+		if(pRecord == NULL) return false;
+
+		pRecord->mHex = false;
+		pRecord->mPrefixLength = 0;
+		pRecord->mDataLength = std::min(arMessage.size(), MAX_TEXT - pRecord->mLocationLength);
+		memcpy(pRecord->mText + pRecord->mLocationLength, arMessage.data(), pRecord->mDataLength);
+
+		pRing->Commit();
+		return true;
+	}
+
+	bool DeferredLog::PushBytes(Logger* apLogger, FilterLevel aLevel, const char* apLocation, const std::string& arPrefix, const byte_t* apData, size_t aLength)
+	{
+		Ring* pRing = this->GetRing();
+		Record* pRecord = this->Begin(pRing, apLogger, aLevel, -1, apLocation, strlen(apLocation));
+		if(pRecord == NULL) return false;
+
+		// there's always room for MAX_BYTES after the location and a short prefix
+		byte_t* pText = pRecord->mText + pRecord->mLocationLength;
+		pRecord->mHex = true;
+		pRecord->mPrefixLength = std::min(arPrefix.size(), MAX_TEXT - pRecord->mLocationLength - MAX_BYTES);
+		memcpy(pText, arPrefix.data(), pRecord->mPrefixLength);
+
+		// the rest of the frame goes in the records that follow, as many as the ring has room for
+		size_t num = std::max<size_t>(1, std::min((aLength + MAX_BYTES - 1) / MAX_BYTES, pRing->NumFree()));
+		size_t offset = 0;
+		for(size_t i = 0; i < num; ++i) {
+			Record* pChunk = pRing->At(i);
+			byte_t* pData = pText + pRecord->mPrefixLength;
+			if(i > 0) {
+				pChunk->mHex = true;
+				pChunk->mLocationLength = 0;
+				pChunk->mPrefixLength = 0;
+				pData = pChunk->mText;
+			}
+			pChunk->mDataLength = std::min(aLength - offset, MAX_BYTES);
+			memcpy(pData, apData + offset, pChunk->mDataLength);
+			offset += pChunk->mDataLength;
+			pChunk->mMore = (i + 1 < num);
+			pChunk->mBytesLeftOut = 0;
+		}
+		pRing->At(num - 1)->mBytesLeftOut = aLength - offset;
+
+		pRing->Commit(num);
+		return true;
+	}
+
+	size_t DeferredLog::Flush()
+	{
+		CriticalSection flush(&mFlushLock);
+
+		std::vector<Ring*> rings;
+		{
+			CriticalSection cs(&mLock);
+			rings = mRings;
+		}
+
+		size_t num = 0;
+		BOOST_FOREACH(Ring* pRing, rings) {
+			// checked before draining so nothing the thread logged last is left behind
+			bool exited = pRing->HasThreadExited();
+			while(pRing->Front() != NULL) {
+				this->Publish(pRing);
+				++num;
+			}
+			if(exited) this->Retire(pRing);
+		}
+		return num;
+	}
+
+	size_t DeferredLog::NumDropped()
+	{
+		CriticalSection cs(&mLock);
+		size_t num = mRetiredDropped;
+		BOOST_FOREACH(Ring* pRing, mRings) { num += pRing->NumDropped(); }
+		return num;
+	}
+
+	size_t DeferredLog::NumRings()
+	{
+		CriticalSection cs(&mLock);
+		return mRings.size();
+	}
+
+	void DeferredLog::Retire(Ring* apRing)
+	{
+		{
+			CriticalSection cs(&mLock);
+			mRings.erase(std::find(mRings.begin(), mRings.end(), apRing));
+			mRetiredDropped += apRing->NumDropped();
+		}
+		Ring::Release(apRing, false);
+	}
+
+	DeferredLog::Ring* DeferredLog::GetRing()
+	{
+		Ring* pRing = mLocalRing.get();
+		if(pRing == NULL) {
+			pRing = new Ring(mNumRecords);
+			{
+				CriticalSection cs(&mLock);
+				mRings.push_back(pRing);
+			}
+			mLocalRing.reset(pRing);
+		}
+		return pRing;
+	}
+
+	DeferredLog::Record* DeferredLog::Begin(Ring* apRing, Logger* apLogger, FilterLevel aLevel, int aErrorCode, const char* apLocation, size_t aLength)
+	{
+		Record* pRecord = apRing->Reserve();
+		if(pRecord != NULL) {
+			pRecord->mpLogger = apLogger;
+			pRecord->mTime = TimeStamp::GetUTCTimeStamp();
+			pRecord->mLevel = aLevel;
+			pRecord->mErrorCode = aErrorCode;
+			pRecord->mMore = false;
+			pRecord->mBytesLeftOut = 0;
+
+			size_t skip = (aLength > MAX_LOCATION) ? aLength - MAX_LOCATION : 0;
+			pRecord->mLocationLength = aLength - skip;
+			memcpy(pRecord->mText, apLocation + skip, pRecord->mLocationLength);
+		}
+		return pRecord;
+	}
+
+	void DeferredLog::Publish(Ring* apRing)
+	{
+		Record* pRecord = apRing->Front();
+		Logger* pLogger = pRecord->mpLogger;
+		millis_t time = pRecord->mTime;
+		FilterLevel level = pRecord->mLevel;
+		int errorCode = pRecord->mErrorCode;
+
+		const char* pText = reinterpret_cast<const char*>(pRecord->mText);
+		std::string location(pText, pRecord->mLocationLength);
+		pText += pRecord->mLocationLength;
+		std::string message(pText, pRecord->mPrefixLength);
+		pText += pRecord->mPrefixLength;
+
+		if(pRecord->mHex) {
+			message += " " + toHex(reinterpret_cast<const byte_t*>(pText), pRecord->mDataLength, true);
+			while(pRecord->mMore) {
+				apRing->Pop();
+				pRecord = apRing->Front();
+				message += " " + toHex(pRecord->mText, pRecord->mDataLength, true);
+			}
+			if(pRecord->mBytesLeftOut > 0) {
+				std::ostringstream oss;
+				oss << " ... " << pRecord->mBytesLeftOut << " more bytes not logged, the ring was full";
+				message += oss.str();
+			}
+		}
+		else message.append(pText, pRecord->mDataLength);
+		apRing->Pop();
+
+		mpLog->LogAt(UTCTimeStamp_t(time), level, pLogger->GetName(), location, message, errorCode);
+	}
+
+	void DeferredLog::Run()
+	{
+		while(!this->IsExitRequested()) {
+			this->Flush();
+			CriticalSection cs(&mLock);
+			if(!this->IsExitRequested()) cs.TimedWait(mPeriod);
+		}
+	}
+
+	void DeferredLog::SignalStop()
+	{
+		CriticalSection cs(&mLock);
+		cs.Signal();
+	}
+}
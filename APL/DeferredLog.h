@@ -0,0 +1,184 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __DEFERRED_LOG_H_
+#define __DEFERRED_LOG_H_
+
+#include "Types.h"
+#include "LogTypes.h"
+#include "Lock.h"
+#include "Threadable.h"
+#include "Uncopyable.h"
+
+#include <string>
+#include <vector>
+#include <boost/thread/tss.hpp>
+
+namespace apl
+{
+	class EventLog;
+	class Logger;
+	class ThreadBoost;
+
+	/** Moves the formatting and fan-out of log messages off the threads that generate them.
+
+		While a DeferredLog is attached to an EventLog, its Loggers copy each enabled message
+		into a fixed size record in a ring owned by the calling thread instead of calling the
+		subscribers. Each ring has a single producer and a single consumer, so the hot path
+		takes no locks and doesn't allocate once the thread's ring exists. Frames logged with
+		Logger::LogBytes are copied raw and only hex formatted when they're drained. A frame
+		longer than MAX_BYTES continues in the records that follow and is still published as
+		one entry. If the ring doesn't have room for all of it, the entry ends with the number
+		of bytes that were left out.
+
+		A background thread drains the rings every aPeriod milliseconds and hands the entries,
+		stamped with the time they were generated, to the EventLog's subscribers through
+		ILogBase::LogAt. Entries from one thread stay in order. When a ring is full, new
+		messages are dropped and counted. Text messages longer than a record are truncated.
+		The ring of a thread that has exited is freed once it has been drained.
+
+		Detach, i.e. destroy, the DeferredLog only after the threads that log have stopped.
+	*/
+	class DeferredLog : public Threadable, private Uncopyable
+	{
+		public:
+
+			/**
+				@param apLog		Log whose Loggers are deferred, its subscribers receive the entries
+				@param aNumRecords	Number of records in each thread's ring
+				@param aPeriod		How often the background thread drains the rings, in milliseconds
+			*/
+			DeferredLog(EventLog* apLog, size_t aNumRecords = DEFAULT_NUM_RECORDS, millis_t aPeriod = 10);
+			~DeferredLog();
+
+			static const size_t DEFAULT_NUM_RECORDS = 1024;
+
+			/// Bytes of a frame that each record holds, longer frames take several records
+			static const size_t MAX_BYTES = 320;
+
+			/// Copies a message into the calling thread's ring. @return false if it was dropped
+			bool Push(Logger* apLogger, FilterLevel aLevel, const std::string& arLocation, const std::string& arMessage, int aErrorCode);
+
+			/// Copies raw bytes into the calling thread's ring, they're logged as arPrefix followed by the hex. @return false if dropped
+			bool PushBytes(Logger* apLogger, FilterLevel aLevel, const char* apLocation, const std::string& arPrefix, const byte_t* apData, size_t aLength);
+
+			/// Formats and publishes everything that's queued on the calling thread. @return number of entries published
+			size_t Flush();
+
+			/// @return number of messages dropped because a ring was full
+			size_t NumDropped();
+
+			/// @return number of rings held, one per thread that has logged until it exits and its ring is drained
+			size_t NumRings();
+
+			std::string Description() const { return "DeferredLog"; }
+
+		private:
+
+			enum {
+				MAX_LOCATION = 96,						/// longer locations keep their tail, i.e. the file name and line
+				MAX_TEXT = MAX_LOCATION + 64 + MAX_BYTES
+			};
+
+			struct Record
+			{
+				Logger* mpLogger;
+				millis_t mTime;
+				FilterLevel mLevel;
+				int mErrorCode;
+				bool mHex;					/// the data is raw bytes to hex format after the prefix
+				bool mMore;					/// the frame continues in the next record, which has no location or prefix
+				size_t mBytesLeftOut;		/// bytes of the frame that didn't fit in the ring, set on its last record
+				size_t mLocationLength;
+				size_t mPrefixLength;
+				size_t mDataLength;
+				byte_t mText[MAX_TEXT];		/// the location, then the prefix, then the message text or raw bytes
+			};
+
+			class Ring
+			{
+				public:
+					Ring(size_t aNumRecords);
+
+					/// @return the record to fill in, or NULL if the ring is full. Producer only
+					Record* Reserve();
+
+					/// @return the record aOffset places after the one Reserve returns, which must be free. Producer only
+					Record* At(size_t aOffset);
+
+					/// @return number of records that can be filled in before the ring is full. Producer only
+					size_t NumFree() const;
+
+					/// Publishes aNum records, starting with the one from the last Reserve. Producer only
+					void Commit(size_t aNum = 1);
+
+					/// @return the oldest published record, or NULL if there isn't one. Consumer only
+					Record* Front();
+
+					/// Frees the record from the last Front. Consumer only
+					void Pop();
+
+					size_t NumDropped() const { return mDropped; }
+
+					/// @return true once the thread that logs to the ring has exited. Consumer only
+					bool HasThreadExited();
+
+					/// Drops the reference of the logging thread or of the DeferredLog, the last one deletes the ring
+					static void Release(Ring* apRing, bool aThread);
+
+				private:
+					std::vector<Record> mRecords;
+					volatile size_t mHead;		/// records published, only the producer writes it
+					volatile size_t mTail;		/// records consumed, only the consumer writes it
+					volatile size_t mDropped;
+
+					SigLock mLock;				/// guards the two flags below
+					bool mThreadExited;
+					bool mLogReleased;
+			};
+
+			Ring* GetRing();
+			Record* Begin(Ring* apRing, Logger* apLogger, FilterLevel aLevel, int aErrorCode, const char* apLocation, size_t aLength);
+
+			/// Publishes the entry at the front of the ring and pops all of its records
+			void Publish(Ring* apRing);
+
+			/// Forgets the drained ring of a thread that has exited
+			void Retire(Ring* apRing);
+
+			static void OnThreadExit(Ring* apRing) { Ring::Release(apRing, true); }
+
+			void Run();
+			void SignalStop();
+
+			EventLog* mpLog;
+			const size_t mNumRecords;
+			const millis_t mPeriod;
+
+			SigLock mLock;						/// guards mRings and mRetiredDropped, and wakes the drain thread
+			std::vector<Ring*> mRings;			/// the ring of every thread that has logged and not been retired
+			size_t mRetiredDropped;				/// messages dropped by the rings that were retired
+			boost::thread_specific_ptr<Ring> mLocalRing;	/// shares the ring with mRings until the thread exits
+
+			SigLock mFlushLock;					/// one consumer at a time
+			ThreadBoost* mpThread;
+	};
+
+}
+
+#endif
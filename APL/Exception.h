@@ -93,6 +93,14 @@ namespace apl {
 			{}
 	};
 
+	class CapacityException : public Exception
+	{
+		public:
+			CapacityException(const std::string& aSource, const std::string& aMessage) throw() :
+			Exception(aSource, aMessage)
+			{}
+	};
+
 	class NotImplementedException : public Exception
 	{
 		public:
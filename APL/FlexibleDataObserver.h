@@ -123,6 +123,9 @@ namespace apl
 			template <class T>
 			void Load(const T& arPoint, typename PointMap<T>::Type& arMap, size_t aIndex);
 
+			template <class T>
+			void Load(const T* apPoints, size_t aNum, typename PointMap<T>::Type& arMap, size_t aStart);
+
 		private:
 
 			size_t mCommsLostCount;
@@ -145,6 +148,12 @@ namespace apl
 			virtual void _Update(const ControlStatus& arPoint, size_t aIndex) { Load(arPoint, mControlStatusMap, aIndex); }
 			virtual void _Update(const SetpointStatus& arPoint, size_t aIndex) { Load(arPoint, mSetpointStatusMap, aIndex); }
 
+			virtual void _Update(const Binary* apPoints, size_t aNum, size_t aStart) { Load(apPoints, aNum, mBinaryMap, aStart); }
+			virtual void _Update(const Analog* apPoints, size_t aNum, size_t aStart) { Load(apPoints, aNum, mAnalogMap, aStart); }
+			virtual void _Update(const Counter* apPoints, size_t aNum, size_t aStart) { Load(apPoints, aNum, mCounterMap, aStart); }
+			virtual void _Update(const ControlStatus* apPoints, size_t aNum, size_t aStart) { Load(apPoints, aNum, mControlStatusMap, aStart); }
+			virtual void _Update(const SetpointStatus* apPoints, size_t aNum, size_t aStart) { Load(apPoints, aNum, mSetpointStatusMap, aStart); }
+
 
 			template <class T, class U>
 			bool Check(typename PointMap<T>::Type& arMap, U aValue, byte_t aQual, size_t aIndex);
@@ -207,6 +216,21 @@ namespace apl
 		mNewData = true; arMap[aIndex] = arPoint;
 	}
 
+	template <class T>
+	void FlexibleDataObserver::Load(const T* apPoints, size_t aNum, typename PointMap<T>::Type& arMap, size_t aStart)
+	{
+		if(aNum == 0) return;
+		mNewData = true;
+
+		// the indices ascend, so each point goes right after the previous one
+		typename PointMap<T>::Type::iterator pos = arMap.lower_bound(aStart);
+		for(size_t i = 0; i < aNum; ++i) {
+			if(pos != arMap.end() && pos->first == aStart + i) pos->second = apPoints[i];
+			else pos = arMap.insert(pos, typename PointMap<T>::Type::value_type(aStart + i, apPoints[i]));
+			++pos;
+		}
+	}
+
 	template <class T>
 	void FlexibleDataObserver::Print(typename PointMap<T>::Type& arMap)
 	{
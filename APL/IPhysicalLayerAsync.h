@@ -25,6 +25,16 @@ namespace apl{
 
 	class IHandlerAsync;
 
+	/// One of the buffers that make up a gather write
+	struct WriteBuffer
+	{
+		WriteBuffer() : mpData(NULL), mLength(0) {}
+		WriteBuffer(const byte_t* apData, size_t aLength) : mpData(apData), mLength(aLength) {}
+
+		const byte_t* mpData;
+		size_t mLength;
+	};
+
 
 	/**		Defines an asynchronous interface for serial/tcp/?
 	*/
@@ -65,6 +75,15 @@ namespace apl{
 				*/
 			virtual void AsyncWrite(const byte_t* apBuffer, size_t aLength) = 0;
 
+			/** Starts a send operation that writes several buffers back to back as a single operation.
+				Callback is the same as AsyncWrite and occurs once.
+
+				@param apBuffers	Array of buffers to write in order. The array and the buffers it
+									points to must remain available until the write callback or close occurs.
+				@param aNumBuffers	Number of buffers in the array
+				*/
+			virtual void AsyncWriteGather(const WriteBuffer* apBuffers, size_t aNumBuffers) = 0;
+
 			/** Starts a read operation. Use SetHandler to provide a callback that is called by
 			    OnReceive(const byte_t*, size_t) or a failure will result in the layer closing.
 
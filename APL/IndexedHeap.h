@@ -0,0 +1,109 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __INDEXED_HEAP_H_
+#define __INDEXED_HEAP_H_
+
+#include <vector>
+#include <cstddef>
+#include <assert.h>
+
+namespace apl {
+
+	/** Binary heap of pointers that supports removing any element in O(log n).
+
+		OrderType provides static bool Before(T, T), true if the first element belongs
+		closer to the top, and static size_t& Index(T), a slot in the element where the
+		heap keeps the element's current position.
+	*/
+	template <class T, class OrderType>
+	class IndexedHeap
+	{
+		public:
+
+		bool Empty() const { return mHeap.empty(); }
+		size_t Size() const { return mHeap.size(); }
+
+		T Top() const { assert(!mHeap.empty()); return mHeap.front(); }
+
+		void Push(T aElem)
+		{
+			mHeap.push_back(aElem);
+			this->SiftUp(mHeap.size() - 1, aElem);
+		}
+
+		T Pop()
+		{
+			T top = this->Top();
+			this->Erase(top);
+			return top;
+		}
+
+		void Erase(T aElem)
+		{
+			size_t pos = OrderType::Index(aElem);
+			assert(pos < mHeap.size() && mHeap[pos] == aElem);
+
+			T last = mHeap.back();
+			mHeap.pop_back();
+			if(pos == mHeap.size()) return;
+
+			// the element moved into the hole may belong either above or below it
+			if(pos > 0 && OrderType::Before(last, mHeap[(pos - 1) / 2])) this->SiftUp(pos, last);
+			else this->SiftDown(pos, last);
+		}
+
+		private:
+
+		void Place(size_t aPos, T aElem)
+		{
+			mHeap[aPos] = aElem;
+			OrderType::Index(aElem) = aPos;
+		}
+
+		void SiftUp(size_t aPos, T aElem)
+		{
+			while(aPos > 0) {
+				size_t parent = (aPos - 1) / 2;
+				if(!OrderType::Before(aElem, mHeap[parent])) break;
+				this->Place(aPos, mHeap[parent]);
+				aPos = parent;
+			}
+			this->Place(aPos, aElem);
+		}
+
+		void SiftDown(size_t aPos, T aElem)
+		{
+			size_t size = mHeap.size();
+			for(;;) {
+				size_t child = 2 * aPos + 1;
+				if(child >= size) break;
+				if(child + 1 < size && OrderType::Before(mHeap[child + 1], mHeap[child])) ++child;
+				if(!OrderType::Before(mHeap[child], aElem)) break;
+				this->Place(aPos, mHeap[child]);
+				aPos = child;
+			}
+			this->Place(aPos, aElem);
+		}
+
+		std::vector<T> mHeap;
+	};
+
+}
+
+#endif
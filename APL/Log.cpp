@@ -29,6 +29,9 @@ using namespace std;
 namespace apl
 {
 	
+	EventLog::EventLog() : mpDeferred(NULL)
+	{}
+
 	EventLog::~EventLog()
 	{	
 		for(LoggerMap::iterator i = mLogMap.begin(); i != mLogMap.end(); i++) {
@@ -44,6 +47,14 @@ namespace apl
 		}
 	}
 
+	void EventLog::LogAt( UTCTimeStamp_t aTime, FilterLevel aFilterLevel, const std::string& aDeviceName, const std::string& aLocation, const std::string& aMessage, int aErrorCode)
+	{
+		std::set<ILogBase*>::iterator i = mSubscribers.begin();		
+		for(; i != mSubscribers.end(); ++i){
+			(*i)->LogAt(aTime, aFilterLevel, aDeviceName, aLocation, aMessage, aErrorCode);
+		}
+	}
+
 	void EventLog::SetVar(const std::string& aSource, const std::string& aVarName, int aValue)
 	{
 		std::set<ILogBase*>::iterator i = mSubscribers.begin();		
@@ -35,12 +35,13 @@
 namespace apl
 {
 
+	class DeferredLog;
+
 	class EventLog : public ILogBase, private Uncopyable
 	{
 		public:
 
-			/** Immediate printing to minimize effect of debugging output on execution timing. */
-			//EventLog();
+			EventLog();
 			virtual ~EventLog();
 
 			Logger* GetLogger( FilterLevel aFilter, const std::string& aLoggerID );
@@ -52,10 +53,16 @@ namespace apl
 
 			//implement the log function from ILogBase
 			void Log( FilterLevel aFilterLevel, const std::string& aDeviceName, const std::string& aLocation, const std::string& aMessage, int aErrorCode);
+			void LogAt( UTCTimeStamp_t aTime, FilterLevel aFilterLevel, const std::string& aDeviceName, const std::string& aLocation, const std::string& aMessage, int aErrorCode);
 			void SetVar(const std::string& aSource, const std::string& aVarName, int aValue);
 
+			/// While set, the Loggers hand their messages to apDeferred instead of calling the subscribers. Called by DeferredLog
+			void SetDeferred(DeferredLog* apDeferred) { mpDeferred = apDeferred; }
+			DeferredLog* GetDeferred() { return mpDeferred; }
+
 		private:
 			SigLock mLock;
+			DeferredLog* mpDeferred;
 
 			//holds pointers to the loggers that have been distributed
 			typedef std::map<std::string, Logger*> LoggerMap;
@@ -21,6 +21,7 @@
 
 #include <string>
 #include "LogTypes.h"
+#include "Types.h"
 
 namespace apl
 {
@@ -32,6 +33,10 @@ namespace apl
 			/// logging error messages, etc
 			virtual void Log( FilterLevel aFilter, const std::string& aDevice, const std::string& aLocation, const std::string& aMessage, int aErrorCode) {}
 
+			/// logging a message that was generated at aTime, i.e. delivered later by a DeferredLog. Drops the time by default
+			virtual void LogAt( UTCTimeStamp_t aTime, FilterLevel aFilter, const std::string& aDevice, const std::string& aLocation, const std::string& aMessage, int aErrorCode)
+			{ this->Log(aFilter, aDevice, aLocation, aMessage, aErrorCode); }
+
 			/// updating a variable/metric in the system
 			virtual void SetVar(const std::string& aSource, const std::string& aVarName, int aValue) {}
 	};
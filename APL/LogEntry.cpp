@@ -39,6 +39,17 @@ namespace apl
 	{
 	}
 
+	LogEntry::LogEntry( UTCTimeStamp_t aTime, FilterLevel aLevel, const std::string& aDeviceName, const std::string& aLocation, const std::string& aMessage, int aErrorCode)
+		:
+		mFilterLevel(aLevel),
+		mDeviceName(aDeviceName),
+		mLocation(aLocation),
+		mMessage(aMessage),
+		mTime(aTime),
+		mErrorCode(aErrorCode)
+	{
+	}
+
 	string LogEntry :: LogString()
 	{
 		ostringstream oss;
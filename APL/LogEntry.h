@@ -31,12 +31,14 @@ namespace apl {
 			LogEntry():mTime(TimeStamp::GetUTCTimeStamp()){};
 
 			LogEntry( FilterLevel aLevel, const std::string& aDeviceName, const std::string& aLocation, const std::string& aMessage, int aErrorCode);
+			LogEntry( UTCTimeStamp_t aTime, FilterLevel aLevel, const std::string& aDeviceName, const std::string& aLocation, const std::string& aMessage, int aErrorCode);
 
 			const std::string&	GetDeviceName() { return mDeviceName; }
 			const std::string&	GetLocation() { return mLocation; }
 			const std::string&	GetMessage() { return mMessage; }
 			FilterLevel			GetFilterLevel() { return mFilterLevel; }
 			std::string			GetTimeString(){ return TimeStamp::UTCTimeStampToString(mTime);}			
+			UTCTimeStamp_t		GetTime() { return mTime; }
 			int					GetErrorCode(){return mErrorCode; }
 
 			std::string			LogString();
@@ -71,23 +71,33 @@ namespace apl{
 	void LogEntryCircularBuffer :: Log( FilterLevel aFilterLevel, const std::string& aDeviceName, const std::string& aLocation, const std::string& aMessage, int aErrorCode)
 	{
 		if(mIgnoreCodes.find(aErrorCode) == mIgnoreCodes.end()) { //only log messages that aren't ignored
-		
-			LogEntry item( aFilterLevel, aDeviceName, aLocation, aMessage, aErrorCode );
-			size_t num = 0;
-			{
-				CriticalSection cs(&mLock);
-				num = mItemQueue.size();
-				mItemQueue.push_back(item);
-				if(mItemQueue.size() > mMaxEntries)
-				{ mItemQueue.pop_front(); }
-				cs.Signal();
-			}
-			
-			// only notify if the queue was empty
-			if(num == 0) this->NotifyAll();
+			this->Add(LogEntry( aFilterLevel, aDeviceName, aLocation, aMessage, aErrorCode ));
+		}
+	}
+
+	void LogEntryCircularBuffer :: LogAt( UTCTimeStamp_t aTime, FilterLevel aFilterLevel, const std::string& aDeviceName, const std::string& aLocation, const std::string& aMessage, int aErrorCode)
+	{
+		if(mIgnoreCodes.find(aErrorCode) == mIgnoreCodes.end()) {
+			this->Add(LogEntry( aTime, aFilterLevel, aDeviceName, aLocation, aMessage, aErrorCode ));
 		}
 	}
 
+	void LogEntryCircularBuffer :: Add(const LogEntry& arEntry)
+	{
+		size_t num = 0;
+		{
+			CriticalSection cs(&mLock);
+			num = mItemQueue.size();
+			mItemQueue.push_back(arEntry);
+			if(mItemQueue.size() > mMaxEntries)
+			{ mItemQueue.pop_front(); }
+			cs.Signal();
+		}
+		
+		// only notify if the queue was empty
+		if(num == 0) this->NotifyAll();
+	}
+
 	void LogEntryCircularBuffer :: SetMaxEntries(size_t aMax)
 	{
 		CriticalSection cs(&mLock);
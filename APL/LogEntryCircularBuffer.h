@@ -39,6 +39,7 @@ class LogEntryCircularBuffer : public ILogBase, public SubjectBase<SigLock>, pri
 		bool ReadLog(LogEntry&, int aTimeout = 0);
 		void SetMaxEntries(size_t aMax);
 		void Log( FilterLevel aFilterLevel, const std::string& aDeviceName, const std::string& aLocation, const std::string& aMessage, int aErrorCode);
+		void LogAt( UTCTimeStamp_t aTime, FilterLevel aFilterLevel, const std::string& aDeviceName, const std::string& aLocation, const std::string& aMessage, int aErrorCode);
 		size_t Count();
 		void AddIgnoreCode(int aCode);
 
@@ -48,6 +49,7 @@ class LogEntryCircularBuffer : public ILogBase, public SubjectBase<SigLock>, pri
 
 	private:
 		bool CheckRead(LogEntry& aEntry);
+		void Add(const LogEntry& arEntry);
 		size_t mMaxEntries;
 		std::deque<LogEntry> mItemQueue;
 		std::set<int> mIgnoreCodes;
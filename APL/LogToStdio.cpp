@@ -28,8 +28,19 @@ LogToStdio LogToStdio::mInstance;
 void LogToStdio::Log( FilterLevel aFilter, const std::string& aDevice, const std::string& aLocation, const std::string& aMessage, int aErrorCode)
 {
 	LogEntry item( aFilter, aDevice, aLocation, aMessage, aErrorCode );
+	this->Print(item);
+}
+
+void LogToStdio::LogAt( UTCTimeStamp_t aTime, FilterLevel aFilter, const std::string& aDevice, const std::string& aLocation, const std::string& aMessage, int aErrorCode)
+{
+	LogEntry item( aTime, aFilter, aDevice, aLocation, aMessage, aErrorCode );
+	this->Print(item);
+}
+
+void LogToStdio::Print(LogEntry& arEntry)
+{
 	CriticalSection cs(&mLock);
-	std::cout << "IMMEDIATE: " << item.LogString() << std::endl;
+	std::cout << "IMMEDIATE: " << arEntry.LogString() << std::endl;
 }
 
 } //end ns
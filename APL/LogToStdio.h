@@ -25,14 +25,19 @@
 
 namespace apl {
 
+class LogEntry;
+
 class LogToStdio : public ILogBase
 {
 	MACRO_SINGLETON_INSTANCE(LogToStdio);
 
 	public:
 		void Log( FilterLevel aFilter, const std::string& aDevice, const std::string& aLocation, const std::string& aMessage, int aErrorCode);
+		void LogAt( UTCTimeStamp_t aTime, FilterLevel aFilter, const std::string& aDevice, const std::string& aLocation, const std::string& aMessage, int aErrorCode);
 
 	private:
+		void Print(LogEntry& arEntry);
+
 		SigLock mLock;
 };
 
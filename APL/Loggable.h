@@ -46,6 +46,12 @@ namespace apl
 
 #define LOGGER_BLOCK(logger, severity, string) ERROR_LOGGER_BLOCK(logger, severity, string, -1)
 
+/// Logs prefix and a hex dump of the bytes without a stream, a DeferredLog only formats the hex when it's drained
+#define LOG_BYTES(severity, prefix, data, length)\
+	if(this->mpLogger->IsEnabled(severity)){\
+		this->mpLogger->LogBytes(severity, LOCATION, prefix, data, length);\
+	}
+
 #ifndef APL_LOGALL
 #define ERROR_LOGGER_BLOCK(logger, severity, string, code)\
 	if(logger->IsEnabled(severity)){\
@@ -19,6 +19,8 @@
 #include "Logger.h"
 #include <assert.h>
 #include "Log.h"
+#include "DeferredLog.h"
+#include "ToHex.h"
 #include <iostream>
 using namespace std;
 
@@ -63,7 +65,18 @@ namespace apl
 	void Logger::Log( FilterLevel aFilterLevel, const std::string& aLocation, const std::string& aMessage, int aErrorCode)
 	{
 		if(this->IsEnabled(aFilterLevel)) {
-			mpLog->Log(aFilterLevel, mName, aLocation, aMessage, aErrorCode);
+			DeferredLog* pDeferred = mpLog->GetDeferred();
+			if(pDeferred == NULL) mpLog->Log(aFilterLevel, mName, aLocation, aMessage, aErrorCode);
+			else pDeferred->Push(this, aFilterLevel, aLocation, aMessage, aErrorCode);
+		}
+	}
+
+	void Logger::LogBytes( FilterLevel aFilterLevel, const char* apLocation, const std::string& arPrefix, const byte_t* apData, size_t aLength)
+	{
+		if(this->IsEnabled(aFilterLevel)) {
+			DeferredLog* pDeferred = mpLog->GetDeferred();
+			if(pDeferred == NULL) mpLog->Log(aFilterLevel, mName, apLocation, arPrefix + " " + toHex(apData, aLength, true), -1);
+			else pDeferred->PushBytes(this, aFilterLevel, apLocation, arPrefix, apData, aLength);
 		}
 	}
 
@@ -44,6 +44,9 @@ namespace apl
 
 			void SetVarName(const std::string& arVarName) { mVarName = arVarName; }
 			void Log( FilterLevel aFilterLevel, const std::string& aLocation, const std::string& aMessage, int aErrorCode = -1);
+
+			/// Logs arPrefix followed by a hex dump of the bytes. If the log is deferred, the bytes are copied and formatted later
+			void LogBytes( FilterLevel aFilterLevel, const char* apLocation, const std::string& arPrefix, const byte_t* apData, size_t aLength);
 			std::string GetName() const { return mName; }
 
 			//functions for manipulating filter levels
@@ -0,0 +1,309 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include "MetricRegistry.h"
+
+#include "Exception.h"
+
+#include <boost/foreach.hpp>
+
+namespace apl
+{
+	const size_t MetricRegistry::DEFAULT_MAX_SLOTS;
+	const size_t MetricRegistry::DEFAULT_MAX_GAUGES;
+	const size_t MetricRegistry::MAX_SAMPLE;
+
+	boost::thread_specific_ptr<MetricRegistry::LocalShardVector> MetricRegistry::msLocalShards;
+	SigLock MetricRegistry::msSerialLock;
+	size_t MetricRegistry::msNextSerial = 0;
+
+	size_t MetricSnapshot::Percentile(double aFraction) const
+	{
+		if(mValue == 0) return 0;
+
+		size_t target = static_cast<size_t>(aFraction * mValue + 0.5);
+		if(target < 1) target = 1;
+
+		size_t sum = 0;
+		for(size_t i = 0; i < mBuckets.size(); ++i) {
+			sum += mBuckets[i];
+			if(sum >= target) {
+				size_t upper = MetricRegistry::BucketUpperBound(i);
+				return (upper < mMax) ? upper : mMax;
+			}
+		}
+		return mMax;
+	}
+
+	MetricRegistry::Shard::Shard(size_t aNumBlocks) :
+	mNumBlocks(aNumBlocks),
+	mpBlocks(new size_t*[(aNumBlocks > 0) ? aNumBlocks : 1]())
+	{}
+
+	MetricRegistry::Shard::~Shard()
+	{
+		for(size_t i = 0; i < mNumBlocks; ++i) delete[] mpBlocks[i];
+		delete[] mpBlocks;
+	}
+
+	volatile size_t* MetricRegistry::Shard::AddBlock(size_t aBlock)
+	{
+		size_t* pBlock = new size_t[BLOCK_SLOTS]();
+		StoreRelease(mpBlocks[aBlock], pBlock);
+		return pBlock;
+	}
+
+	MetricRegistry::MetricRegistry(size_t aMaxSlots, size_t aMaxGauges) :
+	mMaxSlots(aMaxSlots),
+	mMaxGauges(aMaxGauges),
+	mSerial(NextSerial()),
+	mpGaugeBlocks(new volatile size_t*[(NumBlocks(aMaxGauges) > 0) ? NumBlocks(aMaxGauges) : 1]()),
+	mNumSlots(0),
+	mNumGauges(0),
+	mNextTicket(0)
+	{}
+
+	MetricRegistry::~MetricRegistry()
+	{
+		BOOST_FOREACH(Shard* pShard, mShards) { delete pShard; }
+		for(size_t i = 0; i < NumBlocks(mMaxGauges); ++i) delete[] const_cast<size_t*>(mpGaugeBlocks[i]);
+		delete[] mpGaugeBlocks;
+	}
+
+	size_t MetricRegistry::NextSerial()
+	{
+		CriticalSection cs(&msSerialLock);
+		return msNextSerial++;
+	}
+
+	size_t MetricRegistry::NumSlots(MetricType aType)
+	{
+		switch(aType)
+		{
+			case(MT_HISTOGRAM): return NUM_BUCKETS + 2;
+			default: return 1;
+		}
+	}
+
+	MetricHandle MetricRegistry::RegisterCounter(const std::string& arName)
+	{
+		return this->Register(arName, MT_COUNTER);
+	}
+
+	MetricHandle MetricRegistry::RegisterGauge(const std::string& arName)
+	{
+		return this->Register(arName, MT_GAUGE);
+	}
+
+	MetricHandle MetricRegistry::RegisterHistogram(const std::string& arName)
+	{
+		return this->Register(arName, MT_HISTOGRAM);
+	}
+
+	MetricHandle MetricRegistry::Register(const std::string& arName, MetricType aType)
+	{
+		CriticalSection cs(&mLock);
+
+		NameMap::iterator i = mNameToMetric.find(arName);
+		if(i != mNameToMetric.end()) {
+			const Metric& m = *i->second;
+			if(m.mType != aType) throw ArgumentException(LOCATION, "Metric registered with a different type: " + arName);
+			return m.mHandle;
+		}
+
+		// reclaimed handles go first so that stacks that come and go don't grow the registry
+		std::vector<MetricHandle>& free = (aType == MT_GAUGE) ? mFreeGauges : mFreeSlots[NumSlots(aType)];
+		MetricHandle handle;
+		if(!free.empty()) {
+			handle = free.back();
+			free.pop_back();
+			this->Clear(aType, handle);
+		}
+		else if(aType == MT_GAUGE) {
+			handle = this->Allocate(1, mMaxGauges, mNumGauges, arName);
+			size_t block = handle >> BLOCK_BITS;
+			if(mpGaugeBlocks[block] == NULL) mpGaugeBlocks[block] = new size_t[BLOCK_SLOTS]();
+		}
+		else handle = this->Allocate(NumSlots(aType), mMaxSlots, mNumSlots, arName);
+
+		mNameToMetric[arName] = mMetrics.insert(mMetrics.end(), Metric(arName, aType, handle));
+		return handle;
+	}
+
+	MetricHandle MetricRegistry::Allocate(size_t aNumSlots, size_t aMax, size_t& arCount, const std::string& arName)
+	{
+		// a metric's slots never straddle two blocks
+		size_t start = arCount;
+		if((start & (BLOCK_SLOTS - 1)) + aNumSlots > BLOCK_SLOTS) start = (start | (BLOCK_SLOTS - 1)) + 1;
+		if(start > aMax || aMax - start < aNumSlots) throw CapacityException(LOCATION, "No room for metric: " + arName);
+		arCount = start + aNumSlots;
+		return start;
+	}
+
+	void MetricRegistry::Clear(MetricType aType, MetricHandle aHandle)
+	{
+		if(aType == MT_GAUGE) {
+			mpGaugeBlocks[aHandle >> BLOCK_BITS][aHandle & (BLOCK_SLOTS - 1)] = 0;
+			return;
+		}
+
+		BOOST_FOREACH(Shard* pShard, mShards) {
+			volatile size_t* pBlock = pShard->GetBlock(aHandle >> BLOCK_BITS);
+			if(pBlock == NULL) continue;
+			volatile size_t* pSlots = pBlock + (aHandle & (BLOCK_SLOTS - 1));
+			for(size_t i = 0; i < NumSlots(aType); ++i) pSlots[i] = 0;
+		}
+	}
+
+	size_t MetricRegistry::Unregister(const std::vector<std::string>& arNames)
+	{
+		CriticalSection cs(&mLock);
+
+		size_t ticket = mNextTicket++;
+		std::vector<Metric>& unregistered = mUnregistered[ticket];
+		BOOST_FOREACH(const std::string& name, arNames) {
+			NameMap::iterator i = mNameToMetric.find(name);
+			if(i == mNameToMetric.end()) continue;
+			unregistered.push_back(*i->second);
+			mMetrics.erase(i->second);
+			mNameToMetric.erase(i);
+		}
+		return ticket;
+	}
+
+	void MetricRegistry::Reclaim(size_t aTicket)
+	{
+		CriticalSection cs(&mLock);
+
+		std::map<size_t, std::vector<Metric> >::iterator i = mUnregistered.find(aTicket);
+		if(i == mUnregistered.end()) return;
+		BOOST_FOREACH(const Metric& m, i->second) {
+			if(m.mType == MT_GAUGE) mFreeGauges.push_back(m.mHandle);
+			else mFreeSlots[NumSlots(m.mType)].push_back(m.mHandle);
+		}
+		mUnregistered.erase(i);
+	}
+
+	MetricRegistry::Shard* MetricRegistry::AddShard()
+	{
+		Shard* pShard = new Shard(NumBlocks(mMaxSlots));
+		{
+			CriticalSection cs(&mLock);
+			mShards.push_back(pShard);
+		}
+
+		if(msLocalShards.get() == NULL) msLocalShards.reset(new LocalShardVector());
+		msLocalShards->push_back(LocalShard(mSerial, pShard));
+		return pShard;
+	}
+
+	void MetricRegistry::Read(std::vector<MetricSnapshot>& arValues)
+	{
+		std::vector<Metric> metrics;
+		std::vector<Shard*> shards;
+		{
+			CriticalSection cs(&mLock);
+			metrics.assign(mMetrics.begin(), mMetrics.end());
+			shards = mShards;
+		}
+
+		size_t start = arValues.size();
+		arValues.resize(start + metrics.size());
+		for(size_t i = 0; i < metrics.size(); ++i) this->Snapshot(metrics[i], shards, arValues[start + i]);
+	}
+
+	bool MetricRegistry::Read(const std::string& arName, MetricSnapshot& arValue)
+	{
+		std::vector<Metric> metric;
+		std::vector<Shard*> shards;
+		{
+			CriticalSection cs(&mLock);
+			NameMap::iterator i = mNameToMetric.find(arName);
+			if(i == mNameToMetric.end()) return false;
+			metric.push_back(*i->second);
+			shards = mShards;
+		}
+		this->Snapshot(metric.front(), shards, arValue);
+		return true;
+	}
+
+	void MetricRegistry::Snapshot(const Metric& arMetric, const std::vector<Shard*>& arShards, MetricSnapshot& arValue)
+	{
+		arValue.mName = arMetric.mName;
+		arValue.mType = arMetric.mType;
+		arValue.mValue = 0;
+		arValue.mMax = 0;
+		arValue.mBuckets.clear();
+
+		switch(arMetric.mType)
+		{
+			case(MT_GAUGE):
+				arValue.mValue = mpGaugeBlocks[arMetric.mHandle >> BLOCK_BITS][arMetric.mHandle & (BLOCK_SLOTS - 1)];
+				break;
+			case(MT_COUNTER):
+				BOOST_FOREACH(Shard* pShard, arShards) {
+					volatile size_t* pBlock = pShard->GetBlock(arMetric.mHandle >> BLOCK_BITS);
+					if(pBlock != NULL) arValue.mValue += pBlock[arMetric.mHandle & (BLOCK_SLOTS - 1)];
+				}
+				break;
+			case(MT_HISTOGRAM):
+				arValue.mBuckets.resize(NUM_BUCKETS, 0);
+				BOOST_FOREACH(Shard* pShard, arShards) {
+					volatile size_t* pBlock = pShard->GetBlock(arMetric.mHandle >> BLOCK_BITS);
+					if(pBlock == NULL) continue;
+					volatile size_t* pSlots = pBlock + (arMetric.mHandle & (BLOCK_SLOTS - 1));
+					arValue.mValue += pSlots[0];
+					if(pSlots[1] > arValue.mMax) arValue.mMax = pSlots[1];
+					for(size_t i = 0; i < NUM_BUCKETS; ++i) arValue.mBuckets[i] += pSlots[2 + i];
+				}
+				break;
+		}
+	}
+
+	size_t MetricRegistry::BucketFor(size_t aSample)
+	{
+		if(aSample > MAX_SAMPLE) aSample = MAX_SAMPLE;
+		if(aSample < SUB_BUCKETS) return aSample;
+
+		// position of the highest set bit
+		size_t msb = 0;
+		size_t v = aSample;
+		if(v >= (1 << 16)) { v >>= 16; msb += 16; }
+		if(v >= (1 << 8)) { v >>= 8; msb += 8; }
+		if(v >= (1 << 4)) { v >>= 4; msb += 4; }
+		if(v >= (1 << 2)) { v >>= 2; msb += 2; }
+		if(v >= (1 << 1)) { msb += 1; }
+
+		size_t sub = (aSample >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+		return (msb - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+	}
+
+	size_t MetricRegistry::BucketLowerBound(size_t aBucket)
+	{
+		if(aBucket < SUB_BUCKETS) return aBucket;
+		size_t group = aBucket / SUB_BUCKETS;
+		return (SUB_BUCKETS + aBucket % SUB_BUCKETS) << (group - 1);
+	}
+
+	size_t MetricRegistry::BucketUpperBound(size_t aBucket)
+	{
+		if(aBucket < SUB_BUCKETS) return aBucket;
+		size_t group = aBucket / SUB_BUCKETS;
+		return BucketLowerBound(aBucket) + ((static_cast<size_t>(1) << (group - 1)) - 1);
+	}
+}
@@ -0,0 +1,259 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __METRIC_REGISTRY_H_
+#define __METRIC_REGISTRY_H_
+
+#include "Types.h"
+#include "AtomicOps.h"
+#include "Lock.h"
+#include "Uncopyable.h"
+
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <boost/thread/tss.hpp>
+
+namespace apl
+{
+	/// Refers to a registered metric, returned by the MetricRegistry::Register* functions
+	typedef size_t MetricHandle;
+
+	enum MetricType
+	{
+		MT_COUNTER,
+		MT_GAUGE,
+		MT_HISTOGRAM
+	};
+
+	/// Value of a metric at the time of a MetricRegistry::Read
+	struct MetricSnapshot
+	{
+		MetricSnapshot() : mType(MT_COUNTER), mValue(0), mMax(0) {}
+
+		/// @return upper bound of the bucket that holds aFraction (0.0 - 1.0) of the samples, 0 if there are none
+		size_t Percentile(double aFraction) const;
+
+		std::string mName;
+		MetricType mType;
+		size_t mValue;					/// counter total, gauge value, or number of histogram samples
+		size_t mMax;					/// largest histogram sample
+		std::vector<size_t> mBuckets;	/// histogram sample counts, see MetricRegistry::BucketFor
+	};
+
+	/** Counters, gauges and latency histograms that are cheap enough to update from the
+		protocol threads of hundreds of stacks.
+
+		Metrics are registered up front by name and updated through numeric handles, so the
+		hot path never builds or compares strings. Counters and histograms are kept per
+		thread: each thread that updates a metric gets a shard of word sized slots that only
+		it writes, so an update is a plain load and store with no locks or atomic operations.
+		Gauges hold the last value set by any thread. Read() sums the shards without stopping
+		the writers, so a snapshot may miss updates that are in flight.
+
+		Slots are handed out in blocks of BLOCK_SLOTS, and a shard only allocates the blocks
+		its thread updates, so memory grows with the metrics in use rather than the capacity.
+
+		Histograms are log-linear like an HDR histogram: 8 linear sub-buckets per power of
+		two, so any sample is placed within 12.5% of its value. Samples above MAX_SAMPLE are
+		counted in the last bucket.
+
+		Registering a name that exists returns the existing handle. Unregister forgets names
+		right away, so registering one again starts from zero, but their slots are only reused
+		after Reclaim, once nothing updates the old handles anymore.
+	*/
+	class MetricRegistry : private Uncopyable
+	{
+		public:
+
+			/**
+				@param aMaxSlots	Slots that can be registered, a counter uses 1 and a histogram NUM_BUCKETS + 2
+				@param aMaxGauges	Number of gauges that can be registered
+			*/
+			MetricRegistry(size_t aMaxSlots = DEFAULT_MAX_SLOTS, size_t aMaxGauges = DEFAULT_MAX_GAUGES);
+			~MetricRegistry();
+
+			/// Room for the metrics of about 17000 stacks, only the blocks in use are allocated
+			static const size_t DEFAULT_MAX_SLOTS = 1 << 22;
+			static const size_t DEFAULT_MAX_GAUGES = 1 << 20;
+
+			enum {
+				BLOCK_BITS = 12,
+				BLOCK_SLOTS = 1 << BLOCK_BITS,
+				SUB_BUCKET_BITS = 3,
+				SUB_BUCKETS = 1 << SUB_BUCKET_BITS,
+				MAX_SAMPLE_BITS = 32,
+				NUM_BUCKETS = (MAX_SAMPLE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS
+			};
+
+			static const size_t MAX_SAMPLE = 0xFFFFFFFF;
+
+			/// Register functions throw ArgumentException if the name exists with a different type, CapacityException if the registry is full
+			MetricHandle RegisterCounter(const std::string& arName);
+			MetricHandle RegisterGauge(const std::string& arName);
+			MetricHandle RegisterHistogram(const std::string& arName);
+
+			/**
+				Forgets the names: Read doesn't report them and registering one again gets slots of
+				its own. Names that aren't registered are skipped.
+
+				@return ticket for Reclaim, the slots are kept until then for whoever still holds the handles
+			*/
+			size_t Unregister(const std::vector<std::string>& arNames);
+
+			/// Frees the slots of the metrics unregistered with aTicket for reuse, call it once nothing updates them
+			void Reclaim(size_t aTicket);
+
+			void Increment(MetricHandle aCounter, size_t aCount = 1)
+			{
+				volatile size_t* pSlot = this->GetSlots(aCounter);
+				*pSlot = *pSlot + aCount;
+			}
+
+			void SetGauge(MetricHandle aGauge, size_t aValue)
+			{
+				mpGaugeBlocks[aGauge >> BLOCK_BITS][aGauge & (BLOCK_SLOTS - 1)] = aValue;
+			}
+
+			void Record(MetricHandle aHistogram, size_t aSample)
+			{
+				volatile size_t* pSlots = this->GetSlots(aHistogram);
+				pSlots[0] = pSlots[0] + 1;
+				if(aSample > pSlots[1]) pSlots[1] = aSample;
+				volatile size_t* pBucket = pSlots + 2 + BucketFor(aSample);
+				*pBucket = *pBucket + 1;
+			}
+
+			/// Appends a snapshot of every registered metric to arValues, in registration order
+			void Read(std::vector<MetricSnapshot>& arValues);
+
+			/// @return false if there's no metric named arName
+			bool Read(const std::string& arName, MetricSnapshot& arValue);
+
+			/// @return index of the histogram bucket that holds aSample
+			static size_t BucketFor(size_t aSample);
+
+			/// @return smallest and largest samples that go into aBucket
+			static size_t BucketLowerBound(size_t aBucket);
+			static size_t BucketUpperBound(size_t aBucket);
+
+		private:
+
+			struct Metric
+			{
+				Metric(const std::string& arName, MetricType aType, MetricHandle aHandle) :
+				mName(arName), mType(aType), mHandle(aHandle)
+				{}
+
+				std::string mName;
+				MetricType mType;
+				MetricHandle mHandle;
+			};
+
+			/// Blocks of slots updated by a single thread
+			class Shard
+			{
+				public:
+					Shard(size_t aNumBlocks);
+					~Shard();
+
+					/// @return the block, or NULL if the thread hasn't updated anything in it
+					volatile size_t* GetBlock(size_t aBlock) const { return LoadAcquire(mpBlocks[aBlock]); }
+
+					/// Allocates a zeroed block and publishes it to readers. Owning thread only
+					volatile size_t* AddBlock(size_t aBlock);
+
+				private:
+					const size_t mNumBlocks;
+					size_t* volatile* const mpBlocks;
+			};
+
+			/// A thread's shard for one registry. Serial numbers are never reused, so entries
+			/// left behind by a destroyed registry are never matched
+			struct LocalShard
+			{
+				LocalShard(size_t aSerial, Shard* apShard) : mSerial(aSerial), mpShard(apShard) {}
+
+				size_t mSerial;
+				Shard* mpShard;
+			};
+			typedef std::vector<LocalShard> LocalShardVector;
+
+			/// @return the calling thread's slots for aHandle
+			volatile size_t* GetSlots(MetricHandle aHandle)
+			{
+				Shard* pShard = this->GetShard();
+				volatile size_t* pBlock = pShard->GetBlock(aHandle >> BLOCK_BITS);
+				if(pBlock == NULL) pBlock = pShard->AddBlock(aHandle >> BLOCK_BITS);
+				return pBlock + (aHandle & (BLOCK_SLOTS - 1));
+			}
+
+			Shard* GetShard()
+			{
+				LocalShardVector* pLocal = msLocalShards.get();
+				if(pLocal != NULL) {
+					for(LocalShardVector::iterator i = pLocal->begin(); i != pLocal->end(); ++i) {
+						if(i->mSerial == mSerial) return i->mpShard;
+					}
+				}
+				return this->AddShard();
+			}
+
+			static size_t NextSerial();
+			static size_t NumSlots(MetricType aType);
+			static size_t NumBlocks(size_t aMaxSlots) { return (aMaxSlots + BLOCK_SLOTS - 1) / BLOCK_SLOTS; }
+			Shard* AddShard();
+			MetricHandle Register(const std::string& arName, MetricType aType);
+
+			/// @return handle of aNumSlots new slots in one block, arCount is the number of slots handed out so far
+			MetricHandle Allocate(size_t aNumSlots, size_t aMax, size_t& arCount, const std::string& arName);
+
+			/// Zeroes the slots of a handle that's being reused
+			void Clear(MetricType aType, MetricHandle aHandle);
+			void Snapshot(const Metric& arMetric, const std::vector<Shard*>& arShards, MetricSnapshot& arValue);
+
+			const size_t mMaxSlots;
+			const size_t mMaxGauges;
+			const size_t mSerial;
+
+			volatile size_t** const mpGaugeBlocks;	/// allocated as gauges are registered
+
+			SigLock mLock;						/// guards everything below, never taken by updates once a thread has its shard
+			size_t mNumSlots;
+			size_t mNumGauges;
+			typedef std::list<Metric> MetricList;
+			MetricList mMetrics;				/// in registration order, a list so unregistering doesn't move the others
+			typedef std::map<std::string, MetricList::iterator> NameMap;
+			NameMap mNameToMetric;
+			std::vector<Shard*> mShards;
+
+			typedef std::map<size_t, std::vector<MetricHandle> > FreeMap;
+			FreeMap mFreeSlots;					/// reclaimed handles by number of slots
+			std::vector<MetricHandle> mFreeGauges;
+			size_t mNextTicket;
+			std::map<size_t, std::vector<Metric> > mUnregistered;	/// metrics waiting for Reclaim, by ticket
+
+			static boost::thread_specific_ptr<LocalShardVector> msLocalShards;
+			static SigLock msSerialLock;
+			static size_t msNextSerial;
+	};
+
+}
+
+#endif
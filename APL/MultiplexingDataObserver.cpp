@@ -69,6 +69,12 @@ namespace apl{
 	void MultiplexingDataObserver :: _Update(const ControlStatus& arPoint, size_t aIndex) { PassThrough<ControlStatus>(arPoint, aIndex); }
 	void MultiplexingDataObserver :: _Update(const SetpointStatus& arPoint, size_t aIndex) { PassThrough<SetpointStatus>(arPoint, aIndex); }
 
+	void MultiplexingDataObserver :: _Update(const Binary* apPoints, size_t aNum, size_t aStart) { PassThrough<Binary>(apPoints, aNum, aStart); }
+	void MultiplexingDataObserver :: _Update(const Analog* apPoints, size_t aNum, size_t aStart) { PassThrough<Analog>(apPoints, aNum, aStart); }
+	void MultiplexingDataObserver :: _Update(const Counter* apPoints, size_t aNum, size_t aStart) { PassThrough<Counter>(apPoints, aNum, aStart); }
+	void MultiplexingDataObserver :: _Update(const ControlStatus* apPoints, size_t aNum, size_t aStart) { PassThrough<ControlStatus>(apPoints, aNum, aStart); }
+	void MultiplexingDataObserver :: _Update(const SetpointStatus* apPoints, size_t aNum, size_t aStart) { PassThrough<SetpointStatus>(apPoints, aNum, aStart); }
+
 	template <typename T>
 	void MultiplexingDataObserver :: PassThrough(const T& arPoint, size_t aIndex)
 	{
@@ -80,4 +86,15 @@ namespace apl{
 		}
 	}
 
+	template <typename T>
+	void MultiplexingDataObserver :: PassThrough(const T* apPoints, size_t aNum, size_t aStart)
+	{
+		std::vector<IDataObserver*>::iterator iter = mObservers.begin();
+
+		while(iter != mObservers.end()){
+			(*iter)->Update(apPoints, aNum, aStart);
+			++iter;
+		}
+	}
+
 }
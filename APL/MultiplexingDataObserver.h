@@ -56,8 +56,17 @@ namespace apl
 			void _Update(const ControlStatus& arPoint, size_t aIndex);
 			void _Update(const SetpointStatus& arPoint, size_t aIndex);
 
+			void _Update(const Binary* apPoints, size_t aNum, size_t aStart);
+			void _Update(const Analog* apPoints, size_t aNum, size_t aStart);
+			void _Update(const Counter* apPoints, size_t aNum, size_t aStart);
+			void _Update(const ControlStatus* apPoints, size_t aNum, size_t aStart);
+			void _Update(const SetpointStatus* apPoints, size_t aNum, size_t aStart);
+
 			template <typename T>
 			void PassThrough(const T& arPoint, size_t aIndex);
+
+			template <typename T>
+			void PassThrough(const T* apPoints, size_t aNum, size_t aStart);
 	};
 
 
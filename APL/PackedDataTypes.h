@@ -0,0 +1,160 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __PACKED_DATA_TYPES_H_
+#define __PACKED_DATA_TYPES_H_
+
+#include "DataTypes.h"
+
+namespace apl {
+
+	/// Bit of the quality field that holds the value of the boolean measurement types
+	template <class T> struct StateMask;
+	template <> struct StateMask<Binary> { enum { Mask = BQ_STATE }; };
+	template <> struct StateMask<ControlStatus> { enum { Mask = TQ_STATE }; };
+
+	/**
+		Trivially copyable, vtable free representation of a measurement, for internal containers
+		that store points in bulk (database, event buffers, change buffers). It has the same
+		accessors as the measurement type it stands in for and converts to and from it
+		implicitly, so the public IDataObserver interface keeps using Binary, Analog, etc.
+
+		Analogs, counters, and setpoint status keep their value next to the quality byte.
+	*/
+	template <class T, class V = typename T::ValueType>
+	class PackedPoint
+	{
+		public:
+
+		typedef T MeasType;
+		typedef V ValueType;
+		typedef V Type;
+
+		PackedPoint() { this->Assign(T()); }
+		PackedPoint(const T& arPoint) { this->Assign(arPoint); }
+
+		operator T() const
+		{
+			T point(mValue, mQuality);
+			point.SetTime(mTime);
+			return point;
+		}
+
+		DataTypes GetType() const { return T::MeasEnum; }
+
+		V GetValue() const { return mValue; }
+		void SetValue(V aValue) { mValue = aValue; }
+
+		byte_t GetQuality() const { return mQuality; }
+		void SetQuality(byte_t aQuality) { mQuality = aQuality; }
+		bool CheckQualityBit(byte_t aQualMask) const { return (aQualMask & mQuality) != 0; }
+
+		TimeStamp_t GetTime() const { return mTime; }
+		void SetTime(const TimeStamp_t arTime) { mTime = arTime; }
+
+		bool ShouldGenerateEvent(const PackedPoint& arRHS, double aDeadband, V aLastReportedVal) const
+		{
+			if (mQuality != arRHS.mQuality) return true;
+			return ExceedsDeadband<V>(arRHS.mValue, aLastReportedVal, aDeadband);
+		}
+
+		std::string ToString() const { return T(*this).ToString(); }
+
+		private:
+
+		void Assign(const T& arPoint)
+		{
+			mTime = arPoint.GetTime();
+			mValue = arPoint.GetValue();
+			mQuality = arPoint.GetQuality();
+		}
+
+		TimeStamp_t mTime;
+		V mValue;
+		byte_t mQuality;
+	};
+
+	/// Binaries and control status store their value as a bit of the quality, exactly like BoolDataPoint
+	template <class T>
+	class PackedPoint<T, bool>
+	{
+		public:
+
+		typedef T MeasType;
+		typedef bool ValueType;
+
+		PackedPoint() { this->Assign(T()); }
+		PackedPoint(const T& arPoint) { this->Assign(arPoint); }
+
+		operator T() const
+		{
+			T point;
+			point.SetQualityValue(mQuality);
+			point.SetTime(mTime);
+			return point;
+		}
+
+		DataTypes GetType() const { return T::MeasEnum; }
+
+		bool GetValue() const { return (mQuality & StateMask<T>::Mask) != 0; }
+		void SetValue(bool aValue)
+		{
+			mQuality = aValue ? (mQuality | StateMask<T>::Mask) : (mQuality & ~StateMask<T>::Mask);
+		}
+
+		byte_t GetQuality() const { return mQuality; }
+		void SetQuality(byte_t aQuality) { mQuality = (mQuality & StateMask<T>::Mask) | aQuality; }
+		bool CheckQualityBit(byte_t aQualMask) const { return (aQualMask & mQuality) != 0; }
+
+		TimeStamp_t GetTime() const { return mTime; }
+		void SetTime(const TimeStamp_t arTime) { mTime = arTime; }
+
+		bool ShouldGenerateEvent(const PackedPoint& arRHS, double /*aDeadband*/, uint_32_t /*aLastReportedVal*/) const
+		{ return mQuality != arRHS.mQuality; }
+
+		std::string ToString() const { return T(*this).ToString(); }
+
+		private:
+
+		void Assign(const T& arPoint)
+		{
+			mTime = arPoint.GetTime();
+			mQuality = arPoint.GetQuality();
+		}
+
+		TimeStamp_t mTime;
+		byte_t mQuality;
+	};
+
+	typedef PackedPoint<Binary> PackedBinary;
+	typedef PackedPoint<Analog> PackedAnalog;
+	typedef PackedPoint<Counter> PackedCounter;
+	typedef PackedPoint<ControlStatus> PackedControlStatus;
+	typedef PackedPoint<SetpointStatus> PackedSetpointStatus;
+
+	/// Storage type for a T in bulk containers, the measurement types map to their packed form
+	template <class T> struct PackedTypeOf { typedef T Type; };
+	template <> struct PackedTypeOf<Binary> { typedef PackedBinary Type; };
+	template <> struct PackedTypeOf<Analog> { typedef PackedAnalog Type; };
+	template <> struct PackedTypeOf<Counter> { typedef PackedCounter Type; };
+	template <> struct PackedTypeOf<ControlStatus> { typedef PackedControlStatus Type; };
+	template <> struct PackedTypeOf<SetpointStatus> { typedef PackedSetpointStatus Type; };
+
+}
+
+#endif
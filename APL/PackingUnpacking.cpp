@@ -30,6 +30,11 @@
 #include "Util.h"
 #include <memory>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define APL_PACKED_BITS_SSE2
+#include <emmintrin.h>
+#endif
+
 namespace apl
 {
 	const byte_t UInt8::Max = std::numeric_limits<byte_t>::max();
@@ -94,4 +99,59 @@ namespace apl
 	}
 	#endif
 
+	void PackedBits::Unpack(const apl::byte_t* apIn, size_t aNum, apl::byte_t* apOut)
+	{
+		size_t i = 0;
+
+		#ifdef APL_PACKED_BITS_SSE2
+		// broadcast each of two input bytes across 8 lanes, keep one bit per lane and normalize it to 0/1
+		const __m128i select = _mm_set_epi8(-128, 64, 32, 16, 8, 4, 2, 1, -128, 64, 32, 16, 8, 4, 2, 1);
+		const __m128i one = _mm_set1_epi8(1);
+		for(; i + 16 <= aNum; i += 16, apIn += 2, apOut += 16)
+		{
+			__m128i x = _mm_cvtsi32_si128(apIn[0] | (apIn[1] << 8));
+			x = _mm_unpacklo_epi8(x, x);
+			x = _mm_unpacklo_epi16(x, x);
+			x = _mm_unpacklo_epi32(x, x);
+			x = _mm_cmpeq_epi8(_mm_and_si128(x, select), select);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(apOut), _mm_and_si128(x, one));
+		}
+		#endif
+
+		for(; i + 8 <= aNum; i += 8, ++apIn, apOut += 8) UnpackByte(*apIn, 8, apOut);
+		if(i < aNum) UnpackByte(*apIn, aNum - i, apOut);
+	}
+
+	void PackedBits::Pack(const apl::byte_t* apValues, size_t aNum, apl::byte_t* apOut)
+	{
+		size_t i = 0;
+
+		#ifdef APL_PACKED_BITS_SSE2
+		// movemask gathers the top bit of each lane, so compare against zero first and invert
+		const __m128i zero = _mm_setzero_si128();
+		for(; i + 16 <= aNum; i += 16, apValues += 16, apOut += 2)
+		{
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(apValues));
+			int bits = ~_mm_movemask_epi8(_mm_cmpeq_epi8(x, zero));
+			apOut[0] = static_cast<byte_t>(bits);
+			apOut[1] = static_cast<byte_t>(bits >> 8);
+		}
+		#endif
+
+		for(; i + 8 <= aNum; i += 8, apValues += 8) *(apOut++) = PackByte(apValues, 8);
+		if(i < aNum) *apOut = PackByte(apValues, aNum - i);
+	}
+
+	void PackedBits::UnpackByte(apl::byte_t aBits, size_t aNum, apl::byte_t* apOut)
+	{
+		for(size_t i = 0; i < aNum; ++i) apOut[i] = (aBits >> i) & 0x01;
+	}
+
+	apl::byte_t PackedBits::PackByte(const apl::byte_t* apValues, size_t aNum)
+	{
+		byte_t bits = 0;
+		for(size_t i = 0; i < aNum; ++i) bits |= static_cast<byte_t>((apValues[i] != 0) << i);
+		return bits;
+	}
+
 }
@@ -248,6 +248,26 @@ namespace apl
 		static double FlipWord32(double aValue);
 		#endif
 	};
+
+	/** Bulk conversion between DNP3 bitfields (LSB of the first byte is the first value) and
+		arrays holding one value per byte. Uses SSE2 when the compiler targets it, otherwise
+		a portable byte at a time loop.
+	*/
+	class PackedBits
+	{
+		public:
+		/// Expands aNum bits from apIn into apOut as 0 or 1 values
+		static void Unpack(const apl::byte_t* apIn, size_t aNum, apl::byte_t* apOut);
+
+		/// Compresses aNum values (non-zero is set) into GetSize(aNum) bytes at apOut, unused trailing bits are cleared
+		static void Pack(const apl::byte_t* apValues, size_t aNum, apl::byte_t* apOut);
+
+		static size_t GetSize(size_t aNum) { return (aNum + 7) >> 3; }
+
+		private:
+		static void UnpackByte(apl::byte_t aBits, size_t aNum, apl::byte_t* apOut);
+		static apl::byte_t PackByte(const apl::byte_t* apValues, size_t aNum);
+	};
 }
 
 #endif
@@ -27,15 +27,20 @@ namespace apl {
 struct PhysLayerSettings
 {
 	public:
-	PhysLayerSettings() {}
+	PhysLayerSettings() : TimerWheelResolution(0) {}
 
-	PhysLayerSettings(FilterLevel aLevel, millis_t aRetryTimeout) :
+	PhysLayerSettings(FilterLevel aLevel, millis_t aRetryTimeout, millis_t aTimerWheelResolution = 0) :
 	LogLevel(aLevel),
-	RetryTimeout(aRetryTimeout)
+	RetryTimeout(aRetryTimeout),
+	TimerWheelResolution(aTimerWheelResolution)
 	{}
 
 	FilterLevel LogLevel;
 	millis_t RetryTimeout;
+
+	/// If nonzero the stacks on the port share one TimerSourceWheel with ticks of this many milliseconds,
+	/// instead of an asio timer each. Worth it for ports with many stacks that restart timers constantly
+	millis_t TimerWheelResolution;
 };
 
 }
@@ -19,31 +19,52 @@
 #ifndef __PHYSICAL_LAYER_ASYNC_ASIO_H_
 #define __PHYSICAL_LAYER_ASYNC_ASIO_H_
 
+#include "ASIOIncludes.h"
 #include "PhysicalLayerAsyncBase.h"
 
-namespace boost { namespace asio {
-	class io_service;
-}}
+#include <vector>
 
 namespace apl {
 
 	/// This is the base class for the new async physical layers. It assumes that all of the functions
-	/// are called from a single thread.
+	/// are called from a single thread, or at least from handlers dispatched through GetStrand().
 
 	class PhysicalLayerAsyncASIO : public PhysicalLayerAsyncBase
 	{
 		public:
 			PhysicalLayerAsyncASIO(Logger* apLogger, boost::asio::io_service* apService) :
 			PhysicalLayerAsyncBase(apLogger),
-			mpService(apService)
+			mpService(apService),
+			mStrand(*apService)
 			{}
 
 			virtual ~PhysicalLayerAsyncASIO(){}
 
+			/// All completion handlers of the layer are dispatched through this strand. When the io_service
+			/// is run from a pool of threads, anything that calls into the layer must use the same strand.
+			boost::asio::io_service::strand* GetStrand() { return &mStrand; }
+
 		protected:
+
+			/// Converts a gather write into an asio buffer sequence, the result is valid until the next call
+			const std::vector<boost::asio::const_buffer>& GetBufferSequence(const WriteBuffer* apBuffers, size_t aNumBuffers)
+			{
+				mBufferSequence.clear();
+				for(size_t i = 0; i < aNumBuffers; ++i) {
+					mBufferSequence.push_back(boost::asio::const_buffer(apBuffers[i].mpData, apBuffers[i].mLength));
+				}
+				return mBufferSequence;
+			}
+
 			/// reference to the io_service object that is driving the class
 			/// Use this for any required post operations
 			boost::asio::io_service* mpService;
+
+			/// serializes the completion handlers, wrap every async operation with it
+			boost::asio::io_service::strand mStrand;
+
+		private:
+			std::vector<boost::asio::const_buffer> mBufferSequence;
 	};
 }
 #endif
@@ -131,6 +131,19 @@ void PhysicalLayerAsyncBase::AsyncWrite(const apl::byte_t* apBuff, size_t aNumBy
 	else throw InvalidStateException(LOCATION, "AsyncWrite: " + mState.ToString());
 }
 
+void PhysicalLayerAsyncBase::AsyncWriteGather(const WriteBuffer* apBuffers, size_t aNumBuffers)
+{
+	size_t total = 0;
+	for(size_t i = 0; i < aNumBuffers; ++i) total += apBuffers[i].mLength;
+	if(total < 1) throw ArgumentException(LOCATION, "total length must be > 0");
+
+	if(mState.CanWrite()) {
+		mState.mWriting = true;
+		this->DoAsyncWriteGather(apBuffers, aNumBuffers);
+	}
+	else throw InvalidStateException(LOCATION, "AsyncWriteGather: " + mState.ToString());
+}
+
 void PhysicalLayerAsyncBase::AsyncRead(apl::byte_t* apBuff, size_t aMaxBytes)
 {
 	if(aMaxBytes < 1) throw ArgumentException(LOCATION, "aMaxBytes must be > 0");
@@ -216,6 +229,15 @@ void PhysicalLayerAsyncBase::OnWriteCallback(const boost::system::error_code& ar
 // Actions
 /////////////////////////////////////////////////////
 
+void PhysicalLayerAsyncBase::DoAsyncWriteGather(const WriteBuffer* apBuffers, size_t aNumBuffers)
+{
+	mGatherBuffer.clear();
+	for(size_t i = 0; i < aNumBuffers; ++i) {
+		mGatherBuffer.insert(mGatherBuffer.end(), apBuffers[i].mpData, apBuffers[i].mpData + apBuffers[i].mLength);
+	}
+	this->DoAsyncWrite(&mGatherBuffer[0], mGatherBuffer.size());
+}
+
 void PhysicalLayerAsyncBase::DoWriteSuccess()
 {
 	if(mpHandler) mpHandler->OnSendSuccess();
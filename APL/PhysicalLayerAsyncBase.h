@@ -24,6 +24,8 @@
 #include "IPhysicalLayerAsync.h"
 #include "Loggable.h"
 
+#include <vector>
+
 namespace apl {
 
 	class PLAS_Base;
@@ -70,6 +72,7 @@ namespace apl {
 			void AsyncOpen();
 			void AsyncClose();
 			void AsyncWrite(const apl::byte_t*, size_t);
+			void AsyncWriteGather(const WriteBuffer*, size_t);
 			void AsyncRead(apl::byte_t*, size_t);
 
 			// Not an event delegated to the states
@@ -83,6 +86,10 @@ namespace apl {
 			virtual void DoAsyncRead(byte_t*, size_t) = 0;
 			virtual void DoAsyncWrite(const byte_t*, size_t) = 0;
 
+			/// Layers that can write a buffer sequence natively override this, the default
+			/// flattens the buffers into one and calls DoAsyncWrite
+			virtual void DoAsyncWriteGather(const WriteBuffer*, size_t aNumBuffers);
+
 			// These can be optionally overridden to do something more interesting, i.e. specific logging
 			virtual void DoOpenSuccess() {}
 			virtual void DoOpenFailure() {}
@@ -110,6 +117,8 @@ namespace apl {
 		private:
 
 			void StartClose();
+
+			std::vector<byte_t> mGatherBuffer;	/// only used by the default DoAsyncWriteGather
 	};
 
 	inline void PhysicalLayerAsyncBase::SetHandler(IHandlerAsync* apHandler)
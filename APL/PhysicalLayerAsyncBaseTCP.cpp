@@ -64,36 +64,49 @@ void PhysicalLayerAsyncBaseTCP::DoOpenSuccess()
 
 	if(mTcp.mEnableKeepalive)
 	{
-		const boost::asio::socket_base::keep_alive keepaliveOption(true);
-		mSocket.set_option(keepaliveOption);
-
 #if defined(BOOST_WINDOWS)
 		LOG_BLOCK(LEV_WARNING, "Per-socket keepalive settings are not yet implemented for Windows.");
+#endif
+		ApplyKeepalive(mSocket, mTcp);
+	}
+}
+
+void PhysicalLayerAsyncBaseTCP::ApplyKeepalive(boost::asio::ip::tcp::socket& arSocket, const TCPSettings& arTcp)
+{
+	const boost::asio::socket_base::keep_alive keepaliveOption(true);
+	arSocket.set_option(keepaliveOption);
 
-		// TODO: It looks like this could be implemented via the SIO_KEEPALIVE_VALS WSAIoctl():
-		//
-		//           http://msdn.microsoft.com/en-us/library/dd877220%28v=VS.85%29.aspx
+#if defined(BOOST_WINDOWS)
+	// TODO: It looks like this could be implemented via the SIO_KEEPALIVE_VALS WSAIoctl():
+	//
+	//           http://msdn.microsoft.com/en-us/library/dd877220%28v=VS.85%29.aspx
 #else
-		const boost::asio::detail::socket_option::integer<SOL_TCP, TCP_KEEPIDLE> keepaliveTimeOption(mTcp.mKeepaliveTime);
-		const boost::asio::detail::socket_option::integer<SOL_TCP, TCP_KEEPINTVL> keepaliveIntervalOption(mTcp.mKeepaliveInterval);
-		const boost::asio::detail::socket_option::integer<SOL_TCP, TCP_KEEPCNT> keepaliveProbesOption(mTcp.mKeepaliveProbes);
-		mSocket.set_option(keepaliveTimeOption);
-		mSocket.set_option(keepaliveIntervalOption);
-		mSocket.set_option(keepaliveProbesOption);
+	const boost::asio::detail::socket_option::integer<SOL_TCP, TCP_KEEPIDLE> keepaliveTimeOption(arTcp.mKeepaliveTime);
+	const boost::asio::detail::socket_option::integer<SOL_TCP, TCP_KEEPINTVL> keepaliveIntervalOption(arTcp.mKeepaliveInterval);
+	const boost::asio::detail::socket_option::integer<SOL_TCP, TCP_KEEPCNT> keepaliveProbesOption(arTcp.mKeepaliveProbes);
+	arSocket.set_option(keepaliveTimeOption);
+	arSocket.set_option(keepaliveIntervalOption);
+	arSocket.set_option(keepaliveProbesOption);
 #endif
-	}
 }
 
 void PhysicalLayerAsyncBaseTCP::DoAsyncRead(byte_t* apBuffer, size_t aMaxBytes)
 {
 	mSocket.async_read_some(buffer(apBuffer, aMaxBytes),
-		boost::bind(&PhysicalLayerAsyncBaseTCP::OnReadCallback, this, placeholders::error, apBuffer, placeholders::bytes_transferred));
+		mStrand.wrap(boost::bind(&PhysicalLayerAsyncBaseTCP::OnReadCallback, this, placeholders::error, apBuffer, placeholders::bytes_transferred)));
 }
 
 void PhysicalLayerAsyncBaseTCP::DoAsyncWrite(const byte_t* apBuffer, size_t aNumBytes)
 {
 	async_write(mSocket, buffer(apBuffer, aNumBytes), 
-		boost::bind(&PhysicalLayerAsyncBaseTCP::OnWriteCallback, this, placeholders::error, aNumBytes));
+		mStrand.wrap(boost::bind(&PhysicalLayerAsyncBaseTCP::OnWriteCallback, this, placeholders::error, aNumBytes)));
+}
+
+void PhysicalLayerAsyncBaseTCP::DoAsyncWriteGather(const WriteBuffer* apBuffers, size_t aNumBuffers)
+{
+	const std::vector<const_buffer>& buffers = this->GetBufferSequence(apBuffers, aNumBuffers);
+	async_write(mSocket, buffers,
+		mStrand.wrap(boost::bind(&PhysicalLayerAsyncBaseTCP::OnWriteCallback, this, placeholders::error, buffer_size(buffers))));
 }
 
 void PhysicalLayerAsyncBaseTCP::DoOpenFailure()
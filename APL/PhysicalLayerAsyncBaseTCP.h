@@ -41,8 +41,12 @@ namespace apl {
 			void DoOpenSuccess();
 			void DoAsyncRead(byte_t*, size_t);
 			void DoAsyncWrite(const byte_t*, size_t);
+			void DoAsyncWriteGather(const WriteBuffer*, size_t);
 			void DoOpenFailure();
 
+			/// Enables keepalive on a socket, the timing in arTcp is only applied on POSIX systems
+			static void ApplyKeepalive(boost::asio::ip::tcp::socket& arSocket, const TCPSettings& arTcp);
+
 		protected:
 			boost::asio::ip::tcp::socket mSocket;
                         TCPSettings mTcp;
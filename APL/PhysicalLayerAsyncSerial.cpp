@@ -59,7 +59,7 @@ void PhysicalLayerAsyncSerial::DoOpen()
 	//use post to simulate an async open operation
 	if(!ec) asio_serial::Configure(mSettings, mPort, ec);
 
-	mpService->post(bind(&PhysicalLayerAsyncSerial::OnOpenCallback, this, ec));
+	mStrand.post(bind(&PhysicalLayerAsyncSerial::OnOpenCallback, this, ec));
 }
 
 void PhysicalLayerAsyncSerial::DoClose()
@@ -77,13 +77,20 @@ void PhysicalLayerAsyncSerial::DoOpenSuccess()
 void PhysicalLayerAsyncSerial::DoAsyncRead(byte_t* apBuffer, size_t aMaxBytes)
 {
 	mPort.async_read_some(buffer(apBuffer, aMaxBytes),
-		boost::bind(&PhysicalLayerAsyncSerial::OnReadCallback, this, placeholders::error, apBuffer, placeholders::bytes_transferred));
+		mStrand.wrap(boost::bind(&PhysicalLayerAsyncSerial::OnReadCallback, this, placeholders::error, apBuffer, placeholders::bytes_transferred)));
 }
 
 void PhysicalLayerAsyncSerial::DoAsyncWrite(const byte_t* apBuffer, size_t aNumBytes)
 {
 	async_write(mPort, buffer(apBuffer, aNumBytes), 
-		boost::bind(&PhysicalLayerAsyncSerial::OnWriteCallback, this, placeholders::error, aNumBytes));
+		mStrand.wrap(boost::bind(&PhysicalLayerAsyncSerial::OnWriteCallback, this, placeholders::error, aNumBytes)));
+}
+
+void PhysicalLayerAsyncSerial::DoAsyncWriteGather(const WriteBuffer* apBuffers, size_t aNumBuffers)
+{
+	const std::vector<const_buffer>& buffers = this->GetBufferSequence(apBuffers, aNumBuffers);
+	async_write(mPort, buffers,
+		mStrand.wrap(boost::bind(&PhysicalLayerAsyncSerial::OnWriteCallback, this, placeholders::error, buffer_size(buffers))));
 }
 
 }
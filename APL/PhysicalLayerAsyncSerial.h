@@ -39,6 +39,7 @@ namespace apl {
 			void DoOpenSuccess();
 			void DoAsyncRead(byte_t*, size_t);
 			void DoAsyncWrite(const byte_t*, size_t);
+			void DoAsyncWriteGather(const WriteBuffer*, size_t);
 
 			void DoOpen();
 
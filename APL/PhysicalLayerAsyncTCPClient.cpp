@@ -54,7 +54,7 @@ void PhysicalLayerAsyncTCPClient::DoOpen()
 	
 	ip::tcp::endpoint serverEndpoint(address, mTcp.mPort);
 
-	mSocket.async_connect(serverEndpoint, boost::bind(&PhysicalLayerAsyncTCPClient::OnOpenCallback, this, placeholders::error));
+	mSocket.async_connect(serverEndpoint, mStrand.wrap(boost::bind(&PhysicalLayerAsyncTCPClient::OnOpenCallback, this, placeholders::error)));
 }
 
 }
@@ -62,7 +62,7 @@ void PhysicalLayerAsyncTCPServer::DoOpen()
 		if(ec) throw Exception(LOCATION, ec.message());
 	}
 	
-	mAcceptor.async_accept(mSocket, boost::bind(&PhysicalLayerAsyncTCPServer::OnOpenCallback, this, placeholders::error));
+	mAcceptor.async_accept(mSocket, mStrand.wrap(boost::bind(&PhysicalLayerAsyncTCPServer::OnOpenCallback, this, placeholders::error)));
 }
 
 void PhysicalLayerAsyncTCPServer::DoOpeningClose()
@@ -0,0 +1,328 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include "ASIOIncludes.h"
+#include "PhysicalLayerAsyncUDP.h"
+
+#include <boost/bind.hpp>
+#include <string>
+#include <cstring>
+
+#include "Exception.h"
+#include "IHandlerAsync.h"
+#include "Logger.h"
+
+#if defined(__linux__) && defined(MSG_WAITFORONE)
+#define APL_UDP_MMSG
+#include <sys/socket.h>
+#include <errno.h>
+#endif
+
+using namespace boost;
+using namespace boost::asio;
+using namespace boost::system;
+using namespace std;
+
+namespace apl {
+
+const size_t PhysicalLayerAsyncUDP::MAX_BATCH;
+const int PhysicalLayerAsyncUDP::NO_LINK_ADDRESS;
+
+// fields of the DNP3 link header that the peers are keyed by, the addresses are little endian
+enum {
+	LH_START_05 = 0,
+	LH_START_64 = 1,
+	LH_DEST = 4,
+	LH_SRC = 6,
+	LH_ADDRESS_END = 8
+};
+
+PhysicalLayerAsyncUDP::PhysicalLayerAsyncUDP(Logger* apLogger, boost::asio::io_service* apIOService, const UDPSettings& arUdp) :
+PhysicalLayerAsyncASIO(apLogger, apIOService),
+mUdp(arUdp),
+mSocket(*apIOService),
+mHasRemote(false),
+mRx(MAX_BATCH),
+mRxHead(0),
+mRxCount(0),
+mTxNext(0),
+mTxBytes(0)
+{
+	if(mUdp.mMaxDatagramSize == 0) throw ArgumentException(LOCATION, "Max datagram size must be greater than 0");
+	for(size_t i = 0; i < MAX_BATCH; ++i) mRx[i].mBuffer.resize(mUdp.mMaxDatagramSize);
+}
+
+/* Implement the actions */
+
+void PhysicalLayerAsyncUDP::DoOpen()
+{
+	error_code ec;
+
+	ip::address_v4 local = ip::address_v4::from_string(mUdp.mLocalAddress, ec);
+	if(ec) throw ArgumentException(LOCATION, "string Address: " + mUdp.mLocalAddress + " is invalid");
+
+	mPeers.clear();
+	mHasRemote = !mUdp.mRemoteAddress.empty();
+	if(mHasRemote) {
+		ip::address_v4 remote = ip::address_v4::from_string(mUdp.mRemoteAddress, ec);
+		if(ec) throw ArgumentException(LOCATION, "string Address: " + mUdp.mRemoteAddress + " is invalid");
+		mRemote = ip::udp::endpoint(remote, mUdp.mRemotePort);
+	}
+
+	mSocket.open(ip::udp::v4(), ec);
+	if(!ec) mSocket.bind(ip::udp::endpoint(local, mUdp.mLocalPort), ec);
+
+	// binding completes immediately, but the state machine expects the callback later
+	mStrand.post(boost::bind(&PhysicalLayerAsyncUDP::OnOpenCallback, this, ec));
+}
+
+void PhysicalLayerAsyncUDP::DoClose()
+{
+	mRxHead = mRxCount = 0;
+
+	error_code ec;
+	mSocket.close(ec);
+	if(ec) LOG_BLOCK(LEV_WARNING, ec.message());
+}
+
+void PhysicalLayerAsyncUDP::DoOpenSuccess()
+{
+	LOG_BLOCK(LEV_INFO, "Bound to " << mUdp.mLocalAddress << ":" << mUdp.mLocalPort);
+}
+
+void PhysicalLayerAsyncUDP::DoOpenFailure()
+{
+	LOG_BLOCK(LEV_INFO, "Failed socket open, re-closing");
+	DoClose();
+}
+
+void PhysicalLayerAsyncUDP::DoAsyncRead(byte_t* apBuffer, size_t aMaxBytes)
+{
+	if(!this->Deliver(apBuffer, aMaxBytes)) this->WaitReadable(apBuffer, aMaxBytes);
+}
+
+void PhysicalLayerAsyncUDP::DoAsyncWrite(const byte_t* apBuffer, size_t aNumBytes)
+{
+	WriteBuffer buff(apBuffer, aNumBytes);
+	this->DoAsyncWriteGather(&buff, 1);
+}
+
+void PhysicalLayerAsyncUDP::DoAsyncWriteGather(const WriteBuffer* apBuffers, size_t aNumBuffers)
+{
+	mTxBuffers.assign(apBuffers, apBuffers + aNumBuffers);
+	mTx.clear();
+	mTxNext = 0;
+	mTxBytes = 0;
+
+	bool peers = mUdp.mRemoteAddress.empty();
+
+	for(size_t i = 0; i < aNumBuffers; ++i) {
+		size_t len = apBuffers[i].mLength;
+		int addr = peers ? LinkAddress(apBuffers[i].mpData, len, LH_DEST) : NO_LINK_ADDRESS;
+		if(mTx.empty() || (mTx.back().mSize + len) > mUdp.mMaxDatagramSize || mTx.back().mAddress != addr) {
+			mTx.push_back(TxDatagram(i, addr));
+		}
+		++mTx.back().mNum;
+		mTx.back().mSize += len;
+		mTxBytes += len;
+	}
+
+	for(size_t i = 0; i < mTx.size(); ++i) {
+		PeerMap::iterator p = (mTx[i].mAddress == NO_LINK_ADDRESS) ? mPeers.end() : mPeers.find(static_cast<uint_16_t>(mTx[i].mAddress));
+		mTx[i].mDest = (p == mPeers.end()) ? mRemote : p->second;
+	}
+
+	if(mHasRemote) this->WaitWritable();
+	else {
+		// UDP is lossy anyway, the layers above recover the same way they do from a lost datagram
+		LOG_BLOCK(LEV_WARNING, "No datagram received yet to reply to, dropping " << mTxBytes << " bytes");
+		mStrand.post(boost::bind(&PhysicalLayerAsyncUDP::OnWriteCallback, this, error_code(), mTxBytes));
+	}
+}
+
+/* Private helpers */
+
+int PhysicalLayerAsyncUDP::LinkAddress(const byte_t* apData, size_t aSize, size_t aOffset)
+{
+	if(aSize < LH_ADDRESS_END || apData[LH_START_05] != 0x05 || apData[LH_START_64] != 0x64) return NO_LINK_ADDRESS;
+	return apData[aOffset] | (apData[aOffset + 1] << 8);
+}
+
+void PhysicalLayerAsyncUDP::WaitReadable(byte_t* apBuffer, size_t aMaxBytes)
+{
+	mSocket.async_receive(null_buffers(),
+		mStrand.wrap(boost::bind(&PhysicalLayerAsyncUDP::OnReadable, this, placeholders::error, apBuffer, aMaxBytes)));
+}
+
+void PhysicalLayerAsyncUDP::WaitWritable()
+{
+	mSocket.async_send(null_buffers(),
+		mStrand.wrap(boost::bind(&PhysicalLayerAsyncUDP::OnWritable, this, placeholders::error)));
+}
+
+void PhysicalLayerAsyncUDP::OnReadable(const error_code& arErr, byte_t* apBuffer, size_t aMaxBytes)
+{
+	if(arErr) {
+		this->OnReadCallback(arErr, apBuffer, 0);
+		return;
+	}
+
+	error_code ec;
+	this->ReceiveBatch(ec);
+	if(ec) this->OnReadCallback(ec, apBuffer, 0);
+	else if(!this->Deliver(apBuffer, aMaxBytes)) this->WaitReadable(apBuffer, aMaxBytes);
+}
+
+void PhysicalLayerAsyncUDP::OnWritable(const error_code& arErr)
+{
+	if(arErr) {
+		this->OnWriteCallback(arErr, 0);
+		return;
+	}
+
+	error_code ec;
+	bool done = this->SendBatch(ec);
+	if(ec) this->OnWriteCallback(ec, 0);
+	else if(done) this->OnWriteCallback(ec, mTxBytes);
+	else this->WaitWritable();
+}
+
+bool PhysicalLayerAsyncUDP::Deliver(byte_t* apBuffer, size_t aMaxBytes)
+{
+	while(mRxHead < mRxCount && mRx[mRxHead].mPos == mRx[mRxHead].mSize) ++mRxHead;
+	if(mRxHead == mRxCount) return false;
+
+	RxDatagram& d = mRx[mRxHead];
+	size_t num = min(d.mSize - d.mPos, aMaxBytes);
+	memcpy(apBuffer, &d.mBuffer[d.mPos], num);
+	d.mPos += num;
+
+	// completion handlers may never run inside the initiating call
+	mStrand.post(boost::bind(&PhysicalLayerAsyncUDP::OnReadCallback, this, error_code(), apBuffer, num));
+	return true;
+}
+
+void PhysicalLayerAsyncUDP::ReceiveBatch(error_code& arErr)
+{
+	mRxHead = mRxCount = 0;
+
+#ifdef APL_UDP_MMSG
+	mmsghdr msgs[MAX_BATCH];
+	iovec iov[MAX_BATCH];
+	memset(msgs, 0, sizeof(msgs));
+
+	for(size_t i = 0; i < MAX_BATCH; ++i) {
+		iov[i].iov_base = &mRx[i].mBuffer[0];
+		iov[i].iov_len = mUdp.mMaxDatagramSize;
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = mRx[i].mSource.data();
+		msgs[i].msg_hdr.msg_namelen = mRx[i].mSource.capacity();
+	}
+
+	int num = recvmmsg(mSocket.native(), msgs, MAX_BATCH, MSG_DONTWAIT, NULL);
+	if(num < 0) {
+		if(errno != EAGAIN && errno != EWOULDBLOCK) arErr = error_code(errno, error::get_system_category());
+		return;
+	}
+
+	for(int i = 0; i < num; ++i) {
+		RxDatagram& d = mRx[i];
+		d.mPos = 0;
+		d.mSize = msgs[i].msg_len;
+		d.mSource.resize(msgs[i].msg_hdr.msg_namelen);
+		if(msgs[i].msg_hdr.msg_flags & MSG_TRUNC) {
+			LOG_BLOCK(LEV_WARNING, "Discarding datagram larger than " << mUdp.mMaxDatagramSize << " bytes");
+			d.mSize = 0;
+		}
+	}
+	mRxCount = num;
+#else
+	RxDatagram& d = mRx[0];
+	d.mPos = 0;
+	d.mSize = mSocket.receive_from(buffer(d.mBuffer), d.mSource, 0, arErr);
+	if(arErr == error::message_size) {
+		LOG_BLOCK(LEV_WARNING, "Discarding datagram larger than " << mUdp.mMaxDatagramSize << " bytes");
+		arErr = error_code();
+		d.mSize = 0;
+	}
+	if(!arErr) mRxCount = 1;
+#endif
+
+	if(!mUdp.mRemoteAddress.empty()) return;
+
+	// frames go back to the sender of their destination, anything else to whoever spoke last
+	for(size_t i = 0; i < mRxCount; ++i) {
+		const RxDatagram& d = mRx[i];
+		if(d.mSize == 0) continue;
+		int addr = LinkAddress(&d.mBuffer[0], d.mSize, LH_SRC);
+		if(addr != NO_LINK_ADDRESS) mPeers[static_cast<uint_16_t>(addr)] = d.mSource;
+		mRemote = d.mSource;
+		mHasRemote = true;
+	}
+}
+
+bool PhysicalLayerAsyncUDP::SendBatch(error_code& arErr)
+{
+#ifdef APL_UDP_MMSG
+	while(mTxNext < mTx.size()) {
+		size_t num = min(mTx.size() - mTxNext, MAX_BATCH);
+		mmsghdr msgs[MAX_BATCH];
+		memset(msgs, 0, sizeof(msgs));
+
+		size_t first = mTx[mTxNext].mFirst;
+		const TxDatagram& last = mTx[mTxNext + num - 1];
+		std::vector<iovec> iov(last.mFirst + last.mNum - first);
+		for(size_t i = 0; i < iov.size(); ++i) {
+			iov[i].iov_base = const_cast<byte_t*>(mTxBuffers[first + i].mpData);
+			iov[i].iov_len = mTxBuffers[first + i].mLength;
+		}
+
+		for(size_t i = 0; i < num; ++i) {
+			TxDatagram& dg = mTx[mTxNext + i];
+			msgs[i].msg_hdr.msg_iov = &iov[dg.mFirst - first];
+			msgs[i].msg_hdr.msg_iovlen = dg.mNum;
+			msgs[i].msg_hdr.msg_name = dg.mDest.data();
+			msgs[i].msg_hdr.msg_namelen = dg.mDest.size();
+		}
+
+		int sent = sendmmsg(mSocket.native(), msgs, num, MSG_DONTWAIT);
+		if(sent < 0) {
+			if(errno != EAGAIN && errno != EWOULDBLOCK) arErr = error_code(errno, error::get_system_category());
+			return false;
+		}
+		mTxNext += sent;
+	}
+#else
+	std::vector<const_buffer> buffers;
+	for(; mTxNext < mTx.size(); ++mTxNext) {
+		const TxDatagram& dg = mTx[mTxNext];
+		buffers.clear();
+		for(size_t i = dg.mFirst; i < dg.mFirst + dg.mNum; ++i) {
+			buffers.push_back(const_buffer(mTxBuffers[i].mpData, mTxBuffers[i].mLength));
+		}
+		mSocket.send_to(buffers, dg.mDest, 0, arErr);
+		if(arErr) return false;
+	}
+#endif
+
+	return true;
+}
+
+}
+
@@ -0,0 +1,128 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __PHYSICAL_LAYER_ASYNC_UDP_H_
+#define __PHYSICAL_LAYER_ASYNC_UDP_H_
+
+#include "PhysicalLayerAsyncASIO.h"
+#include "UDPTypes.h"
+#include <boost/asio/ip/udp.hpp>
+
+#include <vector>
+#include <map>
+
+namespace apl {
+
+	/**
+	Datagram physical layer. Every write is sent as one or more datagrams that each carry
+	whole buffers from the gather list, so link frames are never split across datagrams,
+	and every read returns bytes from a single datagram.
+
+	On Linux the layer drains and sends up to MAX_BATCH datagrams per system call with
+	recvmmsg/sendmmsg, which matters when a router multiplexes many stacks onto the socket.
+
+	Without a configured remote address the layer learns its peers from the DNP3 link header at
+	the start of each received datagram, keeping the sender of every link source address. Each
+	datagram it sends goes to the peer of the destination address of its first frame, and frames
+	for different destinations are never packed together. Anything else is sent to the most
+	recent sender.
+	*/
+	class PhysicalLayerAsyncUDP : public PhysicalLayerAsyncASIO
+	{
+		public:
+			PhysicalLayerAsyncUDP(Logger*, boost::asio::io_service* apIOService, const UDPSettings& arUdp);
+
+			/// Most datagrams read or written by one system call
+			static const size_t MAX_BATCH = 16;
+
+			/* Implement the actions */
+			void DoOpen();
+			void DoClose();
+			void DoOpenSuccess();
+			void DoOpenFailure();
+			void DoAsyncRead(byte_t*, size_t);
+			void DoAsyncWrite(const byte_t*, size_t);
+			void DoAsyncWriteGather(const WriteBuffer*, size_t);
+
+		private:
+
+			struct RxDatagram
+			{
+				RxDatagram() : mSize(0), mPos(0) {}
+
+				std::vector<byte_t> mBuffer;
+				size_t mSize;
+				size_t mPos;	/// bytes already handed to the reader
+				boost::asio::ip::udp::endpoint mSource;
+			};
+
+			/// a run of mTxBuffers sent as one datagram
+			struct TxDatagram
+			{
+				TxDatagram(size_t aFirst, int aAddress) : mFirst(aFirst), mNum(0), mSize(0), mAddress(aAddress) {}
+
+				size_t mFirst;
+				size_t mNum;
+				size_t mSize;
+				int mAddress;	/// link destination of the frames, NO_LINK_ADDRESS if they aren't link frames
+				boost::asio::ip::udp::endpoint mDest;
+			};
+
+			/// returned by LinkAddress() for bytes that don't start with a link header
+			static const int NO_LINK_ADDRESS = -1;
+
+			/// @return the link address at aOffset in the header that apData starts with, or NO_LINK_ADDRESS
+			static int LinkAddress(const byte_t* apData, size_t aSize, size_t aOffset);
+
+			void OnReadable(const boost::system::error_code& arErr, byte_t* apBuffer, size_t aMaxBytes);
+			void OnWritable(const boost::system::error_code& arErr);
+
+			/// Copies the next queued bytes into apBuffer and completes the read, false if nothing is queued
+			bool Deliver(byte_t* apBuffer, size_t aMaxBytes);
+
+			/// Fills the receive queue with whatever datagrams are waiting, without blocking
+			void ReceiveBatch(boost::system::error_code& arErr);
+
+			/// Sends queued datagrams until the socket would block
+			/// @return true if every datagram has been sent
+			bool SendBatch(boost::system::error_code& arErr);
+
+			void WaitReadable(byte_t* apBuffer, size_t aMaxBytes);
+			void WaitWritable();
+
+			UDPSettings mUdp;
+			boost::asio::ip::udp::socket mSocket;
+
+			boost::asio::ip::udp::endpoint mRemote;
+			bool mHasRemote;	/// false until the first datagram arrives if no remote address was configured
+
+			typedef std::map<uint_16_t, boost::asio::ip::udp::endpoint> PeerMap;
+			PeerMap mPeers;		/// sender of the last datagram from each link source address
+
+			std::vector<RxDatagram> mRx;
+			size_t mRxHead;		/// next datagram to read from
+			size_t mRxCount;	/// datagrams received by the last batch
+
+			std::vector<WriteBuffer> mTxBuffers;
+			std::vector<TxDatagram> mTx;
+			size_t mTxNext;		/// first datagram not yet sent
+			size_t mTxBytes;
+	};
+}
+
+#endif
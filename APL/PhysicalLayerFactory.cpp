@@ -22,6 +22,7 @@
 #include "PhysicalLayerAsyncSerial.h"
 #include "PhysicalLayerAsyncTCPClient.h"
 #include "PhysicalLayerAsyncTCPServer.h"
+#include "PhysicalLayerAsyncUDP.h"
 
 #include "Log.h"
 
@@ -43,6 +44,11 @@ namespace apl {
 	{
 		return boost::bind(&PhysicalLayerFactory::FGetTCPServerAsync, aTcp, _2, _1);
 	}
+
+	IPhysicalLayerAsyncFactory PhysicalLayerFactory :: GetUDPAsync(UDPSettings aUdp)
+	{
+		return boost::bind(&PhysicalLayerFactory::FGetUDPAsync, aUdp, _2, _1);
+	}
 	
 	IPhysicalLayerAsync* PhysicalLayerFactory :: FGetSerialAsync(SerialSettings s, boost::asio::io_service* apSrv, Logger* apLogger)
 	{
@@ -59,4 +65,9 @@ namespace apl {
 		return new PhysicalLayerAsyncTCPServer(apLogger, apSrv, aTcp);
 	}
 
+	IPhysicalLayerAsync* PhysicalLayerFactory :: FGetUDPAsync(UDPSettings aUdp, boost::asio::io_service* apSrv, Logger* apLogger)
+	{
+		return new PhysicalLayerAsyncUDP(apLogger, apSrv, aUdp);
+	}
+
 }
@@ -22,6 +22,7 @@
 
 #include "SerialTypes.h"
 #include "TCPTypes.h"
+#include "UDPTypes.h"
 #include "Types.h"
 #include "Exception.h"
 #include "PhysicalLayerFunctors.h"
@@ -36,11 +37,13 @@ namespace apl{
 		static IPhysicalLayerAsyncFactory GetSerialAsync(SerialSettings s);
 		static IPhysicalLayerAsyncFactory GetTCPClientAsync(TCPSettings aTcp);
 		static IPhysicalLayerAsyncFactory GetTCPServerAsync(TCPSettings aTcp);
+		static IPhysicalLayerAsyncFactory GetUDPAsync(UDPSettings aUdp);
 
 		//normal factory functions
 		static IPhysicalLayerAsync* FGetSerialAsync(SerialSettings s, boost::asio::io_service* apSrv, Logger* apLogger);
 		static IPhysicalLayerAsync* FGetTCPClientAsync(TCPSettings aTcp, boost::asio::io_service* apSrv, Logger* apLogger);
 		static IPhysicalLayerAsync* FGetTCPServerAsync(TCPSettings aTcp, boost::asio::io_service* apSrv, Logger* apLogger);
+		static IPhysicalLayerAsync* FGetUDPAsync(UDPSettings aUdp, boost::asio::io_service* apSrv, Logger* apLogger);
 	};
 }
 
@@ -76,4 +76,11 @@ namespace apl
 		this->AddLayer(arName, s, pli);
 	}
 
+	void PhysicalLayerManager ::AddUDP(const std::string& arName, PhysLayerSettings s, UDPSettings aUdp)
+	{
+		IPhysicalLayerAsyncFactory fac = PhysicalLayerFactory::GetUDPAsync(aUdp);
+		PhysLayerInstance pli(fac);
+		this->AddLayer(arName, s, pli);
+	}
+
 }
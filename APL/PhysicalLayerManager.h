@@ -23,6 +23,7 @@
 #include "PhysicalLayerMap.h"
 #include "SerialTypes.h"
 #include "TCPTypes.h"
+#include "UDPTypes.h"
 
 namespace apl
 {
@@ -41,6 +42,7 @@ namespace apl
 			void AddTCPClient(const std::string& arName, PhysLayerSettings, TCPSettings);
 			void AddTCPServer(const std::string& arName, PhysLayerSettings, TCPSettings);
 			void AddSerial(const std::string& arName, PhysLayerSettings, SerialSettings);
+			void AddUDP(const std::string& arName, PhysLayerSettings, UDPSettings);
 
 			/// Removes a physical layer and deletes it if the manager has ownership.
 			void Remove(const std::string& arName);
@@ -33,6 +33,7 @@ namespace apl
 		virtual ~PhysicalLayerMap() {}
 
 		PhysLayerSettings GetSettings(const std::string& arName);
+		bool HasLayer(const std::string& arName) const { return mSettingsMap.find(arName) != mSettingsMap.end(); }
 		IPhysicalLayerAsync* GetLayer(const std::string& arName, boost::asio::io_service*);
 
 
@@ -0,0 +1,57 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __RELEASABLE_TIMER_SOURCE_H_
+#define __RELEASABLE_TIMER_SOURCE_H_
+
+#include "TimerInterfaces.h"
+#include "Lock.h"
+
+namespace apl {
+
+	/**
+	 * Base of the timer sources that can be handed off without knowing when the io_service is
+	 * done with them. The subclass counts every handler it gives the io_service with AddPending
+	 * and every handler that has been dispatched with RemovePending, and the source deletes
+	 * itself once it has been released and the count drops to zero.
+	 */
+	class ReleasableTimerSource : public ITimerSource
+	{
+		public:
+			ReleasableTimerSource();
+
+			/// Deletes the timer source as soon as every expiration and post it has handed to the io_service
+			/// has been dispatched, which may be right away. Nothing may be started or posted afterwards.
+			virtual void Release();
+
+		protected:
+
+			void AddPending();
+
+			/// May delete the timer source, so it has to be the last thing a handler does
+			void RemovePending();
+
+		private:
+
+			SigLock mLock;			/// guards the two members below, posts can come from any thread
+			size_t mNumPending;		/// handlers given to the io_service that haven't been dispatched yet
+			bool mRelease;
+	};
+}
+
+#endif
@@ -0,0 +1,99 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include "RttEstimator.h"
+
+#include "Exception.h"
+
+#include <math.h>
+
+namespace apl
+{
+	RttEstimator::RttEstimator(millis_t aInitial, millis_t aMin, millis_t aMax) :
+	mMin(aMin),
+	mMax(aMax),
+	mHasSample(false),
+	mSrtt(0),
+	mRttVar(0),
+	mTimeout(0),
+	mpRegistry(NULL),
+	mSrttGauge(0),
+	mRttVarGauge(0),
+	mTimeoutGauge(0)
+	{
+		if(aMin < 0 || aMin > aMax) throw ArgumentException(LOCATION, "Timeout bounds must satisfy 0 <= min <= max");
+		this->SetTimeout(aInitial);
+	}
+
+	void RttEstimator::Sample(millis_t aRtt)
+	{
+		double rtt = (aRtt < 0) ? 0 : static_cast<double>(aRtt);
+
+		if(mHasSample) {
+			mRttVar = 0.75*mRttVar + 0.25*fabs(mSrtt - rtt);
+			mSrtt = 0.875*mSrtt + 0.125*rtt;
+		}
+		else {
+			mSrtt = rtt;
+			mRttVar = rtt/2;
+			mHasSample = true;
+		}
+
+		this->SetTimeout(static_cast<millis_t>(ceil(mSrtt + 4*mRttVar)));
+	}
+
+	void RttEstimator::Backoff()
+	{
+		this->SetTimeout((mTimeout > mMax/2) ? mMax : 2*mTimeout);
+	}
+
+	void RttEstimator::SetTimeout(millis_t aTimeout)
+	{
+		if(aTimeout < mMin) mTimeout = mMin;
+		else if(aTimeout > mMax) mTimeout = mMax;
+		else mTimeout = aTimeout;
+
+		this->UpdateMetrics();
+	}
+
+	void RttEstimator::SetMetrics(MetricRegistry* apRegistry, const std::string& arPrefix)
+	{
+		std::vector<std::string> names;
+		GetMetricNames(arPrefix, names);
+		mSrttGauge = apRegistry->RegisterGauge(names[0]);
+		mRttVarGauge = apRegistry->RegisterGauge(names[1]);
+		mTimeoutGauge = apRegistry->RegisterGauge(names[2]);
+		mpRegistry = apRegistry;
+		this->UpdateMetrics();
+	}
+
+	void RttEstimator::GetMetricNames(const std::string& arPrefix, std::vector<std::string>& arNames)
+	{
+		arNames.push_back(arPrefix + ".srtt_ms");
+		arNames.push_back(arPrefix + ".rttvar_ms");
+		arNames.push_back(arPrefix + ".timeout_ms");
+	}
+
+	void RttEstimator::UpdateMetrics()
+	{
+		if(mpRegistry == NULL) return;
+		mpRegistry->SetGauge(mSrttGauge, static_cast<size_t>(mSrtt));
+		mpRegistry->SetGauge(mRttVarGauge, static_cast<size_t>(mRttVar));
+		mpRegistry->SetGauge(mTimeoutGauge, static_cast<size_t>(mTimeout));
+	}
+}
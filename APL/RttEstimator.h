@@ -0,0 +1,82 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __RTT_ESTIMATOR_H_
+#define __RTT_ESTIMATOR_H_
+
+#include "Types.h"
+#include "MetricRegistry.h"
+
+#include <string>
+
+namespace apl
+{
+	/** Retry timeout derived from measured round trip times the way TCP computes its RTO (RFC 2988):
+
+			srtt = 7/8 srtt + 1/8 rtt
+			rttvar = 3/4 rttvar + 1/4 |srtt - rtt|
+			timeout = srtt + 4 rttvar, bounded to [min, max]
+
+		Each timeout doubles the current value until the next sample. Only exchanges that weren't
+		retried should be sampled, a reply to a retry can't be matched to the attempt it answers.
+		Not thread safe, the owner's strand samples and reads it.
+	*/
+	class RttEstimator
+	{
+		public:
+			/// aInitial is used until the first sample, it's bounded like the computed timeout
+			RttEstimator(millis_t aInitial, millis_t aMin, millis_t aMax);
+
+			/// Update the estimate with the round trip time of an exchange that wasn't retried
+			void Sample(millis_t aRtt);
+
+			/// Double the timeout after a timer expired
+			void Backoff();
+
+			millis_t GetTimeout() const { return mTimeout; }
+			millis_t GetSmoothedRtt() const { return static_cast<millis_t>(mSrtt); }
+			millis_t GetRttVar() const { return static_cast<millis_t>(mRttVar); }
+			bool HasSample() const { return mHasSample; }
+
+			/// Report the estimate as the gauges "<arPrefix>.srtt_ms", "<arPrefix>.rttvar_ms" and "<arPrefix>.timeout_ms"
+			void SetMetrics(MetricRegistry* apRegistry, const std::string& arPrefix);
+
+			/// Appends the names SetMetrics registers under arPrefix to arNames
+			static void GetMetricNames(const std::string& arPrefix, std::vector<std::string>& arNames);
+
+		private:
+
+			void SetTimeout(millis_t aTimeout);
+			void UpdateMetrics();
+
+			const millis_t mMin;
+			const millis_t mMax;
+
+			bool mHasSample;
+			double mSrtt;
+			double mRttVar;
+			millis_t mTimeout;
+
+			MetricRegistry* mpRegistry;
+			MetricHandle mSrttGauge;
+			MetricHandle mRttVarGauge;
+			MetricHandle mTimeoutGauge;
+	};
+}
+
+#endif
@@ -32,7 +32,8 @@ mPort(aPort),
 mEnableKeepalive(aEnableKeepalive),
 mKeepaliveTime(aKeepaliveTime),
 mKeepaliveInterval(aKeepaliveInterval),
-mKeepaliveProbes(aKeepaliveProbes)
+mKeepaliveProbes(aKeepaliveProbes),
+mConcurrentMasters(false)
 {
 }
 
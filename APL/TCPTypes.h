@@ -40,6 +40,11 @@ namespace apl {
 		int mKeepaliveTime;
 		int mKeepaliveInterval;
 		int mKeepaliveProbes;
+
+		/// When set, every master stack on the port schedules its tasks in a lane of its own instead
+		/// of sharing the port's task group, so requests to different outstations are in flight at
+		/// the same time. Defaults to false.
+		bool mConcurrentMasters;
 	};
 
 }
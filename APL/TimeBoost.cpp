@@ -63,6 +63,12 @@ namespace apl{
 		return static_cast<millis_t>(((now.mTime - mTime).total_milliseconds()));
 	}
 
+	int_64_t TimeBoost::GetElapsedUS() const
+	{
+		TimeBoost now;
+		return static_cast<int_64_t>(((now.mTime - mTime).total_microseconds()));
+	}
+
 	std::string TimeBoost::GetTimeString() const
 	{
 		return apl::ToNormalizedString(mTime);
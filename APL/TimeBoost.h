@@ -47,6 +47,7 @@ namespace apl{
 			void SetToNow();
 
 			apl::millis_t GetElapsedMS() const;
+			int_64_t GetElapsedUS() const;
 
 			void SetTo(millis_t aTimeMS);
 
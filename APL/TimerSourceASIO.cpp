@@ -27,13 +27,16 @@
 
 namespace apl {
 
-TimerSourceASIO::TimerSourceASIO(boost::asio::io_service* apService) :
-mpService(apService)
+TimerSourceASIO::TimerSourceASIO(boost::asio::io_service* apService, boost::asio::io_service::strand* apStrand, bool aOwnsStrand) :
+mpService(apService),
+mpStrand(apStrand),
+mOwnsStrand(aOwnsStrand)
 {}
 
 TimerSourceASIO::~TimerSourceASIO()
 {
 	BOOST_FOREACH(TimerASIO* pTimer, mAllTimers) { delete pTimer; }
+	if(mOwnsStrand) delete mpStrand;
 }
 
 ITimer* TimerSourceASIO::Start(millis_t aDelay, const ExpirationHandler& arCallback)
@@ -54,7 +57,9 @@ ITimer* TimerSourceASIO::Start(const boost::posix_time::ptime& arTime, const Exp
 
 void TimerSourceASIO::Post(const ExpirationHandler& arHandler)
 {
-	mpService->post(arHandler);
+	this->AddPending();
+	if(mpStrand == NULL) mpService->post(boost::bind(&TimerSourceASIO::OnPost, this, arHandler));
+	else mpStrand->post(boost::bind(&TimerSourceASIO::OnPost, this, arHandler));
 }
 
 TimerASIO* TimerSourceASIO::GetTimer()
@@ -75,13 +80,22 @@ TimerASIO* TimerSourceASIO::GetTimer()
 
 void TimerSourceASIO::StartTimer(TimerASIO* apTimer, const ExpirationHandler& arCallback)
 {
-	apTimer->mTimer.async_wait(boost::bind(&TimerSourceASIO::OnTimerCallback, this, _1, apTimer, arCallback));
+	this->AddPending();
+	if(mpStrand == NULL) apTimer->mTimer.async_wait(boost::bind(&TimerSourceASIO::OnTimerCallback, this, _1, apTimer, arCallback));
+	else apTimer->mTimer.async_wait(mpStrand->wrap(boost::bind(&TimerSourceASIO::OnTimerCallback, this, _1, apTimer, arCallback)));
 }
 
 void TimerSourceASIO::OnTimerCallback(const boost::system::error_code& ec, TimerASIO* apTimer, ExpirationHandler aCallback)
 {
 	mIdleTimers.push_back(apTimer);
 	if(! (ec || apTimer->mCanceled) ) aCallback();
+	this->RemovePending();
+}
+
+void TimerSourceASIO::OnPost(ExpirationHandler aHandler)
+{
+	aHandler();
+	this->RemovePending();
 }
 
 } //end namespace
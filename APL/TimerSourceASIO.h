@@ -19,25 +19,26 @@
 #ifndef __TIMER_SOURCE_ASIO_H_
 #define __TIMER_SOURCE_ASIO_H_
 
-#include "TimerInterfaces.h"
+#include "ASIOIncludes.h"
+#include "ReleasableTimerSource.h"
 
 #include <queue>
 
-namespace boost {
-
-namespace asio { class io_service; }
-namespace system { class error_code; }
-
-}
-
 namespace apl {
 
 	class TimerASIO;
 
-	class TimerSourceASIO : public ITimerSource
+	class TimerSourceASIO : public ReleasableTimerSource
 	{
 		public:
-			TimerSourceASIO(boost::asio::io_service*);
+			/**
+				@param apService	io_service that drives the timers
+				@param apStrand		Optional strand through which all expirations and posts are dispatched. Required
+									when the io_service is run from more than one thread and the timer source's users
+									expect to be called from a single thread at a time.
+				@param aOwnsStrand	If true, the strand is deleted along with the timer source
+			*/
+			TimerSourceASIO(boost::asio::io_service* apService, boost::asio::io_service::strand* apStrand = NULL, bool aOwnsStrand = false);
 			~TimerSourceASIO();
 
 			ITimer* Start(millis_t, const ExpirationHandler&);
@@ -50,6 +51,8 @@ namespace apl {
 			void StartTimer(TimerASIO*, const ExpirationHandler&);
 
 			boost::asio::io_service* mpService;
+			boost::asio::io_service::strand* mpStrand;
+			bool mOwnsStrand;
 
 			typedef std::deque<TimerASIO*> TimerQueue;
 
@@ -57,6 +60,7 @@ namespace apl {
 			TimerQueue mIdleTimers;
 
 			void OnTimerCallback(const boost::system::error_code&, TimerASIO*, ExpirationHandler);
+			void OnPost(ExpirationHandler);
 	};
 }
 
@@ -0,0 +1,372 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include "TimerSourceWheel.h"
+
+#include <boost/foreach.hpp>
+#include <boost/bind.hpp>
+#include <algorithm>
+#include <assert.h>
+
+using namespace boost::posix_time;
+
+namespace apl {
+
+TimerWheelEntry::TimerWheelEntry(TimerSourceWheel* apSource) :
+mpSource(apSource),
+mpPrev(this),
+mpNext(this),
+mTick(0),
+mList(0)
+{}
+
+void TimerWheelEntry::Cancel()
+{
+	assert(!this->IsEmpty());
+	mpSource->Remove(this);
+	mpSource->Release(this);
+}
+
+void TimerWheelEntry::LinkBefore(TimerWheelEntry* apNode)
+{
+	mpPrev = apNode->mpPrev;
+	mpNext = apNode;
+	apNode->mpPrev->mpNext = this;
+	apNode->mpPrev = this;
+}
+
+void TimerWheelEntry::Unlink()
+{
+	mpPrev->mpNext = mpNext;
+	mpNext->mpPrev = mpPrev;
+	mpPrev = mpNext = this;
+}
+
+const boost::uint64_t TimerSourceWheel::NEVER = static_cast<boost::uint64_t>(-1);
+
+TimerSourceWheel::TimerSourceWheel(boost::asio::io_service* apService, boost::asio::io_service::strand* apStrand, millis_t aResolution, bool aOwnsStrand) :
+mpService(apService),
+mpStrand(apStrand),
+mOwnsStrand(aOwnsStrand),
+mTimer(*apService),
+mEpoch(boost::asio::deadline_timer::traits_type::now()),
+mResolution((aResolution > 0) ? aResolution * 1000 : 1000),
+mTick(0),
+mArmed(false),
+mDispatching(false),
+mArmedTick(0),
+mpOverflow(new TimerWheelEntry(this)),
+mpNever(new TimerWheelEntry(this))
+{
+	for(size_t i = 0; i < NUM_SLOTS; ++i) mSlots[i] = new TimerWheelEntry(this);
+	for(size_t i = 0; i < NUM_LISTS; ++i) mCount[i] = 0;
+}
+
+TimerSourceWheel::~TimerSourceWheel()
+{
+	BOOST_FOREACH(TimerWheelEntry* pTimer, mAllTimers) { delete pTimer; }
+	for(size_t i = 0; i < NUM_SLOTS; ++i) delete mSlots[i];
+	delete mpOverflow;
+	delete mpNever;
+	if(mOwnsStrand) delete mpStrand;
+}
+
+void TimerSourceWheel::Release()
+{
+	boost::system::error_code ec;
+	mTimer.cancel(ec);
+	ReleasableTimerSource::Release();
+}
+
+ITimer* TimerSourceWheel::Start(millis_t aDelay, const ExpirationHandler& arCallback)
+{
+	ptime expiration = boost::asio::deadline_timer::traits_type::now() + milliseconds(aDelay);
+	return this->StartTimer(this->GetTimer(), expiration, arCallback);
+}
+
+ITimer* TimerSourceWheel::Start(const ptime& arTime, const ExpirationHandler& arCallback)
+{
+	return this->StartTimer(this->GetTimer(), arTime, arCallback);
+}
+
+void TimerSourceWheel::Post(const ExpirationHandler& arHandler)
+{
+	this->AddPending();
+	if(mpStrand == NULL) mpService->post(boost::bind(&TimerSourceWheel::OnPost, this, arHandler));
+	else mpStrand->post(boost::bind(&TimerSourceWheel::OnPost, this, arHandler));
+}
+
+size_t TimerSourceWheel::NumActive() const
+{
+	size_t num = 0;
+	for(size_t i = 0; i < NUM_LISTS; ++i) num += mCount[i];
+	return num;
+}
+
+size_t TimerSourceWheel::ShiftOf(size_t aList)
+{
+	return (aList == 0) ? 0 : ROOT_BITS + (aList - 1) * LEVEL_BITS;
+}
+
+TimerWheelEntry* TimerSourceWheel::GetTimer()
+{
+	TimerWheelEntry* pTimer;
+	if(mIdleTimers.size() == 0) {
+		pTimer = new TimerWheelEntry(this);
+		mAllTimers.push_back(pTimer);
+	}
+	else {
+		pTimer = mIdleTimers.front();
+		mIdleTimers.pop_front();
+	}
+	return pTimer;
+}
+
+ITimer* TimerSourceWheel::StartTimer(TimerWheelEntry* apTimer, const ptime& arTime, const ExpirationHandler& arCallback)
+{
+	// nothing is pending, so the wheel can skip straight to the present
+	if(this->IsIdle()) mTick = std::max(mTick, this->CurrentTick());
+
+	boost::uint64_t tick = this->TickFor(arTime);
+	if(tick != NEVER && tick <= mTick) tick = mTick + 1;
+
+	apTimer->mExpiration = arTime;
+	apTimer->mHandler = arCallback;
+	apTimer->mTick = tick;
+	this->Insert(apTimer);
+
+	if(tick != NEVER && !mDispatching && (!mArmed || tick < mArmedTick)) this->Arm(tick);
+
+	return apTimer;
+}
+
+void TimerSourceWheel::Release(TimerWheelEntry* apTimer)
+{
+	apTimer->mHandler.clear();
+	mIdleTimers.push_back(apTimer);
+}
+
+void TimerSourceWheel::Insert(TimerWheelEntry* apTimer)
+{
+	TimerWheelEntry* pList;
+	size_t list;
+
+	if(apTimer->mTick == NEVER) {
+		list = NEVER_LIST;
+		pList = mpNever;
+	}
+	else {
+		assert(apTimer->mTick >= mTick);
+		boost::uint64_t delta = apTimer->mTick - mTick;
+
+		list = 0;
+		while(list < NUM_LEVELS && delta >= (static_cast<boost::uint64_t>(1) << ShiftOf(list + 1))) ++list;
+
+		if(list == 0) pList = mSlots[apTimer->mTick & (ROOT_SIZE - 1)];
+		else if(list < NUM_LEVELS) {
+			size_t index = static_cast<size_t>(apTimer->mTick >> ShiftOf(list)) & (LEVEL_SIZE - 1);
+			pList = mSlots[ROOT_SIZE + (list - 1) * LEVEL_SIZE + index];
+		}
+		else pList = mpOverflow;
+	}
+
+	apTimer->mList = list;
+	apTimer->LinkBefore(pList);
+	++mCount[list];
+}
+
+void TimerSourceWheel::Remove(TimerWheelEntry* apTimer)
+{
+	apTimer->Unlink();
+	--mCount[apTimer->mList];
+}
+
+size_t TimerSourceWheel::Cascade(size_t aLevel)
+{
+	size_t index = static_cast<size_t>(mTick >> ShiftOf(aLevel)) & (LEVEL_SIZE - 1);
+	TimerWheelEntry* pSlot = mSlots[ROOT_SIZE + (aLevel - 1) * LEVEL_SIZE + index];
+
+	while(!pSlot->IsEmpty()) {
+		TimerWheelEntry* pTimer = pSlot->mpNext;
+		this->Remove(pTimer);
+		this->Insert(pTimer);
+	}
+
+	return index;
+}
+
+void TimerSourceWheel::CascadeOverflow()
+{
+	// timers that are still out of range go back on the end of the list
+	for(size_t num = mCount[OVERFLOW_LIST]; num > 0; --num) {
+		TimerWheelEntry* pTimer = mpOverflow->mpNext;
+		this->Remove(pTimer);
+		this->Insert(pTimer);
+	}
+}
+
+void TimerSourceWheel::Expire(TimerWheelEntry* apSlot)
+{
+	// timers started by the handlers land on later ticks, never in this slot
+	while(!apSlot->IsEmpty()) {
+		TimerWheelEntry* pTimer = apSlot->mpNext;
+		this->Remove(pTimer);
+		ExpirationHandler handler;
+		handler.swap(pTimer->mHandler);
+		this->Release(pTimer);
+		handler();
+	}
+}
+
+void TimerSourceWheel::Step()
+{
+	++mTick;
+
+	if((mTick & (ROOT_SIZE - 1)) == 0) {
+		size_t level = 1;
+		while(level < NUM_LEVELS && this->Cascade(level) == 0) ++level;
+		if(level == NUM_LEVELS) this->CascadeOverflow();
+	}
+
+	this->Expire(mSlots[mTick & (ROOT_SIZE - 1)]);
+}
+
+void TimerSourceWheel::Advance(boost::uint64_t aTick)
+{
+	while(mTick < aTick) {
+		// with an empty root level nothing happens until the next cascade
+		if(mCount[0] == 0) {
+			boost::uint64_t next = this->NextCascade();
+			if(next > aTick) {
+				mTick = aTick;
+				break;
+			}
+			if(next - 1 > mTick) {
+				mTick = next - 1;
+				continue;
+			}
+		}
+		this->Step();
+	}
+}
+
+boost::uint64_t TimerSourceWheel::NextCascade() const
+{
+	for(size_t list = 1; list <= OVERFLOW_LIST; ++list) {
+		if(mCount[list] > 0) {
+			size_t shift = ShiftOf(list);
+			return ((mTick >> shift) + 1) << shift;
+		}
+	}
+	return NEVER;
+}
+
+bool TimerSourceWheel::IsIdle() const
+{
+	for(size_t i = 0; i < NEVER_LIST; ++i) if(mCount[i] > 0) return false;
+	return true;
+}
+
+void TimerSourceWheel::Arm(boost::uint64_t aTick)
+{
+	mArmed = true;
+	mArmedTick = aTick;
+	mTimer.expires_at(this->TimeOf(aTick));
+	this->AddPending();
+	if(mpStrand == NULL) mTimer.async_wait(boost::bind(&TimerSourceWheel::OnTimerCallback, this, _1));
+	else mTimer.async_wait(mpStrand->wrap(boost::bind(&TimerSourceWheel::OnTimerCallback, this, _1)));
+}
+
+void TimerSourceWheel::ArmNext()
+{
+	boost::uint64_t tick = this->NextCascade();
+
+	if(mCount[0] > 0) {
+		for(boost::uint64_t t = mTick + 1; t < tick && t <= mTick + ROOT_SIZE; ++t) {
+			if(!mSlots[t & (ROOT_SIZE - 1)]->IsEmpty()) {
+				tick = t;
+				break;
+			}
+		}
+	}
+
+	if(tick != NEVER) this->Arm(tick);
+}
+
+void TimerSourceWheel::OnTimerCallback(const boost::system::error_code& ec)
+{
+	// the wait was replaced by an earlier one, or the source is being released
+	if(!ec) {
+		try {
+			this->OnTick();
+		}
+		catch(...) {
+			this->RemovePending();
+			throw;
+		}
+	}
+	this->RemovePending();
+}
+
+void TimerSourceWheel::OnPost(ExpirationHandler aHandler)
+{
+	aHandler();
+	this->RemovePending();
+}
+
+void TimerSourceWheel::OnTick()
+{
+	mArmed = false;
+	mDispatching = true;
+
+	try {
+		// picks up anything left behind if a handler threw on the last pass
+		this->Expire(mSlots[mTick & (ROOT_SIZE - 1)]);
+		this->Advance(this->CurrentTick());
+	}
+	catch(...) {
+		mDispatching = false;
+		this->Arm(mTick);
+		throw;
+	}
+
+	mDispatching = false;
+	this->ArmNext();
+}
+
+boost::uint64_t TimerSourceWheel::TickFor(const ptime& arTime) const
+{
+	if(arTime.is_pos_infinity() || arTime >= ptime(boost::date_time::max_date_time)) return NEVER;
+	if(arTime.is_special()) return 0;
+
+	boost::int64_t us = (arTime - mEpoch).total_microseconds();
+	return (us <= 0) ? 0 : (us + mResolution - 1) / mResolution;
+}
+
+boost::uint64_t TimerSourceWheel::CurrentTick() const
+{
+	boost::int64_t us = (boost::asio::deadline_timer::traits_type::now() - mEpoch).total_microseconds();
+	return (us <= 0) ? 0 : us / mResolution;
+}
+
+ptime TimerSourceWheel::TimeOf(boost::uint64_t aTick) const
+{
+	return mEpoch + microseconds(static_cast<boost::int64_t>(aTick) * mResolution);
+}
+
+} //end namespace
@@ -0,0 +1,174 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __TIMER_SOURCE_WHEEL_H_
+#define __TIMER_SOURCE_WHEEL_H_
+
+#include "ASIOIncludes.h"
+#include "ReleasableTimerSource.h"
+
+#include <boost/cstdint.hpp>
+#include <deque>
+
+namespace apl {
+
+	class TimerSourceWheel;
+
+	/**
+	 * Timer handed out by TimerSourceWheel. It's an intrusive list node that is
+	 * linked into one slot of the wheel while it's pending.
+	 */
+	class TimerWheelEntry : public ITimer
+	{
+		friend class TimerSourceWheel;
+
+		public:
+
+			/// Implement ITimer
+			void Cancel();
+			boost::posix_time::ptime ExpiresAt() { return mExpiration; }
+
+		private:
+
+			TimerWheelEntry(TimerSourceWheel* apSource);
+
+			bool IsEmpty() const { return mpNext == this; }
+			void LinkBefore(TimerWheelEntry* apNode);
+			void Unlink();
+
+			TimerSourceWheel* mpSource;
+			TimerWheelEntry* mpPrev;
+			TimerWheelEntry* mpNext;
+
+			boost::posix_time::ptime mExpiration;
+			boost::uint64_t mTick;			/// tick on which the timer fires
+			size_t mList;					/// which list of the wheel the timer is on
+			ExpirationHandler mHandler;
+	};
+
+	/**
+	 * ITimerSource built on a hierarchical timing wheel that is driven by a single asio
+	 * deadline_timer. Start and Cancel are O(1) list operations and only touch asio when
+	 * the new timer is due before the tick asio is already waiting for. Like
+	 * TimerSourceASIO, a canceled timer never generates a callback.
+	 *
+	 * Time is divided into ticks of aResolution milliseconds. A timer fires on the first
+	 * tick at or after its expiration, so it's never early and at most one tick late.
+	 * The root level covers the next 256 ticks and three coarser levels of 64 slots cover
+	 * 2^26 ticks, timers that are further out wait on an overflow list. StartInfinite
+	 * timers are kept on a list of their own and never fire.
+	 *
+	 * Releasing the wheel drops the timers that are still pending, their handlers never run.
+	 */
+	class TimerSourceWheel : public ReleasableTimerSource
+	{
+		friend class TimerWheelEntry;
+
+		public:
+			/**
+				@param apService	io_service that drives the timers
+				@param apStrand		Optional strand through which all expirations and posts are dispatched, see
+									TimerSourceASIO
+				@param aResolution	Length of a tick in milliseconds
+				@param aOwnsStrand	If true, the strand is deleted along with the timer source
+			*/
+			TimerSourceWheel(boost::asio::io_service* apService, boost::asio::io_service::strand* apStrand = NULL, millis_t aResolution = 1, bool aOwnsStrand = false);
+			~TimerSourceWheel();
+
+			/// Cancels the wait on the next tick, so the wheel goes away once its posts are dispatched
+			void Release();
+
+			ITimer* Start(millis_t, const ExpirationHandler&);
+			ITimer* Start(const boost::posix_time::ptime&, const ExpirationHandler&);
+			void Post(const ExpirationHandler&);
+
+			/// @return number of timers that are currently pending
+			size_t NumActive() const;
+
+		private:
+
+			enum {
+				ROOT_BITS = 8,
+				LEVEL_BITS = 6,
+				NUM_LEVELS = 4,
+				ROOT_SIZE = 1 << ROOT_BITS,
+				LEVEL_SIZE = 1 << LEVEL_BITS,
+				NUM_SLOTS = ROOT_SIZE + (NUM_LEVELS - 1) * LEVEL_SIZE
+			};
+
+			/// lists that a pending timer can be on, the wheel levels are 0 to NUM_LEVELS - 1
+			enum {
+				OVERFLOW_LIST = NUM_LEVELS,
+				NEVER_LIST = NUM_LEVELS + 1,
+				NUM_LISTS = NUM_LEVELS + 2
+			};
+
+			static const boost::uint64_t NEVER;
+
+			static size_t ShiftOf(size_t aList);
+
+			TimerWheelEntry* GetTimer();
+			ITimer* StartTimer(TimerWheelEntry*, const boost::posix_time::ptime&, const ExpirationHandler&);
+			void Release(TimerWheelEntry*);
+
+			void Insert(TimerWheelEntry*);
+			void Remove(TimerWheelEntry*);
+			size_t Cascade(size_t aLevel);
+			void CascadeOverflow();
+			void Expire(TimerWheelEntry* apSlot);
+			void Step();
+			void Advance(boost::uint64_t aTick);
+			boost::uint64_t NextCascade() const;
+			bool IsIdle() const;
+
+			void Arm(boost::uint64_t aTick);
+			void ArmNext();
+			void OnTimerCallback(const boost::system::error_code&);
+			void OnTick();
+			void OnPost(ExpirationHandler);
+
+			boost::uint64_t TickFor(const boost::posix_time::ptime&) const;
+			boost::uint64_t CurrentTick() const;
+			boost::posix_time::ptime TimeOf(boost::uint64_t aTick) const;
+
+			boost::asio::io_service* mpService;
+			boost::asio::io_service::strand* mpStrand;
+			bool mOwnsStrand;
+			boost::asio::deadline_timer mTimer;
+
+			const boost::posix_time::ptime mEpoch;		/// time of tick 0
+			const boost::int64_t mResolution;			/// tick length in microseconds
+
+			boost::uint64_t mTick;			/// last tick that has been processed
+			bool mArmed;
+			bool mDispatching;				/// set while expiring timers, the wheel is re-armed once afterwards
+			boost::uint64_t mArmedTick;		/// tick mTimer is waiting for when mArmed is set
+
+			TimerWheelEntry* mSlots[NUM_SLOTS];		/// root slots followed by the slots of each coarser level
+			TimerWheelEntry* mpOverflow;
+			TimerWheelEntry* mpNever;
+			size_t mCount[NUM_LISTS];				/// number of timers on each list
+
+			typedef std::deque<TimerWheelEntry*> TimerQueue;
+
+			TimerQueue mAllTimers;
+			TimerQueue mIdleTimers;
+	};
+}
+
+#endif
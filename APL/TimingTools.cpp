@@ -36,6 +36,12 @@ namespace apl{
 		return ret;
 	}
 
+	apl::int_64_t StopWatch :: ElapsedUS(bool aReset){
+		apl::int_64_t ret = mStartTime.GetElapsedUS();
+		if(aReset) mStartTime.SetToNow();
+		return ret;
+	}
+
 	void StopWatch :: Restart(){
 		mStartTime.SetToNow();
 	}
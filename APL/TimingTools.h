@@ -39,6 +39,9 @@ namespace apl{
 		//by default each call to Elapsed restarts the timer.
 		apl::millis_t Elapsed(bool aReset = true);
 
+		//same as Elapsed, in microseconds
+		apl::int_64_t ElapsedUS(bool aReset = true);
+
 		//restart or re-zero the StopWatch.
 		void Restart();
 
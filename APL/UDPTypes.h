@@ -0,0 +1,58 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __UDP_TYPES_H_
+#define __UDP_TYPES_H_
+
+#include "Types.h"
+
+#include <string>
+
+namespace apl {
+
+	struct UDPSettings
+	{
+		/**
+			@param aLocalAddress	Address to bind, "0.0.0.0" for any interface
+			@param aLocalPort		Port to bind, 0 for an ephemeral port
+			@param aRemoteAddress	Peer that all datagrams are sent to. If empty the layer replies to
+									the sender of each frame's link destination address, or to the
+									source of the most recently received datagram
+			@param aRemotePort		Port of the peer, ignored if aRemoteAddress is empty
+			@param aMaxDatagramSize	Largest datagram that is sent or received. Link frames are packed
+									into datagrams whole, so this must be at least one maximum sized frame
+		*/
+		UDPSettings(const std::string aLocalAddress,
+			const uint_16_t aLocalPort,
+			const std::string aRemoteAddress = "",
+			const uint_16_t aRemotePort = 0,
+			const size_t aMaxDatagramSize = DEFAULT_MAX_DATAGRAM_SIZE);
+
+		/// fits in an ethernet frame without IP fragmentation
+		static const size_t DEFAULT_MAX_DATAGRAM_SIZE = 1472;
+
+		std::string mLocalAddress;
+		uint_16_t mLocalPort;
+		std::string mRemoteAddress;
+		uint_16_t mRemotePort;
+		size_t mMaxDatagramSize;
+	};
+
+}
+
+#endif
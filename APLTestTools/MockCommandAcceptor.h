@@ -29,6 +29,9 @@ namespace apl {
 	{
 		public:
 
+		/// @param aAutoRespond if false, responses are held until RespondOne() is called
+		MockCommandAcceptor(bool aAutoRespond = true) : mAutoRespond(aAutoRespond) {}
+
 		void AcceptCommand(const BinaryOutput& aBo, size_t, int aSequence, IResponseAcceptor* apRspAcceptor)
 		{ mBinaryOutputs.push(aBo); this->AcceptCommand(aSequence, apRspAcceptor); }
 
@@ -50,9 +53,26 @@ namespace apl {
 			return b;
 		}
 
+		size_t NumHeld() { return mHeld.size(); }
+
+		/// Responds to the oldest held command
+		void RespondOne()
+		{
+			if(mHeld.empty()) throw Exception(LOCATION, "no commands are being held");
+			HeldCommand cmd = mHeld.front();
+			mHeld.pop();
+			this->Respond(cmd.mSequence, cmd.mpRspAcceptor);
+		}
+
 		private:
 
 		void AcceptCommand(int aSeq, IResponseAcceptor* apRspAcceptor)
+		{
+			if(mAutoRespond) this->Respond(aSeq, apRspAcceptor);
+			else mHeld.push(HeldCommand(aSeq, apRspAcceptor));
+		}
+
+		void Respond(int aSeq, IResponseAcceptor* apRspAcceptor)
 		{
 			if(mResponses.empty()) throw Exception(LOCATION, "response queue is empty");
 			else
@@ -64,6 +84,16 @@ namespace apl {
 
 		}
 
+		struct HeldCommand
+		{
+			HeldCommand(int aSequence, IResponseAcceptor* apRspAcceptor) : mSequence(aSequence), mpRspAcceptor(apRspAcceptor) {}
+			int mSequence;
+			IResponseAcceptor* mpRspAcceptor;
+		};
+
+		bool mAutoRespond;
+		std::queue<HeldCommand> mHeld;
+
 		std::queue<CommandStatus> mResponses;
 		std::queue<Setpoint> mSetpoints;
 		std::queue<BinaryOutput> mBinaryOutputs;
@@ -37,14 +37,68 @@ using namespace std;
 
 namespace apl { namespace dnp {
 
-	APDU::APDU(size_t aFragSize) : 
+	/// Builds the QualifierInfo for every possible qualifier byte
+	class APDU::QualifierTable
+	{
+		public:
+
+		QualifierTable()
+		{
+			for(size_t i = 0; i < 256; ++i) {
+				QualifierInfo& info = mTable[i];
+				info.mpHeader = NULL;
+				info.mHeaderSize = 0;
+				info.mValueSize = 0;
+				info.mIsRange = false;
+				for(size_t t = 0; t < NUM_OBJECT_TYPES; ++t) info.mPrefixSize[t] = -1;
+
+				QualifierCode code = IObjectHeader::ByteToQualifierCode(static_cast<byte_t>(i));
+				if(code == QC_UNDEFINED) continue;
+
+				// only the singleton's address is taken, it may not be constructed yet during static initialization
+				info.mpHeader = APDU::GetObjectHeader(code);
+
+				switch(code) {
+					case(QC_1B_START_STOP): info.mIsRange = true; info.mValueSize = 1; break;
+					case(QC_2B_START_STOP): info.mIsRange = true; info.mValueSize = 2; break;
+					case(QC_4B_START_STOP): info.mIsRange = true; info.mValueSize = 4; break;
+					case(QC_ALL_OBJ): break;
+					case(QC_2B_CNT):
+					case(QC_2B_CNT_2B_INDEX):
+						info.mValueSize = 2; break;
+					case(QC_4B_CNT):
+					case(QC_4B_CNT_4B_INDEX):
+						info.mValueSize = 4; break;
+					default:
+						info.mValueSize = 1; break;
+				}
+
+				info.mHeaderSize = 3 + (info.mIsRange ? 2 : 1) * info.mValueSize;
+
+				for(size_t t = 0; t < NUM_OBJECT_TYPES; ++t) {
+					info.mPrefixSize[t] = APDU::GetPrefixSize(code, static_cast<ObjectTypes>(t));
+				}
+			}
+		}
+
+		const QualifierInfo& Get(byte_t aQualifier) const { return mTable[aQualifier]; }
+
+		private:
+
+		QualifierInfo mTable[256];
+	};
+
+	const APDU::QualifierTable APDU::mQualifierTable;
+
+	APDU::APDU(size_t aFragSize, BufferPool* apPool) : 
 	mIsInterpreted(false),
 	mpAppHeader(NULL),
 	mObjectHeaders(0),
-	mBuffer(aFragSize),
+	mBuffer(aFragSize, apPool),
 	mFragmentSize(0)
 	{
-		
+		// enough for any realistic fragment, so Interpret() doesn't allocate
+		mObjectHeaders.reserve(RESERVED_HEADERS);
 	}
 
 	
@@ -129,6 +183,16 @@ namespace apl { namespace dnp {
 		mIsInterpreted = false;
 		mpAppHeader = NULL;
 		mObjectHeaders.clear();
+		mBuffer.Borrow();
+	}
+
+	void APDU::Release()
+	{
+		mFragmentSize = 0;
+		mIsInterpreted = false;
+		mpAppHeader = NULL;
+		mObjectHeaders.clear();
+		mBuffer.Return();
 	}
 
 	void APDU::Write(const byte_t* apData, size_t aLength)
@@ -144,6 +208,40 @@ namespace apl { namespace dnp {
 		mFragmentSize = aLength;
 	}
 
+	void APDU::Swap(CopyableBuffer& arBuffer, size_t aLength)
+	{
+		if(arBuffer.Size() != mBuffer.Size()) {
+			this->Write(arBuffer, aLength);
+			return;
+		}
+
+		if(aLength > mBuffer.Size()) {
+			ostringstream oss;
+			oss << "Size " << aLength << " exceeds max fragment size of " << mBuffer.Size();
+			throw ArgumentException(LOCATION, oss.str());
+		}
+
+		// swap first, so a pooled fragment that isn't holding a buffer doesn't borrow one just to hand it over
+		mBuffer.Swap(arBuffer);
+		this->Reset();
+		mFragmentSize = aLength;
+	}
+
+	void APDU::CopyFragment(const APDU& arAPDU)
+	{
+		if(this == &arAPDU) return;
+
+		if(!mBuffer.IsPooled() && mBuffer.Size() != arAPDU.Size()) {
+			CopyableBuffer exact(arAPDU.Size());
+			mBuffer.Swap(exact);
+		}
+
+		this->Write(arAPDU.GetBuffer(), arAPDU.Size());
+		mIsInterpreted = arAPDU.mIsInterpreted;
+		mpAppHeader = arAPDU.mpAppHeader;
+		mObjectHeaders = arAPDU.mObjectHeaders;
+	}
+
 	void APDU::Interpret()
 	{
 		if(mIsInterpreted) return;
@@ -195,19 +293,18 @@ namespace apl { namespace dnp {
 	{
 		
 		const byte_t* pStart = mBuffer.Buffer() + aOffset;
-		IObjectHeader* pHdr = AllObjectsHeader::Inst(); //Start by interpreting using the smallest possible header
-		ObjectHeaderField hdrData;
 		
-		if(aRemainder < pHdr->GetSize())
+		//Every header starts with group, variation, and qualifier
+		if(aRemainder < 3)
 		{ throw apl::Exception(LOCATION, GetSizeString(aRemainder),ALERR_INSUFFICIENT_DATA_FOR_HEADER); }
 
-		//Read the header data and select the correct object header based on this information
-		pHdr->Get(pStart, hdrData);
+		//The qualifier byte selects everything else about the header
+		const QualifierInfo& qual = mQualifierTable.Get(pStart[2]);
 		
-		if(hdrData.Qualifier == QC_UNDEFINED)
+		if(qual.mpHeader == NULL)
 		{ throw Exception(LOCATION, "Unknown qualifier", ALERR_UNKNOWN_QUALIFIER); }
 
-		pHdr = this->GetObjectHeader(hdrData.Qualifier);
+		ObjectHeaderField hdrData(pStart[0], pStart[1], static_cast<QualifierCode>(pStart[2]));
 		
 		//lookup the object type
 		ObjectBase* pObj = ObjectBase::Get(hdrData.Group, hdrData.Variation);
@@ -219,14 +316,18 @@ namespace apl { namespace dnp {
 			throw ObjectException(LOCATION, oss.str()); 
 		}
 		
-		if(aRemainder < pHdr->GetSize())
+		if(aRemainder < qual.mHeaderSize)
 		{ throw apl::Exception(LOCATION, GetSizeString(aRemainder), ALERR_INSUFFICIENT_DATA_FOR_HEADER); }
 
-		aRemainder -= pHdr->GetSize();
+		aRemainder -= qual.mHeaderSize;
 
 		//figure out what the size of the prefixes are in bytes and how many objects there are.
-		size_t prefixSize = this->GetPrefixSizeAndValidate(hdrData.Qualifier, pObj->GetType());
-		size_t objCount = this->GetNumObjects(pHdr, pStart);
+		int prefix = qual.mPrefixSize[pObj->GetType()];
+		if(prefix < 0)
+		{ throw Exception(LOCATION, "Unknown Prefix Size", ALERR_ILLEGAL_QUALIFIER_AND_OBJECT); }
+
+		size_t prefixSize = static_cast<size_t>(prefix);
+		size_t objCount = GetNumObjects(qual, pStart);
 		
 		//pStart += pHdr->GetSize(); //move the reading position to the first object
 		
@@ -262,9 +363,9 @@ namespace apl { namespace dnp {
 			throw Exception(LOCATION, "", ALERR_INSUFFICIENT_DATA_FOR_OBJECTS); 
 		}
 
-		mObjectHeaders.push_back(HeaderInfo(hdrData, objCount, prefixSize, pHdr, pObj, aOffset));
+		mObjectHeaders.push_back(HeaderInfo(hdrData, objCount, prefixSize, qual.mpHeader, pObj, aOffset));
 
-		return pHdr->GetSize() + data_size;
+		return qual.mHeaderSize + data_size;
 	}
 
 	IObjectHeader* APDU::GetObjectHeader(QualifierCode aCode)
@@ -296,33 +397,43 @@ namespace apl { namespace dnp {
 		}
 	}
 
-	size_t APDU::GetNumObjects(const IObjectHeader* apHeader, const byte_t* apStart)
-	{
-		switch(apHeader->GetType())
+	namespace {
+		inline size_t ReadHeaderValue(const byte_t* apPos, size_t aSize)
 		{
-			case(OHT_ALL_OBJECTS):
-				return 0;
-			case(OHT_RANGED_2_OCTET):
-			case(OHT_RANGED_4_OCTET):
-			case(OHT_RANGED_8_OCTET):
-				RangeInfo info;
-				static_cast<const IRangeHeader*>(apHeader)->GetRange(apStart, info);
-				if(info.Start > info.Stop)
-				{ throw Exception(LOCATION, "", ALERR_START_STOP_MISMATCH); }
-				return (info.Stop - info.Start + 1); //indices are inclusive
-			case(OHT_COUNT_1_OCTET):
-			case(OHT_COUNT_2_OCTET):
-			case(OHT_COUNT_4_OCTET):
-				return static_cast<const ICountHeader*>(apHeader)->GetCount(apStart);
-			default:
-				assert(false);
-				return 0;
+			switch(aSize)
+			{
+				case(1): return UInt8::Read(apPos);
+				case(2): return UInt16LE::Read(apPos);
+				default: return UInt32LE::Read(apPos);
+			}
 		}
 	}
 
+	size_t APDU::GetNumObjects(const QualifierInfo& arInfo, const byte_t* apStart)
+	{
+		if(arInfo.mValueSize == 0) return 0; //all objects
+
+		const byte_t* pValues = apStart + 3;
+		size_t first = ReadHeaderValue(pValues, arInfo.mValueSize);
+
+		if(!arInfo.mIsRange) return first;
+
+		size_t stop = ReadHeaderValue(pValues + arInfo.mValueSize, arInfo.mValueSize);
+		if(first > stop)
+		{ throw Exception(LOCATION, "", ALERR_START_STOP_MISMATCH); }
+		return (stop - first + 1); //indices are inclusive
+	}
+
 	#define MACRO_QUAL_OBJ_RADIX(qual, type) (qual << 8) | type
 
 	size_t APDU::GetPrefixSizeAndValidate(QualifierCode aCode, ObjectTypes aType)
+	{
+		int size = GetPrefixSize(aCode, aType);
+		if(size < 0) throw Exception(LOCATION, "Unknown Prefix Size", ALERR_ILLEGAL_QUALIFIER_AND_OBJECT);
+		return static_cast<size_t>(size);
+	}
+
+	int APDU::GetPrefixSize(QualifierCode aCode, ObjectTypes aType)
 	{
 		
 		switch(MACRO_QUAL_OBJ_RADIX(aCode, aType))
@@ -365,7 +476,7 @@ namespace apl { namespace dnp {
 			case(MACRO_QUAL_OBJ_RADIX(QC_1B_VCNT_4B_SIZE, OT_VARIABLE)): return 4;
 				
 			default:
-				throw Exception(LOCATION, "Unknown Prefix Size", ALERR_ILLEGAL_QUALIFIER_AND_OBJECT);
+				return -1;
 		}
 	}
 	
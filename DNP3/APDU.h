@@ -48,7 +48,8 @@ namespace apl { namespace dnp {
 		public:
 
 
-			APDU(size_t aFragSize = DEFAULT_FRAG_SIZE);
+			/// If apPool isn't NULL the fragment only holds a buffer from the pool between writing it and Release()
+			APDU(size_t aFragSize = DEFAULT_FRAG_SIZE, BufferPool* apPool = NULL);
 
 			/// Parse the buffer. Throws exception if malformed data are encountered
 			void Interpret();
@@ -68,9 +69,23 @@ namespace apl { namespace dnp {
 			/// Initialize the size to zero.
 			void Reset();
 
+			/// Reset and give a pooled buffer back to its pool until the next write
+			void Release();
+
 			/// Reset and write new data into the buff
 			void Write(const apl::byte_t* apStart, size_t aLength);
 
+			/** Reset and take the first aLength bytes of arBuffer as the new fragment by swapping
+				storage with it. arBuffer receives the old storage. Falls back to Write() if the
+				buffers aren't the same size, so the caller's buffer never changes capacity.
+			*/
+			void Swap(CopyableBuffer& arBuffer, size_t aLength);
+
+			/** Copy another fragment and its interpretation. A pooled fragment copies into a buffer
+				borrowed from its pool, any other fragment's buffer is resized to exactly the copied fragment.
+			*/
+			void CopyFragment(const APDU& arAPDU);
+
 			/* Getter functions */
 
 			FunctionCodes GetFunction() const;
@@ -134,7 +149,7 @@ namespace apl { namespace dnp {
 			// Interpreted Information
 			bool mIsInterpreted;
 			IAppHeader* mpAppHeader;					/// uses a singleton so auto copy is safe
-			std::vector<HeaderInfo> mObjectHeaders;
+			std::vector<HeaderInfo> mObjectHeaders;	/// capacity is reserved up front and kept across fragments
 
 			CopyableBuffer mBuffer;		/// This makes it dynamically sizable without the need for a special copy constructor.
 			size_t mFragmentSize;		/// Number of bytes written to the buffer
@@ -148,12 +163,34 @@ namespace apl { namespace dnp {
 			// Private Functions for Interpreting Frames
 			//////////////////////////////////////////////////////////////
 
-			IObjectHeader* GetObjectHeader(QualifierCode aCode);
+			static IObjectHeader* GetObjectHeader(QualifierCode aCode);
 
 			size_t ReadObjectHeader(size_t aOffset, size_t aRemainder);
 
+			/// @return prefix size in bytes for the combination, or -1 if it isn't allowed
+			static int GetPrefixSize(QualifierCode aCode, ObjectTypes aType);
 			size_t GetPrefixSizeAndValidate(QualifierCode aCode, ObjectTypes aType);
-			size_t GetNumObjects(const IObjectHeader* apHeader, const apl::byte_t* pStart);
+
+			enum { RESERVED_HEADERS = 32 };
+
+			enum { NUM_OBJECT_TYPES = OT_VARIABLE_BY_VARIATION + 1 };
+
+			/// Everything the parser needs to know about a qualifier byte, precomputed so that
+			/// object headers are decoded by table lookup rather than through switches and virtual calls
+			struct QualifierInfo
+			{
+				IObjectHeader* mpHeader;				/// NULL if the qualifier is undefined
+				size_t mHeaderSize;						/// size of the whole object header in bytes
+				size_t mValueSize;						/// size of each start/stop or count value, 0 for all objects
+				bool mIsRange;							/// start/stop if true, otherwise count
+				int mPrefixSize[NUM_OBJECT_TYPES];		/// indexed by ObjectTypes, -1 if the combination isn't allowed
+			};
+
+			class QualifierTable;
+			friend class QualifierTable;
+			static const QualifierTable mQualifierTable;
+
+			static size_t GetNumObjects(const QualifierInfo& arInfo, const apl::byte_t* apStart);
 
 			std::string GetSizeString(size_t aSize) const
 			{
@@ -71,7 +71,9 @@ namespace apl { namespace dnp {
 
 		if(acf.SEQ == c->Sequence()) {		
 			if(acf.FIR == aExpectFIR) {
-				c->CancelTimer();
+				// only the first response is timed, later fragments follow the confirms
+				if(aExpectFIR) c->ReplyReceived();
+				else c->CancelTimer();
 
 				if(acf.FIN) {
 					c->ChangeState(ACS_Idle::Inst());				
@@ -208,7 +210,7 @@ namespace apl { namespace dnp {
 	{
 		// does the confirm sequence match what we expect?
 		if(c->Sequence() == aSeq) {
-			c->CancelTimer();
+			c->ReplyReceived();
 			c->ChangeState(ACS_Idle::Inst());
 			c->DoSendSuccess();
 		}
@@ -29,15 +29,18 @@ namespace apl { namespace dnp {
 struct AppConfig
 {
 	/// Default constructor
-	AppConfig() : RspTimeout(5000), NumRetry(0), FragSize(DEFAULT_FRAG_SIZE) {}
+	AppConfig() : RspTimeout(5000), NumRetry(0), FragSize(DEFAULT_FRAG_SIZE), AdaptiveTimeout(false), MinRspTimeout(100), MaxRspTimeout(60000) {}
 
 	AppConfig(millis_t aRspTimeout, size_t aNumRetry = 0, size_t aFragSize = DEFAULT_FRAG_SIZE) :
 	RspTimeout(aRspTimeout),
 	NumRetry(aNumRetry),
-	FragSize(aFragSize)
+	FragSize(aFragSize),
+	AdaptiveTimeout(false),
+	MinRspTimeout(100),
+	MaxRspTimeout(60000)
 	{}
 
-	/// The response/confirm timeout in millisec
+	/// The response/confirm timeout in millisec, the initial timeout if AdaptiveTimeout is set
 	millis_t RspTimeout;
 
 	/// Number of retries performed for applicable frames
@@ -46,6 +49,13 @@ struct AppConfig
 	/// The maximum size of received application layer fragments
 	size_t FragSize;
 
+	/// If true, the response/confirm timeout follows the measured round trip time, see RttEstimator
+	bool AdaptiveTimeout;
+
+	/// Bounds of the adaptive timeout in millisec
+	millis_t MinRspTimeout;
+	millis_t MaxRspTimeout;
+
 };
 
 }}
@@ -20,6 +20,8 @@
 
 #include <APL/Logger.h>
 #include <APL/TimerInterfaces.h>
+#include <APL/ITimeSource.h>
+#include <APL/RttEstimator.h>
 
 #include "AsyncAppLayer.h"
 #include "AppChannelStates.h"
@@ -28,14 +30,17 @@
 
 namespace apl { namespace dnp {
 
-AppLayerChannel::AppLayerChannel(const std::string& arName, Logger* apLogger, AsyncAppLayer* apAppLayer, ITimerSource* apTimerSrc, millis_t aTimeout) :
+AppLayerChannel::AppLayerChannel(const std::string& arName, Logger* apLogger, AsyncAppLayer* apAppLayer, ITimerSource* apTimerSrc, ITimeSource* apTimeSrc, millis_t aTimeout, RttEstimator* apRtt) :
 Loggable(apLogger),
 mpAppLayer(apAppLayer),
 mpSendAPDU(NULL),
 mNumRetry(0),
+mRetried(false),
 mpTimerSrc(apTimerSrc),
 mpTimer(NULL),
 M_TIMEOUT(aTimeout),
+mpRtt(apRtt),
+mpTimeSrc(apTimeSrc),
 M_NAME(arName)
 {
 	this->Reset();
@@ -92,6 +97,7 @@ bool AppLayerChannel::Retry(ACS_Base* apState)
 {	
 	if(mNumRetry > 0) {
 		--mNumRetry;
+		mRetried = true;
 		LOG_BLOCK(LEV_INFO, "App layer retry, " << mNumRetry << " remaining");
 		this->ChangeState(apState);
 		mpAppLayer->QueueFrame(*mpSendAPDU);
@@ -115,7 +121,9 @@ void AppLayerChannel::DoFinalResponse(APDU& arAPDU)
 void AppLayerChannel::StartTimer()
 {
 	if(mpTimer != NULL) throw InvalidStateException(LOCATION, "");
-	mpTimer = mpTimerSrc->Start(M_TIMEOUT, boost::bind(&AppLayerChannel::Timeout, this));
+	millis_t timeout = (mpRtt == NULL) ? M_TIMEOUT : mpRtt->GetTimeout();
+	mpTimer = mpTimerSrc->Start(timeout, boost::bind(&AppLayerChannel::Timeout, this));
+	mRttStart = mpTimeSrc->GetUTC();
 }
 
 void AppLayerChannel::CancelTimer()
@@ -125,6 +133,12 @@ void AppLayerChannel::CancelTimer()
 	mpTimer = NULL;
 }
 
+void AppLayerChannel::ReplyReceived()
+{
+	this->CancelTimer();
+	if(mpRtt != NULL && !mRetried) mpRtt->Sample((mpTimeSrc->GetUTC() - mRttStart).total_milliseconds());
+}
+
 void AppLayerChannel::ChangeState(ACS_Base* apState)
 {
 	if(apState != mpState) {
@@ -136,6 +150,7 @@ void AppLayerChannel::ChangeState(ACS_Base* apState)
 void AppLayerChannel::Timeout()
 {
 	mpTimer = NULL;
+	if(mpRtt != NULL) mpRtt->Backoff();
 	mpState->OnTimeout(this);
 }
 
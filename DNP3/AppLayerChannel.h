@@ -21,11 +21,14 @@
 
 #include <APL/Types.h>
 #include <APL/Loggable.h>
+#include <boost/date_time/posix_time/ptime.hpp>
 
 namespace apl {
 	class Logger;
 	class ITimerSource;
+	class ITimeSource;
 	class ITimer;
+	class RttEstimator;
 }
 
 namespace apl { namespace dnp {
@@ -55,7 +58,8 @@ class AppLayerChannel : public Loggable
 	friend class ACS_WaitForFinalResponse;
 
 	public:
-	AppLayerChannel(const std::string& arName, Logger*, AsyncAppLayer*, ITimerSource*, millis_t aTimeout);
+	/// If apRtt isn't NULL, it's sampled with round trips timed by apTimeSrc and supplies the timeout instead of aTimeout
+	AppLayerChannel(const std::string& arName, Logger*, AsyncAppLayer*, ITimerSource*, ITimeSource* apTimeSrc, millis_t aTimeout, RttEstimator* apRtt = NULL);
 	virtual ~AppLayerChannel(){}
 
 	/// Resets the channel to the initial state
@@ -77,7 +81,7 @@ class AppLayerChannel : public Loggable
 	int IncrSequence() { return mSequence = NextSeq(mSequence); }
 	void QueueSend(APDU&);
 	void ChangeState(ACS_Base*);
-	void SetRetry(size_t aNumRetry) { mNumRetry = aNumRetry; }
+	void SetRetry(size_t aNumRetry) { mNumRetry = aNumRetry; mRetried = false; }
 	bool Retry(ACS_Base*);
 
 	virtual void DoSendSuccess() = 0;
@@ -88,6 +92,9 @@ class AppLayerChannel : public Loggable
 
 	void StartTimer();
 	void CancelTimer();
+
+	/// Cancel the timer because the reply arrived, its round trip time is sampled unless the send was retried
+	void ReplyReceived();
 	Logger* GetLogger() { return mpLogger; }
 
 	AsyncAppLayer* mpAppLayer;
@@ -102,10 +109,14 @@ class AppLayerChannel : public Loggable
 
 	APDU* mpSendAPDU;
 	size_t mNumRetry;
+	bool mRetried;			/// the current send was retried, so replies can't be timed
 	ITimerSource* mpTimerSrc;
 	ITimer* mpTimer;
 	bool mConfirming;
 	const millis_t M_TIMEOUT;
+	RttEstimator* mpRtt;
+	ITimeSource* mpTimeSrc;		/// times the round trips, normally system time but can be a mock for testing
+	boost::posix_time::ptime mRttStart;		/// taken when the timer is started
 	const std::string M_NAME;
 };
 
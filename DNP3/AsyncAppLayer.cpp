@@ -26,16 +26,18 @@ using namespace std;
 
 namespace apl { namespace dnp {
 
-AsyncAppLayer::AsyncAppLayer(apl::Logger* apLogger, ITimerSource* apTimerSrc, AppConfig aAppCfg) :
+AsyncAppLayer::AsyncAppLayer(apl::Logger* apLogger, ITimerSource* apTimerSrc, AppConfig aAppCfg, BufferPoolSet* apPools, ITimeSource* apTimeSrc) :
 Loggable(apLogger),
 IUpperLayer(apLogger),
-mIncoming(aAppCfg.FragSize),
+mIncoming(aAppCfg.FragSize, GetPool(apPools, aAppCfg.FragSize)),
 mConfirm(2), // only need 2 bytes for a confirm message
 mSending(false),
 mConfirmSending(false),
 mpUser(NULL),
-mSolicited(apLogger->GetSubLogger("sol"), this, apTimerSrc, aAppCfg.RspTimeout),
-mUnsolicited(apLogger->GetSubLogger("unsol"), this, apTimerSrc, aAppCfg.RspTimeout),
+mAdaptiveTimeout(aAppCfg.AdaptiveTimeout),
+mRspRtt(aAppCfg.RspTimeout, aAppCfg.MinRspTimeout, aAppCfg.MaxRspTimeout),
+mSolicited(apLogger->GetSubLogger("sol"), this, apTimerSrc, apTimeSrc, aAppCfg.RspTimeout, mAdaptiveTimeout ? &mRspRtt : NULL),
+mUnsolicited(apLogger->GetSubLogger("unsol"), this, apTimerSrc, apTimeSrc, aAppCfg.RspTimeout, mAdaptiveTimeout ? &mRspRtt : NULL),
 mNumRetry(aAppCfg.NumRetry)
 {
 	mConfirm.SetFunction(FC_CONFIRM);	
@@ -47,6 +49,11 @@ void AsyncAppLayer::SetUser(IAsyncAppUser* apUser)
 	mpUser = apUser;
 }
 
+void AsyncAppLayer::SetRttMetrics(MetricRegistry* apRegistry, const std::string& arPrefix)
+{
+	if(mAdaptiveTimeout) mRspRtt.SetMetrics(apRegistry, arPrefix);
+}
+
 /////////////////////////////
 // IAsyncAppLayer
 /////////////////////////////
@@ -97,6 +104,34 @@ void AsyncAppLayer::_OnReceive(const apl::byte_t* apBuffer, size_t aSize)
 
 	try {
 		mIncoming.Write(apBuffer, aSize);
+	}
+	catch(Exception ex) {
+		EXCEPTION_BLOCK(LEV_WARNING, ex);
+		return;
+	}
+
+	this->ProcessIncoming();
+}
+
+void AsyncAppLayer::_OnReceiveBuffer(CopyableBuffer& arBuffer, size_t aSize)
+{
+	if(!this->IsLowerLayerUp())
+		throw InvalidStateException(LOCATION, "LowerLaterDown");
+
+	try {
+		mIncoming.Swap(arBuffer, aSize);
+	}
+	catch(Exception ex) {
+		EXCEPTION_BLOCK(LEV_WARNING, ex);
+		return;
+	}
+
+	this->ProcessIncoming();
+}
+
+void AsyncAppLayer::ProcessIncoming()
+{
+	try {
 		mIncoming.Interpret();
 
 		LOG_BLOCK(LEV_INTERPRET, "<= AL " << mIncoming.ToString());
@@ -127,6 +162,9 @@ void AsyncAppLayer::_OnReceive(const apl::byte_t* apBuffer, size_t aSize)
 	catch(Exception ex) {
 		EXCEPTION_BLOCK(LEV_WARNING, ex);
 	}
+
+	// users copy anything they keep, so a pooled buffer can go back until the next fragment
+	mIncoming.Release();
 }
 
 void AsyncAppLayer::_OnLowerLayerUp()
@@ -21,6 +21,9 @@
 
 #include <queue>
 #include <APL/AsyncLayerInterfaces.h>
+#include <APL/BufferPool.h>
+#include <APL/RttEstimator.h>
+#include <APL/TimeSource.h>
 
 #include "APDU.h"
 #include "AsyncAppInterfaces.h"
@@ -51,10 +54,14 @@ class AsyncAppLayer : public IUpperLayer, public IAsyncAppLayer
 
 	public:
 
-		AsyncAppLayer(apl::Logger* apLogger, ITimerSource*, AppConfig aAppCfg);
+		/// If apPools isn't NULL, incoming fragments are held in a pooled buffer only while they're processed
+		AsyncAppLayer(apl::Logger* apLogger, ITimerSource*, AppConfig aAppCfg, BufferPoolSet* apPools = NULL, ITimeSource* apTimeSrc = TimeSource::Inst());
 
 		void SetUser(IAsyncAppUser*);
 
+		/// Report the adaptive timeout as "<arPrefix>.srtt_ms" etc, no-op unless AppConfig::AdaptiveTimeout is set
+		void SetRttMetrics(MetricRegistry* apRegistry, const std::string& arPrefix);
+
 		/////////////////////////////////////////////////
 		// Implement IAsyncAppLayer
 		/////////////////////////////////////////////////
@@ -73,6 +80,12 @@ class AsyncAppLayer : public IUpperLayer, public IAsyncAppLayer
 		/// internal event handler
 		void _OnReceive(const apl::byte_t*, size_t);
 
+		/// Same as _OnReceive, but takes the fragment by swapping buffers instead of copying it
+		void _OnReceiveBuffer(CopyableBuffer& arBuffer, size_t aSize);
+
+		/// Interprets mIncoming and dispatches it to the appropriate internal event handler
+		void ProcessIncoming();
+
 		void _OnLowerLayerUp();
 		void _OnLowerLayerDown();
 		void _OnSendSuccess();
@@ -105,6 +118,9 @@ class AsyncAppLayer : public IUpperLayer, public IAsyncAppLayer
 
 		IAsyncAppUser* mpUser;				/// Interface for dispatching callbacks
 
+		const bool mAdaptiveTimeout;
+		RttEstimator mRspRtt;				/// Shared by both channels if the timeout is adaptive
+
 		SolicitedChannel mSolicited;			/// Channel used for solicited communications
 		UnsolicitedChannel mUnsolicited;		/// Channel used for unsolicited communications
 		size_t mNumRetry;
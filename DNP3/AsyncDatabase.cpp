@@ -49,30 +49,35 @@ namespace apl { namespace dnp {
 			case(DT_BINARY):
 				this->mBinaryVec.resize(aNumPoints);
 				this->AssignIndices(mBinaryVec);
+				this->mBinaryImage.Invalidate();
 				if ( aStartOnline )
 					this->SetAllOnline(mBinaryVec);
 				break;
 			case(DT_ANALOG):
 				this->mAnalogVec.resize(aNumPoints);
 				this->AssignIndices(mAnalogVec);
+				this->mAnalogImage.Invalidate();
 				if ( aStartOnline )
 					this->SetAllOnline(mAnalogVec);
 				break;
 			case(DT_COUNTER):
 				this->mCounterVec.resize(aNumPoints);
 				this->AssignIndices(mCounterVec);
+				this->mCounterImage.Invalidate();
 				if ( aStartOnline )
 					this->SetAllOnline(mCounterVec);
 				break;
 			case(DT_CONTROL_STATUS):
 				this->mControlStatusVec.resize(aNumPoints);
 				this->AssignIndices(mControlStatusVec);
+				this->mControlStatusImage.Invalidate();
 				if ( aStartOnline )
 					this->SetAllOnline(mControlStatusVec);
 				break;
 			case(DT_SETPOINT_STATUS):
 				this->mSetpointStatusVec.resize(aNumPoints);
 				this->AssignIndices(mSetpointStatusVec);
+				this->mSetpointStatusImage.Invalidate();
 				if ( aStartOnline )
 					this->SetAllOnline(mSetpointStatusVec);
 				break;			
@@ -197,7 +202,7 @@ namespace apl { namespace dnp {
 
 	void AsyncDatabase::_Update(const apl::Binary& arPoint, size_t aIndex)
 	{
-		if(UpdateValue<apl::Binary>(mBinaryVec, arPoint, aIndex))
+		if(UpdateValue<apl::Binary>(mBinaryVec, mBinaryImage, arPoint, aIndex))
 		{
 			LOG_BLOCK(LEV_DEBUG, "Binary Change: " << arPoint.ToString() << " Index: " << aIndex);
 			BinaryInfo& v = mBinaryVec[aIndex];
@@ -207,7 +212,7 @@ namespace apl { namespace dnp {
 
 	void AsyncDatabase::_Update(const apl::Analog& arPoint, size_t aIndex)
 	{
-		if(UpdateValue<apl::Analog>(mAnalogVec, arPoint, aIndex))
+		if(UpdateValue<apl::Analog>(mAnalogVec, mAnalogImage, arPoint, aIndex))
 		{
 			LOG_BLOCK(LEV_DEBUG, "Analog Change: " << arPoint.ToString() << " Index: " << aIndex);
 			mAnalogVec[aIndex].mLastEventValue = mAnalogVec[aIndex].mValue.GetValue();
@@ -218,7 +223,7 @@ namespace apl { namespace dnp {
 	
 	void AsyncDatabase::_Update(const apl::Counter& arPoint, size_t aIndex)
 	{
-		if(UpdateValue<apl::Counter>(mCounterVec, arPoint, aIndex))
+		if(UpdateValue<apl::Counter>(mCounterVec, mCounterImage, arPoint, aIndex))
 		{
 			LOG_BLOCK(LEV_DEBUG, "Counter Change: " << arPoint.ToString() << " Index: " << aIndex);
 			mCounterVec[aIndex].mLastEventValue = mCounterVec[aIndex].mValue.GetValue();
@@ -229,13 +234,35 @@ namespace apl { namespace dnp {
 
 	void AsyncDatabase::_Update(const apl::ControlStatus& arPoint, size_t aIndex)
 	{
-		UpdateValue<apl::ControlStatus>(mControlStatusVec, arPoint, aIndex); 
+		UpdateValue<apl::ControlStatus>(mControlStatusVec, mControlStatusImage, arPoint, aIndex); 
 	}
 
 	void AsyncDatabase::_Update(const apl::SetpointStatus& arPoint, size_t aIndex)
 	{
-		UpdateValue<apl::SetpointStatus>(mSetpointStatusVec, arPoint, aIndex); 
+		UpdateValue<apl::SetpointStatus>(mSetpointStatusVec, mSetpointStatusImage, arPoint, aIndex); 
 	}
+
+	template<typename T>
+	void AsyncDatabase::UpdateRun(const T* apPoints, size_t aNum, size_t aStart)
+	{
+		// qualified so the compiler binds the single point versions directly
+		for(size_t i = 0; i < aNum; ++i) AsyncDatabase::_Update(apPoints[i], aStart + i);
+	}
+
+	void AsyncDatabase::_Update(const apl::Binary* apPoints, size_t aNum, size_t aStart)
+	{ this->UpdateRun(apPoints, aNum, aStart); }
+
+	void AsyncDatabase::_Update(const apl::Analog* apPoints, size_t aNum, size_t aStart)
+	{ this->UpdateRun(apPoints, aNum, aStart); }
+
+	void AsyncDatabase::_Update(const apl::Counter* apPoints, size_t aNum, size_t aStart)
+	{ this->UpdateRun(apPoints, aNum, aStart); }
+
+	void AsyncDatabase::_Update(const apl::ControlStatus* apPoints, size_t aNum, size_t aStart)
+	{ this->UpdateRun(apPoints, aNum, aStart); }
+
+	void AsyncDatabase::_Update(const apl::SetpointStatus* apPoints, size_t aNum, size_t aStart)
+	{ this->UpdateRun(apPoints, aNum, aStart); }
 	
 	//////////////////////////////////////////////////////////////////////////////
 	// misc public functions
@@ -22,6 +22,7 @@
 
 #include "AsyncDatabaseInterfaces.h"
 #include "DNPConstants.h"
+#include "StaticImage.h"
 
 #include <APL/Exception.h>
 #include <APL/Loggable.h>
@@ -78,6 +79,14 @@ namespace apl { namespace dnp {
 			void Begin(ControlIterator& arIter)		{ arIter = mControlStatusVec.begin(); }
 			void Begin(SetpointIterator& arIter)	{ arIter = mSetpointStatusVec.begin(); }
 
+			/* Encoded static data for responses, points are marked dirty in the images as they're updated */
+
+			void GetImage(StaticImage<BinaryInfo>*& arpImage)			{ arpImage = &mBinaryImage; }
+			void GetImage(StaticImage<AnalogInfo>*& arpImage)			{ arpImage = &mAnalogImage; }
+			void GetImage(StaticImage<CounterInfo>*& arpImage)			{ arpImage = &mCounterImage; }
+			void GetImage(StaticImage<ControlStatusInfo>*& arpImage)	{ arpImage = &mControlStatusImage; }
+			void GetImage(StaticImage<SetpointStatusInfo>*& arpImage)	{ arpImage = &mSetpointStatusImage; }
+
 
 		private:
 
@@ -92,6 +101,16 @@ namespace apl { namespace dnp {
 			void _Update(const apl::ControlStatus& arPoint, size_t);
 			void _Update(const apl::SetpointStatus& arPoint, size_t);
 
+			// runs of points are applied without a virtual call per point
+			void _Update(const apl::Binary* apPoints, size_t aNum, size_t aStart);
+			void _Update(const apl::Analog* apPoints, size_t aNum, size_t aStart);
+			void _Update(const apl::Counter* apPoints, size_t aNum, size_t aStart);
+			void _Update(const apl::ControlStatus* apPoints, size_t aNum, size_t aStart);
+			void _Update(const apl::SetpointStatus* apPoints, size_t aNum, size_t aStart);
+
+			template<typename T>
+			void UpdateRun(const T* apPoints, size_t aNum, size_t aStart);
+
 			template<typename T>
 			void AssignIndices( std::vector< PointInfo<T> >& arVector );
 
@@ -99,7 +118,7 @@ namespace apl { namespace dnp {
 			void SetAllOnline( std::vector< PointInfo<T> >& arVector );
 
 			template<typename T>
-			bool UpdateValue(std::vector< PointInfo<T> >& arVec, const T& arValue, size_t aIndex);
+			bool UpdateValue(std::vector< PointInfo<T> >& arVec, StaticImage< PointInfo<T> >& arImage, const T& arValue, size_t aIndex);
 
 			template<typename T>
 			void PerformRead(std::vector< PointInfo<T> >& arVec, T& arValue, size_t aIndex);
@@ -114,6 +133,12 @@ namespace apl { namespace dnp {
 			std::vector< PointInfo<apl::ControlStatus> > mControlStatusVec;
 			std::vector< PointInfo<apl::SetpointStatus> > mSetpointStatusVec;
 
+			StaticImage<BinaryInfo> mBinaryImage;
+			StaticImage<AnalogInfo> mAnalogImage;
+			StaticImage<CounterInfo> mCounterImage;
+			StaticImage<ControlStatusInfo> mControlStatusImage;
+			StaticImage<SetpointStatusInfo> mSetpointStatusImage;
+
 			IAsyncEventBuffer* mpEventBuffer;
 
 			template <typename T>
@@ -145,11 +170,12 @@ namespace apl { namespace dnp {
 	}
 
 	template<typename T>
-	bool AsyncDatabase::UpdateValue(std::vector< PointInfo<T> >& arVec, const T& arValue, size_t aIndex)
+	bool AsyncDatabase::UpdateValue(std::vector< PointInfo<T> >& arVec, StaticImage< PointInfo<T> >& arImage, const T& arValue, size_t aIndex)
 	{
 		if(aIndex >= arVec.size()) throw apl::IndexOutOfBoundsException(LOCATION);
 
-		T& value = arVec[aIndex].mValue;
+		typename PointInfo<T>::StoredType& value = arVec[aIndex].mValue;
+		arImage.MarkDirty(aIndex);
 
 		if(value.ShouldGenerateEvent(arValue, arVec[aIndex].mDeadband, arVec[aIndex].mLastEventValue))
 		{
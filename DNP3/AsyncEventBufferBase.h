@@ -22,6 +22,7 @@
 
 #include "ClassCounter.h"
 #include "EventTypes.h"
+#include "EventStore.h"
 
 namespace apl { namespace dnp {
 
@@ -29,6 +30,8 @@ namespace apl { namespace dnp {
 	/** Base class for the AsyncEventBuffer classes (with templating and
 		virtual function for Update to alter event storage behavior)
 
+		SetType::Type is an EventStore, which is preallocated to aMaxEvents.
+
 		Single-threaded for asynchronous/event-based model.
 	*/
 	template <class EventType, class SetType>
@@ -75,8 +78,8 @@ namespace apl { namespace dnp {
 		typename EvtItr< EventType >::Type Begin();
 
 		size_t NumSelected() { return mSelectedEvents.size(); }
-		size_t NumUnselected() { return mEventSet.size(); }
-		size_t Size() { return mSelectedEvents.size() + mEventSet.size(); }
+		size_t NumUnselected() { return mEventStore.Size(); }
+		size_t Size() { return mSelectedEvents.size() + mEventStore.Size(); }
 
 		bool IsOverflown();
 
@@ -89,12 +92,13 @@ namespace apl { namespace dnp {
 
 		/**
 			Overridable NVII function called by Update. Default implementation does
-			a simple insert into mEventSet
+			a simple insert into mEventStore
 
 
 			@param arEvent Event update to add the to the buffer
+			@param aNewValue false if the event is being returned by Deselect
 		*/
-		virtual void _Update(const EventType& arEvent);
+		virtual void _Update(const EventType& arEvent, bool aNewValue);
 
 		ClassCounter mCounter;		/// counter for class events
 		const size_t M_MAX_EVENTS;	/// max number of events to accept before setting overflow
@@ -106,7 +110,7 @@ namespace apl { namespace dnp {
 		typename std::vector< EventType > mSelectedEvents;
 
 		/// store to keep and order incoming events
-		typename SetType::Type mEventSet;
+		typename SetType::Type mEventStore;
 	};
 
 
@@ -117,7 +121,9 @@ namespace apl { namespace dnp {
 	mIsOverflown(false),
 	mDropFirst(aDropFirst)
 	{
-
+		// one extra slot for the event that is dropped on overflow
+		mEventStore.Reserve(aMaxEvents + 1);
+		mSelectedEvents.reserve(aMaxEvents);
 	}
 
 	template <class EventType, class SetType>
@@ -128,8 +134,7 @@ namespace apl { namespace dnp {
 
 		if(this->NumUnselected() > M_MAX_EVENTS) { //we've overflown and we've got to drop an event
 			mIsOverflown = true;
-			if(mDropFirst) mEventSet.erase(mEventSet.begin());
-			else mEventSet.erase((++mEventSet.rbegin()).base());
+			mCounter.DecrCount(mDropFirst ? mEventStore.EraseFirst() : mEventStore.EraseLast());
 		}
 	}
 
@@ -141,14 +146,15 @@ namespace apl { namespace dnp {
 
 		if(aNewValue) arEvent.mSequence = mSequence++;
 
-		this->_Update(arEvent); // call the overridable NVII function
+		this->_Update(arEvent, aNewValue); // call the overridable NVII function
 	}
 
 	template <class EventType, class SetType>
-	void AsyncEventBufferBase<EventType, SetType> :: _Update(const EventType& arEvent)
+	void AsyncEventBufferBase<EventType, SetType> :: _Update(const EventType& arEvent, bool aNewValue)
 	{
 		this->mCounter.IncrCount(arEvent.mClass);
-		this->mEventSet.insert(arEvent);
+		if(aNewValue) this->mEventStore.Insert(arEvent);
+		else this->mEventStore.Restore(arEvent);
 	}
 
 	template <class EventType, class SetType>
@@ -156,8 +162,9 @@ namespace apl { namespace dnp {
 	{
 		size_t num = mSelectedEvents.size();
 
-		// put selected events back into the event buffer
-		for(size_t i=0; i < num; i++) this->Update(mSelectedEvents[i], false);
+		// put selected events back into the event buffer, newest first so each
+		// one lands at the front of what has already been restored
+		for(size_t i=num; i > 0; --i) this->Update(mSelectedEvents[i-1], false);
 
 		mSelectedEvents.clear();
 
@@ -197,24 +204,7 @@ namespace apl { namespace dnp {
 	template <class EventType, class SetType>
 	size_t AsyncEventBufferBase <EventType, SetType> :: Select(PointClass aClass, size_t aMaxEvent)
 	{
-		typename SetType::Type::iterator i = mEventSet.begin();
-
-		size_t count = 0;
-
-		while( i != mEventSet.end() && count < aMaxEvent)
-		{
-			if( ( i->mClass & aClass) != 0 )
-			{
-				mCounter.DecrCount(i->mClass);
-				mSelectedEvents.push_back(*i);
-				mEventSet.erase(i++);
-				++count;
-				mSelectedEvents.back().mWritten = false;
-			}
-			else ++i;
-		}
-
-		return count;
+		return mEventStore.Select(aClass, aMaxEvent, mCounter, mSelectedEvents);
 	}
 
 }} //end NS
@@ -42,7 +42,7 @@ namespace apl { namespace dnp {
 
 		AsyncSingleEventBuffer(size_t aMaxEvents);
 
-		void _Update(const EventType& arEvent);
+		void _Update(const EventType& arEvent, bool aNewValue);
 	};
 
 	/** Event buffer that stores all changes to all points in the order. */
@@ -80,22 +80,25 @@ namespace apl { namespace dnp {
 	{}
 
 	template <class EventType>
-	void AsyncSingleEventBuffer<EventType> :: _Update(const EventType& arEvent)
+	void AsyncSingleEventBuffer<EventType> :: _Update(const EventType& arEvent, bool aNewValue)
 	{
-		typename IndexSet< EventType >::Type::iterator i = this->mEventSet.find(arEvent);
+		size_t slot = this->mEventStore.Find(arEvent.mIndex);
 
-		if(i != this->mEventSet.end() )
+		if(slot != IndexSet< EventType >::Type::NPOS)
 		{
-			if(arEvent.mValue.GetTime() >= i->mValue.GetTime())
+			const EventType& existing = this->mEventStore.Get(slot);
+			if(arEvent.mValue.GetTime() >= existing.mValue.GetTime())
 			{
-				this->mEventSet.erase(i);
-				this->mEventSet.insert(arEvent); //new event
+				if(arEvent.mClass != existing.mClass) {
+					this->mCounter.DecrCount(existing.mClass);
+					this->mCounter.IncrCount(arEvent.mClass);
+				}
+				this->mEventStore.Replace(slot, arEvent); //new value, same place in line
 			}
 		}
 		else
 		{
-			this->mEventSet.insert(arEvent); //new event
-			this->mCounter.IncrCount(arEvent.mClass);
+			this->AsyncEventBufferBase< EventType, IndexSet< EventType > >::_Update(arEvent, aNewValue); //new event
 		}
 	}
 
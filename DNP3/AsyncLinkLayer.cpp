@@ -28,22 +28,27 @@
 #include "PriLinkLayerStates.h"
 #include "SecLinkLayerStates.h"
 #include "DNPConstants.h"
+#include "StackMetrics.h"
 
 using namespace boost;
 
 namespace apl { namespace dnp {
 
-AsyncLinkLayer::AsyncLinkLayer(apl::Logger* apLogger, ITimerSource* apTimerSrc, const LinkConfig& arConfig) :
+AsyncLinkLayer::AsyncLinkLayer(apl::Logger* apLogger, ITimerSource* apTimerSrc, const LinkConfig& arConfig, ITimeSource* apTimeSrc) :
 Loggable(apLogger),
 ILowerLayer(apLogger),
 mCONFIG(arConfig),
 mRetryRemaining(0),
+mRetried(false),
 mpTimerSrc(apTimerSrc),
 mpTimer(NULL),
+mAckRtt(arConfig.Timeout, arConfig.MinTimeout, arConfig.MaxTimeout),
+mpTimeSrc(apTimeSrc),
 mNextReadFCB(false),
 mNextWriteFCB(false),
 mIsOnline(false),
 mpRouter(NULL),
+mpMetrics(NULL),
 mpPriState(PLLS_SecNotReset::Inst()),
 mpSecState(SLLS_NotReset::Inst())
 {}
@@ -54,6 +59,11 @@ void AsyncLinkLayer::SetRouter(ILinkRouter* apRouter)
 	mpRouter = apRouter;	
 }
 
+void AsyncLinkLayer::SetRttMetrics(MetricRegistry* apRegistry, const std::string& arPrefix)
+{
+	if(mCONFIG.AdaptiveTimeout) mAckRtt.SetMetrics(apRegistry, arPrefix);
+}
+
 void AsyncLinkLayer::ChangeState(PriStateBase* apState) 
 { mpPriState = apState; }
 
@@ -82,6 +92,7 @@ bool AsyncLinkLayer::Validate(bool aIsMaster, uint_16_t aSrc, uint_16_t aDest)
 		return false;
 	}
 
+	if(mpMetrics) mpMetrics->FrameReceived();
 	return true;
 }
 
@@ -112,6 +123,7 @@ void AsyncLinkLayer::OnLowerLayerDown()
 
 void AsyncLinkLayer::Transmit(const LinkFrame& arFrame)
 {
+	if(mpMetrics) mpMetrics->FrameSent();
 	mpRouter->Transmit(arFrame);
 }
 
@@ -149,7 +161,9 @@ void AsyncLinkLayer::SendDelayedUserData(bool aFCB)
 void AsyncLinkLayer::StartTimer()
 {
 	assert(mpTimer == NULL);
-	mpTimer = this->mpTimerSrc->Start(mCONFIG.Timeout, bind(&AsyncLinkLayer::OnTimeout, this));
+	millis_t timeout = mCONFIG.AdaptiveTimeout ? mAckRtt.GetTimeout() : mCONFIG.Timeout;
+	mpTimer = this->mpTimerSrc->Start(timeout, bind(&AsyncLinkLayer::OnTimeout, this));
+	mAckStart = mpTimeSrc->GetUTC();
 }
 
 void AsyncLinkLayer::CancelTimer()
@@ -159,15 +173,24 @@ void AsyncLinkLayer::CancelTimer()
 	mpTimer = NULL;
 }
 
+void AsyncLinkLayer::AckReceived()
+{
+	this->CancelTimer();
+	if(mCONFIG.AdaptiveTimeout && !mRetried) mAckRtt.Sample((mpTimeSrc->GetUTC() - mAckStart).total_milliseconds());
+	mRetried = false; // the next frame, if any, is a first attempt
+}
+
 void AsyncLinkLayer::ResetRetry()
 {
 	this->mRetryRemaining = mCONFIG.NumRetry;
+	mRetried = false;
 }
 
 bool AsyncLinkLayer::Retry()
 {
 	if(mRetryRemaining > 0) {
 		--mRetryRemaining;
+		mRetried = true;
 		return true;
 	}
 	else return false;
@@ -247,6 +270,7 @@ void AsyncLinkLayer::OnTimeout()
 {
 	assert(mpTimer);
 	mpTimer = NULL;
+	if(mCONFIG.AdaptiveTimeout) mAckRtt.Backoff();
 	mpPriState->OnTimeout(this);
 }
 
@@ -23,6 +23,8 @@
 #include <queue>
 #include <APL/AsyncLayerInterfaces.h>
 #include <APL/TimerInterfaces.h>
+#include <APL/TimeSource.h>
+#include <APL/RttEstimator.h>
 
 #include "ILinkContext.h"
 #include "LinkFrame.h"
@@ -31,6 +33,7 @@
 namespace apl {  namespace dnp {
 
 	class ILinkRouter;
+	class StackMetrics;
 	class PriStateBase;
 	class SecStateBase;
 
@@ -39,10 +42,16 @@ namespace apl {  namespace dnp {
 	{
 		public:
 
-		AsyncLinkLayer(apl::Logger*, ITimerSource*, const LinkConfig& arConfig);
+		AsyncLinkLayer(apl::Logger*, ITimerSource*, const LinkConfig& arConfig, ITimeSource* apTimeSrc = TimeSource::Inst());
 
 		void SetRouter(ILinkRouter*);
 
+		/// Frames sent and received are counted in apMetrics
+		void SetMetrics(StackMetrics* apMetrics) { mpMetrics = apMetrics; }
+
+		/// Report the adaptive timeout as "<arPrefix>.srtt_ms" etc, no-op unless LinkConfig::AdaptiveTimeout is set
+		void SetRttMetrics(MetricRegistry* apRegistry, const std::string& arPrefix);
+
 		// ILinkContext interface
 		void OnLowerLayerUp();
 		void OnLowerLayerDown();
@@ -91,6 +100,9 @@ namespace apl {  namespace dnp {
 		void StartTimer();
 		void CancelTimer();
 
+		/// Cancel the timer because the ACK arrived, its round trip time is sampled unless the frame was retried
+		void AckReceived();
+
 		const LinkConfig mCONFIG;
 
 		//Retry Count
@@ -107,9 +119,13 @@ namespace apl {  namespace dnp {
 		void Transmit(const LinkFrame&);
 
 		size_t mRetryRemaining;
+		bool mRetried;				/// the frame being confirmed was retried, so the ACK can't be timed
 
 		ITimerSource* mpTimerSrc;
 		ITimer* mpTimer;
+		RttEstimator mAckRtt;		/// drives the timeout if LinkConfig::AdaptiveTimeout is set
+		ITimeSource* mpTimeSrc;		/// times the acks, normally system time but can be a mock for testing
+		boost::posix_time::ptime mAckStart;	/// taken when the timer is started
 
 		/// callback from the active timer
 		void OnTimeout();
@@ -126,6 +142,7 @@ namespace apl {  namespace dnp {
 		std::string SendString() { return "~>"; }
 
 		ILinkRouter* mpRouter;
+		StackMetrics* mpMetrics;
 		PriStateBase* mpPriState;
 		SecStateBase* mpSecState;
 	};
@@ -23,6 +23,7 @@
 #include <APL/IPhysicalLayerAsync.h>
 #include <APL/Logger.h>
 #include <sstream>
+#include <memory.h>
 #include <boost/foreach.hpp>
 
 #include "ILinkContext.h"
@@ -35,59 +36,66 @@ namespace apl { namespace dnp {
 AsyncLinkLayerRouter::AsyncLinkLayerRouter(apl::Logger* apLogger, IPhysicalLayerAsync* apPhys, ITimerSource* apTimerSrc, millis_t aOpenRetry) :
 Loggable(apLogger),
 AsyncPhysLayerMonitor(apLogger, apPhys, apTimerSrc, aOpenRetry),
-mReceiver(apLogger, this),
-mTransmitting(false)
-{}
+mFramePool(INITIAL_POOL_SIZE),
+mNumWriting(0),
+mReceiver(apLogger, this)
+{
+	mFreeSlots.reserve(INITIAL_POOL_SIZE);
+	mWriteBuffers.reserve(INITIAL_POOL_SIZE);
+	for(size_t i = 0; i < INITIAL_POOL_SIZE; ++i) mFreeSlots.push_back(&mFramePool[i]);
+}
 
 void AsyncLinkLayerRouter::AddContext(ILinkContext* apContext, uint_16_t aAddress)
 {
 	assert(apContext != NULL);
 
-	if(mAddressMap.find(aAddress) != mAddressMap.end()) {
+	if(mAddressTable.Find(aAddress) != NULL) {
 	  ostringstream oss;
 	  oss << "Address already in use: " << aAddress;
       throw ArgumentException(LOCATION, oss.str());
 	}
 
-	BOOST_FOREACH(AddressMap::value_type v, mAddressMap) {
-		if(apContext == v.second) {
-			ostringstream oss;
-			oss << "Context already in bound to address:  " << v.first;
-			throw ArgumentException(LOCATION, oss.str());
-		}
+	uint_16_t bound;
+	if(mAddressTable.FindAddress(apContext, bound)) {
+		ostringstream oss;
+		oss << "Context already in bound to address:  " << bound;
+		throw ArgumentException(LOCATION, oss.str());
 	}
 
-	mAddressMap[aAddress] = apContext;
+	mAddressTable.Bind(aAddress, apContext);
 	if(this->IsOpen()) apContext->OnLowerLayerUp();
 }
 
 void AsyncLinkLayerRouter::RemoveContext(uint_16_t aAddress)
 {
-	AddressMap::iterator i = mAddressMap.find(aAddress);	
-	if(i != mAddressMap.end()) { 
-		ILinkContext* pContext = i->second;
-		mAddressMap.erase(i);
-		if(this->IsOpen()) pContext->OnLowerLayerDown();
-	}
+	ILinkContext* pContext = mAddressTable.Unbind(aAddress);
+	if(pContext != NULL && this->IsOpen()) pContext->OnLowerLayerDown();
 }
 
+size_t AsyncLinkLayerRouter::GetRxCount(uint_16_t aAddress) const
+{
+	LinkAddressTable::Entry* pEntry = mAddressTable.Find(aAddress);
+	return (pEntry == NULL) ? 0 : pEntry->mNumRx;
+}
 
 ILinkContext* AsyncLinkLayerRouter::GetContext(uint_16_t aDest)
 {
-	AddressMap::iterator i = mAddressMap.find(aDest);
-	return (i == mAddressMap.end()) ? NULL : i->second;
+	LinkAddressTable::Entry* pEntry = mAddressTable.Find(aDest);
+	return (pEntry == NULL) ? NULL : pEntry->mpContext;
 }
 
 
 ILinkContext* AsyncLinkLayerRouter::GetDestination(uint_16_t aDest)
 {
-	ILinkContext* pDest = GetContext(aDest);
+	LinkAddressTable::Entry* pEntry = mAddressTable.Find(aDest);
 	
-	if(pDest == NULL) {
+	if(pEntry == NULL) {
 		ERROR_BLOCK(LEV_WARNING, "Frame for unknown destination: " << aDest, DLERR_UNKNOWN_DESTINATION);
+		return NULL;
 	}
 	
-	return pDest;
+	++pEntry->mNumRx;
+	return pEntry->mpContext;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -151,7 +159,18 @@ void AsyncLinkLayerRouter::Transmit(const LinkFrame& arFrame)
 	if(this->GetContext(arFrame.GetSrc())) {
 		if(!this->IsLowerLayerUp()) 
 			throw InvalidStateException(LOCATION, "LowerLayerDown");
-		this->mTransmitQueue.push_back(arFrame);
+		LOG_BLOCK(LEV_INTERPRET, "~> " << arFrame.ToString());
+
+		if(mFreeSlots.empty()) {
+			mFramePool.push_back(FrameSlot());
+			mFreeSlots.push_back(&mFramePool.back());
+		}
+		FrameSlot* pSlot = mFreeSlots.back();
+		mFreeSlots.pop_back();
+
+		pSlot->mSize = arFrame.GetSize();
+		memcpy(pSlot->mBuffer, arFrame.GetBuffer(), pSlot->mSize);
+		mTransmitQueue.push_back(pSlot);
 		this->CheckForSend();
 	}
 	else {
@@ -163,44 +182,59 @@ void AsyncLinkLayerRouter::Transmit(const LinkFrame& arFrame)
 
 void AsyncLinkLayerRouter::_OnSendSuccess()
 {
-	assert(mTransmitQueue.size() > 0);
-	assert(mTransmitting);
-	ILinkContext* pContext = this->GetContext(mTransmitQueue.front().GetSrc());
-	assert(pContext != NULL);
-	mTransmitting = false;	
-	mTransmitQueue.pop_front();
+	assert(mNumWriting > 0);
+	this->ReleaseWritten();
 	this->CheckForSend();	
 }
 
 void AsyncLinkLayerRouter::_OnSendFailure()
 {	
 	LOG_BLOCK(LEV_ERROR, "Unexpected _OnSendFailure");
-	mTransmitting = false;
+	mNumWriting = 0;
 	this->CheckForSend();
 }
 
+void AsyncLinkLayerRouter::ReleaseWritten()
+{
+	for(size_t i = 0; i < mNumWriting; ++i) {
+		mFreeSlots.push_back(mTransmitQueue.front());
+		mTransmitQueue.pop_front();
+	}
+	mNumWriting = 0;
+}
+
 void AsyncLinkLayerRouter::CheckForSend()
 {
-	if(mTransmitQueue.size() > 0 && !mTransmitting) {
-		mTransmitting = true;
-		const LinkFrame& f = mTransmitQueue.front();
-		LOG_BLOCK(LEV_INTERPRET, "~> " << f.ToString());
-		mpPhys->AsyncWrite(f.GetBuffer(), f.GetSize());
+	// everything that queued up while the last write was in progress goes out in one write
+	if(mTransmitQueue.size() > 0 && mNumWriting == 0) {
+		mWriteBuffers.clear();
+		for(TransmitQueue::iterator i = mTransmitQueue.begin(); i != mTransmitQueue.end(); ++i) {
+			mWriteBuffers.push_back(WriteBuffer((*i)->mBuffer, (*i)->mSize));
+		}
+		mNumWriting = mWriteBuffers.size();
+		mpPhys->AsyncWriteGather(&mWriteBuffers[0], mWriteBuffers.size());
 	}
 }
 
 void AsyncLinkLayerRouter::Up()
 {
 	mpPhys->AsyncRead(mReceiver.WriteBuff(), mReceiver.NumWriteBytes());
-	BOOST_FOREACH(AddressMap::value_type p, mAddressMap) { p.second->OnLowerLayerUp(); }
+	// copy, since a context can remove itself from the router in the callback
+	std::vector<uint_16_t> addresses(mAddressTable.Addresses());
+	BOOST_FOREACH(uint_16_t a, addresses) {
+		ILinkContext* pContext = this->GetContext(a);
+		if(pContext) pContext->OnLowerLayerUp();
+	}
 }
 
 void AsyncLinkLayerRouter::Down()
 {
-	mTransmitting = false;
-	mTransmitQueue.erase(mTransmitQueue.begin(), mTransmitQueue.end());
-	for(AddressMap::iterator i = mAddressMap.begin(); i != mAddressMap.end(); ++i) {		
-		i->second->OnLowerLayerDown();
+	mNumWriting = mTransmitQueue.size();
+	this->ReleaseWritten();
+	std::vector<uint_16_t> addresses(mAddressTable.Addresses());
+	BOOST_FOREACH(uint_16_t a, addresses) {
+		ILinkContext* pContext = this->GetContext(a);
+		if(pContext) pContext->OnLowerLayerDown();
 	}
 	
 }
@@ -20,18 +20,16 @@
 #define __ASYNC_LINK_LAYER_ROUTER_H_
 
 
-#include <map>
-#include <queue>
+#include <deque>
+#include <vector>
 
 #include <APL/AsyncPhysLayerMonitor.h>
+#include <APL/IPhysicalLayerAsync.h>
 
 #include "LinkLayerReceiver.h"
 #include "IFrameSink.h"
 #include "ILinkRouter.h"
-
-namespace apl {
-  class IPhysicalLayerAsync;
-}
+#include "LinkAddressTable.h"
 
 namespace apl { namespace dnp {
 
@@ -67,7 +65,10 @@ namespace apl { namespace dnp {
 		// ILinkRouter interface
 		void Transmit(const LinkFrame&);
 
-		size_t NumContext() { return mAddressMap.size(); }
+		size_t NumContext() { return mAddressTable.Size(); }
+
+		/// @return Number of frames received for aAddress since its context was added, 0 if unbound
+		size_t GetRxCount(uint_16_t aAddress) const;
 
 		private:
 
@@ -75,17 +76,34 @@ namespace apl { namespace dnp {
 		ILinkContext* GetContext(uint_16_t aDest);
 
 		void CheckForSend();
+		void ReleaseWritten();
+
+		/// enough slots to queue a default sized fragment without growing the pool
+		static const size_t INITIAL_POOL_SIZE = 16;
 
+		/// A transmitted frame waiting in the pool
+		struct FrameSlot
+		{
+			size_t mSize;
+			apl::byte_t mBuffer[LS_MAX_FRAME_SIZE];
+		};
 
-		typedef std::map<uint_16_t, ILinkContext*> AddressMap;
-		typedef std::deque<LinkFrame> TransmitQueue;
+		typedef std::deque<FrameSlot*> TransmitQueue;
 
-		AddressMap mAddressMap;
+		LinkAddressTable mAddressTable;
+
+		/// Frames are copied into pooled slots as they are queued, a deque never moves its
+		/// elements so slots stay valid while they're being written
+		std::deque<FrameSlot> mFramePool;
+		std::vector<FrameSlot*> mFreeSlots;
 		TransmitQueue mTransmitQueue;
 
+		/// Gather list for the current write, covers the first mNumWriting frames of the queue
+		std::vector<WriteBuffer> mWriteBuffers;
+		size_t mNumWriting;
+
 		/// Handles the parsing of incoming frames
 		LinkLayerReceiver mReceiver;
-		bool mTransmitting;
 
 		/* Events - NVII delegates from IUpperLayer */
 
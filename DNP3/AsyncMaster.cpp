@@ -21,6 +21,7 @@
 #include "AsyncMasterStates.h"
 #include "ObjectReadIterator.h"
 #include "ResponseLoader.h"
+#include "StackMetrics.h"
 
 #include <APL/DataInterfaces.h>
 #include <APL/AsyncTaskInterfaces.h>
@@ -40,15 +41,16 @@ using namespace boost;
 
 namespace apl { namespace dnp {
 
-AsyncMaster::AsyncMaster(Logger* apLogger, MasterConfig aCfg, IAsyncAppLayer* apAppLayer, IDataObserver* apPublisher, AsyncTaskGroup* apTaskGroup, ITimerSource* apTimerSrc, ITimeSource* apTimeSrc) :
+AsyncMaster::AsyncMaster(Logger* apLogger, MasterConfig aCfg, IAsyncAppLayer* apAppLayer, IDataObserver* apPublisher, AsyncTaskGroup* apTaskGroup, ITimerSource* apTimerSrc, ITimeSource* apTimeSrc, BufferPoolSet* apPools) :
 Loggable(apLogger),
 mCommsStatus(apLogger, "comms_status"),
-mRequest(aCfg.FragSize),
+mRequest(aCfg.FragSize, GetPool(apPools, aCfg.FragSize)),
 mpAppLayer(apAppLayer),
 mpPublisher(apPublisher),
 mpTaskGroup(apTaskGroup),
 mpTimerSrc(apTimerSrc),
 mpTimeSrc(apTimeSrc),
+mpMetrics(NULL),
 mpState(AMS_Closed::Inst()),
 mpTask(NULL),
 mpScheduledTask(NULL),
@@ -128,6 +130,7 @@ void AsyncMaster::StartTask(MasterTaskBase* apMasterTask, bool aInit)
 {
 	if(aInit) apMasterTask->Init();
 	apMasterTask->ConfigureRequest(mRequest);
+	if(mpMetrics) mRequestTimer.Restart();
 	mpAppLayer->SendRequest(mRequest);
 }
 
@@ -179,6 +182,7 @@ void AsyncMaster::OnLowerLayerUp()
 
 void AsyncMaster::OnLowerLayerDown()
 {
+	mRequest.Release();
 	mpState->OnLowerLayerDown(this);
 	mSchedule.DisableOnlineTasks();
 	mCommsStatus.Set(COMMS_DOWN);
@@ -191,6 +195,7 @@ void AsyncMaster::OnSolSendSuccess()
 
 void AsyncMaster::OnSolFailure()
 {
+	mRequest.Release(); // the next task writes a new request
 	mpState->OnFailure(this);
 }
 
@@ -214,6 +219,8 @@ void AsyncMaster::OnPartialResponse(const APDU& arAPDU)
 
 void AsyncMaster::OnFinalResponse(const APDU& arAPDU)
 {
+	if(mpMetrics) mpMetrics->RequestCompleted(static_cast<size_t>(mRequestTimer.ElapsedUS()));
+	mRequest.Release();
 	mLastIIN = arAPDU.GetIIN();
 	this->ProcessIIN(arAPDU.GetIIN());
 	mpState->OnFinalResponse(this, arAPDU);
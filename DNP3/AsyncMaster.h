@@ -25,6 +25,8 @@
 #include <APL/TimeSource.h>
 #include <APL/PostingNotifierSource.h>
 #include <APL/CachedLogVariable.h>
+#include <APL/TimingTools.h>
+#include <APL/BufferPool.h>
 
 #include "APDU.h"
 #include "AsyncAppInterfaces.h"
@@ -52,6 +54,7 @@ namespace apl {
 namespace apl { namespace dnp {
 
 class AMS_Base;
+class StackMetrics;
 
 /** DNP3 master. The tasks functions can perform all the various things that a master might need to do.
 
@@ -73,11 +76,15 @@ class AsyncMaster : public Loggable, public IAsyncAppUser
 
 	public:
 
-	AsyncMaster(Logger*, MasterConfig aCfg, IAsyncAppLayer*, IDataObserver*, AsyncTaskGroup*, ITimerSource*, ITimeSource* apTimeSrc = TimeSource::Inst());
+	/// If apPools isn't NULL, requests only hold a pooled buffer until their transaction completes
+	AsyncMaster(Logger*, MasterConfig aCfg, IAsyncAppLayer*, IDataObserver*, AsyncTaskGroup*, ITimerSource*, ITimeSource* apTimeSrc = TimeSource::Inst(), BufferPoolSet* apPools = NULL);
 	virtual ~AsyncMaster() {}
 
 	ICommandAcceptor* GetCmdAcceptor() { return &mCommandQueue; }
 
+	/// Request round trip times are recorded in apMetrics
+	void SetMetrics(StackMetrics* apMetrics) { mpMetrics = apMetrics; }
+
 	/* Implement IAsyncAppUser - callbacks from the app layer */
 
 	void OnLowerLayerUp();
@@ -125,6 +132,8 @@ class AsyncMaster : public Loggable, public IAsyncAppUser
 	AsyncTaskGroup* mpTaskGroup;			 /// How task execution is controlled
 	ITimerSource* mpTimerSrc;				 /// Controls the posting of events to marshall across threads
 	ITimeSource* mpTimeSrc;					 /// Access to UTC, normally system time but can be a mock for testing
+	StackMetrics* mpMetrics;				 /// NULL unless the stack reports metrics
+	StopWatch mRequestTimer;				 /// started when a request is sent
 
 	AMS_Base* mpState;						 /// Pointer to active state, start in TLS_Closed
 	MasterTaskBase* mpTask;					 /// The current master task
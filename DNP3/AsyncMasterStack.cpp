@@ -28,12 +28,14 @@ Logger* apLogger,
 ITimerSource* apTimerSrc,
 IDataObserver* apPublisher,
 AsyncTaskGroup* apTaskGroup,
-const MasterStackConfig& arCfg) :
+const MasterStackConfig& arCfg,
+BufferPoolSet* apPools) :
 
-AsyncStack(apLogger, apTimerSrc, arCfg.app, arCfg.link),
-mMaster(apLogger->GetSubLogger("master"), arCfg.master, &mApplication, apPublisher, apTaskGroup, apTimerSrc)
+AsyncStack(apLogger, apTimerSrc, arCfg.app, arCfg.link, apPools),
+mMaster(apLogger->GetSubLogger("master"), arCfg.master, &mApplication, apPublisher, apTaskGroup, apTimerSrc, TimeSource::Inst(), apPools)
 {
 	mApplication.SetUser(&mMaster);
+	mMaster.SetMetrics(&mMetrics);
 }
 	
 }}
@@ -35,7 +35,8 @@ class AsyncMasterStack : public AsyncStack
 		ITimerSource* apTimerSrc,
 		IDataObserver* apPublisher,
 		AsyncTaskGroup* apTaskGroup,
-		const MasterStackConfig& arCfg);
+		const MasterStackConfig& arCfg,
+		BufferPoolSet* apPools = NULL);
 
 	AsyncMaster mMaster;
 };
@@ -25,14 +25,16 @@
 #include <APL/Logger.h>
 #include <APL/IPhysicalLayerAsync.h>
 #include <APL/AsyncTaskGroup.h>
+#include <APL/ReleasableTimerSource.h>
 
 namespace apl { namespace dnp {
 
-AsyncPort::AsyncPort(const std::string& arName, Logger* apLogger, AsyncTaskGroup* apGroup, ITimerSource* apTimerSrc, IPhysicalLayerAsync* apPhys, millis_t aOpenDelay) :
+AsyncPort::AsyncPort(const std::string& arName, Logger* apLogger, AsyncTaskGroup* apGroup, ReleasableTimerSource* apTimerSrc, IPhysicalLayerAsync* apPhys, millis_t aOpenDelay) :
 Loggable(apLogger->GetSubLogger("port")),
 mName(arName),
 mRouter(apLogger, apPhys, apTimerSrc, aOpenDelay),
 mpGroup(apGroup),
+mpTimerSrc(apTimerSrc),
 mpPhys(apPhys),
 mRelease(false)
 {
@@ -44,9 +46,11 @@ AsyncPort::~AsyncPort()
 {
 	delete mpPhys;
 	delete mpGroup;
-
+	mpTimerSrc->Release();	// after the group, so its canceled timers are counted as outstanding
 }
 
+ITimerSource* AsyncPort::GetTimerSource() { return mpTimerSrc; }
+
 //Once we're sure the router is done with 
 void AsyncPort::Release() //do nothing right now
 {
@@ -67,10 +71,10 @@ void AsyncPort::OnStateChange(IPhysMonitor::State aState)
 	}	
 }
 
-void AsyncPort::Associate(const std::string& arStackName, AsyncStack* apStack, uint_16_t aLocalAddress)
+void AsyncPort::Associate(const std::string& arStackName, AsyncStack* apStack, uint_16_t aLocalAddress, AsyncTaskGroup* apLane)
 {
 	LOG_BLOCK(LEV_DEBUG, "Linking stack to port: " << aLocalAddress);	
-	mStackMap[arStackName] = StackRecord(apStack, aLocalAddress);	
+	mStackMap[arStackName] = StackRecord(apStack, aLocalAddress, apLane);	
 	apStack->mLink.SetRouter(&mRouter);
 	mRouter.AddContext(&apStack->mLink, aLocalAddress);
 	if(!mRouter.IsRunning()) {
@@ -79,6 +83,11 @@ void AsyncPort::Associate(const std::string& arStackName, AsyncStack* apStack, u
 	}
 }
 
+void AsyncPort::AssociateAll(const BindingVector& arBindings)
+{
+	BOOST_FOREACH(const Binding& b, arBindings) { this->Associate(b.mStackName, b.mpStack, b.mLocalAddress, b.mpLane); }
+}
+
 void AsyncPort::Disassociate(const std::string& arStackName)
 {	
 	StackMap::iterator i = mStackMap.find(arStackName);	
@@ -86,6 +95,7 @@ void AsyncPort::Disassociate(const std::string& arStackName)
 	LOG_BLOCK(LEV_DEBUG, "Unlinking stack from port: " << r.mLocalAddress);
 	mRouter.RemoveContext(r.mLocalAddress);		// decouple the stack from the router and tell the stack to go offline if the it was previously online
 	delete r.pStack;							// delete the stack
+	delete r.mpLane;							// and its task group, after the stack's tasks are gone
 	if(mRouter.IsRunning() && mRouter.NumContext() == 0) {
 		LOG_BLOCK(LEV_DEBUG, "Stopping router");
 		mRouter.Stop();
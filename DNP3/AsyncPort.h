@@ -29,6 +29,7 @@ namespace apl {
 	class Logger;
 	class IPhysicalLayerAsync;
 	class ITimerSource;
+	class ReleasableTimerSource;
 	class AsyncTaskGroup;
 }
 
@@ -50,24 +51,51 @@ class AsyncPort : public Loggable, public IPhysMonitor
 {
 	struct StackRecord
 	{
-		StackRecord() : pStack(NULL), mLocalAddress(0)
+		StackRecord() : pStack(NULL), mLocalAddress(0), mpLane(NULL)
 		{}
 
-		StackRecord(AsyncStack* apStack, uint_16_t aLocalAddress) :
-		pStack(apStack) , mLocalAddress(aLocalAddress)
+		StackRecord(AsyncStack* apStack, uint_16_t aLocalAddress, AsyncTaskGroup* apLane) :
+		pStack(apStack) , mLocalAddress(aLocalAddress), mpLane(apLane)
 		{}
 
 		AsyncStack* pStack;
 		uint_16_t mLocalAddress;
+		AsyncTaskGroup* mpLane;		/// task group owned by the stack alone, NULL if it uses the port's group
 	};
 
 	public:
-	AsyncPort(const std::string& arName, Logger*, AsyncTaskGroup*, ITimerSource* apTimerSrc, IPhysicalLayerAsync*, millis_t aOpenDelay);
+
+	/// A stack waiting to be associated with the port, see Associate
+	struct Binding
+	{
+		Binding(const std::string& arStackName, AsyncStack* apStack, uint_16_t aLocalAddress, AsyncTaskGroup* apLane) :
+		mStackName(arStackName), mpStack(apStack), mLocalAddress(aLocalAddress), mpLane(apLane)
+		{}
+
+		std::string mStackName;
+		AsyncStack* mpStack;
+		uint_16_t mLocalAddress;
+		AsyncTaskGroup* mpLane;
+	};
+
+	typedef std::vector<Binding> BindingVector;
+
+	/// The port owns the task group, the timer source and the physical layer. The timer source is released
+	/// when the port is deleted, and goes away once the handlers it has outstanding are dispatched.
+	AsyncPort(const std::string& arName, Logger*, AsyncTaskGroup*, ReleasableTimerSource* apTimerSrc, IPhysicalLayerAsync*, millis_t aOpenDelay);
 	~AsyncPort();
 
 
 	AsyncTaskGroup* GetGroup() { return mpGroup; }
-	void Associate(const std::string& arStackName, AsyncStack* apStack, uint_16_t aLocalAddress);
+
+	/// Timer source bound to the port's strand, every stack on the port must use it
+	ITimerSource* GetTimerSource();
+
+	/// @param apLane	Task group used only by this stack, the port deletes it with the stack. NULL if the stack uses the port's group
+	void Associate(const std::string& arStackName, AsyncStack* apStack, uint_16_t aLocalAddress, AsyncTaskGroup* apLane = NULL);
+
+	/// Associates every stack in the vector, so a batch of stacks costs one posted operation per port
+	void AssociateAll(const BindingVector& arBindings);
 	void Disassociate(const std::string& arStackName);
 
 	std::string Name() { return mName; }
@@ -82,6 +110,7 @@ class AsyncPort : public Loggable, public IPhysMonitor
 	std::string mName;
 	AsyncLinkLayerRouter mRouter;
 	AsyncTaskGroup* mpGroup;
+	ReleasableTimerSource* mpTimerSrc;
 	IPhysicalLayerAsync* mpPhys;
 	bool mRelease;
 
@@ -21,7 +21,9 @@
 #include "Objects.h"
 #include "DNPConstants.h"
 #include "SlaveResponseTypes.h"
+#include "StackMetrics.h"
 #include <APL/Logger.h>
+#include <APL/TimingTools.h>
 
 #include <boost/bind.hpp>
 
@@ -44,7 +46,8 @@ mMode(UNDEFINED),
 mpDB(apDB),
 mFIR(true),
 mFIN(false),
-mpRspTypes(apRspTypes)
+mpRspTypes(apRspTypes),
+mpMetrics(NULL)
 {}
 
 void AsyncResponseContext::Reset()
@@ -174,6 +177,8 @@ void AsyncResponseContext::SelectEvents(PointClass aClass, size_t aNum)
 
 void AsyncResponseContext::LoadResponse(APDU& arAPDU)
 {
+	StopWatch sw;
+
 	//delay the setting of FIR/FIN until we know if it will be multifragmented or not
 	arAPDU.Set(FC_RESPONSE);
 
@@ -184,6 +189,8 @@ void AsyncResponseContext::LoadResponse(APDU& arAPDU)
 	if(wrote_all) wrote_all = LoadStaticData(arAPDU);
 
 	FinalizeResponse(arAPDU, events, wrote_all);
+
+	if(mpMetrics) mpMetrics->FragmentBuilt(static_cast<size_t>(sw.ElapsedUS()));
 }
 
 bool AsyncResponseContext::SelectUnsol(ClassMask m) 
@@ -206,11 +213,15 @@ bool AsyncResponseContext::HasEvents(ClassMask m)
 
 bool AsyncResponseContext::LoadUnsol(APDU& arAPDU, const IINField& arIIN, ClassMask m)
 {	
+	StopWatch sw;
+
 	this->SelectUnsol(m);
 
 	arAPDU.Set(FC_UNSOLICITED_RESPONSE, true, true, true, true);
 	bool events = false;
 	this->LoadEventData(arAPDU, events);
+
+	if(mpMetrics) mpMetrics->FragmentBuilt(static_cast<size_t>(sw.ElapsedUS()));
 	return events;
 }
 
@@ -239,6 +250,11 @@ bool AsyncResponseContext::IsEmpty()
 	return this->IsStaticEmpty() && this->IsEventEmpty();
 }
 
+bool AsyncResponseContext::HasOnlyStaticData()
+{
+	return mBinaryEvents.empty() && mAnalogEvents.empty() && mCounterEvents.empty() && !this->IsStaticEmpty();
+}
+
 bool AsyncResponseContext::IsStaticEmpty()
 {
 	return this->mStaticBinaries.empty() && this->mStaticCounters.empty() &&
@@ -268,16 +284,13 @@ bool AsyncResponseContext::LoadStaticBinaries(APDU& arAPDU)
 		int grp = iter.pObject->GetGroup();
 		int var = iter.pObject->GetVariation();
 
-		switch(MACRO_DNP_RADIX(grp, var))
+		//special case for the bitfield, which has no room for flags so it only carries points that are nominally online
+		if(mpRspTypes->mpStaticBinaryBitfield != NULL && IsNominal(iter))
+		{
+			if(!this->IterateBitfield(iter, arAPDU, mpRspTypes->mpStaticBinaryBitfield)) return false;
+		}
+		else switch(MACRO_DNP_RADIX(grp, var))
 		{
-			//special case for the bitfield
-			/*case(MACRO_DNP_RADIX(1,1)):
-			{
-				WriteFunc<Binary>::Type func = bind(&Group1Var1::Write, Group1Var1::Inst(), _1, iter.first->mIndex, _3, _2);
-				if(!this->IterateContiguous(iter, arAPDU, func)) return false;
-				break;
-			}*/
-
 			MACRO_CONTINUOUS_CASE(1,2);
 			
 			default:
@@ -290,6 +303,31 @@ bool AsyncResponseContext::LoadStaticBinaries(APDU& arAPDU)
 	return true;
 }
 
+bool AsyncResponseContext::IsNominal(const IterRecord<BinaryInfo>& arIters)
+{
+	for(StaticIter<BinaryInfo>::Type i = arIters.first; ; ++i) {
+		if((i->mValue.GetQuality() & ~BQ_STATE) != BQ_ONLINE) return false;
+		if(i == arIters.last) return true;
+	}
+}
+
+bool AsyncResponseContext::IterateBitfield(IterRecord<BinaryInfo>& arIters, APDU& arAPDU, const BitfieldObject* apObj)
+{
+	size_t start = arIters.first->mIndex;
+	size_t stop = arIters.last->mIndex;
+
+	ObjectWriteIterator owi = arAPDU.WriteContiguous(apObj, start, stop);
+	if(owi.IsEnd()) return false; // out of space in the fragment
+
+	// gather the states into one byte per point and pack them in bulk
+	size_t num = owi.Count();
+	if(mBits.size() < num) mBits.resize(num);
+	for(size_t i = 0; i < num; ++i, ++arIters.first) mBits[i] = arIters.first->mValue.GetValue() ? 1 : 0;
+	BitfieldObject::WriteRange(*owi, &mBits[0], num);
+
+	return num == (stop - start + 1);
+}
+
 bool AsyncResponseContext::LoadStaticAnalogs(APDU& arAPDU)
 {
 	while(!mStaticAnalogs.empty())
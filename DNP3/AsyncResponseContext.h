@@ -28,6 +28,8 @@
 #include "ClassMask.h"
 
 #include <queue>
+#include <string.h>
+#include <vector>
 #include <boost/function.hpp>
 
 
@@ -37,6 +39,7 @@ class AsyncDatabase;
 class AsyncSlaveEventBuffer;
 class ObjectBase;
 class SlaveResponseTypes;
+class StackMetrics;
 
 template <class T>
 struct WriteFunc
@@ -64,6 +67,12 @@ class AsyncResponseContext : public Loggable
 
 	IAsyncEventBuffer* GetBuffer() { return &mBuffer; }
 
+	/// @return number of events in the buffer, selected or not
+	size_t NumEvents() { return mBuffer.Size(); }
+
+	/// Time spent loading fragments is recorded in apMetrics
+	void SetMetrics(StackMetrics* apMetrics) { mpMetrics = apMetrics; }
+
 	/// Setup the response context with a new read request
 	IINField Configure(const APDU& arRequest);
 
@@ -80,6 +89,11 @@ class AsyncResponseContext : public Loggable
 	/// @return TRUE is all of the response data has already been written
 	bool IsComplete() { return IsEmpty(); }
 
+	/** @return TRUE if the rest of the response is static data only. Such a fragment can be loaded
+		before the previous one is confirmed, since a confirm only clears the events that were written.
+	*/
+	bool HasOnlyStaticData();
+
 	/// Reset the state of the object to the initial state
 	void Reset();
 
@@ -124,9 +138,12 @@ class AsyncResponseContext : public Loggable
 	bool mFIR;
 	bool mFIN;
 	SlaveResponseTypes* mpRspTypes;
+	StackMetrics* mpMetrics;
 
 	IINField mTempIIN;
 
+	std::vector<byte_t> mBits;			/// Scratch values for IterateBitfield, one per byte
+
 	template <class T>
 	struct IterRecord
 	{
@@ -196,6 +213,12 @@ class AsyncResponseContext : public Loggable
 	template <class T>
 	bool IterateContiguous(IterRecord<T>& arIters, APDU& arAPDU);
 
+	// true if no point left in the range has flags other than ONLINE, otherwise the range is written as Group1Var2
+	static bool IsNominal(const IterRecord<BinaryInfo>& arIters);
+
+	// writes static binaries as a packed bitfield, i.e. Group1Var1
+	bool IterateBitfield(IterRecord<BinaryInfo>& arIters, APDU& arAPDU, const BitfieldObject* apObj);
+
 	// T is the event type
 	template <class T>
 	size_t IterateIndexed(EventRequest<T>& arIters, typename EvtItr< EventInfo<T> >::Type& arIter, APDU& arAPDU);
@@ -284,19 +307,24 @@ bool AsyncResponseContext::IterateContiguous(IterRecord<T>& arIters, APDU& arAPD
 {
 	size_t start = arIters.first->mIndex;
 	size_t stop = arIters.last->mIndex;
-	StreamObject<typename T::MeasType>* pObj = arIters.pObject;
 
 	ObjectWriteIterator owi = arAPDU.WriteContiguous(arIters.pObject, start, stop);
-
-	for(size_t i=start; i<=stop; ++i)
-	{
-		if(owi.IsEnd()) return false; // out of space in the fragment
-		pObj->Write(*owi, arIters.first->mValue);
-		++arIters.first; //increment the iterators
-		++owi;
-	}
-
-	return true;
+	if(owi.IsEnd()) return false; // out of space in the fragment
+
+	// the static values are kept encoded, only points updated since the last read are written again
+	StaticImage<T>* pImage;
+	mpDB->GetImage(pImage);
+	size_t num_points = mpDB->NumType(T::MeasType::MeasEnum);
+	if(!pImage->IsConfigured(arIters.pObject, num_points)) pImage->Configure(arIters.pObject, num_points);
+	typename StaticIter<T>::Type begin;
+	mpDB->Begin(begin);
+	pImage->Refresh(begin);
+
+	size_t num = owi.Count();
+	memcpy(*owi, pImage->Get(start), num*pImage->ObjectSize());
+	arIters.first += num;
+
+	return num == (stop - start + 1);
 }
 
 
@@ -314,7 +342,7 @@ size_t AsyncResponseContext::IterateIndexed(EventRequest<T>& arRequest, typename
 		if(write.IsEnd()) return i;										//that's all we can get into this fragment
 
 		write.SetIndex(arIter->mIndex);
-		arRequest.pObj->Write(*write, arIter->mValue);					// do the write
+		arRequest.pObj->WritePacked(*write, arIter->mValue);			// do the write
 		arIter->mWritten = true;										// flag it as written
 		++arIter;														// advance the read iterator
 		++write;														// advance the write iterator
@@ -359,11 +387,11 @@ size_t AsyncResponseContext::IterateCTO(const StreamObject<T>* apObj, size_t aCo
 	{
 		if(write.IsEnd()) return i;										// that's all we can get into this fragment
 
-		T tmp = arIter->mValue;											// make a copy and adjust the time
+		typename EventInfo<T>::StoredType tmp = arIter->mValue;		// make a copy and adjust the time
 		tmp.SetTime(tmp.GetTime()-start);
 
 		write.SetIndex(arIter->mIndex);
-		apObj->Write(*write, tmp);										// do the write, with the tmp
+		apObj->WritePacked(*write, tmp);								// do the write, with the tmp
 		arIter->mWritten = true;										// flag it as written
 		++arIter;														// advance the read iterator
 		++write;														// advance the write iterator
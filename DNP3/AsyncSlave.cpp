@@ -23,6 +23,7 @@
 #include "AsyncDatabase.h"
 #include "DNPExceptions.h"
 #include "ObjectReadIterator.h"
+#include "StackMetrics.h"
 
 #include <APL/Logger.h>
 #include <APL/TimingTools.h>
@@ -40,9 +41,11 @@ AsyncSlave::AsyncSlave(
 					   ITimeManager* apTime,
 					   AsyncDatabase* apDatabase,
 					   IDNPCommandMaster* apCmdMaster,
-					   const SlaveConfig& arCfg
+					   const SlaveConfig& arCfg,
+					   BufferPoolSet* apPools
 					   ) :
 Loggable(apLogger),
+mChangeBuffer(arCfg.mCoalesceUpdates),
 mpAppLayer(apAppLayer),
 mpTimerSrc(apTimerSrc),
 mpDatabase(apDatabase),
@@ -51,13 +54,24 @@ mpState(AS_Closed::Inst()),
 mConfig(arCfg),
 mRspTypes(arCfg),
 mpUnsolTimer(NULL),
-mResponse(arCfg.mMaxFragSize),
-mUnsol(arCfg.mMaxFragSize),
+mNumPending(0),
+mCommandCursor(0),
+mCollectCommands(false),
+mpCommandTimer(NULL),
+mpCmdRspNext(NULL),
+mResponse(arCfg.mMaxFragSize, GetPool(apPools, arCfg.mMaxFragSize)),
+mNextResponse(arCfg.mMaxFragSize, GetPool(apPools, arCfg.mMaxFragSize)),
+mpRspInFlight(&mResponse),
+mpFragmentAhead(NULL),
+mRequest(DEFAULT_FRAG_SIZE, GetPool(apPools, DEFAULT_FRAG_SIZE)),
+mUnsol(arCfg.mMaxFragSize, GetPool(apPools, arCfg.mMaxFragSize)),
 mRspContext(apLogger, apDatabase, &mRspTypes, arCfg.mMaxBinaryEvents, arCfg.mMaxAnalogEvents, arCfg.mMaxCounterEvents),
 mHaveLastRequest(false),
-mLastRequest(arCfg.mMaxFragSize),
+mLastRequest(0),
+mHoldResponse(false),
 mpTime(apTime),
 mCommsStatus(apLogger, "comms_status"),
+mpMetrics(NULL),
 mDeferredUpdate(false),
 mDeferredRequest(false),
 mDeferredUnsol(false),
@@ -73,6 +87,9 @@ mpTimeTimer(NULL)
 	// use the cmd master to send and rsp queue to wait for reply
 	mpCmdMaster->SetResponseObserver(&mRspQueue);
 
+	// Command responses from user code will trigger a POST on the timer source to call OnCommandResponse
+	mRspQueue.AddObserver(mNotifierSource.Get(boost::bind(&AsyncSlave::OnCommandResponse, this), mpTimerSrc));
+
 	// Incoming data will trigger a POST on the timer source to call OnDataUpdate
 	mChangeBuffer.AddObserver(mNotifierSource.Get(boost::bind(&AsyncSlave::OnDataUpdate, this), mpTimerSrc));
 
@@ -82,6 +99,12 @@ mpTimeTimer(NULL)
 	mCommsStatus.Set(COMMS_DOWN);
 }
 
+void AsyncSlave::SetMetrics(StackMetrics* apMetrics)
+{
+	mpMetrics = apMetrics;
+	mRspContext.SetMetrics(apMetrics);
+}
+
 /* Implement IAsyncAppUser - external callbacks from the app layer */
 	
 void AsyncSlave::OnLowerLayerUp()
@@ -92,6 +115,7 @@ void AsyncSlave::OnLowerLayerUp()
 
 void AsyncSlave::OnLowerLayerDown()
 {
+	mUnsol.Release(); // the app layer has dropped it
 	mpState->OnLowerLayerDown(this);
 	this->FlushDeferredEvents();
 	mCommsStatus.Set(COMMS_DOWN);
@@ -113,6 +137,7 @@ void AsyncSlave::OnSolFailure()
 
 void AsyncSlave::OnUnsolSendSuccess()
 {
+	mUnsol.Release(); // the unsol channel is done with it, the state may build the next one
 	mpState->OnUnsolSendSuccess(this);
 	this->FlushDeferredEvents();
 	mCommsStatus.Set(COMMS_UP);
@@ -120,6 +145,7 @@ void AsyncSlave::OnUnsolSendSuccess()
 
 void AsyncSlave::OnUnsolFailure()
 {
+	mUnsol.Release();
 	mpState->OnUnsolFailure(this);
 	LOG_BLOCK(LEV_WARNING, "Unsol response failure");
 	this->FlushDeferredEvents();
@@ -154,6 +180,20 @@ void AsyncSlave::OnUnsolTimerExpiration()
 	this->FlushDeferredEvents();
 }
 
+void AsyncSlave::OnCommandResponse()
+{
+	this->ProcessCommandResponses();
+	mpState->OnCommandResponse(this);
+	this->FlushDeferredEvents();
+}
+
+void AsyncSlave::OnCommandTimeout()
+{
+	mpCommandTimer = NULL;
+	mpState->OnCommandTimeout(this);
+	this->FlushDeferredEvents();
+}
+
 /* Private functions */
 
 void AsyncSlave::FlushDeferredEvents()
@@ -172,6 +212,7 @@ void AsyncSlave::FlushDeferredEvents()
 	if(mpState->AcceptsDeferredRequests() && mDeferredRequest) {
 		mDeferredRequest = false;
 		mpState->OnRequest(this, mRequest, mSeqInfo);
+		if(!mDeferredRequest) mRequest.Release();
 	}
 
 	// if an unsol timer expiration was Deferred by a state,
@@ -186,6 +227,9 @@ void AsyncSlave::FlushDeferredEvents()
 		mDeferredUnknown = false;
 		mpState->OnUnknown(this);
 	}
+
+	// every event that can change the buffer ends here
+	if(mpMetrics) mpMetrics->EventBufferDepth(mRspContext.NumEvents());
 }
 
 size_t AsyncSlave::FlushUpdates()
@@ -213,14 +257,25 @@ void AsyncSlave::ConfigureAndSendSimpleResponse()
 	mResponse.Set(FC_RESPONSE);
 	mRspIIN.BitwiseOR(mIIN);
 	mResponse.SetIIN(mRspIIN);
+	mpRspInFlight = &mResponse;
 	mpAppLayer->SendResponse(mResponse);
 }
 
+void AsyncSlave::LoadFragmentAhead()
+{
+	// the callbacks of the send may already have ended the response or started another one
+	if(mpState != AS_WaitForRspSuccess::Inst() || mpFragmentAhead != NULL || !mRspContext.HasOnlyStaticData()) return;
+
+	mpFragmentAhead = (mpRspInFlight == &mResponse) ? &mNextResponse : &mResponse;
+	mRspContext.LoadResponse(*mpFragmentAhead);
+}
+
 void AsyncSlave::Send(APDU& arAPDU, const IINField& arIIN)
 {
 	mRspIIN.BitwiseOR(mIIN);
 	mRspIIN.BitwiseOR(arIIN);
 	arAPDU.SetIIN(mRspIIN);
+	mpRspInFlight = &arAPDU;
 	mpAppLayer->SendResponse(arAPDU);
 }
 
@@ -228,6 +283,7 @@ void AsyncSlave::Send(APDU& arAPDU)
 {
 	mRspIIN.BitwiseOR(mIIN);	
 	arAPDU.SetIIN(mRspIIN);
+	mpRspInFlight = &arAPDU;
 	mpAppLayer->SendResponse(arAPDU);
 }
 
@@ -360,46 +416,39 @@ void AsyncSlave::HandleSelect(const APDU& arRequest, SequenceInfo aSeqInfo)
 
 void AsyncSlave::HandleOperate(const APDU& arRequest, SequenceInfo aSeqInfo)
 {
-	if ( aSeqInfo == SI_PREV && mLastRequest == arRequest )
-		return;
-
-	mResponse.Set(FC_RESPONSE);
+	this->ClearCommands();
 
-	for(HeaderReadIterator hdr = arRequest.BeginRead(); !hdr.IsEnd(); ++hdr) {
+	if ( aSeqInfo == SI_PREV && mHaveLastRequest && mLastRequest == arRequest )
+		return;
 
-		ObjectReadIterator i = hdr.BeginRead();
+	this->DispatchOperate(arRequest, aSeqInfo, false);
+}
 
-		switch(MACRO_DNP_RADIX(hdr->GetGroup(), hdr->GetVariation())) {
+void AsyncSlave::HandleDirectOperate(const APDU& arRequest, SequenceInfo aSeqInfo)
+{
+	this->ClearCommands();
 
-			case(MACRO_DNP_RADIX(12,1)):	
-				this->RespondToCommands<BinaryOutput>(Group12Var1::Inst(), i, boost::bind(&AsyncSlave::Operate<BinaryOutput>, this, _1, _2, false, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
-				break;
-			
-			case(MACRO_DNP_RADIX(41,1)):
-				this->RespondToCommands<Setpoint>(Group41Var1::Inst(), i, boost::bind(&AsyncSlave::Operate<Setpoint>, this, _1, _2, false, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
-				break;
-				
-			case(MACRO_DNP_RADIX(41,2)):
-				this->RespondToCommands<Setpoint>(Group41Var2::Inst(), i, boost::bind(&AsyncSlave::Operate<Setpoint>, this, _1, _2, false, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
-				break;
+	this->DispatchOperate(arRequest, aSeqInfo, true);
+}
 
-			case(MACRO_DNP_RADIX(41,3)):
-				this->RespondToCommands<Setpoint>(Group41Var3::Inst(), i, boost::bind(&AsyncSlave::Operate<Setpoint>, this, _1, _2, false, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
-				break;
-				
-			case(MACRO_DNP_RADIX(41,4)):
-				this->RespondToCommands<Setpoint>(Group41Var4::Inst(), i, boost::bind(&AsyncSlave::Operate<Setpoint>, this, _1, _2, false, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
-				break;
+void AsyncSlave::DispatchOperate(const APDU& arRequest, SequenceInfo aSeqInfo, bool aDirect)
+{
+	try {
+		this->RespondToOperate(arRequest, aSeqInfo, aDirect);
 
-			default:
-				mRspIIN.SetFuncNotSupported(true);
-				ERROR_BLOCK(LEV_WARNING, "Object/Function mismatch", SERR_OBJ_FUNC_MISMATCH);
-				break;
-		}
+		// user code may have already responded during the dispatch
+		this->ProcessCommandResponses();
+		if(!mCommands.empty() && mNumPending == 0) this->BuildCommandResponse(arRequest);
+	}
+	catch(...) {
+		// the request won't be answered with these commands, so nothing may wait on them
+		mCollectCommands = false;
+		this->ClearCommands();
+		throw;
 	}
 }
 
-void AsyncSlave::HandleDirectOperate(const APDU& arRequest, SequenceInfo aSeqInfo)
+void AsyncSlave::RespondToOperate(const APDU& arRequest, SequenceInfo aSeqInfo, bool aDirect)
 {
 	mResponse.Set(FC_RESPONSE);
 
@@ -410,28 +459,28 @@ void AsyncSlave::HandleDirectOperate(const APDU& arRequest, SequenceInfo aSeqInf
 		switch(MACRO_DNP_RADIX(hdr->GetGroup(), hdr->GetVariation())) {
 
 			case(MACRO_DNP_RADIX(12,1)):	
-				this->RespondToCommands<BinaryOutput>(Group12Var1::Inst(), i, boost::bind(&AsyncSlave::Operate<BinaryOutput>, this, _1, _2, true, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
+				this->RespondToCommands<BinaryOutput>(Group12Var1::Inst(), i, boost::bind(&AsyncSlave::Operate<BinaryOutput>, this, _1, _2, aDirect, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
 				break;
 			
 			case(MACRO_DNP_RADIX(41,1)):
-				this->RespondToCommands<Setpoint>(Group41Var1::Inst(), i, boost::bind(&AsyncSlave::Operate<Setpoint>, this, _1, _2, true, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
+				this->RespondToCommands<Setpoint>(Group41Var1::Inst(), i, boost::bind(&AsyncSlave::Operate<Setpoint>, this, _1, _2, aDirect, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
 				break;
 				
 			case(MACRO_DNP_RADIX(41,2)):
-				this->RespondToCommands<Setpoint>(Group41Var2::Inst(), i, boost::bind(&AsyncSlave::Operate<Setpoint>, this, _1, _2, true, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
+				this->RespondToCommands<Setpoint>(Group41Var2::Inst(), i, boost::bind(&AsyncSlave::Operate<Setpoint>, this, _1, _2, aDirect, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
 				break;
 
 			case(MACRO_DNP_RADIX(41,3)):
-				this->RespondToCommands<Setpoint>(Group41Var3::Inst(), i, boost::bind(&AsyncSlave::Operate<Setpoint>, this, _1, _2, true, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
+				this->RespondToCommands<Setpoint>(Group41Var3::Inst(), i, boost::bind(&AsyncSlave::Operate<Setpoint>, this, _1, _2, aDirect, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
 				break;
 				
 			case(MACRO_DNP_RADIX(41,4)):
-				this->RespondToCommands<Setpoint>(Group41Var4::Inst(), i, boost::bind(&AsyncSlave::Operate<Setpoint>, this, _1, _2, true, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
+				this->RespondToCommands<Setpoint>(Group41Var4::Inst(), i, boost::bind(&AsyncSlave::Operate<Setpoint>, this, _1, _2, aDirect, hdr.info(), aSeqInfo, arRequest.GetControl().SEQ));
 				break;
 
 			default:
 				mRspIIN.SetFuncNotSupported(true);
-				ERROR_BLOCK(LEV_WARNING, "Object/Function mismatch", SERR_OBJ_FUNC_MISMATCH);
+				if(!mCollectCommands) ERROR_BLOCK(LEV_WARNING, "Object/Function mismatch", SERR_OBJ_FUNC_MISMATCH);
 				break;
 		}
 	}
@@ -477,6 +526,7 @@ void AsyncSlave::HandleUnknown()
 {
 	mResponse.Set(FC_RESPONSE);
 	mRspIIN.SetObjectUnknown(true);
+	mHaveLastRequest = false;	// the response to the last request is gone, a repeat of it can't be answered by resending
 }
 
 void AsyncSlave::StartUnsolTimer(millis_t aTimeout)
@@ -485,6 +535,66 @@ void AsyncSlave::StartUnsolTimer(millis_t aTimeout)
 	mpUnsolTimer = mpTimerSrc->Start(aTimeout, boost::bind(&AsyncSlave::OnUnsolTimerExpiration, this));
 }
 
+void AsyncSlave::ProcessCommandResponses()
+{
+	CommandResponse rsp(CS_UNDEFINED);
+	int sequence;
+
+	while(mRspQueue.Pop(rsp, sequence))
+	{
+		bool found = false;
+		for(size_t i = 0; i < mCommands.size(); ++i)
+		{
+			CommandRecord& rec = mCommands[i];
+			if(rec.mPending && rec.mSequence == sequence)
+			{
+				rec.mStatus = rsp.mResult;
+				rec.mPending = false;
+				--mNumPending;
+				found = true;
+				break;
+			}
+		}
+
+		if(!found) LOG_BLOCK(LEV_DEBUG, "Discarding command response for sequence: " << sequence);
+	}
+}
+
+void AsyncSlave::BuildCommandResponse(const APDU& arRequest)
+{
+	// the sequence info and direct flag are only used when dispatching, not when collecting
+	mCollectCommands = true;
+	mCommandCursor = 0;
+	this->RespondToOperate(arRequest, SI_OTHER, false);
+	mCollectCommands = false;
+}
+
+void AsyncSlave::ExpireCommands()
+{
+	for(size_t i = 0; i < mCommands.size(); ++i)
+	{
+		CommandRecord& rec = mCommands[i];
+		if(rec.mPending)
+		{
+			rec.mStatus = CS_TIMEOUT;
+			rec.mPending = false;
+		}
+	}
+	mNumPending = 0;
+}
+
+void AsyncSlave::ClearCommands()
+{
+	mCommands.clear();
+	mNumPending = 0;
+}
+
+void AsyncSlave::StartCommandTimer()
+{
+	assert(mpCommandTimer == NULL);
+	mpCommandTimer = mpTimerSrc->Start(mConfig.mCommandResponseTimeout, boost::bind(&AsyncSlave::OnCommandTimeout, this));
+}
+
 void AsyncSlave::ResetTimeIIN()
 {
 	mpTimeTimer = NULL;
@@ -27,6 +27,7 @@
 #include <APL/ChangeBuffer.h>
 #include <APL/CommandResponseQueue.h>
 #include <APL/CachedLogVariable.h>
+#include <APL/BufferPool.h>
 
 #include "AsyncAppInterfaces.h"
 #include "APDU.h"
@@ -37,6 +38,9 @@
 #include "ObjectReadIterator.h"
 #include "DNPCommandMaster.h"
 
+#include <vector>
+#include <assert.h>
+
 namespace apl
 {
 	class ITimerSource;
@@ -45,6 +49,7 @@ namespace apl
 namespace apl { namespace dnp {
 
 class AS_Base;
+class StackMetrics;
 
 /** @section desc DNP3 outstation.
 
@@ -76,12 +81,17 @@ class AsyncSlave : public Loggable, public IAsyncAppUser
 	friend class AS_WaitForRspSuccess;
 	friend class AS_WaitForUnsolSuccess;
 	friend class AS_WaitForSolUnsolSuccess;
+	friend class AS_WaitForCmdRsp;
 
 	public:
 
-	AsyncSlave(Logger*, IAsyncAppLayer*, ITimerSource*, ITimeManager* apTime, AsyncDatabase*, IDNPCommandMaster*, const SlaveConfig& arCfg);
+	/// If apPools isn't NULL, deferred requests and unsolicited responses only hold a pooled buffer while they're pending
+	AsyncSlave(Logger*, IAsyncAppLayer*, ITimerSource*, ITimeManager* apTime, AsyncDatabase*, IDNPCommandMaster*, const SlaveConfig& arCfg, BufferPoolSet* apPools = NULL);
 	virtual ~AsyncSlave() {}
 
+	/// Fragment build times and the event buffer depth are reported to apMetrics
+	void SetMetrics(StackMetrics* apMetrics);
+
 
 	///////////////////////////////////
 	// External events
@@ -125,19 +135,43 @@ class AsyncSlave : public Loggable, public IAsyncAppUser
 
 	ITimer* mpUnsolTimer;					/// timer for sending unsol responses
 
+	/// Tracks the outcome of a single control in the operate request being processed
+	struct CommandRecord
+	{
+		CommandRecord(int aSequence, CommandStatus aStatus, bool aPending) :
+			mSequence(aSequence), mStatus(aStatus), mPending(aPending)
+		{}
+
+		int mSequence;						/// sequence the command was dispatched with, -1 if it was never dispatched
+		CommandStatus mStatus;
+		bool mPending;						/// true while user code has not yet responded
+	};
+
+	std::vector<CommandRecord> mCommands;	/// controls from the current operate request, in request order
+	size_t mNumPending;						/// number of records still waiting on user code
+	size_t mCommandCursor;					/// next record to consume when building the response
+	bool mCollectCommands;					/// true when building the response from recorded statuses
+	ITimer* mpCommandTimer;					/// timer bounding how long we wait on user code
+	AS_Base* mpCmdRspNext;					/// state to enter once the operate response is sent
+
 	IINField mIIN;							/// IIN bits that persist between requests (i.e. NeedsTime/Restart/Etc)
 	IINField mRspIIN;						/// Transient IIN bits that get merged before a response is issued
-	APDU mResponse;							/// APDU used to form responses
+	APDU mResponse;							/// APDU used to form responses, only holds a pooled buffer during a response
+	APDU mNextResponse;						/// spare APDU so a fragment can be loaded while the previous one is in flight, only holds a pooled buffer meanwhile
+	APDU* mpRspInFlight;					/// the response fragment last handed to the app layer
+	APDU* mpFragmentAhead;					/// fragment loaded ahead of the previous one's confirm, NULL if there isn't one
 	APDU mRequest;							/// APDU used to save Deferred requests
 	SequenceInfo mSeqInfo;
 	APDU mUnsol;							/// APDY used to form unsol responses
 	AsyncResponseContext mRspContext;		/// Used to track and construct response fragments
 
-	bool mHaveLastRequest;
-	APDU mLastRequest;						/// APDU used to form responses
+	bool mHaveLastRequest;					/// false if there's no last request or its response has been overwritten
+	APDU mLastRequest;						/// last request, at its exact length, to recognize a repeated operate
+	bool mHoldResponse;						/// keep the response buffer after the response, a repeat of the request resends it
 
 	ITimeManager* mpTime;
 	CachedLogVariable mCommsStatus;
+	StackMetrics* mpMetrics;				/// NULL unless the stack reports metrics
 
 	// Flags that tell us that some action has been Deferred
 	// until the slave is in a state capable of handling it.
@@ -151,8 +185,11 @@ class AsyncSlave : public Loggable, public IAsyncAppUser
 
 	void OnDataUpdate();					/// internal event dispatched when user code commits an update to mChangeBuffer
 	void OnUnsolTimerExpiration();			/// internal event dispatched when the unsolicited pack/retry timer expires
+	void OnCommandResponse();				/// internal event dispatched when user code responds to a command
+	void OnCommandTimeout();				/// internal event dispatched when user code fails to respond in time
 
 	void ConfigureAndSendSimpleResponse();
+	void LoadFragmentAhead();				/// loads the next static fragment while the one in flight waits on its confirm
 	void Send(APDU&);
 	void Send(APDU& arAPDU, const IINField& arIIN); /// overload with additional IIN data
 	void SendUnsolicited(APDU& arAPDU);
@@ -163,6 +200,8 @@ class AsyncSlave : public Loggable, public IAsyncAppUser
 	void HandleSelect(const APDU& arRequest, SequenceInfo aSeqInfo);
 	void HandleOperate(const APDU& arRequest, SequenceInfo aSeqInfo);
 	void HandleDirectOperate(const APDU& arRequest, SequenceInfo aSeqInfo);
+	void DispatchOperate(const APDU& arRequest, SequenceInfo aSeqInfo, bool aDirect);	/// clears the commands if anything throws
+	void RespondToOperate(const APDU& arRequest, SequenceInfo aSeqInfo, bool aDirect);
 	void HandleEnableUnsolicited(const APDU& arRequest, bool aIsEnable);
 	void HandleUnknown();
 
@@ -176,6 +215,14 @@ class AsyncSlave : public Loggable, public IAsyncAppUser
 	void FlushDeferredEvents();
 	void StartUnsolTimer(millis_t aTimeout);
 
+	// Command helpers
+
+	void ProcessCommandResponses();
+	void BuildCommandResponse(const APDU& arRequest);
+	void ExpireCommands();
+	void ClearCommands();
+	void StartCommandTimer();
+
 	// Task handlers
 
 	void ResetTimeIIN();
@@ -238,9 +285,23 @@ CommandStatus AsyncSlave::Select(T& arCmd, size_t aIndex, const HeaderInfo& aHdr
 	return res;
 }
 
+/**
+	Operate is called twice for every control in a request. The first pass dispatches the
+	command to user code and records it, the second (mCollectCommands == true) runs once
+	every dispatched command has been answered or has timed out, and fills in the response.
+*/
 template <class T>
 CommandStatus AsyncSlave::Operate(T& arCmd, size_t aIndex, bool aDirect, const HeaderInfo& aHdr, SequenceInfo aSeqInfo, int aAPDUSequence)
 {
+	if(mCollectCommands)
+	{
+		assert(mCommandCursor < mCommands.size());
+		const CommandRecord& rec = mCommands[mCommandCursor++];
+		if(rec.mSequence >= 0)
+			LOG_BLOCK(LEV_INFO, arCmd.ToString() << " Index: " << aIndex << " Result: " << ToString(rec.mStatus));
+		return rec.mStatus;
+	}
+
 	++mSequence;
 	CommandStatus res;
 	if ( aDirect )
@@ -252,15 +313,16 @@ CommandStatus AsyncSlave::Operate(T& arCmd, size_t aIndex, bool aDirect, const H
 	{
 		if ( res == CS_NOT_SUPPORTED )
 			mRspIIN.SetParameterError(true);
-		return res;
+		mCommands.push_back(CommandRecord(-1, res, false));
 	}
 	else
 	{
-		CommandResponse cr(CS_HARDWARE_ERROR);
-		mRspQueue.WaitForResponse(cr, mSequence); //wait forever on a response from user space
-		LOG_BLOCK(LEV_INFO, arCmd.ToString() << " Index: " << aIndex << " Result: " << ToString(cr.mResult));
-		return cr.mResult;
+		// the response from user space is picked up asynchronously, see OnCommandResponse()
+		mCommands.push_back(CommandRecord(mSequence, CS_TIMEOUT, true));
+		++mNumPending;
 	}
+
+	return res;
 }
 
 
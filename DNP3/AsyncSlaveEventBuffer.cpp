@@ -70,6 +70,11 @@ namespace apl { namespace dnp {
 		}
 	}
 
+	size_t AsyncSlaveEventBuffer :: Size()
+	{
+		return mBinaryEvents.Size() + mAnalogEvents.Size() + mCounterEvents.Size();
+	}
+
 	size_t AsyncSlaveEventBuffer :: NumSelected()
 	{
 		return mBinaryEvents.NumSelected() + mAnalogEvents.NumSelected() + mCounterEvents.NumSelected();
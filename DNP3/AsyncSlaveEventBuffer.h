@@ -47,6 +47,9 @@ class AsyncSlaveEventBuffer : public IAsyncEventBuffer
 
 		size_t NumType(DataTypes aType);
 
+		/// @return number of events of all types, selected or not
+		size_t Size();
+
 		void Begin(BinaryEventIter& arIter)		{ arIter = mBinaryEvents.Begin(); }
 		void Begin(AnalogEventIter& arIter)		{ arIter = mAnalogEvents.Begin(); }
 		void Begin(CounterEventIter& arIter)	{ arIter = mCounterEvents.Begin(); }
@@ -22,13 +22,14 @@
 namespace apl { namespace dnp {
 
 
-AsyncSlaveStack::AsyncSlaveStack(Logger* apLogger, ITimerSource* apTimerSrc, ICommandAcceptor* apCmdAcceptor, const SlaveStackConfig& arCfg) :
-AsyncStack(apLogger->GetSubLogger("slave"), apTimerSrc, arCfg.app, arCfg.link),
+AsyncSlaveStack::AsyncSlaveStack(Logger* apLogger, ITimerSource* apTimerSrc, ICommandAcceptor* apCmdAcceptor, const SlaveStackConfig& arCfg, BufferPoolSet* apPools) :
+AsyncStack(apLogger->GetSubLogger("slave"), apTimerSrc, arCfg.app, arCfg.link, apPools),
 mDB(apLogger),
 mCmdMaster(10000),
-mSlave(apLogger, &mApplication, apTimerSrc, &mTimeSource, &mDB, &mCmdMaster, arCfg.slave)
+mSlave(apLogger, &mApplication, apTimerSrc, &mTimeSource, &mDB, &mCmdMaster, arCfg.slave, apPools)
 {
 	this->mApplication.SetUser(&mSlave);
+	mSlave.SetMetrics(&mMetrics);
 	mDB.Configure(arCfg.device);
 	mCmdMaster.Configure(arCfg.device, apCmdAcceptor);
 }
@@ -38,12 +38,14 @@ class AsyncSlaveStack : public AsyncStack
 		@param apTimerSrc		Timer source used by the slave for asynchronous eventing
 		@param apCmdAcceptor	Command acceptor interface used for dispatching commands to the outside world
 		@param arCfg			Configuration struct that holds parameters for the stack
+		@param apPools			If not NULL, fragment buffers are borrowed from these pools only while in use
 	*/
 	AsyncSlaveStack(
 		Logger* apLogger,
 		ITimerSource* apTimerSrc,
 		ICommandAcceptor* apCmdAcceptor,
-		const SlaveStackConfig& arCfg);
+		const SlaveStackConfig& arCfg,
+		BufferPoolSet* apPools = NULL);
 
 	TimeSourceSystemOffset mTimeSource;
 	AsyncDatabase mDB;				/// The database holds static event data and forwards to an event buffer
@@ -78,6 +78,7 @@ void AS_Base::SwitchOnFunction(AsyncSlave* c, AS_Base* apNext, const APDU& arReq
 			IINField iin = c->mRspContext.Configure(arRequest);
 			c->mRspContext.LoadResponse(c->mResponse);
 			c->Send(c->mResponse, iin);
+			c->LoadFragmentAhead();
 			break;
 		}
 		case(FC_WRITE):
@@ -91,17 +92,17 @@ void AS_Base::SwitchOnFunction(AsyncSlave* c, AS_Base* apNext, const APDU& arReq
 			c->Send(c->mResponse);
 			break;
 		case(FC_OPERATE):
-			ChangeState(c, apNext);
 			c->HandleOperate(arRequest, aSeqInfo);
-			c->Send(c->mResponse);
+			this->DoCommandResponse(c, apNext);
 			break;
 		case(FC_DIRECT_OPERATE):
-			ChangeState(c, apNext);
 			c->HandleDirectOperate(arRequest, aSeqInfo);
-			c->Send(c->mResponse);
+			this->DoCommandResponse(c, apNext);
 			break;
 		case(FC_DIRECT_OPERATE_NO_ACK):			
 			c->HandleDirectOperate(arRequest, aSeqInfo);
+			c->ClearCommands(); // no response, so nothing to wait for
+			c->mResponse.Release();
 			break;
 		case(FC_ENABLE_UNSOLICITED):
 			ChangeState(c, apNext);
@@ -130,6 +131,7 @@ void AS_Base::SwitchOnFunction(AsyncSlave* c, AS_Base* apNext, const APDU& arReq
 void AS_Base::DoRequest(AsyncSlave* c, AS_Base* apNext, const APDU& arAPDU, SequenceInfo aSeqInfo)
 {
 	c->mRspIIN.Zero();
+	c->mHoldResponse = (arAPDU.GetFunction() == FC_OPERATE);
 
 	try
 	{
@@ -150,10 +152,25 @@ void AS_Base::DoRequest(AsyncSlave* c, AS_Base* apNext, const APDU& arAPDU, Sequ
 		c->ConfigureAndSendSimpleResponse();		
 	}
 
-	c->mLastRequest = arAPDU;
+	c->mLastRequest.CopyFragment(arAPDU);
 	c->mHaveLastRequest = true;
 }
 
+/// Operate responses are only sent once user code has responded to every dispatched
+/// command, otherwise we wait for the responses (or the timeout) in AS_WaitForCmdRsp
+void AS_Base::DoCommandResponse(AsyncSlave* c, AS_Base* apNext)
+{
+	if(c->mNumPending > 0) {
+		c->mpCmdRspNext = apNext;
+		c->StartCommandTimer();
+		ChangeState(c, AS_WaitForCmdRsp::Inst());
+	}
+	else {
+		ChangeState(c, apNext);
+		c->Send(c->mResponse);
+	}
+}
+
 // Work functions
 
 void AS_Base::ChangeState(AsyncSlave* c, AS_Base* apState)
@@ -163,9 +180,19 @@ void AS_Base::ChangeState(AsyncSlave* c, AS_Base* apState)
 			c->mpTimeTimer->Cancel();
 			c->mpTimeTimer = NULL;
 		}
+		c->mHaveLastRequest = false;	// the sequence starts over, so nothing can repeat the last request
+		c->mHoldResponse = false;
+	}
+
+	// once no solicited response is outstanding its buffer goes back to the pool,
+	// unless a repeated operate would be answered by sending it again
+	if((apState == AS_Idle::Inst() || apState == AS_WaitForUnsolSuccess::Inst() || apState == AS_Closed::Inst()) && !c->mHoldResponse) {
+		c->mResponse.Release();
 	}
 	LOGGER_BLOCK(c->mpLogger, LEV_DEBUG, "State changed from " << c->mpState->Name() << " to " << apState->Name());
 	c->mpState = apState;
+	c->mpFragmentAhead = NULL;	// a fragment loaded ahead belongs to the response that just ended
+	c->mNextResponse.Release();
 }
 
 void AS_Base::DoUnsolSuccess(AsyncSlave* c)
@@ -262,16 +289,26 @@ void AS_WaitForRspSuccess::OnSolFailure(AsyncSlave* c)
 	c->mRspContext.Reset();	
 }
 
+/// Static fragments are loaded one ahead, so the fragment that was loaded while the last
+/// one was waiting on its confirm goes out right away and the one after it is loaded next.
 void AS_WaitForRspSuccess::OnSolSendSuccess(AsyncSlave* c)
 {
 	c->mRspContext.ClearWritten();
+	if(c->mpRspInFlight == &c->mNextResponse) c->mNextResponse.Release();	// confirmed, the spare isn't needed until the next fragment is loaded ahead
 	
-	if(c->mRspContext.IsComplete()) {
+	if(c->mpFragmentAhead != NULL) {
+		APDU* pFragment = c->mpFragmentAhead;
+		c->mpFragmentAhead = NULL;
+		c->Send(*pFragment);
+		c->LoadFragmentAhead();
+	}
+	else if(c->mRspContext.IsComplete()) {
 		ChangeState(c, AS_Idle::Inst());
 	}
 	else {
 		c->mRspContext.LoadResponse(c->mResponse);
 		c->Send(c->mResponse);
+		c->LoadFragmentAhead();
 	}
 }
 
@@ -282,7 +319,7 @@ void AS_WaitForRspSuccess::OnSolSendSuccess(AsyncSlave* c)
 void AS_WaitForRspSuccess::OnRequest(AsyncSlave* c, const APDU& arAPDU, SequenceInfo aSeqInfo)
 {
 	c->mpAppLayer->CancelResponse();
-	c->mRequest = arAPDU;
+	c->mRequest.CopyFragment(arAPDU);
 	c->mSeqInfo = aSeqInfo;
 	c->mDeferredRequest = true;
 }
@@ -308,7 +345,7 @@ void AS_WaitForUnsolSuccess::OnUnsolSendSuccess(AsyncSlave* c)
 void AS_WaitForUnsolSuccess::OnRequest(AsyncSlave* c, const APDU& arAPDU, SequenceInfo aSeqInfo)
 {
 	if(arAPDU.GetFunction() == FC_READ) { //read requests should be deferred until after the unsol
-		c->mRequest = arAPDU;
+		c->mRequest.CopyFragment(arAPDU);
 		c->mSeqInfo = aSeqInfo;
 		c->mDeferredRequest = true;
 	}
@@ -325,7 +362,7 @@ AS_WaitForSolUnsolSuccess AS_WaitForSolUnsolSuccess::mInstance;
 void AS_WaitForSolUnsolSuccess::OnRequest(AsyncSlave* c, const APDU& arAPDU, SequenceInfo aSeqInfo)
 {
 	// Both channels are busy... buffer the request
-	c->mRequest = arAPDU;
+	c->mRequest.CopyFragment(arAPDU);
 	c->mSeqInfo = aSeqInfo;
 	c->mDeferredRequest = true;
 }
@@ -357,6 +394,79 @@ void AS_WaitForSolUnsolSuccess::OnUnsolSendSuccess(AsyncSlave* c)
 }
 
 
+/* AS_WaitForCmdRsp */
+
+AS_WaitForCmdRsp AS_WaitForCmdRsp::mInstance;
+
+void AS_WaitForCmdRsp::OnLowerLayerDown(AsyncSlave* c)
+{
+	this->CancelTimer(c);
+	c->ClearCommands();
+	AS_OpenBase::OnLowerLayerDown(c);
+}
+
+void AS_WaitForCmdRsp::OnRequest(AsyncSlave* c, const APDU& arAPDU, SequenceInfo aSeqInfo)
+{
+	// still building the last response... buffer the request
+	c->mRequest.CopyFragment(arAPDU);
+	c->mSeqInfo = aSeqInfo;
+	c->mDeferredRequest = true;
+}
+
+void AS_WaitForCmdRsp::OnUnsolFailure(AsyncSlave* c)
+{
+	if(c->mpCmdRspNext != AS_WaitForSolUnsolSuccess::Inst()) {
+		AS_OpenBase::OnUnsolFailure(c);
+		return;
+	}
+
+	c->mpCmdRspNext = AS_WaitForRspSuccess::Inst();
+	c->mRspContext.Reset();
+	if (c->mConfig.mUnsolRetryDelay > 0)
+		c->StartUnsolTimer(c->mConfig.mUnsolRetryDelay);
+	else
+		c->mDeferredUnsol = true;
+}
+
+void AS_WaitForCmdRsp::OnUnsolSendSuccess(AsyncSlave* c)
+{
+	if(c->mpCmdRspNext != AS_WaitForSolUnsolSuccess::Inst()) {
+		AS_OpenBase::OnUnsolSendSuccess(c);
+		return;
+	}
+
+	c->mpCmdRspNext = AS_WaitForRspSuccess::Inst();
+	this->DoUnsolSuccess(c);
+}
+
+void AS_WaitForCmdRsp::OnCommandResponse(AsyncSlave* c)
+{
+	if(c->mNumPending == 0) this->Complete(c);
+}
+
+void AS_WaitForCmdRsp::OnCommandTimeout(AsyncSlave* c)
+{
+	LOGGER_BLOCK(c->mpLogger, LEV_WARNING, "Timed out waiting on " << c->mNumPending << " command response(s)");
+	c->ExpireCommands();
+	this->Complete(c);
+}
+
+void AS_WaitForCmdRsp::Complete(AsyncSlave* c)
+{
+	this->CancelTimer(c);
+	c->BuildCommandResponse(c->mLastRequest);
+	c->ClearCommands();
+	ChangeState(c, c->mpCmdRspNext);
+	c->Send(c->mResponse);
+}
+
+void AS_WaitForCmdRsp::CancelTimer(AsyncSlave* c)
+{
+	if(c->mpCommandTimer) {
+		c->mpCommandTimer->Cancel();
+		c->mpCommandTimer = NULL;
+	}
+}
 
 }} //ens ns
 
@@ -68,6 +68,12 @@ class AS_Base
 	/// Called when a data update is received from the user layer
 	virtual void OnUnsolExpiration(AsyncSlave*);
 
+	/// Called when user code responds to a dispatched command
+	virtual void OnCommandResponse(AsyncSlave*) {}
+
+	/// Called when user code fails to respond to dispatched commands in time
+	virtual void OnCommandTimeout(AsyncSlave*) {}
+
 	/// @return The name associated with the state
 	virtual std::string Name() const = 0;
 
@@ -81,6 +87,7 @@ class AS_Base
 	void SwitchOnFunction(AsyncSlave*, AS_Base* apNext, const APDU& arRequest, SequenceInfo aSeqInfo);
 	void DoUnsolSuccess(AsyncSlave*);
 	void DoRequest(AsyncSlave* c, AS_Base* apNext, const APDU& arAPDU, SequenceInfo aSeqInfo);
+	void DoCommandResponse(AsyncSlave* c, AS_Base* apNext);
 
 	//Work functions
 
@@ -163,6 +170,26 @@ class AS_WaitForSolUnsolSuccess : public AS_OpenBase
 	void OnUnsolSendSuccess(AsyncSlave*);
 };
 
+/** @section desc
+The slave is waiting on user code to respond to operate commands before issuing the response.
+If entered while an unsolicited response was outstanding, it continues to track that transaction.
+*/
+class AS_WaitForCmdRsp : public AS_OpenBase
+{
+	MACRO_STATE_SINGLETON_INSTANCE(AS_WaitForCmdRsp);
+
+	void OnLowerLayerDown(AsyncSlave*);
+	void OnRequest(AsyncSlave*, const APDU&, SequenceInfo);
+	void OnUnsolFailure(AsyncSlave*);
+	void OnUnsolSendSuccess(AsyncSlave*);
+	void OnCommandResponse(AsyncSlave*);
+	void OnCommandTimeout(AsyncSlave*);
+
+	private:
+
+	void Complete(AsyncSlave*);
+	void CancelTimer(AsyncSlave*);
+};
 
 }} //ens ns
 
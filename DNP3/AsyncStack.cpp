@@ -22,14 +22,29 @@
 
 namespace apl { namespace dnp {
 
-AsyncStack::AsyncStack(Logger* apLogger, ITimerSource* apTimerSrc, AppConfig aAppCfg, LinkConfig aCfg) :
+AsyncStack::AsyncStack(Logger* apLogger, ITimerSource* apTimerSrc, AppConfig aAppCfg, LinkConfig aCfg, BufferPoolSet* apPools) :
 mLink(apLogger->GetSubLogger("link"), apTimerSrc, aCfg),
-mTransport(apLogger->GetSubLogger("transport")),
-mApplication(apLogger->GetSubLogger("app"), apTimerSrc, aAppCfg)
+mTransport(apLogger->GetSubLogger("transport"), DEFAULT_FRAG_SIZE, apPools),
+mApplication(apLogger->GetSubLogger("app"), apTimerSrc, aAppCfg, apPools)
 {
+	mLink.SetMetrics(&mMetrics);
 	mLink.SetUpperLayer(&mTransport);
 	mTransport.SetUpperLayer(&mApplication);
 }
 
+void AsyncStack::RegisterMetrics(MetricRegistry* apRegistry, const std::string& arStackName, bool aIsMaster)
+{
+	mMetrics.Register(apRegistry, arStackName, aIsMaster);
+	mLink.SetRttMetrics(apRegistry, arStackName + ".link");
+	mApplication.SetRttMetrics(apRegistry, arStackName + ".app");
+}
+
+void AsyncStack::GetMetricNames(const std::string& arStackName, std::vector<std::string>& arNames)
+{
+	StackMetrics::GetNames(arStackName, arNames);
+	RttEstimator::GetMetricNames(arStackName + ".link", arNames);
+	RttEstimator::GetMetricNames(arStackName + ".app", arNames);
+}
+
 }}
 
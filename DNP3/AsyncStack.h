@@ -22,6 +22,7 @@
 #include "AsyncLinkLayer.h"
 #include "AsyncTransportLayer.h"
 #include "AsyncAppLayer.h"
+#include "StackMetrics.h"
 
 namespace apl {
 class Logger;
@@ -33,9 +34,17 @@ namespace apl { namespace dnp {
 class AsyncStack
 {
 	public:
-	AsyncStack(Logger*, ITimerSource* apTimerSrc, AppConfig aAppCfg, LinkConfig aCfg);
+	/// If apPools isn't NULL, the transport and application layers borrow their fragment buffers from it
+	AsyncStack(Logger*, ITimerSource* apTimerSrc, AppConfig aAppCfg, LinkConfig aCfg, BufferPoolSet* apPools = NULL);
 	virtual ~AsyncStack() {}
 
+	/// Report the stack's metrics to apRegistry as "<arStackName>.<metric>"
+	void RegisterMetrics(MetricRegistry* apRegistry, const std::string& arStackName, bool aIsMaster);
+
+	/// Appends every name RegisterMetrics may use for arStackName to arNames
+	static void GetMetricNames(const std::string& arStackName, std::vector<std::string>& arNames);
+
+	StackMetrics mMetrics;		/// disabled until registered, see AsyncStackManager
 	AsyncLinkLayer mLink;
 	AsyncTransportLayer mTransport;
 	AsyncAppLayer mApplication;
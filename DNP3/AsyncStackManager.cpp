@@ -19,120 +19,359 @@
 #include <APL/ASIOIncludes.h>
 #include "AsyncStackManager.h"
 #include "AsyncPort.h"
+#include "PhysicalLayerAsyncTCPSession.h"
+#include "TCPListener.h"
 
 #include <boost/foreach.hpp>
 #include <APL/TimerSourceASIO.h>
+#include <APL/TimerSourceWheel.h>
+#include <APL/PhysicalLayerAsyncASIO.h>
 #include <APL/Exception.h>
 #include <APL/Logger.h>
+#include <APL/AsyncTaskGroup.h>
 
 #include <DNP3/AsyncMasterStack.h>
 #include <DNP3/AsyncSlaveStack.h>
 #include <DNP3/DeviceTemplate.h>
 
 #include <iostream>
+#include <memory>
 #include <boost/bind.hpp>
 
 using namespace std;
 
 namespace apl { namespace dnp {
 
-AsyncStackManager::AsyncStackManager(Logger* apLogger, bool aAutoRun) :
+AsyncStackManager::AsyncStackManager(Logger* apLogger, bool aAutoRun, size_t aNumThreads) :
 Loggable(apLogger),
 mRunASIO(aAutoRun),
 mRunning(false),
+mPools(&mMetrics, "fragment_pool"),
 mService(),
 mTimerSrc(mService.Get()),
 mMgr(apLogger->GetSubLogger("ports", LEV_WARNING), false),	// the false here is important!!!												  
-mScheduler(&mTimerSrc),								        // it means that any layer we retrieve from the manager, we will delete
-mThread(this)
+mScheduler(&mTimerSrc)								        // it means that any layer we retrieve from the manager, we will delete
 {
-	
+	if(aNumThreads == 0) throw ArgumentException(LOCATION, "At least one thread is required to run the io_service");
+	for(size_t i=0; i<aNumThreads; ++i) mThreads.push_back(new ServiceThread(this));
 }
 
 AsyncStackManager::~AsyncStackManager()
 {	
-	this->Stop(); // tell every port to stop, join on the thread	
+	this->Stop(); // tell every port to stop, join on the threads
 	this->Run(); // run out the io_service, to make sure all the deletes are called, if the io_service wasn't running
+
+	BOOST_FOREACH(ServiceThread* p, mThreads) { delete p; }
+	BOOST_FOREACH(TCPListener* p, mAllListeners) { delete p; }
 }
 
 std::vector<std::string> AsyncStackManager::GetStackNames() { return GetKeys<PortMap, string>(mStackToPort); }
-std::vector<std::string> AsyncStackManager::GetPortNames()  {  return GetKeys<PortMap, string>(mPortToPort); }
+
+std::vector<std::string> AsyncStackManager::GetPortNames()
+{
+	std::vector<std::string> ret = GetKeys<PortMap, string>(mPortToPort);
+	std::vector<std::string> listeners = GetKeys<ListenerMap, string>(mListeners);
+	ret.insert(ret.end(), listeners.begin(), listeners.end());
+	return ret;
+}
 
 void AsyncStackManager::AddTCPClient(const std::string& arName, PhysLayerSettings aSettings, TCPSettings aTcp)
 {	
+	if(mListeners.find(arName) != mListeners.end()) throw ArgumentException(LOCATION, "Port already exists");
 	mMgr.AddTCPClient(arName, aSettings, aTcp);
+	if(aTcp.mConcurrentMasters) mConcurrentPorts.insert(arName);
 }
 
 void AsyncStackManager::AddTCPServer(const std::string& arName, PhysLayerSettings aSettings, TCPSettings aTcp)
 {	
+	if(mListeners.find(arName) != mListeners.end()) throw ArgumentException(LOCATION, "Port already exists");
 	mMgr.AddTCPServer(arName, aSettings, aTcp);
+	if(aTcp.mConcurrentMasters) mConcurrentPorts.insert(arName);
 }
 
 void AsyncStackManager::AddSerial(const std::string& arName, PhysLayerSettings aSettings, SerialSettings aSerial)
 {
+	if(mListeners.find(arName) != mListeners.end()) throw ArgumentException(LOCATION, "Port already exists");
 	mMgr.AddSerial(arName, aSettings, aSerial);
 }
 
+void AsyncStackManager::AddUDP(const std::string& arName, PhysLayerSettings aSettings, UDPSettings aUdp)
+{
+	if(mListeners.find(arName) != mListeners.end()) throw ArgumentException(LOCATION, "Port already exists");
+	mMgr.AddUDP(arName, aSettings, aUdp);
+}
+
+void AsyncStackManager::AddTCPListener(const std::string& arName, PhysLayerSettings aSettings, TCPSettings aTcp, millis_t aHandshakeTimeout)
+{
+	if(mListeners.find(arName) != mListeners.end() || mMgr.HasLayer(arName)) throw ArgumentException(LOCATION, "Port already exists");
+	Logger* pLogger = mpLogger->GetSubLogger(arName, aSettings.LogLevel);
+	pLogger->SetVarName(arName);
+	TCPListener* pListener = new TCPListener(pLogger, mService.Get(), aTcp, aHandshakeTimeout);
+	mAllListeners.push_back(pListener);
+	mListeners[arName] = ListenerRecord(pListener, aSettings);
+}
+
 ICommandAcceptor* AsyncStackManager::AddMaster( const std::string& arPortName, const std::string& arStackName, FilterLevel aLevel, IDataObserver* apPublisher,
 											    const MasterStackConfig& arCfg)
 {
-	AsyncPort* pPort = this->AllocatePort(arPortName);
-	Logger* pLogger = mpLogger->GetSubLogger(arStackName, aLevel);
-	pLogger->SetVarName(arStackName);
-	AsyncMasterStack* pMaster = new AsyncMasterStack(pLogger, &mTimerSrc, apPublisher, pPort->GetGroup(), arCfg);	
-	this->OnAddStack(arStackName, pMaster, pPort, arCfg.link.LocalAddr);
+	AsyncPort* pPort;
+	AsyncTaskGroup* pLane;
+	AsyncMasterStack* pMaster = this->CreateMaster(arPortName, arStackName, aLevel, apPublisher, arCfg, pPort, pLane);
+	this->OnAddStack(arStackName, pMaster, pPort, arCfg.link.LocalAddr, pLane);
 	return pMaster->mMaster.GetCmdAcceptor();
 }
 
 IDataObserver* AsyncStackManager::AddSlave( const std::string& arPortName, const std::string& arStackName, FilterLevel aLevel, ICommandAcceptor* apCmdAcceptor,
 											const SlaveStackConfig& arCfg)
 {
-	AsyncPort* pPort = this->AllocatePort(arPortName);
-	Logger* pLogger = mpLogger->GetSubLogger(arStackName, aLevel);
-	pLogger->SetVarName(arStackName);
-	AsyncSlaveStack* pSlave = new AsyncSlaveStack(pLogger, &mTimerSrc, apCmdAcceptor, arCfg);	
+	AsyncPort* pPort;
+	AsyncSlaveStack* pSlave = this->CreateSlave(arPortName, arStackName, aLevel, apCmdAcceptor, arCfg, pPort);
 	this->OnAddStack(arStackName, pSlave, pPort, arCfg.link.LocalAddr);
 	return pSlave->mSlave.GetDataObserver();
 }
 
+namespace {
+	typedef std::map<AsyncPort*, AsyncPort::BindingVector> BindingMap;
+
+	/// Links the stacks of each port in one operation on the port's strand
+	void PostBindings(const BindingMap& arBindings)
+	{
+		for(BindingMap::const_iterator i = arBindings.begin(); i != arBindings.end(); ++i) {
+			i->first->GetTimerSource()->Post(boost::bind(&AsyncPort::AssociateAll, i->first, i->second));
+		}
+	}
+}
+
+void AsyncStackManager::AddBatch(StackBatch& arBatch)
+{
+	this->CheckBatch(arBatch);
+
+	BOOST_FOREACH(StackBatch::PortRecord& r, arBatch.mPorts) {
+		switch(r.mType) {
+			case(StackBatch::PT_TCP_CLIENT):
+				this->AddTCPClient(r.mName, r.mPhys, r.mTcp);
+				break;
+			case(StackBatch::PT_TCP_SERVER):
+				this->AddTCPServer(r.mName, r.mPhys, r.mTcp);
+				break;
+			case(StackBatch::PT_SERIAL):
+				this->AddSerial(r.mName, r.mPhys, r.mSerial);
+				break;
+			case(StackBatch::PT_UDP):
+				this->AddUDP(r.mName, r.mPhys, r.mUdp);
+				break;
+			case(StackBatch::PT_TCP_LISTENER):
+				this->AddTCPListener(r.mName, r.mPhys, r.mTcp, r.mHandshakeTimeout);
+				break;
+		}
+	}
+
+	// gather the stacks of each port so they're linked in one operation on the port's strand
+	BindingMap bindings;
+
+	try {
+		BOOST_FOREACH(StackBatch::MasterRecord& r, arBatch.mMasters) {
+			AsyncPort* pPort;
+			AsyncTaskGroup* pLane;
+			AsyncMasterStack* pMaster = this->CreateMaster(r.mPortName, r.mStackName, r.mLevel, r.mpPublisher, r.mConfig, pPort, pLane);
+			bindings[pPort].push_back(AsyncPort::Binding(r.mStackName, pMaster, r.mConfig.link.LocalAddr, pLane));
+			r.mpCmdAcceptor = pMaster->mMaster.GetCmdAcceptor();
+		}
+
+		BOOST_FOREACH(StackBatch::SlaveRecord& r, arBatch.mSlaves) {
+			AsyncPort* pPort;
+			AsyncSlaveStack* pSlave = this->CreateSlave(r.mPortName, r.mStackName, r.mLevel, r.mpCmdAcceptor, r.mConfig, pPort);
+			bindings[pPort].push_back(AsyncPort::Binding(r.mStackName, pSlave, r.mConfig.link.LocalAddr, NULL));
+			r.mpDataObserver = pSlave->mSlave.GetDataObserver();
+		}
+	}
+	catch(...) {
+		// the stacks built so far are already indexed, they're linked so their ports own them like any other
+		PostBindings(bindings);
+		if(!bindings.empty() && !mRunning && mRunASIO) this->StartThreads();
+		throw;
+	}
+
+	PostBindings(bindings);
+	if(!bindings.empty() && !mRunning && mRunASIO) this->StartThreads();
+}
+
+AsyncMasterStack* AsyncStackManager::CreateMaster(const std::string& arPortName, const std::string& arStackName, FilterLevel aLevel, IDataObserver* apPublisher,
+												  const MasterStackConfig& arCfg, AsyncPort*& arpPort, AsyncTaskGroup*& arpLane)
+{
+	if(mStackToPort.find(arStackName) != mStackToPort.end()) throw ArgumentException(LOCATION, "Stack already exists: " + arStackName);
+	bool session = mListeners.find(arPortName) != mListeners.end();
+	arpPort = session ? this->AllocateSessionPort(arPortName, arStackName, arCfg.link.LocalAddr, arCfg.link.RemoteAddr) : this->AllocatePort(arPortName);
+	arpLane = NULL;
+	try {
+		Logger* pLogger = mpLogger->GetSubLogger(arStackName, aLevel);
+		pLogger->SetVarName(arStackName);
+		// on a concurrent port the master only waits on its own transactions, the router interleaves the frames
+		if(mConcurrentPorts.find(arPortName) != mConcurrentPorts.end()) arpLane = mScheduler.NewGroup(arpPort->GetTimerSource());
+		std::auto_ptr<AsyncMasterStack> pMaster(new AsyncMasterStack(pLogger, arpPort->GetTimerSource(), apPublisher, (arpLane == NULL) ? arpPort->GetGroup() : arpLane, arCfg, &mPools));
+		this->RegisterMetrics(pMaster.get(), arStackName, true);
+		if(arpLane != NULL) mStackLanes[arStackName] = arpLane;
+		mStackToPort[arStackName] = arpPort;
+		mPortToStacks[arpPort->Name()].insert(arStackName);
+		return pMaster.release();
+	}
+	catch(...) {
+		this->DiscardStack(arStackName, arpPort, arpLane, session);
+		throw;
+	}
+}
+
+AsyncSlaveStack* AsyncStackManager::CreateSlave(const std::string& arPortName, const std::string& arStackName, FilterLevel aLevel, ICommandAcceptor* apCmdAcceptor,
+												const SlaveStackConfig& arCfg, AsyncPort*& arpPort)
+{
+	if(mListeners.find(arPortName) != mListeners.end()) throw ArgumentException(LOCATION, "Slaves can't be added to a TCP listener");
+	if(mStackToPort.find(arStackName) != mStackToPort.end()) throw ArgumentException(LOCATION, "Stack already exists: " + arStackName);
+	arpPort = this->AllocatePort(arPortName);
+	try {
+		Logger* pLogger = mpLogger->GetSubLogger(arStackName, aLevel);
+		pLogger->SetVarName(arStackName);
+		std::auto_ptr<AsyncSlaveStack> pSlave(new AsyncSlaveStack(pLogger, arpPort->GetTimerSource(), apCmdAcceptor, arCfg, &mPools));
+		this->RegisterMetrics(pSlave.get(), arStackName, false);
+		mStackToPort[arStackName] = arpPort;
+		mPortToStacks[arpPort->Name()].insert(arStackName);
+		return pSlave.release();
+	}
+	catch(...) {
+		this->DiscardStack(arStackName, arpPort, NULL, false);
+		throw;
+	}
+}
+
+void AsyncStackManager::DiscardStack(const std::string& arStackName, AsyncPort* apPort, AsyncTaskGroup* apLane, bool aSessionPort)
+{
+	// nothing was posted to the port yet, so the stack never ran and its slots can be reused right away
+	std::vector<std::string> names;
+	AsyncStack::GetMetricNames(arStackName, names);
+	mMetrics.Reclaim(mMetrics.Unregister(names));
+	mStackLanes.erase(arStackName);
+	mStackToPort.erase(arStackName);
+	PortStackMap::iterator i = mPortToStacks.find(apPort->Name());
+	if(i != mPortToStacks.end()) {
+		i->second.erase(arStackName);
+		if(i->second.empty()) mPortToStacks.erase(i);
+	}
+	if(apLane != NULL) mScheduler.Release(apLane);
+	if(aSessionPort) this->ReleasePort(apPort);	// a session port only exists for its stack
+}
+
+void AsyncStackManager::RegisterMetrics(AsyncStack* apStack, const std::string& arStackName, bool aIsMaster)
+{
+	try {
+		apStack->RegisterMetrics(&mMetrics, arStackName, aIsMaster);
+	}
+	catch(const CapacityException& ex) {
+		// a full registry doesn't stop the stack from running, it just isn't measured
+		LOG_BLOCK(LEV_WARNING, "Metric registry is full, " << arStackName << " runs without some of its metrics: " << ex.Message());
+	}
+}
+
+void AsyncStackManager::CheckBatch(const StackBatch& arBatch)
+{
+	std::set<std::string> ports, listeners;
+	BOOST_FOREACH(const StackBatch::PortRecord& r, arBatch.mPorts) {
+		if(mMgr.HasLayer(r.mName) || mListeners.find(r.mName) != mListeners.end() || !ports.insert(r.mName).second) {
+			throw ArgumentException(LOCATION, "Port already exists: " + r.mName);
+		}
+		if(r.mType == StackBatch::PT_TCP_LISTENER) listeners.insert(r.mName);
+	}
+
+	std::set<std::string> stacks;
+	BOOST_FOREACH(const StackBatch::MasterRecord& r, arBatch.mMasters) { this->CheckBatchStack(r.mPortName, r.mStackName, true, ports, listeners, stacks); }
+	BOOST_FOREACH(const StackBatch::SlaveRecord& r, arBatch.mSlaves) { this->CheckBatchStack(r.mPortName, r.mStackName, false, ports, listeners, stacks); }
+}
+
+void AsyncStackManager::CheckBatchStack(const std::string& arPortName, const std::string& arStackName, bool aIsMaster, const std::set<std::string>& arNewPorts,
+										const std::set<std::string>& arNewListeners, std::set<std::string>& arNewStacks)
+{
+	if(mStackToPort.find(arStackName) != mStackToPort.end() || !arNewStacks.insert(arStackName).second) {
+		throw ArgumentException(LOCATION, "Stack already exists: " + arStackName);
+	}
+	bool listener = mListeners.find(arPortName) != mListeners.end() || arNewListeners.find(arPortName) != arNewListeners.end();
+	if(listener && !aIsMaster) throw ArgumentException(LOCATION, "Slaves can't be added to a TCP listener");
+	if(!listener && !mMgr.HasLayer(arPortName) && arNewPorts.find(arPortName) == arNewPorts.end()) {
+		throw ArgumentException(LOCATION, "Port doesn't exist: " + arPortName);
+	}
+}
+
 /// Remove a port and all associated stacks
 void AsyncStackManager::RemovePort(const std::string& arPortName)
 {	
-	AsyncPort* pPort = this->GetPort(arPortName);
-	vector<string> stacks = this->StacksOnPort(arPortName);
-	BOOST_FOREACH(string s, stacks) { this->SeverStack(pPort, s); }		
-	mPortToPort.erase(arPortName);
-	
-	mScheduler.Sever(pPort->GetGroup());	// this tells the scheduler that we'll delete the group
-	mTimerSrc.Post(boost::bind(&AsyncPort::Release, pPort));	
+	if(mListeners.find(arPortName) != mListeners.end()) this->RemoveListener(arPortName);
+	else {
+		AsyncPort* pPort = this->GetPort(arPortName);
+		vector<string> stacks = this->StacksOnPort(arPortName);
+		BOOST_FOREACH(string s, stacks) { this->SeverStack(pPort, s); }		
+		mPortToPort.erase(arPortName);
+		mConcurrentPorts.erase(arPortName);
 		
-	// remove the physical layer from the list
-	// The ports own the layers themselves, so deleting the port will delete the layer
-	mMgr.Remove(arPortName); 
+		this->ReleasePort(pPort);
+			
+		// remove the physical layer from the list
+		// The ports own the layers themselves, so deleting the port will delete the layer
+		mMgr.Remove(arPortName); 
+	}
 
 	this->CheckForJoin();
 }
 
-std::vector<std::string> AsyncStackManager::StacksOnPort(const std::string& arPortName)
+void AsyncStackManager::RemoveListener(const std::string& arName)
 {
-	std::vector<std::string> ret;
-	for(PortMap::iterator i = this->mStackToPort.begin(); i!=mStackToPort.end(); ++i) {
-		if(i->second->Name() == arPortName) ret.push_back(i->first);
+	// each master has a port of its own, they all go with the listener
+	vector<string> stacks = this->StacksOnPort(arName);
+	BOOST_FOREACH(string s, stacks) {
+		AsyncPort* pPort = this->GetPortByStackName(s);
+		this->SeverStack(pPort, s);
+		this->ReleasePort(pPort);
 	}
-	return ret;
+
+	ListenerMap::iterator i = mListeners.find(arName);
+	i->second.mpListener->Close();
+	mListeners.erase(i);
+}
+
+void AsyncStackManager::ReleasePort(AsyncPort* apPort)
+{
+	mScheduler.Sever(apPort->GetGroup());	// this tells the scheduler that we'll delete the group
+	apPort->GetTimerSource()->Post(boost::bind(&AsyncPort::Release, apPort));
+}
+
+std::vector<std::string> AsyncStackManager::StacksOnPort(const std::string& arPortName)
+{
+	PortStackMap::iterator i = mPortToStacks.find(arPortName);
+	if(i == mPortToStacks.end()) return std::vector<std::string>();
+	return std::vector<std::string>(i->second.begin(), i->second.end());
 }
 
 void AsyncStackManager::RemoveStack(const std::string& arStackName)
 {
 	AsyncPort* pPort = this->GetPortByStackName(arStackName);
 	this->SeverStack(pPort, arStackName);
+	if(mListeners.find(pPort->Name()) != mListeners.end()) this->ReleasePort(pPort); // the port only served this stack
 	this->CheckForJoin();
 }
 
 void AsyncStackManager::SeverStack(AsyncPort* apPort, const std::string& arStackName)
 {	
-	mTimerSrc.Post(boost::bind(&AsyncPort::Disassociate, apPort, arStackName)); 
+	// the name is free for a new stack right away, the slots once the stack is deleted on the port's strand
+	std::vector<std::string> names;
+	AsyncStack::GetMetricNames(arStackName, names);
+	size_t ticket = mMetrics.Unregister(names);
+	apPort->GetTimerSource()->Post(boost::bind(&AsyncPort::Disassociate, apPort, arStackName)); 
+	apPort->GetTimerSource()->Post(boost::bind(&MetricRegistry::Reclaim, &mMetrics, ticket));
+	LaneMap::iterator i = mStackLanes.find(arStackName);
+	if(i != mStackLanes.end()) {
+		mScheduler.Sever(i->second);	// the port deletes the lane along with the stack
+		mStackLanes.erase(i);
+	}
 	mStackToPort.erase(arStackName);
+	PortStackMap::iterator j = mPortToStacks.find(apPort->Name());
+	j->second.erase(arStackName);
+	if(j->second.empty()) mPortToStacks.erase(j);
 }
 
 AsyncPort* AsyncStackManager::GetPortByStackName(const std::string& arStackName)
@@ -152,9 +391,8 @@ void AsyncStackManager::Stop()
 		LOG_BLOCK(LEV_DEBUG, "Done removing Port: " << s);
 	}
 	if(mRunning) {
-		LOG_BLOCK(LEV_DEBUG, "Joining on io_service thread");
-		mThread.WaitForStop();
-		mRunning = false;
+		LOG_BLOCK(LEV_DEBUG, "Joining on io_service threads");
+		this->JoinThreads();
 		LOG_BLOCK(LEV_DEBUG, "Done joining");
 	}
 	LOG_BLOCK(LEV_DEBUG, "exit stop");
@@ -162,10 +400,7 @@ void AsyncStackManager::Stop()
 
 void AsyncStackManager::Start()
 {
-	if(this->NumStacks() > 0 && !mRunning) {
-		mRunning = true;
-		mThread.Start();
-	}
+	if(this->NumStacks() > 0 && !mRunning) this->StartThreads();
 }
 
 AsyncPort* AsyncStackManager::AllocatePort(const std::string& arName)
@@ -176,7 +411,7 @@ AsyncPort* AsyncStackManager::AllocatePort(const std::string& arName)
 		IPhysicalLayerAsync* pPhys = mMgr.GetLayer(arName, mService.Get());
 		Logger* pPortLogger = mpLogger->GetSubLogger(arName, s.LogLevel);
 		pPortLogger->SetVarName(arName);
-		pPort = this->CreatePort(arName, pPhys, pPortLogger, s.RetryTimeout);		
+		pPort = this->CreatePort(arName, pPhys, pPortLogger, s);		
 	}
 	return pPort;
 }
@@ -189,14 +424,53 @@ AsyncPort* AsyncStackManager::GetPort(const std::string& arName)
 }
 
 
-AsyncPort* AsyncStackManager::CreatePort(const std::string& arName, IPhysicalLayerAsync* apPhys, Logger* apLogger, millis_t aOpenDelay)
+AsyncPort* AsyncStackManager::AllocateSessionPort(const std::string& arName, const std::string& arStackName, uint_16_t aLocalAddress, uint_16_t aRemoteAddress)
+{
+	ListenerRecord& r = mListeners[arName];
+	std::string name = arName + "." + arStackName;
+	Logger* pPortLogger = mpLogger->GetSubLogger(name, r.mSettings.LogLevel);
+	pPortLogger->SetVarName(name);
+	IPhysicalLayerAsync* pPhys = new PhysicalLayerAsyncTCPSession(pPortLogger, mService.Get(), r.mpListener, aLocalAddress, aRemoteAddress);
+	return this->NewPort(arName, pPhys, pPortLogger, r.mSettings);
+}
+
+AsyncPort* AsyncStackManager::CreatePort(const std::string& arName, IPhysicalLayerAsync* apPhys, Logger* apLogger, const PhysLayerSettings& arSettings)
 {
 	if(GetPortPointer(arName) != NULL) throw ArgumentException(LOCATION, "Port already exists");
-	AsyncPort* pPort = new AsyncPort(arName, apLogger, mScheduler.NewGroup(), &mTimerSrc, apPhys, aOpenDelay);
+	AsyncPort* pPort = this->NewPort(arName, apPhys, apLogger, arSettings);
 	mPortToPort[arName] = pPort;
 	return pPort;
 }
 
+AsyncPort* AsyncStackManager::NewPort(const std::string& arName, IPhysicalLayerAsync* apPhys, Logger* apLogger, const PhysLayerSettings& arSettings)
+{
+	// pin the port to the strand of its physical layer, so that everything on the port is
+	// serialized no matter how many threads are running the io_service. Layers that don't
+	// use asio get a strand of their own, owned by the port's timer source.
+	PhysicalLayerAsyncASIO* pASIO = dynamic_cast<PhysicalLayerAsyncASIO*>(apPhys);
+	bool ownsStrand = (pASIO == NULL);
+	boost::asio::io_service::strand* pStrand = ownsStrand ? new boost::asio::io_service::strand(*mService.Get()) : pASIO->GetStrand();
+
+	ReleasableTimerSource* pTimerSrc = (arSettings.TimerWheelResolution > 0) ?
+		static_cast<ReleasableTimerSource*>(new TimerSourceWheel(mService.Get(), pStrand, arSettings.TimerWheelResolution, ownsStrand)) :
+		static_cast<ReleasableTimerSource*>(new TimerSourceASIO(mService.Get(), pStrand, ownsStrand));
+	return new AsyncPort(arName, apLogger, mScheduler.NewGroup(pTimerSrc), pTimerSrc, apPhys, arSettings.RetryTimeout);
+}
+
+ITimerSource* AsyncStackManager::GetPortTimerSource(const std::string& arPortName)
+{
+	return this->GetPort(arPortName)->GetTimerSource();
+}
+
+size_t AsyncStackManager::NumLanesRunning()
+{
+	size_t num = 0;
+	for(LaneMap::iterator i = mStackLanes.begin(); i != mStackLanes.end(); ++i) {
+		if(i->second->NumRunning() > 0) ++num;
+	}
+	return num;
+}
+
 AsyncPort* AsyncStackManager::GetPortPointer(const std::string& arName)
 {
 	PortMap::iterator i = mPortToPort.find(arName);
@@ -204,6 +478,12 @@ AsyncPort* AsyncStackManager::GetPortPointer(const std::string& arName)
 }
 
 void AsyncStackManager::Run()
+{
+	this->RunService();
+	mService.Get()->reset();
+}
+
+void AsyncStackManager::RunService()
 {
 	size_t num = 0;
 
@@ -216,27 +496,34 @@ void AsyncStackManager::Run()
 		}
 	}
 	while(num > 0);
+}
+
+void AsyncStackManager::StartThreads()
+{
+	mRunning = true;
+	BOOST_FOREACH(ServiceThread* p, mThreads) { p->Start(); }
+}
 
+void AsyncStackManager::JoinThreads()
+{
+	// the io_service can only be reset once every thread has returned from run()
+	BOOST_FOREACH(ServiceThread* p, mThreads) { p->WaitForStop(); }
 	mService.Get()->reset();
+	mRunning = false;
 }
 
-void AsyncStackManager::OnAddStack(const std::string& arStackName, AsyncStack* apStack, AsyncPort* apPort, uint_16_t aAddress)
+void AsyncStackManager::OnAddStack(const std::string& arStackName, AsyncStack* apStack, AsyncPort* apPort, uint_16_t aAddress, AsyncTaskGroup* apLane)
 {	
-	// marshall the linking to the io_service
-	mStackToPort[arStackName] = apPort; //map the stack to a portname
-	mTimerSrc.Post(boost::bind(&AsyncPort::Associate, apPort, arStackName, apStack, aAddress)); 
-	if(!mRunning && mRunASIO) {
-		mRunning = true;
-		mThread.Start();
-	}
+	// marshall the linking to the io_service, the stack was already indexed when it was created
+	apPort->GetTimerSource()->Post(boost::bind(&AsyncPort::Associate, apPort, arStackName, apStack, aAddress, apLane)); 
+	if(!mRunning && mRunASIO) this->StartThreads();
 }
 
 void AsyncStackManager::CheckForJoin()
 {	
 	if(mRunning && this->NumStacks() == 0) {
-		LOG_BLOCK(LEV_DEBUG, "Check For join: joining on io_service thread");
-		mThread.WaitForStop();	//join on the thread, ASIO will exit when there's no more work to be done
-		mRunning = false;		
+		LOG_BLOCK(LEV_DEBUG, "Check For join: joining on io_service threads");
+		this->JoinThreads();	//join on the threads, ASIO will exit when there's no more work to be done
 		LOG_BLOCK(LEV_DEBUG, "Check For join: complete");
 	}	
 }
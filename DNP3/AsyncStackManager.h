@@ -21,6 +21,7 @@
 
 
 #include <map>
+#include <set>
 #include <vector>
 
 #include <APL/Loggable.h>
@@ -33,6 +34,10 @@
 #include <APL/AsyncTaskScheduler.h>
 #include <APL/Lock.h>
 #include <APL/IOService.h>
+#include <APL/MetricRegistry.h>
+#include <APL/BufferPool.h>
+
+#include <DNP3/StackBatch.h>
 
 namespace apl {
 	class IPhysicalLayerAsync;
@@ -45,6 +50,9 @@ namespace apl { namespace dnp {
 
 class AsyncPort;
 class AsyncStack;
+class AsyncMasterStack;
+class AsyncSlaveStack;
+class TCPListener;
 
 struct SlaveStackConfig;
 struct MasterStackConfig;
@@ -53,28 +61,50 @@ struct MasterStackConfig;
 	The interface for C++ projects for dnp3. Provides an interface for starting/stopping
 	master/slave protocol stacks. Any method may be called while the system is running.
 	Methods should only be called from a single thread at at a time.
+
+	The io_service can be run from a pool of threads. Each port is pinned to the strand
+	of its physical layer, so the router, stacks and timers of a single port never execute
+	concurrently while different ports are free to run in parallel.
 */
-class AsyncStackManager : private Threadable, private Loggable
+class AsyncStackManager : private Loggable
 {
 	public:
 		/**
-			@param apLogger - Logger to use for all other loggers
-			@param aAutoRun	- Stacks begin execution immediately after being added
+			@param apLogger		- Logger to use for all other loggers
+			@param aAutoRun		- Stacks begin execution immediately after being added
+			@param aNumThreads	- Number of threads that run the io_service, must be at least 1
 		*/
-		AsyncStackManager(Logger* apLogger, bool aAutoRun = false);
+		AsyncStackManager(Logger* apLogger, bool aAutoRun = false, size_t aNumThreads = 1);
 		~AsyncStackManager();
 
 		// All the io_service marshalling now occurs here. It's now safe to add/remove while the manager is running.
 
-		/// Adds a TCPClient port, excepts if the port already exists
+		/// Adds a TCPClient port, excepts if the port already exists. If TCPSettings::mConcurrentMasters
+		/// is set, every master on the port gets a task group of its own so their transactions overlap
 		void AddTCPClient(const std::string& arName, PhysLayerSettings, TCPSettings);
 
-		/// Adds a TCPServer port, excepts if the port already exists
+		/// Adds a TCPServer port, excepts if the port already exists. See AddTCPClient for mConcurrentMasters
 		void AddTCPServer(const std::string& arName, PhysLayerSettings, TCPSettings);
 
 		/// Adds a Serial port, excepts if the port already exists
 		void AddSerial(const std::string& arName, PhysLayerSettings, SerialSettings);
 
+		/// Adds a UDP port, excepts if the port already exists
+		void AddUDP(const std::string& arName, PhysLayerSettings, UDPSettings);
+
+		/**
+			Adds a TCP listener that many outstations connect to, excepts if the port already exists.
+			Every master added to the listener gets a connection of its own, chosen by the source
+			address of the first link frame the connection sends, which must match the master's
+			link.RemoteAddr and be addressed to its link.LocalAddr. Slaves can't be added to a listener.
+
+			@param arName				Unique name of the port
+			@param aPhys				Log level and open retry timeout, applied to every master's connection
+			@param aTcp					Endpoint to listen on
+			@param aHandshakeTimeout	How long a new connection has to send its first link frame
+		*/
+		void AddTCPListener(const std::string& arName, PhysLayerSettings aPhys, TCPSettings aTcp, millis_t aHandshakeTimeout = 30000);
+
 		/**
 			Adds a master stack - Stack will automatically start running if Start() has been called or aAutoRun == true
 
@@ -107,6 +137,17 @@ class AsyncStackManager : private Threadable, private Loggable
 								ICommandAcceptor* apCmdAcceptor,
 								const SlaveStackConfig&);
 
+		/**
+			Adds the ports and stacks of a batch in one pass. The whole batch is checked before
+			anything is built, so a duplicate name or a stack on an unknown port excepts without adding
+			anything. The stacks of each port are associated with it by a single posted operation
+			instead of one per stack, which is what makes bringing up thousands of stacks fast.
+			If a stack still fails to build, the stacks built before it are kept and the exception is rethrown.
+
+			@param arBatch	Ports and stacks to add, the interfaces of the stacks are written back to its records
+		*/
+		void AddBatch(StackBatch& arBatch);
+
 		/// Remove a port and all associated stacks
 		void RemovePort(const std::string& arPortName);
 
@@ -119,26 +160,85 @@ class AsyncStackManager : private Threadable, private Loggable
 		/// @return a vector of all the port names
 		std::vector<std::string> GetPortNames();
 
-		/// Start the thread if it isn't running
+		/// Start the threads if they aren't running
 		void Start();
 
-		/// Stop the thread, doesn't delete anything until the stack manager destructs
+		/// Stop the threads, doesn't delete anything until the stack manager destructs
 		void Stop();
 
+		/// @return the number of threads that run the io_service
+		size_t NumThreads() { return mThreads.size(); }
+
+		/**
+			Every stack reports its metrics here as "<stack name>.<metric>", see StackMetrics for the list.
+			The registry may be read at any time without blocking the stacks. The metrics of a removed
+			stack are dropped with it, so a stack added again under the same name starts from zero. If
+			the registry is full a stack runs without metrics, and a warning is logged.
+
+			Fragment buffers are shared by all the stacks and borrowed only while a transaction is in
+			progress, the pools report their occupancy as "fragment_pool.<size>.in_use" and
+			"fragment_pool.<size>.allocated".
+		*/
+		MetricRegistry* GetMetrics() { return &mMetrics; }
+
 	private:
 
+		/// One of the pool of threads running the shared io_service
+		class ServiceThread : public Threadable
+		{
+			public:
+				ServiceThread(AsyncStackManager* apManager) : mpManager(apManager), mThread(this) {}
+
+				void Start() { mThread.Start(); }
+				void WaitForStop() { mThread.WaitForStop(); }
+
+			private:
+				void Run() { mpManager->RunService(); }
+
+				AsyncStackManager* mpManager;
+				Thread mThread;
+		};
+
 		AsyncPort* AllocatePort(const std::string& arName);
-		AsyncPort* CreatePort(const std::string& arName, IPhysicalLayerAsync* apPhys, Logger* apLogger, millis_t aOpenDelay);
+		AsyncPort* AllocateSessionPort(const std::string& arName, const std::string& arStackName, uint_16_t aLocalAddress, uint_16_t aRemoteAddress);
+		AsyncPort* CreatePort(const std::string& arName, IPhysicalLayerAsync* apPhys, Logger* apLogger, const PhysLayerSettings& arSettings);
+		AsyncPort* NewPort(const std::string& arName, IPhysicalLayerAsync* apPhys, Logger* apLogger, const PhysLayerSettings& arSettings);
+		void ReleasePort(AsyncPort* apPort);
+		void RemoveListener(const std::string& arName);
 		AsyncPort* GetPort(const std::string& arName);
 		AsyncPort* GetPortByStackName(const std::string& arStackName);
 		AsyncPort* GetPortPointer(const std::string& arName);
 
+		/// Run the io_service on the calling thread until it runs out of work, then reset it
 		void Run();
 
+		/// Run the io_service until it runs out of work, executed by every ServiceThread
+		void RunService();
+
+		void StartThreads();
+		void JoinThreads();
+
 		/// Remove a stack
 		void SeverStack(AsyncPort* apPort, const std::string& arStackName);
 
-		void OnAddStack(const std::string& arStackName, AsyncStack* apStack, AsyncPort* apPort, uint_16_t aAddress);
+		/// Build a stack and index it under its port, the caller associates it with the port
+		AsyncMasterStack* CreateMaster(const std::string& arPortName, const std::string& arStackName, FilterLevel aLevel, IDataObserver* apPublisher,
+									   const MasterStackConfig& arCfg, AsyncPort*& arpPort, AsyncTaskGroup*& arpLane);
+		AsyncSlaveStack* CreateSlave(const std::string& arPortName, const std::string& arStackName, FilterLevel aLevel, ICommandAcceptor* apCmdAcceptor,
+									 const SlaveStackConfig& arCfg, AsyncPort*& arpPort);
+
+		/// Undo whatever CreateMaster/CreateSlave did for a stack that failed before it was indexed
+		void DiscardStack(const std::string& arStackName, AsyncPort* apPort, AsyncTaskGroup* apLane, bool aSessionPort);
+
+		/// A stack that doesn't fit in the registry keeps running without those metrics
+		void RegisterMetrics(AsyncStack* apStack, const std::string& arStackName, bool aIsMaster);
+
+		/// Excepts if any port or stack of the batch can't be added
+		void CheckBatch(const StackBatch& arBatch);
+		void CheckBatchStack(const std::string& arPortName, const std::string& arStackName, bool aIsMaster, const std::set<std::string>& arNewPorts,
+							 const std::set<std::string>& arNewListeners, std::set<std::string>& arNewStacks);
+
+		void OnAddStack(const std::string& arStackName, AsyncStack* apStack, AsyncPort* apPort, uint_16_t aAddress, AsyncTaskGroup* apLane = NULL);
 		void CheckForJoin();
 
 		bool mRunASIO;
@@ -148,19 +248,58 @@ class AsyncStackManager : private Threadable, private Loggable
 		std::vector<std::string> StacksOnPort(const std::string& arPortName);
 
 	protected:
+		/// Timer source of a port, whatever is posted to it runs on the port's strand. Excepts if the port doesn't exist
+		ITimerSource* GetPortTimerSource(const std::string& arPortName);
+
+		/// @return how many masters on concurrent ports have a task of their own group running, i.e. a request outstanding
+		size_t NumLanesRunning();
+
+		MetricRegistry mMetrics;	/// outlives the io_service, pending handlers may still report
+		BufferPoolSet mPools;		/// fragment buffers the stacks borrow while a transaction is in progress, outlives the stacks
 		IOService mService;
 		TimerSourceASIO mTimerSrc;
 
 	private:
 		PhysicalLayerManager mMgr;
 		AsyncTaskScheduler mScheduler;
-		Thread mThread;
+
+		typedef std::vector<ServiceThread*> ThreadVector;
+		ThreadVector mThreads;
 
 		typedef std::map<std::string, AsyncPort*> PortMap;
 		PortMap mStackToPort;		/// maps a stack name a port instance
 		PortMap mPortToPort;		/// maps a port name to a port instance
 
+		/// The stacks on each port, listener ports included, so a port is torn down without a scan of every stack
+		typedef std::map<std::string, std::set<std::string> > PortStackMap;
+		PortStackMap mPortToStacks;
+
 		typedef std::map<std::string, size_t> mPortCount;	/// how many stacks per port
+
+		/// Ports whose masters each run in their own task group
+		std::set<std::string> mConcurrentPorts;
+
+		/// maps a master on a concurrent port to its task group, so it can be severed from the scheduler
+		typedef std::map<std::string, AsyncTaskGroup*> LaneMap;
+		LaneMap mStackLanes;
+
+		struct ListenerRecord
+		{
+			ListenerRecord() : mpListener(NULL) {}
+			ListenerRecord(TCPListener* apListener, const PhysLayerSettings& arSettings) : mpListener(apListener), mSettings(arSettings) {}
+
+			TCPListener* mpListener;
+			PhysLayerSettings mSettings;
+		};
+
+		/// Every master on a listener has a port of its own that shares the listener's name,
+		/// so it isn't in mPortToPort
+		typedef std::map<std::string, ListenerRecord> ListenerMap;
+		ListenerMap mListeners;
+
+		/// Listeners are deleted with the io_service, like the port timer sources
+		typedef std::vector<TCPListener*> ListenerVector;
+		ListenerVector mAllListeners;
 };
 
 }}
@@ -34,14 +34,14 @@ using namespace std;
 
 namespace apl { namespace dnp {
 
-	AsyncTransportLayer::AsyncTransportLayer(apl::Logger* apLogger, size_t aFragSize) : 
+	AsyncTransportLayer::AsyncTransportLayer(apl::Logger* apLogger, size_t aFragSize, BufferPoolSet* apPools) : 
 	Loggable(apLogger), 
 	IUpperLayer(apLogger),
 	ILowerLayer(apLogger),
 	mpState(TLS_Closed::Inst()),
 	M_FRAG_SIZE(aFragSize),
-	mReceiver(apLogger, this, aFragSize),
-	mTransmitter(apLogger, this, aFragSize),
+	mReceiver(apLogger, this, aFragSize, GetPool(apPools, aFragSize)),
+	mTransmitter(apLogger, this, aFragSize, GetPool(apPools, aFragSize)),
 	mThisLayerUp(false)
 	{
 	
@@ -60,6 +60,7 @@ namespace apl { namespace dnp {
 	void AsyncTransportLayer::ThisLayerDown()
 	{
 		mReceiver.Reset();
+		mTransmitter.Reset();
 		mThisLayerUp = false;
 		if(mpUpperLayer != NULL) mpUpperLayer->OnLowerLayerDown();
 	}
@@ -90,6 +91,11 @@ namespace apl { namespace dnp {
 		if(mpUpperLayer != NULL) mpUpperLayer->OnReceive(apData, aNumBytes);
 	}
 
+	void AsyncTransportLayer::ReceiveAPDU(CopyableBuffer& arBuffer, size_t aNumBytes)
+	{
+		if(mpUpperLayer != NULL) mpUpperLayer->OnReceiveBuffer(arBuffer, aNumBytes);
+	}
+
 	bool AsyncTransportLayer::ContinueSend()
 	{
 		return !mTransmitter.SendSuccess();
@@ -102,6 +108,7 @@ namespace apl { namespace dnp {
 
 	void AsyncTransportLayer::SignalSendFailure()
 	{
+		mTransmitter.Reset();
 		if(mpUpperLayer != NULL) mpUpperLayer->OnSendFailure();
 	}
 	
@@ -27,6 +27,7 @@
 #include "DNPConstants.h"
 
 #include <APL/AsyncLayerInterfaces.h>
+#include <APL/BufferPool.h>
 
 namespace apl { namespace dnp {
 
@@ -39,7 +40,8 @@ namespace apl { namespace dnp {
 	{
 		public:
 
-		AsyncTransportLayer(apl::Logger* apLogger, size_t aFragSize = DEFAULT_FRAG_SIZE);
+		/// If apPools isn't NULL, the reassembly and transmit buffers are borrowed from it only while in use
+		AsyncTransportLayer(apl::Logger* apLogger, size_t aFragSize = DEFAULT_FRAG_SIZE, BufferPoolSet* apPools = NULL);
 		virtual ~AsyncTransportLayer(){}
 
 		/* Actions - Taken by the states/transmitter/receiver in response to events */
@@ -51,6 +53,7 @@ namespace apl { namespace dnp {
 		void TransmitAPDU(const byte_t* apData, size_t aNumBytes);
 		void TransmitTPDU(const byte_t* apData, size_t aNumBytes);
 		void ReceiveAPDU(const byte_t* apData, size_t aNumBytes);
+		void ReceiveAPDU(CopyableBuffer& arBuffer, size_t aNumBytes); /// upper layer may swap the buffer out
 		void ReceiveTPDU(const byte_t* apData, size_t aNumBytes);
 
 		bool ContinueSend(); /// return true if
@@ -20,6 +20,8 @@
 #define __BUFFER_SET_TYPES_H_
 
 
+#include "EventStore.h"
+
 #include <map>
 #include <set>
 #include <vector>
@@ -30,30 +32,18 @@ namespace apl { namespace dnp {
 
 	// C++ doesn't allow templated typedefs, but this technique simulates this behavior
 
-	/// Set that forces data exclusivity by index
+	/// Store that forces data exclusivity by index, selected in index order
 	template <class T>
 	struct IndexSet
 	{
-		struct LessThanByIndex
-		{
-			// Const to fix VS compilation bug
-			bool operator()(const T& a, const T& b) const
-			{ return a.mIndex < b.mIndex; }
-		};
-		typedef std::set< T,LessThanByIndex > Type;
+		typedef EventStore<T, InsertionOrder, true> Type;
 	};
 
-	///  Multiset that orders data by order by timestamp, multi-entries allowed
+	/// Store that orders data by timestamp, multi-entries allowed
 	template <class T>
 	struct TimeMultiSet
 	{
-		struct LessThanByTime
-		{
-			bool operator()(const T& a, const T& b) const
-			{ return a.mValue.GetTime() < b.mValue.GetTime(); }
-		};
-
-		typedef std::multiset<T, LessThanByTime > Type;
+		typedef EventStore<T, TimeOrder> Type;
 	};
 
 	/** Sorts events by the order in which they are inserted.
@@ -71,19 +61,11 @@ namespace apl { namespace dnp {
 		typedef std::multiset<T, InsertionOrder > Type;
 	};
 
-	/** Sorts events by the order in which they are inserted.
-		The last event value has been hijacked here for use with VTO.
-	*/
+	/// Store that orders data by the order in which they are inserted
 	template <class T>
 	struct InsertionOrderSet2
 	{
-		struct InsertionOrder
-		{
-			bool operator()(const T& a, const T& b) const
-			{ return a.mSequence < b.mSequence; }
-		};
-
-		typedef std::set<T, InsertionOrder > Type;
+		typedef EventStore<T, InsertionOrder> Type;
 	};
 
 
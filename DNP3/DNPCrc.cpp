@@ -18,20 +18,45 @@
 // 
 
 #include "DNPCrc.h"
-#include <APL/CRC.h>
+#include "LinkLayerConstants.h"
 
+#include <APL/CRC.h>
 #include <APL/PackingUnpacking.h>
 
 namespace apl { namespace dnp {
 
-	unsigned int DNPCrc::mpCrcTable[256];
+	uint_16_t DNPCrc::mCrcTable[8][256];
 	
 	//initialize the table
 	bool DNPCrc::mIsInitialized = DNPCrc::InitCrcTable();
 
 	unsigned int DNPCrc::CalcCrc(const byte_t* aInput, size_t aLength)
 	{
-		return CRC::CalcCRC(aInput, aLength, mpCrcTable, 0x0000, true);
+		unsigned int crc = 0;
+
+		// the crc is only 16 bits wide, so it only folds into the first two bytes of each slice
+		while(aLength >= 8)
+		{
+			crc = mCrcTable[7][(aInput[0] ^ crc) & 0xFF] ^
+				mCrcTable[6][aInput[1] ^ (crc >> 8)] ^
+				mCrcTable[5][aInput[2]] ^
+				mCrcTable[4][aInput[3]] ^
+				mCrcTable[3][aInput[4]] ^
+				mCrcTable[2][aInput[5]] ^
+				mCrcTable[1][aInput[6]] ^
+				mCrcTable[0][aInput[7]];
+			aInput += 8;
+			aLength -= 8;
+		}
+
+		while(aLength > 0)
+		{
+			crc = mCrcTable[0][(crc ^ *aInput) & 0xFF] ^ (crc >> 8);
+			++aInput;
+			--aLength;
+		}
+
+		return (~crc) & 0xFFFF;
 	}
 
 	void DNPCrc::AddCrc(byte_t* aInput, size_t aLength)
@@ -47,9 +72,36 @@ namespace apl { namespace dnp {
 		return CalcCrc(aInput, aLength) == UInt16LE::Read(aInput+aLength);
 	}
 
+	bool DNPCrc::IsCorrectBodyCRC(const apl::byte_t* apBody, size_t aLength)
+	{
+		while(aLength > 0)
+		{
+			size_t num = (aLength < LS_DATA_BLOCK_SIZE) ? aLength : LS_DATA_BLOCK_SIZE;
+			if(!IsCorrectCRC(apBody, num)) return false;
+			apBody += num + LS_CRC_SIZE;
+			aLength -= num;
+		}
+
+		return true;
+	}
+
 	bool DNPCrc::InitCrcTable()
 	{
-		CRC::PrecomputeCRC(mpCrcTable, 0xA6BC);
+		unsigned int table[256];
+		CRC::PrecomputeCRC(table, 0xA6BC);
+
+		for(size_t i = 0; i < 256; ++i) mCrcTable[0][i] = static_cast<uint_16_t>(table[i]);
+
+		// mCrcTable[k][i] is the effect of byte i followed by k zero bytes
+		for(size_t k = 1; k < 8; ++k)
+		{
+			for(size_t i = 0; i < 256; ++i)
+			{
+				uint_16_t prev = mCrcTable[k-1][i];
+				mCrcTable[k][i] = mCrcTable[0][prev & 0xFF] ^ (prev >> 8);
+			}
+		}
+
 		return true;
 	}
 
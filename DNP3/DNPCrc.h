@@ -24,6 +24,11 @@
 
 namespace apl { namespace dnp {
 
+	/** Computes and checks the CRC-16 used by the DNP3 link layer.
+
+		Uses a slicing-by-8 table lookup that folds eight input bytes per iteration. A full
+		16 byte data block is two iterations and a link header is exactly one.
+	*/
 	class DNPCrc
 	{
 		public:
@@ -34,13 +39,20 @@ namespace apl { namespace dnp {
 
 			static bool IsCorrectCRC(const apl::byte_t* aInput, size_t aLength);
 
+			/** Validates every CRC in the body of a FT3 frame in a single pass
+				@param apBody Pointer to the first data block, immediately following the header
+				@param aLength Number of user data bytes in the frame, excluding the block CRCs
+				@return true if the CRC of every block is correct
+			*/
+			static bool IsCorrectBodyCRC(const apl::byte_t* apBody, size_t aLength);
+
 		private:
 
 			static bool mIsInitialized;
 
 			static bool InitCrcTable();
 
-			static unsigned int mpCrcTable[256]; //Precomputed CRC lookup table
+			static apl::uint_16_t mCrcTable[8][256]; //Precomputed slicing tables, mCrcTable[0] is the classic byte table
 
 	};
 
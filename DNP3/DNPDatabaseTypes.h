@@ -23,6 +23,7 @@
 
 #include <APL/Types.h>
 #include <APL/DataTypes.h>
+#include <APL/PackedDataTypes.h>
 
 #include "PointClass.h"
 
@@ -46,11 +47,12 @@ struct PointInfoBase
 
 	PointInfoBase() : mClass(PC_CLASS_0) {}
 
-	T mValue;						/// current measurement (i.e. Binary, Analog, etc)
+	typedef T MeasType;
+	typedef typename PackedTypeOf<T>::Type StoredType;
+
+	StoredType mValue;				/// current measurement (i.e. Binary, Analog, etc) stored without a vtable
 	PointClass mClass;				/// class of the point (PC_CLASS<0-3>)
 	size_t mIndex;					/// index of the measurement
-
-	typedef T MeasType;
 };
 
 /**
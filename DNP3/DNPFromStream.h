@@ -69,6 +69,10 @@ namespace apl { namespace dnp {
 
 			template <typename T>
 			static typename T::DataType ReadQVT(const apl::byte_t* apPos, const T* apObj);
+
+			/// Applies one of the conversion functions above to aNum consecutive objects
+			template <typename T, typename T::DataType (*Read)(const apl::byte_t*, const T*)>
+			static void ReadRange(const apl::byte_t* apPos, size_t aNum, typename T::DataType* apOut, const T* apObj);
 	};
 
 	template <typename T, typename PayloadType, apl::SetpointEncodingType EncodingType>
@@ -140,6 +144,14 @@ namespace apl { namespace dnp {
 		ret.SetTime((TimeStamp_t)apObj->mTime.Get(apPos));
 		return ret;
 	}
+
+	template <typename T, typename T::DataType (*Read)(const apl::byte_t*, const T*)>
+	inline void DNPFromStream::ReadRange(const apl::byte_t* apPos, size_t aNum, typename T::DataType* apOut, const T* apObj)
+	{
+		// qualified so the object size is a constant and the loop has no virtual calls
+		const size_t size = apObj->T::GetSize();
+		for(size_t i = 0; i < aNum; ++i, apPos += size) apOut[i] = Read(apPos, apObj);
+	}
 }}
 
 #ifdef APL_PLATFORM_WIN
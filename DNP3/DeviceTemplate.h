@@ -66,10 +66,9 @@ struct DeviceTemplate
 	template <class T>
 	static void InitObserver(IDataObserver* apObs, size_t aNum)
 	{
-		for(size_t i=0; i<aNum; ++i) {
-			T val;
-			apObs->Update(val, i);
-		}
+		if(aNum == 0) return;
+		std::vector<T> values(aNum);
+		apObs->Update(&values[0], aNum, 0);
 	}
 
 	/// Helper function for setting up default names
@@ -0,0 +1,301 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __EVENT_STORE_H_
+#define __EVENT_STORE_H_
+
+
+#include "ClassCounter.h"
+#include "PointClass.h"
+
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <assert.h>
+
+namespace apl { namespace dnp {
+
+	/// Orders events by the sequence in which they were added to the buffer
+	struct InsertionOrder
+	{
+		template <class T>
+		static bool Before(const T& a, const T& b)
+		{ return a.mSequence < b.mSequence; }
+	};
+
+	/// Orders events by timestamp, events with the same timestamp keep insertion order
+	struct TimeOrder
+	{
+		template <class T>
+		static bool Before(const T& a, const T& b)
+		{ return a.mValue.GetTime() < b.mValue.GetTime(); }
+	};
+
+	/** Preallocated event storage used by the AsyncEventBuffers.
+
+		Events live in a slab of slots that are threaded onto one intrusive, ordered list
+		per point class. A free list recycles slots, so once the slab is reserved Insert,
+		Select and Restore do not touch the heap. Events normally arrive in order, so
+		Insert searches for its position from the back of a list and Restore (deselected
+		events going back in) searches from the front, both of which are O(1) in practice.
+
+		If UniqueIndex is true the store also keeps an index->slot table so the single
+		event per point buffers can find the existing event for a point in O(1), and each
+		selection is sorted by index so responses group points by index.
+	*/
+	template <class EventType, class OrderType, bool UniqueIndex = false>
+	class EventStore
+	{
+		public:
+
+		static const size_t NPOS = static_cast<size_t>(-1);
+
+		EventStore() : mSize(0), mFree(NPOS)
+		{
+			for(size_t i = 0; i < NUM_LISTS; ++i) mHead[i] = mTail[i] = NPOS;
+		}
+
+		/// Grows the slab so that it can hold at least aNumEvents without allocating
+		void Reserve(size_t aNumEvents)
+		{
+			size_t num = mSlots.size();
+			if(aNumEvents <= num) return;
+
+			mSlots.resize(aNumEvents);
+			for(size_t i = aNumEvents; i > num; --i) {
+				mSlots[i-1].mNext = mFree;
+				mFree = i-1;
+			}
+		}
+
+		size_t Size() const { return mSize; }
+
+		/// Adds a new event, searching for its position from the back
+		void Insert(const EventType& arEvent)
+		{
+			size_t list = ListFor(arEvent.mClass);
+			size_t slot = this->Acquire(arEvent);
+
+			size_t prev = mTail[list];
+			while(prev != NPOS && Precedes(arEvent, mSlots[prev].mEvent)) prev = mSlots[prev].mPrev;
+			this->LinkAfter(list, prev, slot);
+		}
+
+		/// Returns a deselected event, searching for its position from the front
+		void Restore(const EventType& arEvent)
+		{
+			size_t list = ListFor(arEvent.mClass);
+			size_t slot = this->Acquire(arEvent);
+
+			size_t next = mHead[list];
+			while(next != NPOS && Precedes(mSlots[next].mEvent, arEvent)) next = mSlots[next].mNext;
+			this->LinkAfter(list, (next == NPOS) ? mTail[list] : mSlots[next].mPrev, slot);
+		}
+
+		/// @return slot holding the event for aIndex, or NPOS. Only valid for UniqueIndex stores
+		size_t Find(size_t aIndex) const
+		{
+			return (aIndex < mIndexTable.size()) ? mIndexTable[aIndex] : NPOS;
+		}
+
+		const EventType& Get(size_t aSlot) const { return mSlots[aSlot].mEvent; }
+
+		/// Overwrites the event in aSlot in place, keeping its position in the buffer
+		void Replace(size_t aSlot, const EventType& arEvent)
+		{
+			size_t sequence = mSlots[aSlot].mEvent.mSequence;
+
+			if(mSlots[aSlot].mEvent.mClass == arEvent.mClass) {
+				mSlots[aSlot].mEvent = arEvent;
+				mSlots[aSlot].mEvent.mSequence = sequence;
+			}
+			else {
+				this->Erase(aSlot);
+				EventType evt(arEvent);
+				evt.mSequence = sequence;
+				this->Insert(evt);
+			}
+		}
+
+		/// Removes the first event across all classes
+		/// @return the class of the removed event
+		PointClass EraseFirst()
+		{
+			size_t first = NPOS;
+			for(size_t i = 0; i < NUM_LISTS; ++i) {
+				size_t slot = mHead[i];
+				if(slot != NPOS && (first == NPOS || Precedes(mSlots[slot].mEvent, mSlots[first].mEvent))) first = slot;
+			}
+			assert(first != NPOS);
+			PointClass pc = mSlots[first].mEvent.mClass;
+			this->Erase(first);
+			return pc;
+		}
+
+		/// Removes the last event across all classes
+		/// @return the class of the removed event
+		PointClass EraseLast()
+		{
+			size_t last = NPOS;
+			for(size_t i = 0; i < NUM_LISTS; ++i) {
+				size_t slot = mTail[i];
+				if(slot != NPOS && (last == NPOS || Precedes(mSlots[last].mEvent, mSlots[slot].mEvent))) last = slot;
+			}
+			assert(last != NPOS);
+			PointClass pc = mSlots[last].mEvent.mClass;
+			this->Erase(last);
+			return pc;
+		}
+
+		/**
+			Moves events matching aClass into arSelected, merging the class lists in order
+
+			@return Number of events selected
+		*/
+		size_t Select(PointClass aClass, size_t aMaxEvent, ClassCounter& arCounter, std::vector<EventType>& arSelected)
+		{
+			size_t start = arSelected.size();
+			size_t count = 0;
+
+			while(count < aMaxEvent)
+			{
+				size_t first = NPOS;
+				for(size_t i = 0; i < NUM_LISTS; ++i) {
+					size_t slot = mHead[i];
+					if(slot == NPOS || (mSlots[slot].mEvent.mClass & aClass) == 0) continue;
+					if(first == NPOS || Precedes(mSlots[slot].mEvent, mSlots[first].mEvent)) first = slot;
+				}
+
+				if(first == NPOS) break;
+
+				arCounter.DecrCount(mSlots[first].mEvent.mClass);
+				arSelected.push_back(mSlots[first].mEvent);
+				arSelected.back().mWritten = false;
+				this->Erase(first);
+				++count;
+			}
+
+			if(UniqueIndex) std::sort(arSelected.begin() + start, arSelected.end(), LessThanByIndex());
+
+			return count;
+		}
+
+		private:
+
+		enum { NUM_LISTS = 4 };
+
+		struct Slot
+		{
+			Slot() : mPrev(NPOS), mNext(NPOS) {}
+
+			EventType mEvent;
+			size_t mPrev;	/// previous slot in the class list
+			size_t mNext;	/// next slot in the class list, or in the free list
+		};
+
+		struct LessThanByIndex
+		{
+			bool operator()(const EventType& a, const EventType& b) const
+			{ return a.mIndex < b.mIndex; }
+		};
+
+		/// strict ordering used everywhere, ties in OrderType are broken by insertion sequence
+		static bool Precedes(const EventType& a, const EventType& b)
+		{
+			if(OrderType::Before(a, b)) return true;
+			if(OrderType::Before(b, a)) return false;
+			return a.mSequence < b.mSequence;
+		}
+
+		static size_t ListFor(PointClass aClass)
+		{
+			switch(aClass)
+			{
+				case(PC_CLASS_1): return 1;
+				case(PC_CLASS_2): return 2;
+				case(PC_CLASS_3): return 3;
+				default: return 0;
+			}
+		}
+
+		size_t Acquire(const EventType& arEvent)
+		{
+			// only happens if deselected events push the store past its reserved size
+			if(mFree == NPOS) this->Reserve(mSlots.empty() ? 1 : 2*mSlots.size());
+
+			size_t slot = mFree;
+			mFree = mSlots[slot].mNext;
+			mSlots[slot].mEvent = arEvent;
+			++mSize;
+
+			if(UniqueIndex) {
+				if(arEvent.mIndex >= mIndexTable.size()) mIndexTable.resize(arEvent.mIndex + 1, NPOS);
+				mIndexTable[arEvent.mIndex] = slot;
+			}
+
+			return slot;
+		}
+
+		/// links aSlot into aList after aPrev, or at the head if aPrev == NPOS
+		void LinkAfter(size_t aList, size_t aPrev, size_t aSlot)
+		{
+			size_t next = (aPrev == NPOS) ? mHead[aList] : mSlots[aPrev].mNext;
+
+			mSlots[aSlot].mPrev = aPrev;
+			mSlots[aSlot].mNext = next;
+
+			if(aPrev == NPOS) mHead[aList] = aSlot;
+			else mSlots[aPrev].mNext = aSlot;
+
+			if(next == NPOS) mTail[aList] = aSlot;
+			else mSlots[next].mPrev = aSlot;
+		}
+
+		void Erase(size_t aSlot)
+		{
+			size_t list = ListFor(mSlots[aSlot].mEvent.mClass);
+			size_t prev = mSlots[aSlot].mPrev;
+			size_t next = mSlots[aSlot].mNext;
+
+			if(prev == NPOS) mHead[list] = next;
+			else mSlots[prev].mNext = next;
+
+			if(next == NPOS) mTail[list] = prev;
+			else mSlots[next].mPrev = prev;
+
+			if(UniqueIndex) mIndexTable[mSlots[aSlot].mEvent.mIndex] = NPOS;
+
+			mSlots[aSlot].mNext = mFree;
+			mFree = aSlot;
+			--mSize;
+		}
+
+		std::vector<Slot> mSlots;			/// the slab, grows only when Reserve()'d
+		std::vector<size_t> mIndexTable;	/// point index -> slot, only used when UniqueIndex is true
+		size_t mHead[NUM_LISTS];			/// first slot of each class list
+		size_t mTail[NUM_LISTS];			/// last slot of each class list
+		size_t mSize;
+		size_t mFree;						/// head of the free slot list
+	};
+
+	template <class EventType, class OrderType, bool UniqueIndex>
+	const size_t EventStore<EventType, OrderType, UniqueIndex>::NPOS;
+
+}} //end NS
+
+#endif
@@ -0,0 +1,128 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __LINK_ADDRESS_TABLE_H_
+#define __LINK_ADDRESS_TABLE_H_
+
+#include <APL/Types.h>
+
+#include <vector>
+#include <algorithm>
+#include <stddef.h>
+
+namespace apl { namespace dnp {
+
+	class ILinkContext;
+
+	/** Direct lookup table from DNP address to an object bound to that address. The router
+		uses it to demultiplex received frames to link contexts without a search.
+
+		The 64K address space is split into 256 pages of 256 addresses. A page is only
+		allocated once an address in it is bound, so a port with a handful of addresses
+		costs a few KB while every lookup is still two array indexes.
+	*/
+	template <class T>
+	class AddressTable
+	{
+		public:
+
+		/// Table slot for a single address
+		struct Entry
+		{
+			Entry() : mpContext(NULL), mNumRx(0) {}
+
+			T* mpContext;
+			size_t mNumRx;	/// frames received for this address since it was bound
+		};
+
+		AddressTable() : mPages(NUM_PAGES, static_cast<Entry*>(NULL)) {}
+
+		~AddressTable()
+		{
+			for(size_t i = 0; i < NUM_PAGES; ++i) delete[] mPages[i];
+		}
+
+		/// @return the entry for aAddress, or NULL if no context is bound to it
+		Entry* Find(uint_16_t aAddress) const
+		{
+			Entry* pPage = mPages[aAddress >> PAGE_BITS];
+			if(pPage == NULL) return NULL;
+			Entry* pEntry = pPage + (aAddress & PAGE_MASK);
+			return (pEntry->mpContext == NULL) ? NULL : pEntry;
+		}
+
+		/// Binds a context to an unused address and resets its counters
+		void Bind(uint_16_t aAddress, T* apContext)
+		{
+			Entry*& pPage = mPages[aAddress >> PAGE_BITS];
+			if(pPage == NULL) pPage = new Entry[PAGE_SIZE];
+			Entry& e = pPage[aAddress & PAGE_MASK];
+			e.mpContext = apContext;
+			e.mNumRx = 0;
+			mAddresses.push_back(aAddress);
+		}
+
+		/// @return the context that was bound to aAddress, or NULL
+		T* Unbind(uint_16_t aAddress)
+		{
+			Entry* pEntry = this->Find(aAddress);
+			if(pEntry == NULL) return NULL;
+			T* pContext = pEntry->mpContext;
+			pEntry->mpContext = NULL;
+			mAddresses.erase(std::find(mAddresses.begin(), mAddresses.end(), aAddress));
+			return pContext;
+		}
+
+		/// @return the address apContext is bound to through arAddress, or false if it isn't bound
+		bool FindAddress(const T* apContext, uint_16_t& arAddress) const
+		{
+			for(size_t i = 0; i < mAddresses.size(); ++i) {
+				if(this->Find(mAddresses[i])->mpContext == apContext) {
+					arAddress = mAddresses[i];
+					return true;
+				}
+			}
+			return false;
+		}
+
+		/// Bound addresses in the order they were bound
+		const std::vector<uint_16_t>& Addresses() const { return mAddresses; }
+
+		size_t Size() const { return mAddresses.size(); }
+
+		private:
+
+		enum {
+			PAGE_BITS = 8,
+			PAGE_SIZE = 1 << PAGE_BITS,
+			PAGE_MASK = PAGE_SIZE - 1,
+			NUM_PAGES = (1 << 16) >> PAGE_BITS
+		};
+
+		AddressTable(const AddressTable&);
+		AddressTable& operator=(const AddressTable&);
+
+		std::vector<Entry*> mPages;			/// NUM_PAGES pointers, NULL until a page is used
+		std::vector<uint_16_t> mAddresses;	/// bound addresses, used to iterate over the contexts
+	};
+
+	typedef AddressTable<ILinkContext> LinkAddressTable;
+
+}}
+
+#endif
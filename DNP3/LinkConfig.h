@@ -41,7 +41,10 @@ struct LinkConfig
 	NumRetry(aNumRetry),
 	LocalAddr(aLocalAddr),
 	RemoteAddr(aRemoteAddr),
-	Timeout(aTimeout)
+	Timeout(aTimeout),
+	AdaptiveTimeout(false),
+	MinTimeout(50),
+	MaxTimeout(10000)
 	{}
 
 	LinkConfig(
@@ -53,7 +56,10 @@ struct LinkConfig
 	NumRetry(0),
 	LocalAddr(aIsMaster ? 1 : 1024),
 	RemoteAddr(aIsMaster ? 1024 : 1),
-	Timeout(1000)
+	Timeout(1000),
+	AdaptiveTimeout(false),
+	MinTimeout(50),
+	MaxTimeout(10000)
 	{}
 
 	/// The master/slave bit set on all messages
@@ -71,9 +77,16 @@ struct LinkConfig
 	/// dnp3 address of the remote device
 	uint_16_t RemoteAddr;
 
-	/// the response timeout in milliseconds for confirmed requests
+	/// the response timeout in milliseconds for confirmed requests, the initial timeout if AdaptiveTimeout is set
 	millis_t Timeout;
 
+	/// if true, the timeout follows the measured round trip time of confirmed frames, see RttEstimator
+	bool AdaptiveTimeout;
+
+	/// bounds of the adaptive timeout in milliseconds
+	millis_t MinTimeout;
+	millis_t MaxTimeout;
+
 	private:
 
 	LinkConfig() {}
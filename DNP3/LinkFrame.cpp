@@ -87,11 +87,7 @@ bool LinkFrame::ValidateBodyCRC() const
 
 bool LinkFrame::ValidateBodyCRC(const byte_t* apBody, size_t aLength)
 {
-	if(aLength == 0) return true;	//base case of recursion
-	size_t max = LS_DATA_BLOCK_SIZE ;
-	size_t num = (aLength <= max) ? aLength : max;
-	if(!DNPCrc::IsCorrectCRC(apBody,num)) return false;
-	else return ValidateBodyCRC(apBody+num+2, aLength-num); //tail recursive
+	return DNPCrc::IsCorrectBodyCRC(apBody, aLength);
 }
 
 size_t LinkFrame::CalcFrameSize(size_t aDataLength)
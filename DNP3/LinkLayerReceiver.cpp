@@ -109,7 +109,7 @@ bool LinkLayerReceiver::ReadHeader()
 bool LinkLayerReceiver::ValidateBody()
 {
 	size_t len = mHeader.GetLength() - LS_MIN_LENGTH;
-	if(LinkFrame::ValidateBodyCRC(mBuffer.ReadBuff()+LS_HEADER_SIZE, len)) return true;
+	if(DNPCrc::IsCorrectBodyCRC(mBuffer.ReadBuff()+LS_HEADER_SIZE, len)) return true;
 	else
 	{
 		mCrcFailures.Increment();
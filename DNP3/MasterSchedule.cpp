@@ -33,23 +33,26 @@ MasterSchedule::MasterSchedule(AsyncTaskGroup* apGroup) : mpGroup(apGroup)
 
 void MasterSchedule::EnableOnlineTasks()
 {
-	mpGroup->Enable(ONLINE_ONLY_TASKS);
+	mpGroup->Enable(mTasks, ONLINE_ONLY_TASKS);
 }
 
 void MasterSchedule::DisableOnlineTasks()
 {
-	mpGroup->Disable(ONLINE_ONLY_TASKS);
+	mpGroup->Disable(mTasks, ONLINE_ONLY_TASKS);
 }
 
 void MasterSchedule::ResetStartupTasks()
 {
-	mpGroup->ResetTasks(START_UP_TASKS);
+	mpGroup->ResetTasks(mTasks, START_UP_TASKS);
 }
 
 MasterSchedule MasterSchedule::GetSchedule(MasterConfig aCfg, AsyncMaster* apMaster, AsyncTaskGroup* apGroup)
 {
+	MasterSchedule schedule(apGroup);
+
 	AsyncTaskBase* pIntegrity = apGroup->Add(aCfg.IntegrityRate, aCfg.TaskRetryRate, AMP_POLL, bind(&AsyncMaster::IntegrityPoll, apMaster, _1), "Integrity Poll");	
 	pIntegrity->SetFlags(ONLINE_ONLY_TASKS | START_UP_TASKS);
+	schedule.mTasks.push_back(pIntegrity);
 
 	if(aCfg.DoUnsolOnStartup)
 	{
@@ -58,6 +61,7 @@ MasterSchedule MasterSchedule::GetSchedule(MasterConfig aCfg, AsyncMaster* apMas
 		AsyncTaskBase* pUnsolDisable = apGroup->Add(-1, aCfg.TaskRetryRate, AMP_UNSOL_CHANGE, handler, "Unsol Disable");
 		pUnsolDisable->SetFlags(ONLINE_ONLY_TASKS | START_UP_TASKS);
 		pIntegrity->AddDependency(pUnsolDisable);
+		schedule.mTasks.push_back(pUnsolDisable);
 
 		if(aCfg.EnableUnsol)
 		{
@@ -65,6 +69,7 @@ MasterSchedule MasterSchedule::GetSchedule(MasterConfig aCfg, AsyncMaster* apMas
 			AsyncTaskBase* pUnsolEnable = apGroup->Add(-1, aCfg.TaskRetryRate, AMP_UNSOL_CHANGE, handler, "Unsol Enable");
 			pUnsolEnable->SetFlags(ONLINE_ONLY_TASKS | START_UP_TASKS);
 			pUnsolEnable->AddDependency(pIntegrity);			
+			schedule.mTasks.push_back(pUnsolEnable);
 		}
 	}
 
@@ -74,10 +79,9 @@ MasterSchedule MasterSchedule::GetSchedule(MasterConfig aCfg, AsyncMaster* apMas
 		AsyncTaskBase* pEventScan = apGroup->Add(e.ScanRate, aCfg.TaskRetryRate, AMP_POLL, bind(&AsyncMaster::EventPoll, apMaster, _1, e.ClassMask), "Event Scan");
 		pEventScan->SetFlags(ONLINE_ONLY_TASKS);
 		pEventScan->AddDependency(pIntegrity);
+		schedule.mTasks.push_back(pEventScan);
 	}
 
-	MasterSchedule schedule(apGroup);
-
 	// Tasks are executed when the master is is idle
 	schedule.mpCommandTask = apGroup->AddContinuous(AMP_COMMAND, boost::bind(&AsyncMaster::ProcessCommand, apMaster, _1), "Command");
 	schedule.mpTimeTask = apGroup->AddContinuous(AMP_TIME_SYNC, boost::bind(&AsyncMaster::SyncTime, apMaster, _1), "TimeSync");	
@@ -86,6 +90,10 @@ MasterSchedule MasterSchedule::GetSchedule(MasterConfig aCfg, AsyncMaster* apMas
 	schedule.mpTimeTask->SetFlags(ONLINE_ONLY_TASKS);
 	schedule.mpClearRestartTask->SetFlags(ONLINE_ONLY_TASKS);
 
+	schedule.mTasks.push_back(schedule.mpCommandTask);
+	schedule.mTasks.push_back(schedule.mpTimeTask);
+	schedule.mTasks.push_back(schedule.mpClearRestartTask);
+
 	return schedule;
 }
 
@@ -22,6 +22,8 @@
 
 #include "MasterConfig.h"
 
+#include <vector>
+
 namespace apl { 
 	class AsyncTaskGroup;
 	class AsyncTaskBase;
@@ -33,6 +35,8 @@ class AsyncMaster;
 
 /// Create all the tasks required for the master from the
 /// TaskGroup. Defines the types and the dependencies between them.
+/// Other masters may share the group, so the schedule only ever
+/// enables, disables or resets the tasks it created itself.
 class MasterSchedule
 {
 	public:
@@ -58,6 +62,7 @@ class MasterSchedule
 	MasterSchedule(AsyncTaskGroup*);
 	
 	AsyncTaskGroup* mpGroup;
+	std::vector<AsyncTaskBase*> mTasks;	/// every task of this master
 
 	enum AsyncMasterPriority
 	{
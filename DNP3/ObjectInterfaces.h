@@ -20,6 +20,8 @@
 #define __OBJECT_INTERFACES_H_
 
 #include <APL/Types.h>
+#include <APL/PackedDataTypes.h>
+#include <APL/PackingUnpacking.h>
 
 #include <assert.h>
 #include <stddef.h>
@@ -95,12 +97,31 @@ namespace apl { namespace dnp {
 	class StreamObject : public FixedObject
 	{
 		public:
+			typedef typename apl::PackedTypeOf<T>::Type PackedType;
+
 			virtual void Write(apl::byte_t*, const T&) const = 0;
 			virtual T Read(const apl::byte_t*) const = 0;
+
+			/// Reads aNum consecutive objects starting at apPos, measurement objects implement this
+			/// with a loop specialized for their layout
+			virtual void ReadRange(const apl::byte_t* apPos, size_t aNum, T* apOut) const = 0;
+
+			/// Writes the packed form of a measurement, measurement objects override this to skip the conversion
+			virtual void WritePacked(apl::byte_t* apPos, const PackedType& arValue) const
+			{ this->Write(apPos, arValue); }
 			
 			virtual bool HasQuality() const { return false; }
 
 			typedef T DataType;
+
+		protected:
+
+			/// ReadRange for objects that don't have a specialized loop
+			void ReadEach(const apl::byte_t* apPos, size_t aNum, T* apOut) const
+			{
+				size_t size = this->GetSize();
+				for(size_t i = 0; i < aNum; ++i, apPos += size) apOut[i] = this->Read(apPos);
+			}
 	};
 
 	template <class T>
@@ -154,6 +175,14 @@ namespace apl { namespace dnp {
 				if (aValue) *apPos |= bit_mask;
 				else *apPos &= ~bit_mask;
 			}
+
+			/// Expands aNum bits starting at apPos into apValues, one 0/1 byte per value
+			static void ReadRange(const apl::byte_t* apPos, size_t aNum, apl::byte_t* apValues)
+			{ PackedBits::Unpack(apPos, aNum, apValues); }
+
+			/// Packs aNum values (non-zero is set) into the bitfield at apPos
+			static void WriteRange(apl::byte_t* apPos, const apl::byte_t* apValues, size_t aNum)
+			{ PackedBits::Pack(apValues, aNum, apPos); }
 	};
 
 	class VariableByVariationObject : public IndexedObject
@@ -46,6 +46,9 @@ namespace apl { namespace dnp {
 		const ObjectWriteIterator operator++(int);
 		bool IsEnd() const { return mIndex > mStop; };
 
+		/// Number of objects that fit in the fragment, only meaningful when !IsEnd()
+		size_t Count() const { return mStop - mStart + 1; }
+
 		apl::byte_t* operator*() const;
 
 		private:
@@ -27,6 +27,10 @@
 
 #define MACRO_STATIC_INSTANCE(group, var) Group##group##Var##var Group##group##Var##var::mInstance;
 
+#define MACRO_READ_RANGE(group, var, func) \
+	void Group##group##Var##var::ReadRange(const apl::byte_t* apPos, size_t aNum, DataType* apOut) const \
+	{ DNPFromStream::ReadRange<Group##group##Var##var, &DNPFromStream::func<Group##group##Var##var> >(apPos, aNum, apOut, this); }
+
 namespace apl { namespace dnp {
 
 	MACRO_STATIC_INSTANCE(1,0)
@@ -162,14 +166,22 @@ namespace apl { namespace dnp {
 	//////////////////////////////////////////////
 
 	void Group1Var2::Write(apl::byte_t* p, const apl::Binary& v) const { DNPToStream::WriteQ(p, Group1Var2::Inst(), v); }
+	void Group1Var2::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Binary>& v) const { DNPToStream::WriteQ(p, Group1Var2::Inst(), v); }
 	void Group2Var1::Write(apl::byte_t* p, const apl::Binary& v) const { DNPToStream::WriteQ(p, Group2Var1::Inst(), v); }
+	void Group2Var1::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Binary>& v) const { DNPToStream::WriteQ(p, Group2Var1::Inst(), v); }
 	void Group2Var2::Write(apl::byte_t* p, const apl::Binary& v) const { DNPToStream::WriteQT(p, Group2Var2::Inst(), v); }
+	void Group2Var2::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Binary>& v) const { DNPToStream::WriteQT(p, Group2Var2::Inst(), v); }
 	void Group2Var3::Write(apl::byte_t* p, const apl::Binary& v) const { DNPToStream::WriteQT(p, Group2Var3::Inst(), v); }
+	void Group2Var3::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Binary>& v) const { DNPToStream::WriteQT(p, Group2Var3::Inst(), v); }
 
 	Binary Group1Var2::Read(const apl::byte_t* p) const { return DNPFromStream::ReadBinaryQV(p, Group1Var2::Inst()); }
+	MACRO_READ_RANGE(1, 2, ReadBinaryQV)
 	Binary Group2Var1::Read(const apl::byte_t* p) const { return DNPFromStream::ReadBinaryQV(p, Group2Var1::Inst()); }
+	MACRO_READ_RANGE(2, 1, ReadBinaryQV)
 	Binary Group2Var2::Read(const apl::byte_t* p) const { return DNPFromStream::ReadBinaryQV(p, Group2Var2::Inst()); }
+	MACRO_READ_RANGE(2, 2, ReadBinaryQV)
 	Binary Group2Var3::Read(const apl::byte_t* p) const { return DNPFromStream::ReadBinaryQVT(p, Group2Var3::Inst()); }
+	MACRO_READ_RANGE(2, 3, ReadBinaryQVT)
 	
 	
 	//////////////////////////////////////////////
@@ -177,7 +189,9 @@ namespace apl { namespace dnp {
 	//////////////////////////////////////////////
 
 	ControlStatus Group10Var2::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQ(apPos, Group10Var2::Inst()); }
+	MACRO_READ_RANGE(10, 2, ReadQ)
 	void Group10Var2::Write(apl::byte_t* apPos, const ControlStatus& arObj) const { DNPToStream::WriteQ(apPos, Group10Var2::Inst(), arObj); }
+	void Group10Var2::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::ControlStatus>& arObj) const { DNPToStream::WriteQ(apPos, Group10Var2::Inst(), arObj); }
 
 	//////////////////////////////////////////////
 	//	Binary Output Types
@@ -203,6 +217,8 @@ namespace apl { namespace dnp {
 		return b;
 	}
 
+	void Group12Var1::ReadRange(const apl::byte_t* apPos, size_t aNum, BinaryOutput* apOut) const { this->ReadEach(apPos, aNum, apOut); }
+
 	apl::CopyableBuffer Group12Var1::GetValueBytes(const apl::byte_t* apPos) const
 	{
 		return CopyableBuffer(apPos, 10); //first 10 bytes, everything but the status
@@ -213,90 +229,158 @@ namespace apl { namespace dnp {
 	//////////////////////////////////////////////
 
 	Counter Group20Var1::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group20Var1::Inst()); }
+	MACRO_READ_RANGE(20, 1, ReadQV)
 	Counter Group20Var2::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group20Var2::Inst()); }
+	MACRO_READ_RANGE(20, 2, ReadQV)
 	Counter Group20Var3::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group20Var3::Inst()); }
+	MACRO_READ_RANGE(20, 3, ReadQV)
 	Counter Group20Var4::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group20Var4::Inst()); }
+	MACRO_READ_RANGE(20, 4, ReadQV)
 	Counter Group20Var5::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadV(apPos, Group20Var5::Inst()); }
+	MACRO_READ_RANGE(20, 5, ReadV)
 	Counter Group20Var6::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadV(apPos, Group20Var6::Inst()); }
+	MACRO_READ_RANGE(20, 6, ReadV)
 	Counter Group20Var7::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadV(apPos, Group20Var7::Inst()); }
+	MACRO_READ_RANGE(20, 7, ReadV)
 	Counter Group20Var8::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadV(apPos, Group20Var8::Inst()); }
+	MACRO_READ_RANGE(20, 8, ReadV)
 
 	void Group20Var1::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteQV(apPos, Group20Var1::Inst(), v); }
+	void Group20Var1::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteQV(apPos, Group20Var1::Inst(), v); }
 	void Group20Var2::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteQV(apPos, Group20Var2::Inst(), v); }
+	void Group20Var2::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteQV(apPos, Group20Var2::Inst(), v); }
 	void Group20Var3::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteQV(apPos, Group20Var3::Inst(), v); }
+	void Group20Var3::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteQV(apPos, Group20Var3::Inst(), v); }
 	void Group20Var4::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteQV(apPos, Group20Var4::Inst(), v); }
+	void Group20Var4::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteQV(apPos, Group20Var4::Inst(), v); }
 	void Group20Var5::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteV(apPos, Group20Var5::Inst(), v); }
+	void Group20Var5::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteV(apPos, Group20Var5::Inst(), v); }
 	void Group20Var6::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteV(apPos, Group20Var6::Inst(), v); }
+	void Group20Var6::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteV(apPos, Group20Var6::Inst(), v); }
 	void Group20Var7::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteV(apPos, Group20Var7::Inst(), v); }
+	void Group20Var7::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteV(apPos, Group20Var7::Inst(), v); }
 	void Group20Var8::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteV(apPos, Group20Var8::Inst(), v); }
+	void Group20Var8::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteV(apPos, Group20Var8::Inst(), v); }
 
 	Counter Group22Var1::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group22Var1::Inst()); }
+	MACRO_READ_RANGE(22, 1, ReadQV)
 	Counter Group22Var2::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group22Var2::Inst()); }
+	MACRO_READ_RANGE(22, 2, ReadQV)
 	Counter Group22Var3::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group22Var3::Inst()); }
+	MACRO_READ_RANGE(22, 3, ReadQV)
 	Counter Group22Var4::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group22Var4::Inst()); }
+	MACRO_READ_RANGE(22, 4, ReadQV)
 	Counter Group22Var5::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQVT(apPos, Group22Var5::Inst()); }
+	MACRO_READ_RANGE(22, 5, ReadQVT)
 	Counter Group22Var6::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQVT(apPos, Group22Var6::Inst()); }
+	MACRO_READ_RANGE(22, 6, ReadQVT)
 	Counter Group22Var7::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQVT(apPos, Group22Var7::Inst()); }
+	MACRO_READ_RANGE(22, 7, ReadQVT)
 	Counter Group22Var8::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQVT(apPos, Group22Var8::Inst()); }
+	MACRO_READ_RANGE(22, 8, ReadQVT)
 
 	void Group22Var1::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteQV(apPos, Group22Var1::Inst(), v); }
+	void Group22Var1::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteQV(apPos, Group22Var1::Inst(), v); }
 	void Group22Var2::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteQV(apPos, Group22Var2::Inst(), v); }
+	void Group22Var2::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteQV(apPos, Group22Var2::Inst(), v); }
 	void Group22Var3::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteQV(apPos, Group22Var3::Inst(), v); }
+	void Group22Var3::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteQV(apPos, Group22Var3::Inst(), v); }
 	void Group22Var4::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteQV(apPos, Group22Var4::Inst(), v); }
+	void Group22Var4::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteQV(apPos, Group22Var4::Inst(), v); }
 	void Group22Var5::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteQVT(apPos, Group22Var5::Inst(), v); }
+	void Group22Var5::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteQVT(apPos, Group22Var5::Inst(), v); }
 	void Group22Var6::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteQVT(apPos, Group22Var6::Inst(), v); }
+	void Group22Var6::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteQVT(apPos, Group22Var6::Inst(), v); }
 	void Group22Var7::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteQVT(apPos, Group22Var7::Inst(), v); }
+	void Group22Var7::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteQVT(apPos, Group22Var7::Inst(), v); }
 	void Group22Var8::Write(apl::byte_t* apPos, const apl::Counter& v) const { DNPToStream::WriteQVT(apPos, Group22Var8::Inst(), v); }
+	void Group22Var8::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::Counter>& v) const { DNPToStream::WriteQVT(apPos, Group22Var8::Inst(), v); }
 
 
 	//////////////////////////////////////////////
 	//	Analog Input Types
 	//////////////////////////////////////////////
 	void Group30Var1::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteCheckRangeQV(p, Group30Var1::Inst(), v); }
+	void Group30Var1::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteCheckRangeQV(p, Group30Var1::Inst(), v); }
 	void Group30Var2::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteCheckRangeQV(p, Group30Var2::Inst(), v); }
+	void Group30Var2::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteCheckRangeQV(p, Group30Var2::Inst(), v); }
 	void Group30Var3::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteV(p, Group30Var3::Inst(), v); }
+	void Group30Var3::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteV(p, Group30Var3::Inst(), v); }
 	void Group30Var4::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteV(p, Group30Var4::Inst(), v); }
+	void Group30Var4::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteV(p, Group30Var4::Inst(), v); }
 	void Group30Var5::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteCheckRangeQV(p, Group30Var5::Inst(), v); }
+	void Group30Var5::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteCheckRangeQV(p, Group30Var5::Inst(), v); }
 	void Group30Var6::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteCheckRangeQV(p, Group30Var6::Inst(), v); }
+	void Group30Var6::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteCheckRangeQV(p, Group30Var6::Inst(), v); }
 
 	Analog Group30Var1::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group30Var1::Inst()); }
+	MACRO_READ_RANGE(30, 1, ReadQV)
 	Analog Group30Var2::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group30Var2::Inst()); }
+	MACRO_READ_RANGE(30, 2, ReadQV)
 	Analog Group30Var3::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadV(apPos, Group30Var3::Inst()); }
+	MACRO_READ_RANGE(30, 3, ReadV)
 	Analog Group30Var4::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadV(apPos, Group30Var4::Inst()); }
+	MACRO_READ_RANGE(30, 4, ReadV)
 	Analog Group30Var5::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group30Var5::Inst()); }
+	MACRO_READ_RANGE(30, 5, ReadQV)
 	Analog Group30Var6::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group30Var6::Inst()); }
+	MACRO_READ_RANGE(30, 6, ReadQV)
 
 	void Group32Var1::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteCheckRangeQV(p, Group32Var1::Inst(), v); }
+	void Group32Var1::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteCheckRangeQV(p, Group32Var1::Inst(), v); }
 	void Group32Var2::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteCheckRangeQV(p, Group32Var2::Inst(), v); }
+	void Group32Var2::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteCheckRangeQV(p, Group32Var2::Inst(), v); }
 	void Group32Var3::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteCheckRangeQVT(p, Group32Var3::Inst(), v); }
+	void Group32Var3::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteCheckRangeQVT(p, Group32Var3::Inst(), v); }
 	void Group32Var4::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteCheckRangeQVT(p, Group32Var4::Inst(), v); }
+	void Group32Var4::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteCheckRangeQVT(p, Group32Var4::Inst(), v); }
 	void Group32Var5::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteQV(p, Group32Var5::Inst(), v); }
+	void Group32Var5::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteQV(p, Group32Var5::Inst(), v); }
 	void Group32Var6::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteQV(p, Group32Var6::Inst(), v); }
+	void Group32Var6::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteQV(p, Group32Var6::Inst(), v); }
 	void Group32Var7::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteQVT(p, Group32Var7::Inst(), v); }
+	void Group32Var7::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteQVT(p, Group32Var7::Inst(), v); }
 	void Group32Var8::Write(apl::byte_t* p, const apl::Analog& v) const { DNPToStream::WriteQVT(p, Group32Var8::Inst(), v); }
+	void Group32Var8::WritePacked(apl::byte_t* p, const apl::PackedPoint<apl::Analog>& v) const { DNPToStream::WriteQVT(p, Group32Var8::Inst(), v); }
 
 	Analog Group32Var1::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group32Var1::Inst()); }
+	MACRO_READ_RANGE(32, 1, ReadQV)
 	Analog Group32Var2::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group32Var2::Inst()); }
+	MACRO_READ_RANGE(32, 2, ReadQV)
 	Analog Group32Var3::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQVT(apPos, Group32Var3::Inst()); }
+	MACRO_READ_RANGE(32, 3, ReadQVT)
 	Analog Group32Var4::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQVT(apPos, Group32Var4::Inst()); }
+	MACRO_READ_RANGE(32, 4, ReadQVT)
 	Analog Group32Var5::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group32Var5::Inst()); }
+	MACRO_READ_RANGE(32, 5, ReadQV)
 	Analog Group32Var6::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group32Var6::Inst()); }
+	MACRO_READ_RANGE(32, 6, ReadQV)
 	Analog Group32Var7::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQVT(apPos, Group32Var7::Inst()); }
+	MACRO_READ_RANGE(32, 7, ReadQVT)
 	Analog Group32Var8::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQVT(apPos, Group32Var8::Inst()); }
+	MACRO_READ_RANGE(32, 8, ReadQVT)
 	
 	//////////////////////////////////////////////
 	//	Analog Output Status
 	//////////////////////////////////////////////
 
 	SetpointStatus Group40Var1::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group40Var1::Inst()); }
+	MACRO_READ_RANGE(40, 1, ReadQV)
 	SetpointStatus Group40Var2::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group40Var2::Inst()); }
+	MACRO_READ_RANGE(40, 2, ReadQV)
 	SetpointStatus Group40Var3::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group40Var3::Inst()); }
+	MACRO_READ_RANGE(40, 3, ReadQV)
 	SetpointStatus Group40Var4::Read(const apl::byte_t* apPos) const { return DNPFromStream::ReadQV(apPos, Group40Var4::Inst()); }
+	MACRO_READ_RANGE(40, 4, ReadQV)
 
 	void Group40Var1::Write(apl::byte_t* apPos, const apl::SetpointStatus& arObj) const { DNPToStream::WriteQV(apPos, Group40Var1::Inst(), arObj); }
+	void Group40Var1::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::SetpointStatus>& arObj) const { DNPToStream::WriteQV(apPos, Group40Var1::Inst(), arObj); }
 	void Group40Var2::Write(apl::byte_t* apPos, const apl::SetpointStatus& arObj) const { DNPToStream::WriteQV(apPos, Group40Var2::Inst(), arObj); }
+	void Group40Var2::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::SetpointStatus>& arObj) const { DNPToStream::WriteQV(apPos, Group40Var2::Inst(), arObj); }
 	void Group40Var3::Write(apl::byte_t* apPos, const apl::SetpointStatus& arObj) const { DNPToStream::WriteQV(apPos, Group40Var3::Inst(), arObj); }
+	void Group40Var3::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::SetpointStatus>& arObj) const { DNPToStream::WriteQV(apPos, Group40Var3::Inst(), arObj); }
 	void Group40Var4::Write(apl::byte_t* apPos, const apl::SetpointStatus& arObj) const { DNPToStream::WriteQV(apPos, Group40Var4::Inst(), arObj); }
+	void Group40Var4::WritePacked(apl::byte_t* apPos, const apl::PackedPoint<apl::SetpointStatus>& arObj) const { DNPToStream::WriteQV(apPos, Group40Var4::Inst(), arObj); }
 
 	//////////////////////////////////////////////
 	//	Setpoint Types
@@ -315,6 +399,8 @@ namespace apl { namespace dnp {
 		s.SetEncodingType(SPET_INT32);
 		return s;
 	}
+
+	void Group41Var1::ReadRange(const apl::byte_t* apPos, size_t aNum, Setpoint* apOut) const { this->ReadEach(apPos, aNum, apOut); }
 	
 	apl::CopyableBuffer Group41Var1::GetValueBytes(const apl::byte_t* apBuff) const
 	{
@@ -335,6 +421,8 @@ namespace apl { namespace dnp {
 		return s;
 	}
 
+	void Group41Var2::ReadRange(const apl::byte_t* apPos, size_t aNum, Setpoint* apOut) const { this->ReadEach(apPos, aNum, apOut); }
+
 	apl::CopyableBuffer Group41Var2::GetValueBytes(const apl::byte_t* apBuff) const
 	{
 		return CopyableBuffer(apBuff, 2);
@@ -354,6 +442,8 @@ namespace apl { namespace dnp {
 		return s;
 	}
 
+	void Group41Var3::ReadRange(const apl::byte_t* apPos, size_t aNum, Setpoint* apOut) const { this->ReadEach(apPos, aNum, apOut); }
+
 	apl::CopyableBuffer Group41Var3::GetValueBytes(const apl::byte_t* apBuff) const
 	{
 		return CopyableBuffer(apBuff, 4);
@@ -373,6 +463,8 @@ namespace apl { namespace dnp {
 		return s;
 	}
 
+	void Group41Var4::ReadRange(const apl::byte_t* apPos, size_t aNum, Setpoint* apOut) const { this->ReadEach(apPos, aNum, apOut); }
+
 	apl::CopyableBuffer Group41Var4::GetValueBytes(const apl::byte_t* apBuff) const
 	{
 		return CopyableBuffer(apBuff, 8);
@@ -49,7 +49,12 @@
 
 #define MACRO_DECLARE_STREAM_TYPE(datatype) \
 		void Write(apl::byte_t*, const datatype&) const;\
-		datatype Read(const apl::byte_t*) const;
+		datatype Read(const apl::byte_t*) const;\
+		void ReadRange(const apl::byte_t*, size_t, datatype*) const;
+
+#define MACRO_DECLARE_PACKED_STREAM_TYPE(datatype) \
+		MACRO_DECLARE_STREAM_TYPE(datatype) \
+		void WritePacked(apl::byte_t*, const apl::PackedPoint<datatype>&) const;
 
 #define MACRO_DECLARE_QUALITY(packer, position) \
 		Pack<packer,position> mFlag; \
@@ -100,7 +105,7 @@ namespace apl { namespace dnp {
 		MACRO_NAME_SINGLETON_INSTANCE(Group1Var2)
 		MACRO_GROUP_VAR_SIZE_FUNC(1, 2, 1)
 		MACRO_DECLARE_QUALITY(UInt8,0)
-		MACRO_DECLARE_STREAM_TYPE(Binary)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Binary)
 	};
 
 	struct Group2Var0 : public PlaceHolderObject
@@ -114,7 +119,7 @@ namespace apl { namespace dnp {
 		MACRO_NAME_SINGLETON_INSTANCE(Group2Var1)
 		MACRO_GROUP_VAR_SIZE_FUNC_WITH_EVENTS(2, 1, 1)
 		MACRO_DECLARE_QUALITY(UInt8,0)
-		MACRO_DECLARE_STREAM_TYPE(Binary)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Binary)
 	};
 
 	struct Group2Var2 : public StreamObject<Binary>
@@ -123,7 +128,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC_WITH_EVENTS(2, 2, 7)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_TIME(UInt48LE, 1)
-		MACRO_DECLARE_STREAM_TYPE(Binary)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Binary)
 	};
 
 	struct Group2Var3 : public StreamObject<Binary>
@@ -132,7 +137,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC_WITH_EVENTS(2, 3, 3)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_TIME(UInt16LE, 1)
-		MACRO_DECLARE_STREAM_TYPE(Binary)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Binary)
 
 		bool UseCTO() const { return true; }
 	};
@@ -158,7 +163,7 @@ namespace apl { namespace dnp {
 		MACRO_NAME_SINGLETON_INSTANCE(Group10Var2)
 		MACRO_GROUP_VAR_SIZE_FUNC(10, 2, 1)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
-		MACRO_DECLARE_STREAM_TYPE(ControlStatus);
+		MACRO_DECLARE_PACKED_STREAM_TYPE(ControlStatus);
 	};
 
 	//////////////////////////////////////////////
@@ -214,7 +219,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(20, 1, 5)
 		MACRO_DECLARE_QUALITY(UInt8, 0);
 		MACRO_DECLARE_VALUE(UInt32LE, 1);
-		MACRO_DECLARE_STREAM_TYPE(Counter);
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter);
 
 	};
 
@@ -224,7 +229,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(20, 2, 3)
 		MACRO_DECLARE_QUALITY(UInt8, 0);
 		MACRO_DECLARE_VALUE(UInt16LE, 1);
-		MACRO_DECLARE_STREAM_TYPE(Counter);
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter);
 	};
 
 	struct Group20Var3 : public StreamObject<Counter>
@@ -233,7 +238,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(20, 3, 5)
 		MACRO_DECLARE_QUALITY(UInt8, 0);
 		MACRO_DECLARE_VALUE(UInt32LE, 1);
-		MACRO_DECLARE_STREAM_TYPE(Counter);
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter);
 	};
 
 	struct Group20Var4 : public StreamObject<Counter>
@@ -242,7 +247,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(20, 4, 3)
 		MACRO_DECLARE_QUALITY(UInt8, 0);
 		MACRO_DECLARE_VALUE(UInt16LE, 1);
-		MACRO_DECLARE_STREAM_TYPE(Counter);
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter);
 
 	};
 
@@ -251,7 +256,7 @@ namespace apl { namespace dnp {
 		MACRO_NAME_SINGLETON_INSTANCE(Group20Var5)
 		MACRO_GROUP_VAR_SIZE_FUNC(20, 5, 4)
 		MACRO_DECLARE_VALUE(UInt32LE, 0);
-		MACRO_DECLARE_STREAM_TYPE(Counter);
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter);
 	};
 
 	struct Group20Var6 : public StreamObject<Counter>
@@ -259,7 +264,7 @@ namespace apl { namespace dnp {
 		MACRO_NAME_SINGLETON_INSTANCE(Group20Var6)
 		MACRO_GROUP_VAR_SIZE_FUNC(20, 6, 2)
 		MACRO_DECLARE_VALUE(UInt16LE, 0);
-		MACRO_DECLARE_STREAM_TYPE(Counter);
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter);
 	};
 
 	struct Group20Var7 : public StreamObject<Counter>
@@ -267,7 +272,7 @@ namespace apl { namespace dnp {
 		MACRO_NAME_SINGLETON_INSTANCE(Group20Var7)
 		MACRO_GROUP_VAR_SIZE_FUNC(20, 7, 4)
 		MACRO_DECLARE_VALUE(UInt32LE, 0);
-		MACRO_DECLARE_STREAM_TYPE(Counter);
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter);
 	};
 
 	struct Group20Var8 : public StreamObject<Counter>
@@ -275,7 +280,7 @@ namespace apl { namespace dnp {
 		MACRO_NAME_SINGLETON_INSTANCE(Group20Var8)
 		MACRO_GROUP_VAR_SIZE_FUNC(20, 8, 2)
 		MACRO_DECLARE_VALUE(UInt16LE, 0)
-		MACRO_DECLARE_STREAM_TYPE(Counter)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter)
 	};
 
 	//////////////////////////////////////////////
@@ -401,7 +406,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC_WITH_EVENTS(22, 1, 5)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(UInt32LE, 1)
-		MACRO_DECLARE_STREAM_TYPE(Counter)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter)
 	};
 
 	struct Group22Var2 : public StreamObject<Counter>
@@ -410,7 +415,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC_WITH_EVENTS(22, 2, 3)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(UInt16LE, 1)
-		MACRO_DECLARE_STREAM_TYPE(Counter)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter)
 	};
 
 	struct Group22Var3 : public StreamObject<Counter>
@@ -419,7 +424,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC_WITH_EVENTS(22, 3, 5)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(UInt32LE, 1)
-		MACRO_DECLARE_STREAM_TYPE(Counter)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter)
 	};
 
 	struct Group22Var4 : public StreamObject<Counter>
@@ -428,7 +433,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(22, 4, 3)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(UInt16LE, 1)
-		MACRO_DECLARE_STREAM_TYPE(Counter)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter)
 	};
 
 	struct Group22Var5 : public StreamObject<Counter>
@@ -438,7 +443,7 @@ namespace apl { namespace dnp {
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(UInt32LE, 1)
 		MACRO_DECLARE_TIME(UInt48LE, 5)
-		MACRO_DECLARE_STREAM_TYPE(Counter)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter)
 	};
 
 	struct Group22Var6 : public StreamObject<Counter>
@@ -448,7 +453,7 @@ namespace apl { namespace dnp {
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(UInt16LE, 1)
 		MACRO_DECLARE_TIME(UInt48LE, 3)
-		MACRO_DECLARE_STREAM_TYPE(Counter)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter)
 	};
 
 	struct Group22Var7 : public StreamObject<Counter>
@@ -458,7 +463,7 @@ namespace apl { namespace dnp {
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(UInt32LE, 1)
 		MACRO_DECLARE_TIME(UInt48LE, 5)
-		MACRO_DECLARE_STREAM_TYPE(Counter)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter)
 	};
 
 	struct Group22Var8 : public StreamObject<Counter>
@@ -468,7 +473,7 @@ namespace apl { namespace dnp {
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(UInt16LE, 1)
 		MACRO_DECLARE_TIME(UInt48LE, 3)
-		MACRO_DECLARE_STREAM_TYPE(Counter)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Counter)
 	};
 
 	//////////////////////////////////////////////
@@ -565,7 +570,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(30, 1, 5)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE_OVERRANGE(Int32LE, 1, AQ_OVERRANGE)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	struct Group30Var2 : public StreamObject<Analog>
@@ -574,7 +579,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(30, 2, 3)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE_OVERRANGE(Int16LE, 1, AQ_OVERRANGE)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	struct Group30Var3 : public StreamObject<Analog>
@@ -582,7 +587,7 @@ namespace apl { namespace dnp {
 		MACRO_NAME_SINGLETON_INSTANCE(Group30Var3)
 		MACRO_GROUP_VAR_SIZE_FUNC(30, 3, 4)
 		MACRO_DECLARE_VALUE(Int32LE, 0)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	struct Group30Var4 : public StreamObject<Analog>
@@ -590,7 +595,7 @@ namespace apl { namespace dnp {
 		MACRO_NAME_SINGLETON_INSTANCE(Group30Var4)
 		MACRO_GROUP_VAR_SIZE_FUNC(30, 4, 2)
 		MACRO_DECLARE_VALUE(Int16LE, 0)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	struct Group30Var5 : public StreamObject<Analog>
@@ -599,7 +604,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(30, 5, 5)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE_OVERRANGE(SingleFloat, 1, AQ_OVERRANGE)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	struct Group30Var6 : public StreamObject<Analog>
@@ -608,7 +613,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(30, 6, 9)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE_OVERRANGE(DoubleFloat, 1, AQ_OVERRANGE)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	//////////////////////////////////////////////
@@ -701,7 +706,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC_WITH_EVENTS(32, 1, 5)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE_OVERRANGE(Int32LE, 1, AQ_OVERRANGE)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	struct Group32Var2 : public StreamObject<Analog>
@@ -710,7 +715,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC_WITH_EVENTS(32, 2, 3)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE_OVERRANGE(Int16LE, 1, AQ_OVERRANGE)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	struct Group32Var3 : public StreamObject<Analog>
@@ -720,7 +725,7 @@ namespace apl { namespace dnp {
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE_OVERRANGE(Int32LE, 1, AQ_OVERRANGE)
 		MACRO_DECLARE_TIME(UInt48LE, 5)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	struct Group32Var4 : public StreamObject<Analog>
@@ -730,7 +735,7 @@ namespace apl { namespace dnp {
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE_OVERRANGE(Int16LE, 1, AQ_OVERRANGE)
 		MACRO_DECLARE_TIME(UInt48LE, 3)
-		MACRO_DECLARE_STREAM_TYPE(Analog);
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog);
 	};
 
 	struct Group32Var5 : public StreamObject<Analog>
@@ -739,7 +744,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC_WITH_EVENTS(32, 5, 5)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(SingleFloat, 1)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	struct Group32Var6 : public StreamObject<Analog>
@@ -748,7 +753,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC_WITH_EVENTS(32, 6, 9)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(DoubleFloat, 1)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	struct Group32Var7 : public StreamObject<Analog>
@@ -758,7 +763,7 @@ namespace apl { namespace dnp {
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(SingleFloat, 1)
 		MACRO_DECLARE_TIME(UInt48LE, 5)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	struct Group32Var8 : public StreamObject<Analog>
@@ -768,7 +773,7 @@ namespace apl { namespace dnp {
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(DoubleFloat, 1)
 		MACRO_DECLARE_TIME(UInt48LE, 9)
-		MACRO_DECLARE_STREAM_TYPE(Analog)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(Analog)
 	};
 
 	//////////////////////////////////////////////
@@ -867,7 +872,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(40, 1, 5)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(Int32LE, 1)
-		MACRO_DECLARE_STREAM_TYPE(SetpointStatus)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(SetpointStatus)
 	};
 
 	struct Group40Var2 : public StreamObject<SetpointStatus>
@@ -876,7 +881,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(40, 2, 3)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(Int16LE, 1)
-		MACRO_DECLARE_STREAM_TYPE(SetpointStatus)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(SetpointStatus)
 	};
 
 	struct Group40Var3 : public StreamObject<SetpointStatus>
@@ -885,7 +890,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(40, 3, 5)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(SingleFloat, 1)
-		MACRO_DECLARE_STREAM_TYPE(SetpointStatus)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(SetpointStatus)
 	};
 
 	struct Group40Var4 : public StreamObject<SetpointStatus>
@@ -894,7 +899,7 @@ namespace apl { namespace dnp {
 		MACRO_GROUP_VAR_SIZE_FUNC(40, 4, 9)
 		MACRO_DECLARE_QUALITY(UInt8, 0)
 		MACRO_DECLARE_VALUE(DoubleFloat, 1)
-		MACRO_DECLARE_STREAM_TYPE(SetpointStatus)
+		MACRO_DECLARE_PACKED_STREAM_TYPE(SetpointStatus)
 	};
 
 	struct Group41Var1 : public CommandObject<Setpoint>
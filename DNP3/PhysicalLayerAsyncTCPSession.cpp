@@ -0,0 +1,122 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <APL/ASIOIncludes.h>
+#include "PhysicalLayerAsyncTCPSession.h"
+
+#include <boost/bind.hpp>
+#include <memory.h>
+#include <algorithm>
+
+#include <APL/Logger.h>
+
+#include "TCPListener.h"
+
+using namespace boost;
+using namespace boost::asio;
+using namespace boost::system;
+
+namespace apl { namespace dnp {
+
+PhysicalLayerAsyncTCPSession::PhysicalLayerAsyncTCPSession(Logger* apLogger, io_service* apIOService, TCPListener* apListener, uint_16_t aLocalAddress, uint_16_t aRemoteAddress) :
+PhysicalLayerAsyncASIO(apLogger, apIOService),
+mpListener(apListener),
+mLocalAddress(aLocalAddress),
+mRemoteAddress(aRemoteAddress),
+mpSocket(NULL),
+mHeaderPos(LS_HEADER_SIZE)
+{
+
+}
+
+PhysicalLayerAsyncTCPSession::~PhysicalLayerAsyncTCPSession()
+{
+	delete mpSocket;
+}
+
+void PhysicalLayerAsyncTCPSession::Attach(ip::tcp::socket* apSocket, const LinkHeader& arHeader)
+{
+	if(this->IsClosing()) { // the open was cancelled while the listener was handing over the connection
+		error_code ec;
+		apSocket->close(ec);
+		delete apSocket;
+		this->OnOpenCallback(error::operation_aborted);
+		return;
+	}
+
+	mpSocket = apSocket;
+	arHeader.Write(mHeader);
+	mHeaderPos = 0;
+	this->OnOpenCallback(error_code());
+}
+
+void PhysicalLayerAsyncTCPSession::Reject()
+{
+	this->OnOpenCallback(this->IsClosing() ? error::operation_aborted : error::connection_refused);
+}
+
+/* Implement the actions */
+
+void PhysicalLayerAsyncTCPSession::DoOpen()
+{
+	// the previous connection is closed and has no pending operations by the time the layer reopens
+	delete mpSocket;
+	mpSocket = NULL;
+	mpListener->Request(this);
+}
+
+void PhysicalLayerAsyncTCPSession::DoOpeningClose()
+{
+	mpListener->Cancel(this);
+}
+
+void PhysicalLayerAsyncTCPSession::DoClose()
+{
+	error_code ec;
+	mpSocket->close(ec);
+	if(ec) LOG_BLOCK(LEV_WARNING, ec.message());
+}
+
+void PhysicalLayerAsyncTCPSession::DoAsyncRead(byte_t* apBuffer, size_t aMaxBytes)
+{
+	if(mHeaderPos < LS_HEADER_SIZE) {
+		size_t num = std::min<size_t>(aMaxBytes, LS_HEADER_SIZE - mHeaderPos);
+		memcpy(apBuffer, mHeader + mHeaderPos, num);
+		mHeaderPos += num;
+		mStrand.post(boost::bind(&PhysicalLayerAsyncTCPSession::OnReadCallback, this, error_code(), apBuffer, num));
+	}
+	else {
+		mpSocket->async_read_some(buffer(apBuffer, aMaxBytes),
+			mStrand.wrap(boost::bind(&PhysicalLayerAsyncTCPSession::OnReadCallback, this, placeholders::error, apBuffer, placeholders::bytes_transferred)));
+	}
+}
+
+void PhysicalLayerAsyncTCPSession::DoAsyncWrite(const byte_t* apBuffer, size_t aNumBytes)
+{
+	async_write(*mpSocket, buffer(apBuffer, aNumBytes),
+		mStrand.wrap(boost::bind(&PhysicalLayerAsyncTCPSession::OnWriteCallback, this, placeholders::error, aNumBytes)));
+}
+
+void PhysicalLayerAsyncTCPSession::DoAsyncWriteGather(const WriteBuffer* apBuffers, size_t aNumBuffers)
+{
+	const std::vector<const_buffer>& buffers = this->GetBufferSequence(apBuffers, aNumBuffers);
+	async_write(*mpSocket, buffers,
+		mStrand.wrap(boost::bind(&PhysicalLayerAsyncTCPSession::OnWriteCallback, this, placeholders::error, buffer_size(buffers))));
+}
+
+}}
@@ -0,0 +1,78 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __PHYSICAL_LAYER_ASYNC_TCP_SESSION_H_
+#define __PHYSICAL_LAYER_ASYNC_TCP_SESSION_H_
+
+#include <APL/PhysicalLayerAsyncASIO.h>
+#include <boost/asio/ip/tcp.hpp>
+
+#include "LinkHeader.h"
+
+namespace apl { namespace dnp {
+
+	class TCPListener;
+
+	/**
+		Physical layer for one outstation connecting to a TCPListener. Opening the layer
+		asks the listener for the next connection whose first link frame comes from
+		the remote address. The socket is then handed over and the header the listener
+		already consumed is replayed to the first reads.
+	*/
+	class PhysicalLayerAsyncTCPSession : public PhysicalLayerAsyncASIO
+	{
+		public:
+			/**
+				@param aLocalAddress	Link address of the master, the first frame must be addressed to it
+				@param aRemoteAddress	Link address of the outstation, the first frame must come from it
+			*/
+			PhysicalLayerAsyncTCPSession(Logger*, boost::asio::io_service* apIOService, TCPListener* apListener, uint_16_t aLocalAddress, uint_16_t aRemoteAddress);
+			~PhysicalLayerAsyncTCPSession();
+
+			uint_16_t GetLocalAddress() const { return mLocalAddress; }
+			uint_16_t GetRemoteAddress() const { return mRemoteAddress; }
+
+			/// Called by the listener through this layer's strand to complete an open with a connected socket
+			void Attach(boost::asio::ip::tcp::socket* apSocket, const LinkHeader& arHeader);
+
+			/// Called by the listener through this layer's strand to fail an open
+			void Reject();
+
+			/* Implement the actions */
+			void DoOpen();
+			void DoOpeningClose();
+			void DoClose();
+			void DoAsyncRead(byte_t*, size_t);
+			void DoAsyncWrite(const byte_t*, size_t);
+			void DoAsyncWriteGather(const WriteBuffer*, size_t);
+
+		private:
+
+			TCPListener* mpListener;
+			const uint_16_t mLocalAddress;
+			const uint_16_t mRemoteAddress;
+
+			boost::asio::ip::tcp::socket* mpSocket;	/// NULL until the first connection is attached
+
+			byte_t mHeader[LS_HEADER_SIZE];		/// bytes the listener consumed while identifying the connection
+			size_t mHeaderPos;					/// how many of them have been replayed
+	};
+
+}}
+
+#endif
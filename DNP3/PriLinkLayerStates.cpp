@@ -102,7 +102,7 @@ PLLS_ResetLinkWait PLLS_ResetLinkWait::mInstance;
 void PLLS_ResetLinkWait::Ack(AsyncLinkLayer* apLL, bool aIsRcvBuffFull)
 {
 	apLL->ResetWriteFCB();
-	apLL->CancelTimer();
+	apLL->AckReceived();
 	apLL->StartTimer();
 	apLL->ChangeState(PLLS_ConfDataWait::Inst());
 	apLL->SendDelayedUserData(apLL->NextWriteFCB());
@@ -138,7 +138,7 @@ PLLS_ConfDataWait PLLS_ConfDataWait::mInstance;
 void PLLS_ConfDataWait::Ack(AsyncLinkLayer* apLL, bool aIsRcvBuffFull)
 {
 	apLL->ToggleWriteFCB();
-	apLL->CancelTimer();
+	apLL->AckReceived();
 	apLL->ChangeState(PLLS_SecReset::Inst());
 	apLL->DoSendSuccess();
 }
@@ -43,6 +43,19 @@ void ResponseLoader::Process(HeaderReadIterator& arIter)
 	mCTO.NextHeader();
 }
 
+bool ResponseLoader::IsRange(HeaderReadIterator& arIter)
+{
+	switch(arIter->GetHeaderType())
+	{
+		case(OHT_RANGED_2_OCTET):
+		case(OHT_RANGED_4_OCTET):
+		case(OHT_RANGED_8_OCTET):
+			return true;
+		default:
+			return false;
+	}
+}
+
 void ResponseLoader::ProcessData(HeaderReadIterator& arIter, int aGrp, int aVar)
 {
 	switch(MACRO_DNP_RADIX(aGrp, aVar))
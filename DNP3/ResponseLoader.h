@@ -25,6 +25,8 @@
 #include <APL/Loggable.h>
 #include <APL/Logger.h>
 
+#include <vector>
+
 #include "CTOHistory.h"
 #include "ObjectReadIterator.h"
 
@@ -55,11 +57,31 @@ class ResponseLoader : Loggable
 		template <class T>
 		void ReadBitfield(HeaderReadIterator& arHeader);
 
+		/// Ranged headers have contiguous indices, so their objects are published as one run
+		static bool IsRange(HeaderReadIterator& arIter);
+
+		/// Reused buffer that collects a run of T
+		template <class T>
+		std::vector<T>& Run();
+
 		IDataObserver* mpPublisher;
 		Transaction mTransaction;		
 		CTOHistory mCTO;
+
+		std::vector<Binary> mBinaryRun;
+		std::vector<Analog> mAnalogRun;
+		std::vector<Counter> mCounterRun;
+		std::vector<ControlStatus> mControlStatusRun;
+		std::vector<SetpointStatus> mSetpointStatusRun;
+		std::vector<apl::byte_t> mBits;		/// Unpacked bitfield values, one per byte
 };
 
+template <> inline std::vector<Binary>& ResponseLoader::Run<Binary>() { return mBinaryRun; }
+template <> inline std::vector<Analog>& ResponseLoader::Run<Analog>() { return mAnalogRun; }
+template <> inline std::vector<Counter>& ResponseLoader::Run<Counter>() { return mCounterRun; }
+template <> inline std::vector<ControlStatus>& ResponseLoader::Run<ControlStatus>() { return mControlStatusRun; }
+template <> inline std::vector<SetpointStatus>& ResponseLoader::Run<SetpointStatus>() { return mSetpointStatusRun; }
+
 template <class T>
 void ResponseLoader::ReadCTO(HeaderReadIterator& arIter)
 {
@@ -87,6 +109,25 @@ void ResponseLoader::Read(HeaderReadIterator& arIter, StreamObject<T>* apObj)
 	ObjectReadIterator obj = arIter.BeginRead();
 	LOG_BLOCK(LEV_INTERPRET, "Converting " << obj.Count() << " " << apObj->Name() << " To " << typeid(T).name());
 
+	if(IsRange(arIter)) {
+		// the objects are back to back, so the whole header is decoded in one call
+		size_t num = obj.Count();
+		if(num == 0) return;
+		std::vector<T>& run = this->Run<T>();
+		if(run.size() < num) run.resize(num);
+		apObj->ReadRange(*obj, num, &run[0]);
+
+		if(apObj->UseCTO()) {
+			for(size_t i = 0; i < num; ++i) run[i].SetTime(t + run[i].GetTime());
+		}
+		if(!apObj->HasQuality()) {
+			for(size_t i = 0; i < num; ++i) run[i].SetQuality(T::ONLINE);
+		}
+
+		mpPublisher->Update(&run[0], num, obj->Index());
+		return;
+	}
+
 	for( ; !obj.IsEnd(); ++obj) {
 		size_t index = obj->Index();
 		T value = apObj->Read(*obj);
@@ -109,11 +150,31 @@ void ResponseLoader::ReadBitfield(HeaderReadIterator& arIter)
 	ObjectReadIterator obj = arIter.BeginRead();
 	LOG_BLOCK(LEV_INTERPRET, "Converting " << obj.Count() << " " << T::Inst()->Name() << " To " << typeid(b).name());
 
-	for(; !obj.IsEnd(); ++obj)
+	if(obj.IsEnd()) return;
+
+	if(IsRange(arIter))
+	{
+		// expand the whole bitfield at once, then publish it as one run
+		size_t num = obj.Count();
+		if(mBits.size() < num) mBits.resize(num);
+		BitfieldObject::ReadRange(*obj, num, &mBits[0]);
+
+		std::vector<Binary>& run = this->Run<Binary>();
+		if(run.size() < num) run.resize(num);
+		for(size_t i = 0; i < num; ++i) {
+			run[i] = b;
+			run[i].SetValue(mBits[i] != 0);
+		}
+
+		mpPublisher->Update(&run[0], num, obj->Index());
+	}
+	else
 	{
-		bool val = BitfieldObject::StaticRead(*obj, obj->Start(), obj->Index());
-		b.SetValue(val);
-		mpPublisher->Update(b, obj->Index());
+		for(; !obj.IsEnd(); ++obj)
+		{
+			b.SetValue(BitfieldObject::StaticRead(*obj, obj->Start(), obj->Index()));
+			mpPublisher->Update(b, obj->Index());
+		}
 	}
 }
 
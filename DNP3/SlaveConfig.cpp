@@ -27,7 +27,10 @@ namespace apl { namespace dnp {
 	SlaveConfig::SlaveConfig() : 
 	
 	mMaxControls(1),
+	mCommandResponseTimeout(5000),
 	
+	mCoalesceUpdates(false),
+
 	mDisableUnsol(false),
 			
 	mAllowTimeSync(false),
@@ -54,6 +54,13 @@ namespace apl { namespace dnp {
 			/// The maximum number of controls the slave will attempt to process from a single APDU
 			size_t mMaxControls;
 
+			/// How long the slave will wait for user code to respond to an operate before replying with CS_TIMEOUT
+			millis_t mCommandResponseTimeout;
+
+			/// if true, only the latest value for each point is processed per flush of user updates, so
+			/// intermediate changes between flushes won't generate events
+			bool mCoalesceUpdates;
+
 			/// if true, fully disables unsolicited mode as if the slave didn't support it
 			bool mDisableUnsol;
 
@@ -88,7 +95,8 @@ namespace apl { namespace dnp {
 
 			// default static response types
 
-			/// The default group/variation to use for static binary responses
+			/// The default group/variation to use for static binary responses. With 1/1, ranges that have
+			/// a point with flags other than ONLINE are reported as 1/2 so the flags aren't lost
 			GrpVar mStaticBinary;
 
 			/// The default group/variation to use for static analog responses
@@ -28,6 +28,7 @@ namespace apl { namespace dnp {
 	SlaveResponseTypes::SlaveResponseTypes(const SlaveConfig& arCfg)
 	{
 		mpStaticBinary = GetStaticBinary(arCfg.mStaticBinary);
+		mpStaticBinaryBitfield = GetStaticBinaryBitfield(arCfg.mStaticBinary);
 		mpStaticAnalog = GetStaticAnalog(arCfg.mStaticAnalog);
 		mpStaticCounter = GetStaticCounter(arCfg.mStaticCounter);
 		mpStaticControlStatus = Group10Var2::Inst();
@@ -43,7 +44,7 @@ namespace apl { namespace dnp {
 		switch(gv.Grp) {
 			case(1):
 				switch(gv.Var) {
-					//case(1): return Group1Var1::Inst();
+					case(1): //packed responses are written with mpStaticBinaryBitfield, 1/2 describes the same points
 					case(2): return Group1Var2::Inst();
 				}
 				break;
@@ -51,6 +52,12 @@ namespace apl { namespace dnp {
 
 		throw ArgumentException(LOCATION, "Invalid static binary");
 	}
+
+	BitfieldObject* SlaveResponseTypes::GetStaticBinaryBitfield(GrpVar gv)
+	{
+		if(gv.Grp == 1 && gv.Var == 1) return Group1Var1::Inst();
+		return NULL;
+	}
 	
 	StreamObject<Analog>* SlaveResponseTypes::GetStaticAnalog(GrpVar gv)
 	{
@@ -40,6 +40,9 @@ class SlaveResponseTypes
 	StreamObject<ControlStatus>* mpStaticControlStatus;
 	StreamObject<SetpointStatus>* mpStaticSetpointStatus;
 
+	/// Group1Var1 when static binaries are reported as a packed bitfield, otherwise NULL
+	BitfieldObject* mpStaticBinaryBitfield;
+
 	StreamObject<Binary>* mpEventBinary;
 	StreamObject<Analog>* mpEventAnalog;
 	StreamObject<Counter>* mpEventCounter;
@@ -47,6 +50,7 @@ class SlaveResponseTypes
 	private:
 
 	static StreamObject<Binary>* GetStaticBinary(GrpVar);
+	static BitfieldObject* GetStaticBinaryBitfield(GrpVar);
 	static StreamObject<Analog>* GetStaticAnalog(GrpVar);
 	static StreamObject<Counter>* GetStaticCounter(GrpVar);
 	static StreamObject<SetpointStatus>* GetStaticSetpointStatus(GrpVar);
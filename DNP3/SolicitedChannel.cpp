@@ -24,8 +24,8 @@
 namespace apl { namespace dnp {
 
 
-SolicitedChannel::SolicitedChannel(Logger* apLogger, AsyncAppLayer* apApp, ITimerSource* apTimerSrc, millis_t aTimeout) :
-AppLayerChannel("Solicited", apLogger, apApp, apTimerSrc, aTimeout)
+SolicitedChannel::SolicitedChannel(Logger* apLogger, AsyncAppLayer* apApp, ITimerSource* apTimerSrc, ITimeSource* apTimeSrc, millis_t aTimeout, RttEstimator* apRtt) :
+AppLayerChannel("Solicited", apLogger, apApp, apTimerSrc, apTimeSrc, aTimeout, apRtt)
 {}
 
 bool SolicitedChannel::AcceptsResponse() 
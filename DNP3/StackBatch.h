@@ -0,0 +1,150 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __STACK_BATCH_H_
+#define __STACK_BATCH_H_
+
+#include <APL/PhysLayerSettings.h>
+#include <APL/SerialTypes.h>
+#include <APL/TCPTypes.h>
+#include <APL/UDPTypes.h>
+
+#include "MasterStackConfig.h"
+#include "SlaveStackConfig.h"
+
+#include <vector>
+
+namespace apl {
+	class ICommandAcceptor;
+	class IDataObserver;
+}
+
+namespace apl { namespace dnp {
+
+/** A set of ports and stacks that AsyncStackManager::AddBatch brings up together. The
+	Add functions take the same arguments as their AsyncStackManager counterparts and only
+	record them. A stack may refer to a port in the same batch or to one the manager already has.
+
+	AddBatch fills in the interfaces of every master and slave record, so the records are
+	read back after the call the same way the return values of AddMaster/AddSlave are.
+
+	A TCP client or server whose TCPSettings::mConcurrentMasters is set becomes a concurrent
+	port just as it does through AsyncStackManager, so its masters get task groups of their own.
+*/
+class StackBatch
+{
+	public:
+
+	enum PortType {
+		PT_TCP_CLIENT,
+		PT_TCP_SERVER,
+		PT_SERIAL,
+		PT_UDP,
+		PT_TCP_LISTENER
+	};
+
+	struct PortRecord
+	{
+		PortRecord(PortType aType, const std::string& arName, const PhysLayerSettings& arPhys) :
+		mType(aType), mName(arName), mPhys(arPhys), mTcp("", 0), mSerial(), mUdp("", 0), mHandshakeTimeout(0)
+		{}
+
+		PortType mType;
+		std::string mName;
+		PhysLayerSettings mPhys;
+		TCPSettings mTcp;			/// only used by the TCP types
+		SerialSettings mSerial;		/// only used by PT_SERIAL
+		UDPSettings mUdp;			/// only used by PT_UDP
+		millis_t mHandshakeTimeout;	/// only used by PT_TCP_LISTENER
+	};
+
+	struct MasterRecord
+	{
+		MasterRecord(const std::string& arPortName, const std::string& arStackName, FilterLevel aLevel, IDataObserver* apPublisher, const MasterStackConfig& arCfg) :
+		mPortName(arPortName), mStackName(arStackName), mLevel(aLevel), mpPublisher(apPublisher), mConfig(arCfg), mpCmdAcceptor(NULL)
+		{}
+
+		std::string mPortName;
+		std::string mStackName;
+		FilterLevel mLevel;
+		IDataObserver* mpPublisher;
+		MasterStackConfig mConfig;
+		ICommandAcceptor* mpCmdAcceptor;	/// set by AddBatch
+	};
+
+	struct SlaveRecord
+	{
+		SlaveRecord(const std::string& arPortName, const std::string& arStackName, FilterLevel aLevel, ICommandAcceptor* apCmdAcceptor, const SlaveStackConfig& arCfg) :
+		mPortName(arPortName), mStackName(arStackName), mLevel(aLevel), mpCmdAcceptor(apCmdAcceptor), mConfig(arCfg), mpDataObserver(NULL)
+		{}
+
+		std::string mPortName;
+		std::string mStackName;
+		FilterLevel mLevel;
+		ICommandAcceptor* mpCmdAcceptor;
+		SlaveStackConfig mConfig;
+		IDataObserver* mpDataObserver;		/// set by AddBatch
+	};
+
+	void AddTCPClient(const std::string& arName, PhysLayerSettings aPhys, TCPSettings aTcp)
+	{
+		mPorts.push_back(PortRecord(PT_TCP_CLIENT, arName, aPhys));
+		mPorts.back().mTcp = aTcp;
+	}
+
+	void AddTCPServer(const std::string& arName, PhysLayerSettings aPhys, TCPSettings aTcp)
+	{
+		mPorts.push_back(PortRecord(PT_TCP_SERVER, arName, aPhys));
+		mPorts.back().mTcp = aTcp;
+	}
+
+	void AddSerial(const std::string& arName, PhysLayerSettings aPhys, SerialSettings aSerial)
+	{
+		mPorts.push_back(PortRecord(PT_SERIAL, arName, aPhys));
+		mPorts.back().mSerial = aSerial;
+	}
+
+	void AddUDP(const std::string& arName, PhysLayerSettings aPhys, UDPSettings aUdp)
+	{
+		mPorts.push_back(PortRecord(PT_UDP, arName, aPhys));
+		mPorts.back().mUdp = aUdp;
+	}
+
+	void AddTCPListener(const std::string& arName, PhysLayerSettings aPhys, TCPSettings aTcp, millis_t aHandshakeTimeout = 30000)
+	{
+		mPorts.push_back(PortRecord(PT_TCP_LISTENER, arName, aPhys));
+		mPorts.back().mTcp = aTcp;
+		mPorts.back().mHandshakeTimeout = aHandshakeTimeout;
+	}
+
+	void AddMaster(const std::string& arPortName, const std::string& arStackName, FilterLevel aLevel, IDataObserver* apPublisher, const MasterStackConfig& arCfg)
+	{ mMasters.push_back(MasterRecord(arPortName, arStackName, aLevel, apPublisher, arCfg)); }
+
+	void AddSlave(const std::string& arPortName, const std::string& arStackName, FilterLevel aLevel, ICommandAcceptor* apCmdAcceptor, const SlaveStackConfig& arCfg)
+	{ mSlaves.push_back(SlaveRecord(arPortName, arStackName, aLevel, apCmdAcceptor, arCfg)); }
+
+	size_t NumStacks() const { return mMasters.size() + mSlaves.size(); }
+
+	std::vector<PortRecord> mPorts;
+	std::vector<MasterRecord> mMasters;
+	std::vector<SlaveRecord> mSlaves;
+};
+
+}}
+
+#endif
@@ -23,9 +23,9 @@
 
 namespace apl { namespace dnp {
 
-StackManager::StackManager(bool aAutoStart) :
+StackManager::StackManager(bool aAutoStart, size_t aNumThreads) :
 mpLog(new EventLog()),
-mpImpl(new AsyncStackManager(mpLog->GetLogger(LEV_WARNING, "dnp"), aAutoStart))
+mpImpl(new AsyncStackManager(mpLog->GetLogger(LEV_WARNING, "dnp"), aAutoStart, aNumThreads))
 {
 
 }
@@ -47,6 +47,12 @@ void StackManager::AddTCPServer(const std::string& arName, PhysLayerSettings s,
 void StackManager::AddSerial(const std::string& arName, PhysLayerSettings s, SerialSettings aSerial)
 { mpImpl->AddSerial(arName, s, aSerial); }
 
+void StackManager::AddUDP(const std::string& arName, PhysLayerSettings s, UDPSettings aUdp)
+{ mpImpl->AddUDP(arName, s, aUdp); }
+
+void StackManager::AddTCPListener(const std::string& arName, PhysLayerSettings s, TCPSettings aTcp, millis_t aHandshakeTimeout)
+{ mpImpl->AddTCPListener(arName, s, aTcp, aHandshakeTimeout); }
+
 ICommandAcceptor* StackManager::AddMaster(const std::string& arPortName, const std::string& arStackName, FilterLevel aLevel, 
 										  IDataObserver* apPublisher, const MasterStackConfig& arCfg)
 { return mpImpl->AddMaster(arPortName, arStackName, aLevel, apPublisher, arCfg); }
@@ -55,6 +61,9 @@ IDataObserver* StackManager::AddSlave(const std::string& arPortName, const std::
 									  ICommandAcceptor* apCmdAcceptor, const SlaveStackConfig& arCfg)
 { return mpImpl->AddSlave(arPortName, arStackName, aLevel, apCmdAcceptor, arCfg); }
 
+void StackManager::AddBatch(StackBatch& arBatch)
+{ mpImpl->AddBatch(arBatch); }
+
 
 void StackManager::Stop() { mpImpl->Stop(); }
 void StackManager::Start() { mpImpl->Start(); }
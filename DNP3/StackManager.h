@@ -25,9 +25,11 @@
 #include <APL/LogBase.h>
 #include <APL/SerialTypes.h>
 #include <APL/TCPTypes.h>
+#include <APL/UDPTypes.h>
 
 #include <DNP3/MasterStackConfig.h>
 #include <DNP3/SlaveStackConfig.h>
+#include <DNP3/StackBatch.h>
 
 #include <vector>
 
@@ -47,12 +49,14 @@ class AsyncStackManager;
 class StackManager
 {
 	public:
-		StackManager(bool aAutoStart);
+		StackManager(bool aAutoStart, size_t aNumThreads = 1);
 		~StackManager();
 
 		void AddTCPClient(const std::string& arName, PhysLayerSettings aPhys, TCPSettings aTcp);
 		void AddTCPServer(const std::string& arName, PhysLayerSettings aPhys, TCPSettings aTcp);
 		void AddSerial(const std::string& arName, PhysLayerSettings aPhys, SerialSettings aSerial);
+		void AddUDP(const std::string& arName, PhysLayerSettings aPhys, UDPSettings aUdp);
+		void AddTCPListener(const std::string& arName, PhysLayerSettings aPhys, TCPSettings aTcp, millis_t aHandshakeTimeout = 30000);
 
 		ICommandAcceptor* AddMaster(const std::string& arPortName,
 									const std::string& arStackName,
@@ -66,6 +70,8 @@ class StackManager
 								ICommandAcceptor* apCmdAcceptor,
 								const SlaveStackConfig& arCfg);
 
+		void AddBatch(StackBatch& arBatch);
+
 		void RemovePort(const std::string& arPortName);
 
 		void RemoveStack(const std::string& arStackName);
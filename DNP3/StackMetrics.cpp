@@ -0,0 +1,58 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include "StackMetrics.h"
+
+namespace apl { namespace dnp {
+
+StackMetrics::StackMetrics() :
+mpRegistry(NULL),
+mFramesRx(0),
+mFramesTx(0),
+mRequestRtt(0),
+mFragmentBuild(0),
+mEventDepth(0)
+{}
+
+void StackMetrics::Register(MetricRegistry* apRegistry, const std::string& arStackName, bool aIsMaster)
+{
+	std::vector<std::string> names;
+	GetNames(arStackName, names);
+	mFramesRx = apRegistry->RegisterCounter(names[0]);
+	mFramesTx = apRegistry->RegisterCounter(names[1]);
+	if(aIsMaster) {
+		mRequestRtt = apRegistry->RegisterHistogram(names[2]);
+	}
+	else {
+		mFragmentBuild = apRegistry->RegisterHistogram(names[3]);
+		mEventDepth = apRegistry->RegisterGauge(names[4]);
+	}
+	mpRegistry = apRegistry;
+}
+
+void StackMetrics::GetNames(const std::string& arStackName, std::vector<std::string>& arNames)
+{
+	std::string prefix = arStackName + ".";
+	arNames.push_back(prefix + "frames_rx");
+	arNames.push_back(prefix + "frames_tx");
+	arNames.push_back(prefix + "request_rtt_us");
+	arNames.push_back(prefix + "fragment_build_us");
+	arNames.push_back(prefix + "event_buffer_depth");
+}
+
+}}
@@ -0,0 +1,71 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __STACK_METRICS_H_
+#define __STACK_METRICS_H_
+
+#include <APL/MetricRegistry.h>
+
+namespace apl { namespace dnp {
+
+/** The metrics a stack reports to a MetricRegistry, named "<stack>.<metric>":
+
+		frames_rx			link frames received for the stack
+		frames_tx			link frames sent by the stack
+		request_rtt_us		master only, time from sending a request to its final response
+		fragment_build_us	slave only, time to load a response or unsolicited fragment
+		event_buffer_depth	slave only, events waiting in the event buffer
+
+	Stacks with adaptive timeouts also report the gauges link.srtt_ms, link.rttvar_ms and link.timeout_ms,
+	and the same under app., see RttEstimator.
+
+	Every call is a no-op until Register() is called, so stacks that aren't added through
+	an AsyncStackManager don't pay for the timing.
+*/
+class StackMetrics
+{
+	public:
+
+	StackMetrics();
+
+	void Register(MetricRegistry* apRegistry, const std::string& arStackName, bool aIsMaster);
+
+	/// Appends the names Register uses for a master or a slave named arStackName to arNames
+	static void GetNames(const std::string& arStackName, std::vector<std::string>& arNames);
+
+	bool IsEnabled() const { return mpRegistry != NULL; }
+
+	void FrameReceived() { if(mpRegistry) mpRegistry->Increment(mFramesRx); }
+	void FrameSent() { if(mpRegistry) mpRegistry->Increment(mFramesTx); }
+	void RequestCompleted(size_t aMicros) { if(mpRegistry) mpRegistry->Record(mRequestRtt, aMicros); }
+	void FragmentBuilt(size_t aMicros) { if(mpRegistry) mpRegistry->Record(mFragmentBuild, aMicros); }
+	void EventBufferDepth(size_t aDepth) { if(mpRegistry) mpRegistry->SetGauge(mEventDepth, aDepth); }
+
+	private:
+
+	MetricRegistry* mpRegistry;
+	MetricHandle mFramesRx;
+	MetricHandle mFramesTx;
+	MetricHandle mRequestRtt;
+	MetricHandle mFragmentBuild;
+	MetricHandle mEventDepth;
+};
+
+}}
+
+#endif
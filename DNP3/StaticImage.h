@@ -0,0 +1,125 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __STATIC_IMAGE_H_
+#define __STATIC_IMAGE_H_
+
+#include <APL/Types.h>
+
+#include "DNPDatabaseTypes.h"
+#include "ObjectInterfaces.h"
+
+#include <vector>
+
+namespace apl { namespace dnp {
+
+/**
+	The static values of one point type, encoded with the object the slave reports them as and laid
+	out like the objects of a contiguous header, so a range of points is copied straight into a fragment.
+
+	The database marks points dirty as they're updated and only those are encoded again before the
+	next read, which turns integrity polls of mostly unchanged data into a memcpy.
+
+	T is the point info type, i.e. AnalogInfo
+*/
+template <class T>
+class StaticImage
+{
+	public:
+
+	typedef typename T::MeasType MeasType;
+
+	StaticImage() : mpObj(NULL), mObjSize(0), mNum(0), mAllDirty(false) {}
+
+	/// @return true if the image holds aNum points encoded with apObj
+	bool IsConfigured(const StreamObject<MeasType>* apObj, size_t aNum) const
+	{ return mpObj == apObj && mNum == aNum; }
+
+	/// Size the image for aNum points encoded with apObj, all of them are encoded on the next Refresh()
+	void Configure(const StreamObject<MeasType>* apObj, size_t aNum);
+
+	/// Drop the image, i.e. when the database is resized
+	void Invalidate() { this->Configure(NULL, 0); }
+
+	/// Record that point aIndex changed, ignored if the image doesn't cover it
+	void MarkDirty(size_t aIndex)
+	{
+		if(aIndex < mNum && !mAllDirty && !mDirtyFlags[aIndex]) {
+			mDirtyFlags[aIndex] = true;
+			mDirty.push_back(aIndex);
+		}
+	}
+
+	/// Encode the points that changed since the last refresh, aBegin is the database value of point 0
+	void Refresh(typename StaticIter<T>::Type aBegin);
+
+	/// @return number of points that will be encoded on the next Refresh()
+	size_t NumDirty() const { return mAllDirty ? mNum : mDirty.size(); }
+
+	/// @return the encoded objects from point aIndex on
+	const apl::byte_t* Get(size_t aIndex) const { return &mImage[aIndex*mObjSize]; }
+
+	size_t ObjectSize() const { return mObjSize; }
+
+	private:
+
+	const StreamObject<MeasType>* mpObj;
+	size_t mObjSize;
+	size_t mNum;
+
+	bool mAllDirty;
+	std::vector<apl::byte_t> mImage;
+	std::vector<bool> mDirtyFlags;
+	std::vector<size_t> mDirty;
+};
+
+template <class T>
+void StaticImage<T>::Configure(const StreamObject<MeasType>* apObj, size_t aNum)
+{
+	mpObj = apObj;
+	mObjSize = (apObj == NULL) ? 0 : apObj->GetSize();
+	mNum = (apObj == NULL) ? 0 : aNum;
+	mAllDirty = true;
+
+	mImage.assign(mNum*mObjSize, 0);
+	mDirtyFlags.assign(mNum, false);
+	mDirty.clear();
+}
+
+template <class T>
+void StaticImage<T>::Refresh(typename StaticIter<T>::Type aBegin)
+{
+	if(mAllDirty) {
+		apl::byte_t* pPos = mNum > 0 ? &mImage[0] : NULL;
+		for(size_t i = 0; i < mNum; ++i, ++aBegin, pPos += mObjSize) mpObj->WritePacked(pPos, aBegin->mValue);
+		mAllDirty = false;
+	}
+	else {
+		for(size_t i = 0; i < mDirty.size(); ++i) {
+			size_t index = mDirty[i];
+			mpObj->WritePacked(&mImage[index*mObjSize], (aBegin + index)->mValue);
+			mDirtyFlags[index] = false;
+		}
+	}
+
+	mDirty.clear();
+}
+
+}}
+
+#endif
@@ -0,0 +1,239 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <APL/ASIOIncludes.h>
+#include "TCPListener.h"
+
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+
+#include <APL/Exception.h>
+#include <APL/Logger.h>
+#include <APL/PhysicalLayerAsyncBaseTCP.h>
+
+#include "DNPCrc.h"
+#include "LinkHeader.h"
+#include "PhysicalLayerAsyncTCPSession.h"
+
+using namespace boost;
+using namespace boost::asio;
+using namespace boost::system;
+
+namespace apl { namespace dnp {
+
+TCPListener::TCPListener(Logger* apLogger, io_service* apIOService, const TCPSettings& arTcp, millis_t aHandshakeTimeout) :
+Loggable(apLogger),
+mpService(apIOService),
+mStrand(*apIOService),
+mEndpoint(ip::tcp::v4(), arTcp.mPort),
+mAcceptor(*apIOService),
+mTcp(arTcp),
+M_HANDSHAKE_TIMEOUT(aHandshakeTimeout),
+mClosed(false)
+{
+	error_code ec;
+	ip::address_v4 addr = ip::address_v4::from_string(arTcp.mAddress, ec);
+	if(ec) throw ArgumentException(LOCATION, "endpoint: " + arTcp.mAddress + " is invalid ");
+	mEndpoint.address(addr);
+}
+
+TCPListener::~TCPListener()
+{
+	BOOST_FOREACH(Handshake* p, mHandshakes) { delete p; }
+}
+
+void TCPListener::Request(PhysicalLayerAsyncTCPSession* apSession)
+{
+	mStrand.post(boost::bind(&TCPListener::DoRequest, this, apSession));
+}
+
+void TCPListener::Cancel(PhysicalLayerAsyncTCPSession* apSession)
+{
+	mStrand.post(boost::bind(&TCPListener::DoCancel, this, apSession));
+}
+
+void TCPListener::Close()
+{
+	mStrand.post(boost::bind(&TCPListener::DoClose, this));
+}
+
+void TCPListener::DoRequest(PhysicalLayerAsyncTCPSession* apSession)
+{
+	uint_16_t addr = apSession->GetRemoteAddress();
+
+	if(mClosed) {
+		this->Reject(apSession);
+	}
+	else if(mWaiting.Find(addr) != NULL) {
+		LOG_BLOCK(LEV_ERROR, "Another session is already waiting for address: " << addr);
+		this->Reject(apSession);
+	}
+	else {
+		mWaiting.Bind(addr, apSession);
+		if(mWaiting.Size() == 1) this->Listen();
+	}
+}
+
+void TCPListener::DoCancel(PhysicalLayerAsyncTCPSession* apSession)
+{
+	// if the session isn't waiting any more its connection is already on the way
+	AddressTable<PhysicalLayerAsyncTCPSession>::Entry* pEntry = mWaiting.Find(apSession->GetRemoteAddress());
+	if(pEntry == NULL || pEntry->mpContext != apSession) return;
+
+	mWaiting.Unbind(apSession->GetRemoteAddress());
+	this->Reject(apSession);
+	if(mWaiting.Size() == 0) this->StopListening();
+}
+
+void TCPListener::DoClose()
+{
+	mClosed = true;
+	std::vector<uint_16_t> addresses(mWaiting.Addresses());
+	BOOST_FOREACH(uint_16_t a, addresses) { this->Reject(mWaiting.Unbind(a)); }
+	this->StopListening();
+}
+
+void TCPListener::Reject(PhysicalLayerAsyncTCPSession* apSession)
+{
+	apSession->GetStrand()->post(boost::bind(&PhysicalLayerAsyncTCPSession::Reject, apSession));
+}
+
+void TCPListener::Listen()
+{
+	if(mAcceptor.is_open()) return;
+
+	error_code ec;
+	mAcceptor.open(mEndpoint.protocol(), ec);
+	if(!ec) mAcceptor.set_option(ip::tcp::acceptor::reuse_address(true), ec);
+	if(!ec) mAcceptor.bind(mEndpoint, ec);
+	if(!ec) mAcceptor.listen(socket_base::max_connections, ec);
+
+	if(ec) {
+		LOG_BLOCK(LEV_ERROR, "Unable to listen on " << mEndpoint << ": " << ec.message());
+		error_code ignored;
+		mAcceptor.close(ignored);
+		// the sessions retry their open on their own timers
+		std::vector<uint_16_t> addresses(mWaiting.Addresses());
+		BOOST_FOREACH(uint_16_t a, addresses) { this->Reject(mWaiting.Unbind(a)); }
+		return;
+	}
+
+	LOG_BLOCK(LEV_INFO, "Listening on " << mEndpoint);
+	this->StartAccept();
+}
+
+void TCPListener::StopListening()
+{
+	LOG_BLOCK(LEV_DEBUG, "Stopped listening on " << mEndpoint);
+
+	error_code ec;
+	mAcceptor.close(ec);
+	BOOST_FOREACH(Handshake* p, mHandshakes) {
+		if(p->mpSocket != NULL) p->mpSocket->close(ec);
+		p->mTimer.cancel(ec);
+	}
+}
+
+void TCPListener::StartAccept()
+{
+	Handshake* pHandshake = new Handshake(*mpService);
+	pHandshake->mPos = mHandshakes.insert(mHandshakes.end(), pHandshake);
+	pHandshake->mNumPending = 1;
+	mAcceptor.async_accept(*pHandshake->mpSocket, mStrand.wrap(boost::bind(&TCPListener::OnAccept, this, pHandshake, placeholders::error)));
+}
+
+void TCPListener::OnAccept(Handshake* apHandshake, const error_code& arErr)
+{
+	if(arErr || !mAcceptor.is_open()) {
+		if(arErr != error::operation_aborted) LOG_BLOCK(LEV_WARNING, "Accept failed: " << arErr.message());
+		this->Release(apHandshake);
+		if(mAcceptor.is_open()) this->StartAccept();
+		return;
+	}
+
+	error_code ec;
+	LOG_BLOCK(LEV_DEBUG, "Accepted connection from " << apHandshake->mpSocket->remote_endpoint(ec));
+	if(mTcp.mEnableKeepalive) PhysicalLayerAsyncBaseTCP::ApplyKeepalive(*apHandshake->mpSocket, mTcp);
+
+	// the connection has until the timer expires to send a link header
+	apHandshake->mNumPending += 2;
+	apHandshake->mTimer.expires_from_now(posix_time::milliseconds(M_HANDSHAKE_TIMEOUT));
+	apHandshake->mTimer.async_wait(mStrand.wrap(boost::bind(&TCPListener::OnTimeout, this, apHandshake, placeholders::error)));
+	async_read(*apHandshake->mpSocket, buffer(apHandshake->mHeader, LS_HEADER_SIZE),
+		mStrand.wrap(boost::bind(&TCPListener::OnHeader, this, apHandshake, placeholders::error, placeholders::bytes_transferred)));
+
+	this->Release(apHandshake);
+	this->StartAccept();
+}
+
+void TCPListener::OnHeader(Handshake* apHandshake, const error_code& arErr, size_t)
+{
+	error_code ec;
+	apHandshake->mTimer.cancel(ec);
+
+	if(arErr) {
+		LOG_BLOCK(LEV_INFO, "Connection closed before identifying itself: " << arErr.message());
+	}
+	else if(apHandshake->mHeader[LI_START_05] != 0x05 || apHandshake->mHeader[LI_START_64] != 0x64 || !DNPCrc::IsCorrectCRC(apHandshake->mHeader, LI_CRC)) {
+		LOG_BLOCK(LEV_WARNING, "Connection didn't start with a link header, closing");
+	}
+	else {
+		LinkHeader header(apHandshake->mHeader);
+		AddressTable<PhysicalLayerAsyncTCPSession>::Entry* pEntry = mWaiting.Find(header.GetSrc());
+
+		if(pEntry == NULL) {
+			LOG_BLOCK(LEV_WARNING, "No session waiting for address: " << header.GetSrc() << ", closing");
+		}
+		else if(pEntry->mpContext->GetLocalAddress() != header.GetDest()) {
+			LOG_BLOCK(LEV_WARNING, "Frame from address: " << header.GetSrc() << " is for address: " << header.GetDest()
+				<< ", not the master's address: " << pEntry->mpContext->GetLocalAddress() << ", closing");
+		}
+		else {
+			LOG_BLOCK(LEV_INFO, "Attaching connection to session for address: " << header.GetSrc());
+			PhysicalLayerAsyncTCPSession* pSession = mWaiting.Unbind(header.GetSrc());
+			ip::tcp::socket* pSocket = apHandshake->mpSocket;
+			apHandshake->mpSocket = NULL;
+			pSession->GetStrand()->post(boost::bind(&PhysicalLayerAsyncTCPSession::Attach, pSession, pSocket, header));
+			if(mWaiting.Size() == 0) this->StopListening();
+		}
+	}
+
+	this->Release(apHandshake);
+}
+
+void TCPListener::OnTimeout(Handshake* apHandshake, const error_code& arErr)
+{
+	// the timer can expire just as the header arrives, so check that there's still a socket
+	if(!arErr && apHandshake->mpSocket != NULL && apHandshake->mpSocket->is_open()) {
+		LOG_BLOCK(LEV_WARNING, "Connection didn't identify itself within " << M_HANDSHAKE_TIMEOUT << "ms, closing");
+		error_code ec;
+		apHandshake->mpSocket->close(ec);
+	}
+
+	this->Release(apHandshake);
+}
+
+void TCPListener::Release(Handshake* apHandshake)
+{
+	if(--apHandshake->mNumPending == 0) {
+		mHandshakes.erase(apHandshake->mPos);
+		delete apHandshake;	// closes the socket if it wasn't handed over
+	}
+}
+
+}}
@@ -0,0 +1,113 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#ifndef __TCP_LISTENER_H_
+#define __TCP_LISTENER_H_
+
+#include <APL/Loggable.h>
+#include <APL/TCPTypes.h>
+#include <APL/ASIOIncludes.h>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/deadline_timer.hpp>
+
+#include <list>
+
+#include "LinkAddressTable.h"
+#include "LinkLayerConstants.h"
+
+namespace apl { namespace dnp {
+
+	class PhysicalLayerAsyncTCPSession;
+
+	/**
+		Accepts outstation connections on a single endpoint and hands each one to the
+		PhysicalLayerAsyncTCPSession waiting for its link address.
+
+		Sessions register while they are opening. The listener only accepts while at least
+		one session is waiting, reads the 10 byte header of the first link frame from each
+		new connection and uses its source address to find the session in an AddressTable.
+		The destination address of the frame must be the local address of that session's master.
+		Every step is asynchronous and runs on the listener's own strand, so sessions on
+		other strands only ever post to it.
+
+		Connections that don't identify themselves within the handshake timeout, that send
+		something other than a link header, whose address no session is waiting for, or whose
+		frame is addressed to another master are closed.
+	*/
+	class TCPListener : public Loggable
+	{
+		public:
+			TCPListener(Logger*, boost::asio::io_service* apIOService, const TCPSettings& arTcp, millis_t aHandshakeTimeout);
+			~TCPListener();
+
+			/// Ask for the next connection from the session's remote address, answered with Attach() or Reject()
+			void Request(PhysicalLayerAsyncTCPSession* apSession);
+
+			/// Withdraw a request, answered with Reject() unless the connection was already attached
+			void Cancel(PhysicalLayerAsyncTCPSession* apSession);
+
+			/// Stop accepting for good and reject every waiting session. The listener must outlive
+			/// the handlers this leaves pending, so it's only deleted once the io_service has stopped.
+			void Close();
+
+		private:
+
+			/// An accepted connection that hasn't identified itself yet
+			struct Handshake
+			{
+				Handshake(boost::asio::io_service& arService) : mpSocket(new boost::asio::ip::tcp::socket(arService)), mTimer(arService), mNumPending(0) {}
+				~Handshake() { delete mpSocket; }
+
+				boost::asio::ip::tcp::socket* mpSocket;	/// NULL once it's been handed to a session
+				boost::asio::deadline_timer mTimer;
+				byte_t mHeader[LS_HEADER_SIZE];
+				size_t mNumPending;						/// outstanding async operations, deleted when it reaches 0
+				std::list<Handshake*>::iterator mPos;
+			};
+
+			void DoRequest(PhysicalLayerAsyncTCPSession* apSession);
+			void DoCancel(PhysicalLayerAsyncTCPSession* apSession);
+			void DoClose();
+
+			void Listen();
+			void StopListening();
+			void StartAccept();
+
+			void OnAccept(Handshake* apHandshake, const boost::system::error_code& arErr);
+			void OnHeader(Handshake* apHandshake, const boost::system::error_code& arErr, size_t aNumBytes);
+			void OnTimeout(Handshake* apHandshake, const boost::system::error_code& arErr);
+			void Release(Handshake* apHandshake);
+
+			void Reject(PhysicalLayerAsyncTCPSession* apSession);
+
+			boost::asio::io_service* mpService;
+			boost::asio::io_service::strand mStrand;
+			boost::asio::ip::tcp::endpoint mEndpoint;
+			boost::asio::ip::tcp::acceptor mAcceptor;
+			TCPSettings mTcp;
+			const millis_t M_HANDSHAKE_TIMEOUT;
+
+			bool mClosed;
+
+			AddressTable<PhysicalLayerAsyncTCPSession> mWaiting;	/// sessions waiting for a connection, by remote address
+			std::list<Handshake*> mHandshakes;						/// connections in progress
+	};
+
+}}
+
+#endif
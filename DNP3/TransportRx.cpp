@@ -30,10 +30,10 @@ using namespace std;
 
 namespace apl { namespace dnp {
 
-TransportRx::TransportRx(Logger* apLogger, AsyncTransportLayer* apContext, size_t aFragSize) :
+TransportRx::TransportRx(Logger* apLogger, AsyncTransportLayer* apContext, size_t aFragSize, BufferPool* apPool) :
 Loggable(apLogger),
 mpContext(apContext),
-mBuffer(aFragSize),
+mBuffer(aFragSize, apPool),
 mNumBytesRead(0),
 mSeq(0)
 {
@@ -44,6 +44,7 @@ void TransportRx::Reset()
 {
 	mNumBytesRead = 0;
 	mSeq = 0;
+	mBuffer.Return();
 }
 
 void TransportRx::HandleReceive(const apl::byte_t* apData, size_t aNumBytes)
@@ -76,18 +77,27 @@ void TransportRx::HandleReceive(const apl::byte_t* apData, size_t aNumBytes)
 		{
 			ERROR_BLOCK(LEV_WARNING, "Exceeded the buffer size before a complete fragment was read", TLERR_BUFFER_FULL);
 			mNumBytesRead = 0;
+			mBuffer.Return();
+		}
+		else if(first && last) //single segment fragment, hand it up without reassembly
+		{
+			mSeq = (mSeq+1)%64;
+			mpContext->ReceiveAPDU(apData+1, payload_len);
 		}
 		else //passed all validation
 		{
+			mBuffer.Borrow();
 			memcpy(mBuffer+mNumBytesRead, apData+1, payload_len);
 			mNumBytesRead += payload_len;
 			mSeq = (mSeq+1)%64;
 			
 			if(last)
 			{
+				// the upper layer can swap the reassembled fragment out rather than copy it
 				size_t tmp = mNumBytesRead;
 				mNumBytesRead = 0;
 				mpContext->ReceiveAPDU(mBuffer, tmp);
+				mBuffer.Return(); // whatever storage the upper layer handed back
 			}
 		}
 	}
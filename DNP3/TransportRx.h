@@ -36,7 +36,8 @@ State/validation for the DNP3 transport layer's receive channel.
 class TransportRx : public Loggable
 {
 	public:
-		TransportRx(Logger*, AsyncTransportLayer*, size_t aFragSize);
+		/// If apPool isn't NULL, the reassembly buffer is only borrowed while a multi-segment fragment is being read
+		TransportRx(Logger*, AsyncTransportLayer*, size_t aFragSize, BufferPool* apPool = NULL);
 
 		void HandleReceive(const apl::byte_t*, size_t);
 
@@ -31,10 +31,10 @@ using namespace std;
 
 namespace apl { namespace dnp {
 
-TransportTx::TransportTx(Logger* apLogger, AsyncTransportLayer* apContext, size_t aFragSize) : 
+TransportTx::TransportTx(Logger* apLogger, AsyncTransportLayer* apContext, size_t aFragSize, BufferPool* apPool) : 
 Loggable(apLogger),
 mpContext(apContext),
-mBufferAPDU(aFragSize),
+mBufferAPDU(aFragSize, apPool),
 mBufferTPDU(TL_MAX_TPDU_LENGTH),
 mNumBytesSent(0),
 mNumBytesToSend(0),
@@ -46,6 +46,7 @@ void TransportTx::Send(const apl::byte_t* apData, size_t aNumBytes)
 	assert(aNumBytes > 0);
 	assert(aNumBytes <= mBufferAPDU.Size());
 	
+	mBufferAPDU.Borrow();
 	memcpy(mBufferAPDU, apData, aNumBytes);
 	mNumBytesToSend = aNumBytes;
 	mNumBytesSent = 0;
@@ -74,10 +75,17 @@ bool TransportTx::CheckForSend()
 	else
 	{
 		mNumBytesSent = mNumBytesToSend = 0;
+		mBufferAPDU.Return();
 		return true;
 	}
 }
 
+void TransportTx::Reset()
+{
+	mNumBytesSent = mNumBytesToSend = 0;
+	mBufferAPDU.Return();
+}
+
 bool TransportTx::SendSuccess()
 {
 	mSeq = (mSeq+1)%64;
@@ -36,12 +36,16 @@ State/validation for the DNP3 transport layer's send channel.
 class TransportTx : public Loggable
 {
 	public:
-		TransportTx(Logger*, AsyncTransportLayer*, size_t aFragSize);
+		/// If apPool isn't NULL, the APDU buffer is only borrowed while a fragment is being sent
+		TransportTx(Logger*, AsyncTransportLayer*, size_t aFragSize, BufferPool* apPool = NULL);
 
 
 		void Send(const apl::byte_t*, size_t); // A fresh call to Send() will reset the state
 		bool SendSuccess();
 
+		/// Abandon the fragment being sent
+		void Reset();
+
 
 		static byte_t GetHeader(bool aFir, bool aFin, int aSeq);
 
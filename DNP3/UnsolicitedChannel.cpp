@@ -24,8 +24,8 @@
 namespace apl { namespace dnp {
 
 
-UnsolicitedChannel::UnsolicitedChannel(Logger* apLogger, AsyncAppLayer* apApp, ITimerSource* apTimerSrc, millis_t aTimeout) :
-AppLayerChannel("Unsolicited", apLogger, apApp, apTimerSrc, aTimeout)
+UnsolicitedChannel::UnsolicitedChannel(Logger* apLogger, AsyncAppLayer* apApp, ITimerSource* apTimerSrc, ITimeSource* apTimeSrc, millis_t aTimeout, RttEstimator* apRtt) :
+AppLayerChannel("Unsolicited", apLogger, apApp, apTimerSrc, apTimeSrc, aTimeout, apRtt)
 {}
 
 void UnsolicitedChannel::OnUnsol(APDU& arAPDU)
@@ -31,7 +31,7 @@ namespace apl { namespace dnp {
 class UnsolicitedChannel : public AppLayerChannel
 {
 	public:
-	UnsolicitedChannel(Logger* apLogger, AsyncAppLayer* apApp, ITimerSource* apTimerSrc, millis_t aTimeout);
+	UnsolicitedChannel(Logger* apLogger, AsyncAppLayer* apApp, ITimerSource* apTimerSrc, ITimeSource* apTimeSrc, millis_t aTimeout, RttEstimator* apRtt = NULL);
 	virtual ~UnsolicitedChannel(){}
 
 	void OnUnsol(APDU& arAPDU);
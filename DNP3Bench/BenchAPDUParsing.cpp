@@ -0,0 +1,76 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+
+#include <APL/TimingTools.h>
+#include <APLTestTools/BufferHelpers.h>
+#include <DNP3/APDU.h>
+
+#include <vector>
+
+using namespace apl;
+using namespace apl::dnp;
+
+namespace {
+
+	/// fragments captured from master/slave sessions, covering the common qualifiers and object types
+	const char* CAPTURED[] = {
+		"C3 01 3C 02 06 3C 03 06 3C 04 06 3C 01 06",
+		"C0 01 01 02 17 03 01 03 05",
+		"C4 02 50 01 00 07 07 00",
+		"C2 02 70 05 17 01 00 68 65 6C 6C 6F",
+		"C0 05 0C 01 17 01 03 41 01 64 00 00 00 64 00 00 00 00",
+		"C0 05 29 01 28 01 00 02 00 64 00 00 00 00",
+		"E3 81 96 00 02 01 28 01 00 00 00 01 02 01 28 01 00 01 00 01 02 01 28 01 00 02 00 01 02 01 28 01 00 03 00 01 20 02 28 01 00 00 00 01 00 00 20 02 28 01 00 01 00 01 00 00 01 01 01 00 00 03 00 00 1E 02 01 00 00 01 00 01 00 00 01 00 00",
+		"C0 81 00 00 01 02 00 00 09 01 01 01 01 01 01 01 01 01 01 1E 04 01 00 00 03 00 00 00 01 00 02 00 03 00"
+	};
+
+	const size_t NUM_CAPTURED = sizeof(CAPTURED)/sizeof(CAPTURED[0]);
+
+}
+
+BOOST_AUTO_TEST_SUITE(APDUParsingBenchmarks)
+
+	/// Interprets the captured fragments over and over, counting the object headers found
+	BOOST_AUTO_TEST_CASE(InterpretCaptured)
+	{
+		const size_t NUM_ITERATIONS = 1000000;
+
+		std::vector<HexSequence*> fragments;
+		for(size_t i = 0; i < NUM_CAPTURED; ++i) fragments.push_back(new HexSequence(CAPTURED[i]));
+
+		APDU frag;
+		size_t num_headers = 0;
+
+		StopWatch sw;
+		for(size_t i = 0; i < NUM_ITERATIONS; ++i) {
+			HexSequence* pHex = fragments[i % NUM_CAPTURED];
+			frag.Write(*pHex, pHex->Size());
+			frag.Interpret();
+			num_headers += frag.BeginRead().Count();
+		}
+		millis_t elapsed = sw.Elapsed();
+
+		for(size_t i = 0; i < NUM_CAPTURED; ++i) delete fragments[i];
+
+		BOOST_REQUIRE(num_headers >= NUM_ITERATIONS); // every captured fragment has at least one header
+		BOOST_TEST_MESSAGE("Interpreted " << NUM_ITERATIONS << " fragments (" << num_headers << " object headers) in " << elapsed << "ms");
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
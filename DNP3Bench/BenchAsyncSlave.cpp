@@ -0,0 +1,164 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+
+#include <APL/Log.h>
+#include <APL/TimeSource.h>
+#include <APL/TimingTools.h>
+#include <APLTestTools/MockTimerSource.h>
+#include <APLTestTools/BufferHelpers.h>
+#include <DNP3/AsyncSlave.h>
+#include <DNP3/AsyncDatabase.h>
+#include <DNP3/DNPCommandMaster.h>
+#include <DNP3/SlaveConfig.h>
+
+#include <sstream>
+
+using namespace apl;
+using namespace apl::dnp;
+
+namespace {
+
+	/// Stands in for the app layer, counts the response bytes and completes every send immediately
+	class ResponseCounter : public IAsyncAppLayer
+	{
+		public:
+			ResponseCounter() : mpUser(NULL), mBytes(0) {}
+
+			void SetUser(IAsyncAppUser* apUser) { mpUser = apUser; }
+
+			void SendResponse(APDU& arAPDU) { mBytes += arAPDU.Size(); mpUser->OnSolSendSuccess(); }
+			void SendUnsolicited(APDU& arAPDU) { mpUser->OnUnsolSendSuccess(); }
+			void SendRequest(APDU&) {}
+			void CancelResponse() {}
+
+			size_t TakeBytes() { size_t bytes = mBytes; mBytes = 0; return bytes; }
+
+		private:
+			IAsyncAppUser* mpUser;
+			size_t mBytes;
+	};
+
+	/// A slave with nothing below its app layer, polled directly
+	class SlaveBench
+	{
+		public:
+			SlaveBench() :
+				db(log.GetLogger(LEV_WARNING, "db")),
+				cmd_master(10000),
+				slave(log.GetLogger(LEV_WARNING, "slave"), &app, &mts, &fakeTime, &db, &cmd_master, Config())
+			{
+				app.SetUser(&slave);
+			}
+
+			/// Sends a class 0 read and returns the number of response bytes
+			size_t IntegrityPoll(size_t aSeq)
+			{
+				std::ostringstream oss;
+				oss << std::hex << std::uppercase << (0xC0 | (aSeq % 16)) << " 01 3C 01 06";
+				HexSequence hs(oss.str());
+				mRequest.Reset();
+				mRequest.Write(hs, hs.Size());
+				mRequest.Interpret();
+				slave.OnRequest(mRequest, SI_OTHER);
+				return app.TakeBytes();
+			}
+
+			EventLog log;
+			MockTimeManager fakeTime;
+			MockTimerSource mts;
+			ResponseCounter app;
+			AsyncDatabase db;
+			DNPCommandMaster cmd_master;
+			AsyncSlave slave;
+
+		private:
+			static SlaveConfig Config() { SlaveConfig cfg; cfg.mDisableUnsol = true; return cfg; }
+
+			APDU mRequest;
+	};
+
+}
+
+BOOST_AUTO_TEST_SUITE(AsyncSlaveBenchmarks)
+
+	BOOST_AUTO_TEST_CASE(IntegrityPollThroughput)
+	{
+		const size_t NUM_POINTS = 100;
+		const size_t NUM_POLLS = 10000;
+
+		SlaveBench b;
+		b.db.Configure(DT_BINARY, NUM_POINTS);
+		b.db.Configure(DT_ANALOG, NUM_POINTS);
+		b.db.Configure(DT_COUNTER, NUM_POINTS);
+		b.slave.OnLowerLayerUp();
+
+		{
+			Transaction tr(&b.db);
+			for(size_t i=0; i<NUM_POINTS; i++) {
+				b.db.Update(Binary(i % 2 == 0, BQ_ONLINE), i);
+				b.db.Update(Analog(i, AQ_ONLINE), i);
+				b.db.Update(Counter(i, CQ_ONLINE), i);
+			}
+		}
+
+		size_t bytes = 0;
+		StopWatch sw;
+		for(size_t i = 0; i < NUM_POLLS; ++i) bytes += b.IntegrityPoll(i);
+		millis_t elapsed = sw.Elapsed();
+
+		BOOST_REQUIRE_EQUAL(bytes, NUM_POLLS * b.IntegrityPoll(NUM_POLLS));
+		BOOST_TEST_MESSAGE("sizeof Binary/Analog/Counter: " << sizeof(Binary) << "/" << sizeof(Analog) << "/" << sizeof(Counter)
+			<< " packed: " << sizeof(PackedBinary) << "/" << sizeof(PackedAnalog) << "/" << sizeof(PackedCounter));
+		BOOST_TEST_MESSAGE(NUM_POLLS << " integrity polls of " << 3*NUM_POINTS << " points (" << bytes << " bytes) in " << elapsed << "ms");
+	}
+
+	/// A few points change between polls, then every point changes between polls
+	BOOST_AUTO_TEST_CASE(IntegrityPollStaticImage)
+	{
+		const size_t NUM_POINTS = 10000;
+		const size_t NUM_POLLS = 100;
+		const size_t NUM_CHANGES = 10;
+
+		SlaveBench b;
+		b.db.Configure(DT_ANALOG, NUM_POINTS, true);
+		b.slave.OnLowerLayerUp();
+
+		int_64_t few = 0, all = 0;
+		size_t bytes = 0;
+		for(size_t i = 0; i < 2*NUM_POLLS; ++i) {
+			size_t num_changes = (i < NUM_POLLS) ? NUM_CHANGES : NUM_POINTS;
+			{
+				Transaction tr(&b.db);
+				for(size_t j = 0; j < num_changes; ++j) b.db.Update(Analog(static_cast<double>(i), AQ_ONLINE), (i*7919 + j) % NUM_POINTS);
+			}
+
+			StopWatch sw;
+			size_t poll_bytes = b.IntegrityPoll(i);
+			((i < NUM_POLLS) ? few : all) += sw.ElapsedUS();
+
+			if(i == 0) bytes = poll_bytes;
+			BOOST_REQUIRE_EQUAL(poll_bytes, bytes);
+		}
+
+		BOOST_TEST_MESSAGE(NUM_POLLS << " integrity polls of " << NUM_POINTS << " analogs (" << bytes << " bytes), "
+			<< NUM_CHANGES << " changes per poll: " << few << "us, every point changed: " << all << "us");
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+
+#include <APL/AsyncTaskScheduler.h>
+#include <APL/AsyncTaskGroup.h>
+#include <APL/TimeSource.h>
+#include <APL/TimingTools.h>
+#include <APLTestTools/MockTimerSource.h>
+
+#include <boost/bind.hpp>
+#include <deque>
+
+using namespace apl;
+
+namespace {
+
+	/// completes every task it's handed, in order
+	class CompletingHandler
+	{
+		public:
+
+		CompletingHandler() : mNumDispatched(0) {}
+
+		TaskHandler GetHandler() { return boost::bind(&CompletingHandler::OnTask, this, _1); }
+
+		void CompleteAll()
+		{
+			while(!mTasks.empty()) {
+				ITask* p = mTasks.front();
+				mTasks.pop_front();
+				++mNumDispatched;
+				p->OnComplete(true);
+			}
+		}
+
+		size_t mNumDispatched;
+
+		private:
+
+		void OnTask(ITask* apTask) { mTasks.push_back(apTask); }
+
+		std::deque<ITask*> mTasks;
+	};
+
+	/// @return milliseconds to dispatch aNumRounds periods of aNumTasks periodic tasks in one group
+	millis_t TimePeriodicTasks(size_t aNumTasks, size_t aNumRounds)
+	{
+		CompletingHandler handler;
+		MockTimerSource mts;
+		MockTimeSource fake_time;
+		AsyncTaskScheduler ats(&mts, &fake_time);
+		fake_time.SetToNow();
+
+		AsyncTaskGroup* pGroup = ats.NewGroup();
+		for(size_t i = 0; i < aNumTasks; ++i) pGroup->Add(1000, 100, static_cast<int>(i % 4), handler.GetHandler());
+
+		StopWatch sw;
+		pGroup->Enable();
+		for(size_t round = 0; round < aNumRounds; ++round) {
+			handler.CompleteAll();
+			fake_time.Advance(1000);
+			mts.DispatchOne();
+		}
+		millis_t elapsed = sw.Elapsed();
+
+		BOOST_REQUIRE_EQUAL(handler.mNumDispatched, aNumTasks * aNumRounds);
+		return elapsed;
+	}
+
+}
+
+BOOST_AUTO_TEST_SUITE(AsyncTaskBenchmarks)
+
+	BOOST_AUTO_TEST_CASE(ManyPeriodicTasks)
+	{
+		const size_t NUM_ROUNDS = 5;
+		const size_t NUM_SIZES = 2;
+		const size_t NUM_TASKS[NUM_SIZES] = { 1000, 10000 };
+
+		for(size_t i = 0; i < NUM_SIZES; ++i) {
+			millis_t elapsed = TimePeriodicTasks(NUM_TASKS[i], NUM_ROUNDS);
+			BOOST_TEST_MESSAGE(NUM_TASKS[i] * NUM_ROUNDS << " dispatches of " << NUM_TASKS[i] << " periodic tasks in " << elapsed << "ms");
+		}
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,54 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+
+#include <APL/CRC.h>
+#include <APL/TimingTools.h>
+#include <APLTestTools/BufferHelpers.h>
+#include <DNP3/DNPCrc.h>
+#include <DNP3/LinkLayerConstants.h>
+
+using namespace apl;
+using namespace apl::dnp;
+
+BOOST_AUTO_TEST_SUITE(CRCBenchmarks)
+
+	/// Full data blocks through the byte-at-a-time reference and the sliced DNP CRC
+	BOOST_AUTO_TEST_CASE(DataBlocks)
+	{
+		unsigned int table[256];
+		apl::CRC::PrecomputeCRC(table, 0xA6BC);
+
+		const size_t NUM_ITERATIONS = 2000000;
+		ByteStr buff(LS_DATA_BLOCK_SIZE, 0x3A);
+		unsigned int sum1 = 0, sum2 = 0; // keeps the optimizer honest
+
+		StopWatch sw;
+		for(size_t i = 0; i < NUM_ITERATIONS; ++i) sum1 += apl::CRC::CalcCRC(buff, LS_DATA_BLOCK_SIZE, table, 0x0000, true);
+		millis_t reference = sw.Elapsed();
+
+		sw.Restart();
+		for(size_t i = 0; i < NUM_ITERATIONS; ++i) sum2 += DNPCrc::CalcCrc(buff, LS_DATA_BLOCK_SIZE);
+		millis_t sliced = sw.Elapsed();
+
+		BOOST_REQUIRE_EQUAL(sum1, sum2);
+		BOOST_TEST_MESSAGE("CRC of " << NUM_ITERATIONS << " data blocks, reference: " << reference << "ms, sliced: " << sliced << "ms");
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
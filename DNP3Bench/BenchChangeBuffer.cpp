@@ -0,0 +1,112 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+
+#include <APL/ChangeBuffer.h>
+#include <APL/Lock.h>
+#include <APL/Thread.h>
+#include <APL/TimingTools.h>
+
+using namespace apl;
+
+namespace {
+
+	/// counts the points it receives, accepting runs directly
+	class CountingObserver : public IDataObserver
+	{
+		public:
+
+		CountingObserver() : mCount(0) {}
+
+		size_t mCount;
+
+		private:
+
+		void _Start() {}
+		void _End() {}
+
+		void _Update(const Binary&, size_t) { ++mCount; }
+		void _Update(const Analog&, size_t) { ++mCount; }
+		void _Update(const Counter&, size_t) { ++mCount; }
+		void _Update(const ControlStatus&, size_t) { ++mCount; }
+		void _Update(const SetpointStatus&, size_t) { ++mCount; }
+
+		void _Update(const Analog*, size_t aNum, size_t) { mCount += aNum; }
+	};
+
+	/// writes aNumUpdates analogs in transactions of aBatchSize
+	class Producer : public Threadable
+	{
+		public:
+
+		Producer(IDataObserver* apObserver, size_t aNumUpdates, size_t aBatchSize) :
+			mpObserver(apObserver), mNumUpdates(aNumUpdates), mBatchSize(aBatchSize)
+		{}
+
+		std::string Description() const { return "Producer"; }
+
+		private:
+
+		void Run()
+		{
+			size_t num = 0;
+			while(num < mNumUpdates) {
+				Transaction tr(mpObserver);
+				for(size_t i = 0; i < mBatchSize && num < mNumUpdates; ++i, ++num)
+					mpObserver->Update(Analog(static_cast<double>(num)), num % 1000);
+			}
+		}
+
+		IDataObserver* mpObserver;
+		size_t mNumUpdates;
+		size_t mBatchSize;
+	};
+
+}
+
+BOOST_AUTO_TEST_SUITE(ChangeBufferBenchmarks)
+
+	/// A producer thread fills the buffer while this thread flushes it
+	BOOST_AUTO_TEST_CASE(ProducerThroughput)
+	{
+		const size_t NUM_UPDATES = 1000000;
+
+		ChangeBuffer<SigLock> buffer;
+		CountingObserver obs;
+		Producer producer(&buffer, NUM_UPDATES, 100);
+		Thread thread(&producer);
+
+		StopWatch sw;
+		thread.Start();
+
+		size_t count = 0;
+		while(count < NUM_UPDATES) {
+			size_t num = buffer.FlushUpdates(&obs);
+			if(num == 0) Thread::SleepFor(1);
+			count += num;
+		}
+
+		millis_t elapsed = sw.Elapsed();
+		thread.WaitForStop();
+
+		BOOST_REQUIRE_EQUAL(obs.mCount, NUM_UPDATES);
+		BOOST_TEST_MESSAGE(NUM_UPDATES << " updates from a producer thread in " << elapsed << "ms");
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,66 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+
+#include <APL/Log.h>
+#include <APL/DeferredLog.h>
+#include <APL/Thread.h>
+#include <APL/TimingTools.h>
+
+using namespace apl;
+
+namespace {
+
+	/// Times logging of link frames the way the physical layers do with LEV_COMM enabled
+	millis_t TimeFrameLogging(Logger* apLogger, size_t aNumFrames)
+	{
+		byte_t frame[292];
+		for(size_t i = 0; i < sizeof(frame); ++i) frame[i] = static_cast<byte_t>(i);
+
+		StopWatch sw;
+		for(size_t i = 0; i < aNumFrames; ++i) apLogger->LogBytes(LEV_COMM, "PhysicalLayer(100)", "<~~", frame, sizeof(frame));
+		return sw.Elapsed();
+	}
+
+}
+
+BOOST_AUTO_TEST_SUITE(LogBenchmarks)
+
+	BOOST_AUTO_TEST_CASE(FrameLogging)
+	{
+		const size_t NUM_FRAMES = 20000;
+
+		EventLog log;
+		LogEntryCircularBuffer buff(100);
+		log.AddLogSubscriber(&buff);
+		Logger* pLogger = log.GetLogger(LEV_COMM, "LogBench");
+
+		millis_t immediate = TimeFrameLogging(pLogger, NUM_FRAMES);
+		millis_t deferred = 0;
+		{
+			DeferredLog dl(&log, NUM_FRAMES, 100000);
+			Thread::SleepFor(20); // let the drain thread go to sleep
+			deferred = TimeFrameLogging(pLogger, NUM_FRAMES);
+			BOOST_REQUIRE_EQUAL(dl.Flush(), NUM_FRAMES);
+		}
+
+		BOOST_TEST_MESSAGE(NUM_FRAMES << " frames, immediate: " << immediate << "ms, deferred on the calling thread: " << deferred << "ms");
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
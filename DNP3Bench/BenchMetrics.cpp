@@ -0,0 +1,58 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+
+#include <APL/MetricRegistry.h>
+#include <APL/MetricBuffer.h>
+#include <APL/Log.h>
+#include <APL/TimingTools.h>
+
+using namespace apl;
+
+BOOST_AUTO_TEST_SUITE(MetricBenchmarks)
+
+	BOOST_AUTO_TEST_CASE(CounterUpdates)
+	{
+		const size_t NUM_UPDATES = 1000000;
+
+		EventLog log;
+		MetricBuffer buffer;
+		log.AddLogSubscriber(&buffer);
+		Logger* pLogger = log.GetLogger(LEV_WARNING, "bench");
+		pLogger->SetVarName("bench");
+		LogCounter counter(pLogger, "frames_rx");
+
+		StopWatch sw;
+		for(size_t i = 0; i < NUM_UPDATES; ++i) counter.Increment();
+		millis_t logged = sw.Elapsed();
+
+		MetricRegistry reg;
+		MetricHandle c = reg.RegisterCounter("bench.frames_rx");
+		sw.Restart();
+		for(size_t i = 0; i < NUM_UPDATES; ++i) reg.Increment(c);
+		millis_t registry = sw.Elapsed();
+
+		MetricSnapshot s;
+		BOOST_REQUIRE(reg.Read("bench.frames_rx", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, NUM_UPDATES);
+
+		BOOST_TEST_MESSAGE(NUM_UPDATES << " counter updates, LogCounter: " << logged << "ms, MetricRegistry: " << registry << "ms");
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,61 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+
+#include <APL/PackingUnpacking.h>
+#include <APL/TimingTools.h>
+
+#include <vector>
+
+using namespace apl;
+
+namespace {
+
+	/// the bit at a time read the loaders used before PackedBits
+	bool ReadBit(const byte_t* apPos, size_t aIndex)
+	{ return (apPos[aIndex >> 3] & (1 << (aIndex & 0x07))) != 0; }
+
+}
+
+BOOST_AUTO_TEST_SUITE(PackingUnpackingBenchmarks)
+
+	BOOST_AUTO_TEST_CASE(PackedBitsUnpack)
+	{
+		const size_t NUM_POINTS = 100000;
+		const size_t NUM_ITERATIONS = 200;
+
+		std::vector<byte_t> bits(PackedBits::GetSize(NUM_POINTS));
+		for(size_t i = 0; i < bits.size(); ++i) bits[i] = static_cast<byte_t>(i * 37 + 11);
+		std::vector<byte_t> a(NUM_POINTS), b(NUM_POINTS);
+
+		StopWatch sw;
+		for(size_t j = 0; j < NUM_ITERATIONS; ++j) {
+			for(size_t i = 0; i < NUM_POINTS; ++i) a[i] = ReadBit(&bits[0], i) ? 1 : 0;
+		}
+		millis_t per_bit = sw.Elapsed();
+
+		sw.Restart();
+		for(size_t j = 0; j < NUM_ITERATIONS; ++j) PackedBits::Unpack(&bits[0], NUM_POINTS, &b[0]);
+		millis_t bulk = sw.Elapsed();
+
+		BOOST_REQUIRE(a == b);
+		BOOST_TEST_MESSAGE(NUM_ITERATIONS << " x " << NUM_POINTS << " bit unpack, per bit: " << per_bit << "ms, PackedBits: " << bulk << "ms");
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,166 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#define BOOST_TEST_MODULE dnp3bench
+#include <boost/test/unit_test.hpp>
+
+#include <APL/Log.h>
+#include <APL/TimingTools.h>
+#include <APLTestTools/BufferHelpers.h>
+#include <DNP3/APDU.h>
+#include <DNP3/DNPConstants.h>
+#include <DNP3/HeaderReadIterator.h>
+#include <DNP3/ResponseLoader.h>
+#include <DNP3/Objects.h>
+
+#include <sstream>
+#include <iomanip>
+
+using namespace apl;
+using namespace apl::dnp;
+
+namespace {
+
+	/// counts the points it receives, accepting runs directly
+	class PointCountingObserver : public IDataObserver
+	{
+		public:
+
+		PointCountingObserver() : mNumPoints(0) {}
+
+		size_t mNumPoints;
+
+		private:
+
+		void _Start() {}
+		void _End() {}
+
+		void _Update(const Binary&, size_t) { ++mNumPoints; }
+		void _Update(const Analog&, size_t) { ++mNumPoints; }
+		void _Update(const Counter&, size_t) { ++mNumPoints; }
+		void _Update(const ControlStatus&, size_t) { ++mNumPoints; }
+		void _Update(const SetpointStatus&, size_t) { ++mNumPoints; }
+
+		void _Update(const Binary*, size_t aNum, size_t) { mNumPoints += aNum; }
+		void _Update(const Analog*, size_t aNum, size_t) { mNumPoints += aNum; }
+		void _Update(const Counter*, size_t aNum, size_t) { mNumPoints += aNum; }
+	};
+
+	/// appends a 0x01 qualified header for aNum objects of aSize bytes with varying contents
+	void AppendRange(std::ostringstream& arHex, int aGroup, int aVar, size_t aNum, size_t aSize)
+	{
+		arHex << std::hex << std::setfill('0');
+		arHex << " " << std::setw(2) << aGroup << " " << std::setw(2) << aVar << " 01 00 00 ";
+		arHex << std::setw(2) << ((aNum - 1) & 0xFF) << " " << std::setw(2) << ((aNum - 1) >> 8);
+		for(size_t i = 0; i < aNum; ++i) {
+			arHex << " 01";	// online
+			for(size_t j = 1; j < aSize; ++j) arHex << " " << std::setw(2) << ((i * 7 + j) & 0xFF);
+		}
+	}
+
+	/// Decodes a ranged header one object at a time and publishes it as a run, the way
+	/// ResponseLoader did before StreamObject::ReadRange
+	template <class T>
+	void ReadPerObject(HeaderReadIterator& arIter, StreamObject<T>* apObj, IDataObserver* apObserver, std::vector<T>& arRun)
+	{
+		ObjectReadIterator obj = arIter.BeginRead();
+		size_t start = obj.IsEnd() ? 0 : obj->Index();
+		arRun.clear();
+
+		for( ; !obj.IsEnd(); ++obj) {
+			T value = apObj->Read(*obj);
+			if(!apObj->HasQuality()) value.SetQuality(T::ONLINE);
+			arRun.push_back(value);
+		}
+
+		if(!arRun.empty()) apObserver->Update(&arRun[0], arRun.size(), start);
+	}
+
+	/// The reference decoder for the headers RangeDecode builds
+	class PerObjectLoader
+	{
+		public:
+			PerObjectLoader(IDataObserver* apObserver) : mpObserver(apObserver), mTransaction(apObserver) {}
+
+			void Process(HeaderReadIterator& arIter)
+			{
+				switch(MACRO_DNP_RADIX(arIter->GetGroup(), arIter->GetVariation()))
+				{
+					case(MACRO_DNP_RADIX(1,2)): ReadPerObject(arIter, Group1Var2::Inst(), mpObserver, mBinaries); break;
+					case(MACRO_DNP_RADIX(20,1)): ReadPerObject(arIter, Group20Var1::Inst(), mpObserver, mCounters); break;
+					case(MACRO_DNP_RADIX(30,1)): ReadPerObject(arIter, Group30Var1::Inst(), mpObserver, mAnalogs); break;
+					default: BOOST_FAIL("unexpected header");
+				}
+			}
+
+		private:
+			IDataObserver* mpObserver;
+			Transaction mTransaction;
+			std::vector<Binary> mBinaries;
+			std::vector<Counter> mCounters;
+			std::vector<Analog> mAnalogs;
+	};
+
+	template <class Loader>
+	millis_t TimeDecoding(APDU& arFrag, Loader& arLoader, size_t aNumIterations)
+	{
+		StopWatch sw;
+		for(size_t i = 0; i < aNumIterations; ++i) {
+			for(HeaderReadIterator hdr = arFrag.BeginRead(); !hdr.IsEnd(); ++hdr) arLoader.Process(hdr);
+		}
+		return sw.Elapsed();
+	}
+
+}
+
+BOOST_AUTO_TEST_SUITE(ResponseLoaderBenchmarks)
+
+	// 2025 byte integrity response with binaries, counters and analogs
+	BOOST_AUTO_TEST_CASE(RangeDecode)
+	{
+		const size_t NUM_ITERATIONS = 20000;
+
+		std::ostringstream hex;
+		hex << "C0 81 00 00";
+		AppendRange(hex, 1, 2, 500, 1);
+		AppendRange(hex, 20, 1, 150, 5);
+		AppendRange(hex, 30, 1, 150, 5);
+
+		HexSequence hs(hex.str());
+		APDU frag;
+		frag.Write(hs, hs.Size());
+		frag.Interpret();
+		BOOST_REQUIRE(frag.Size() <= 2048);
+
+		PointCountingObserver obs;
+		millis_t per_object = 0, per_range = 0;
+		{
+			PerObjectLoader reference(&obs);
+			per_object = TimeDecoding(frag, reference, NUM_ITERATIONS);
+		}
+		{
+			EventLog log;
+			ResponseLoader rl(log.GetLogger(LEV_INFO, "rsp"), &obs);
+			per_range = TimeDecoding(frag, rl, NUM_ITERATIONS);
+		}
+
+		BOOST_REQUIRE_EQUAL(obs.mNumPoints, 2 * NUM_ITERATIONS * 800);
+		BOOST_TEST_MESSAGE(NUM_ITERATIONS << " fragments, per object: " << per_object << "ms, per range: " << per_range << "ms");
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,111 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <APL/ASIOIncludes.h>
+#include <boost/test/unit_test.hpp>
+
+#include <APL/Log.h>
+#include <APL/FlexibleDataObserver.h>
+#include <APL/TimingTools.h>
+#include <DNP3/AsyncStackManager.h>
+
+#include <boost/foreach.hpp>
+#include <sstream>
+
+using namespace apl;
+using namespace apl::dnp;
+
+namespace {
+
+	/// Adds aNumPorts TCP clients with aStacksPerPort masters each
+	void AddMasters(StackBatch& arBatch, size_t aNumPorts, size_t aStacksPerPort, IDataObserver* apPublisher)
+	{
+		for(size_t i = 0; i < aNumPorts; ++i) {
+			std::ostringstream port;
+			port << "port" << i;
+			arBatch.AddTCPClient(port.str(), PhysLayerSettings(LEV_WARNING, 1000), TCPSettings("127.0.0.1", 30000));
+
+			for(size_t j = 0; j < aStacksPerPort; ++j) {
+				std::ostringstream stack;
+				stack << port.str() << " - stack" << j;
+				MasterStackConfig cfg;
+				cfg.link.LocalAddr = static_cast<uint_16_t>(j);
+				arBatch.AddMaster(port.str(), stack.str(), LEV_WARNING, apPublisher, cfg);
+			}
+		}
+	}
+
+}
+
+BOOST_AUTO_TEST_SUITE(StartupTeardownBenchmarks)
+
+	/// Brings thousands of masters up and tears them down again, added one at a time and as a batch.
+	/// The io_service isn't running, so the teardown includes running out the posted associations.
+	/// Startup and teardown should scale linearly, so the time per stack may not grow much with the count.
+	BOOST_AUTO_TEST_CASE(BatchStartupTeardown)
+	{
+		const size_t STACKS_PER_PORT = 100;
+		const size_t NUM_RUNS = 2;
+		const size_t NUM_STACKS[NUM_RUNS] = { 1000, 10000 };
+		const double MAX_GROWTH = 4.0;	// per stack, from the first run to the last. Quadratic growth would be 10
+
+		FlexibleDataObserver fdo;
+		double singleUp[NUM_RUNS], singleDown[NUM_RUNS], batchedUp[NUM_RUNS], batchedDown[NUM_RUNS];
+
+		for(size_t n = 0; n < NUM_RUNS; ++n) {
+			StackBatch batch;
+			AddMasters(batch, NUM_STACKS[n] / STACKS_PER_PORT, STACKS_PER_PORT, &fdo);
+			double stacks = static_cast<double>(NUM_STACKS[n]);
+
+			{
+				EventLog log;
+				AsyncStackManager* pMgr = new AsyncStackManager(log.GetLogger(LEV_ERROR, "mgr"));
+				StopWatch sw;
+				BOOST_FOREACH(StackBatch::PortRecord& r, batch.mPorts) { pMgr->AddTCPClient(r.mName, r.mPhys, r.mTcp); }
+				BOOST_FOREACH(StackBatch::MasterRecord& r, batch.mMasters) { pMgr->AddMaster(r.mPortName, r.mStackName, r.mLevel, r.mpPublisher, r.mConfig); }
+				singleUp[n] = sw.ElapsedUS() / stacks;
+				BOOST_REQUIRE_EQUAL(pMgr->GetStackNames().size(), NUM_STACKS[n]);
+				sw.Restart();
+				delete pMgr;
+				singleDown[n] = sw.ElapsedUS() / stacks;
+			}
+
+			{
+				EventLog log;
+				AsyncStackManager* pMgr = new AsyncStackManager(log.GetLogger(LEV_ERROR, "mgr"));
+				StopWatch sw;
+				pMgr->AddBatch(batch);
+				batchedUp[n] = sw.ElapsedUS() / stacks;
+				BOOST_REQUIRE_EQUAL(pMgr->GetStackNames().size(), NUM_STACKS[n]);
+				sw.Restart();
+				delete pMgr;
+				batchedDown[n] = sw.ElapsedUS() / stacks;
+			}
+
+			BOOST_TEST_MESSAGE(NUM_STACKS[n] << " masters on " << batch.mPorts.size() << " ports, per stack, one at a time: " << singleUp[n] << "us up, "
+				<< singleDown[n] << "us down, batched: " << batchedUp[n] << "us up, " << batchedDown[n] << "us down");
+		}
+
+		const size_t last = NUM_RUNS - 1;
+		BOOST_CHECK_MESSAGE(singleUp[last] < MAX_GROWTH * singleUp[0], "startup one at a time doesn't scale linearly");
+		BOOST_CHECK_MESSAGE(singleDown[last] < MAX_GROWTH * singleDown[0], "teardown after adding one at a time doesn't scale linearly");
+		BOOST_CHECK_MESSAGE(batchedUp[last] < MAX_GROWTH * batchedUp[0], "batched startup doesn't scale linearly");
+		BOOST_CHECK_MESSAGE(batchedDown[last] < MAX_GROWTH * batchedDown[0], "batched teardown doesn't scale linearly");
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
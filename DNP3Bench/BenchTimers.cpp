@@ -0,0 +1,87 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <APL/ASIOIncludes.h>
+#include <boost/test/unit_test.hpp>
+
+#include <APL/TimerSourceASIO.h>
+#include <APL/TimerSourceWheel.h>
+#include <APL/TimingTools.h>
+
+#include <vector>
+#include <boost/bind.hpp>
+
+using namespace apl;
+
+namespace {
+
+	/// counts expirations, none are expected
+	class CountingHandler
+	{
+		public:
+			CountingHandler() : mCount(0) {}
+
+			void OnExpiration() { ++mCount; }
+			size_t GetCount() { return mCount; }
+
+		private:
+			size_t mCount;
+	};
+
+	/// Restarts a set of long running timers the way stacks restart their response timers
+	template <class T>
+	millis_t TimeChurn(size_t aNumTimers, size_t aNumRounds)
+	{
+		boost::asio::io_service srv;
+		T ts(&srv);
+		CountingHandler handler;
+		std::vector<ITimer*> timers(aNumTimers);
+
+		StopWatch sw;
+		for(size_t i = 0; i < aNumTimers; ++i) timers[i] = ts.Start(5000 + i % 1000, boost::bind(&CountingHandler::OnExpiration, &handler));
+		for(size_t r = 0; r < aNumRounds; ++r) {
+			for(size_t i = 0; i < aNumTimers; ++i) {
+				timers[i]->Cancel();
+				timers[i] = ts.Start(5000 + (i + r) % 1000, boost::bind(&CountingHandler::OnExpiration, &handler));
+			}
+			srv.poll();
+		}
+		for(size_t i = 0; i < aNumTimers; ++i) timers[i]->Cancel();
+		srv.poll();
+		millis_t elapsed = sw.Elapsed();
+
+		BOOST_REQUIRE_EQUAL(0, handler.GetCount());
+		return elapsed;
+	}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TimerBenchmarks)
+
+	BOOST_AUTO_TEST_CASE(WheelChurn)
+	{
+		const size_t NUM_TIMERS = 10000;
+		const size_t NUM_ROUNDS = 20;
+
+		millis_t asio = TimeChurn<TimerSourceASIO>(NUM_TIMERS, NUM_ROUNDS);
+		millis_t wheel = TimeChurn<TimerSourceWheel>(NUM_TIMERS, NUM_ROUNDS);
+
+		BOOST_TEST_MESSAGE(NUM_TIMERS * NUM_ROUNDS << " restarts, TimerSourceASIO: " << asio << "ms, TimerSourceWheel: " << wheel << "ms");
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -22,17 +22,25 @@
 
 namespace apl { namespace dnp {
 
-AppLayerTest::AppLayerTest(bool aIsMaster, size_t aNumRetry, FilterLevel aLevel, bool aImmediate) :
+AppLayerTest::AppLayerTest(bool aIsMaster, size_t aNumRetry, FilterLevel aLevel, bool aImmediate, bool aAdaptiveTimeout) :
 LogTester(aImmediate),
 user(aIsMaster),
 lower(mLog.GetLogger(aLevel, "lower")),
 mts(),
-app(mLog.GetLogger(aLevel, "app"), &mts, AppConfig(1000, aNumRetry))
+fake_time(),
+app(mLog.GetLogger(aLevel, "app"), &mts, MakeConfig(aNumRetry, aAdaptiveTimeout), NULL, &fake_time)
 {
 	lower.SetUpperLayer(&app);
 	app.SetUser(&user);
 }
 
+AppConfig AppLayerTest::MakeConfig(size_t aNumRetry, bool aAdaptiveTimeout)
+{
+	AppConfig cfg(1000, aNumRetry);
+	cfg.AdaptiveTimeout = aAdaptiveTimeout;
+	return cfg;
+}
+
 void AppLayerTest::SendUp(const std::string& aBytes)
 {
 	HexSequence hs(aBytes);
@@ -33,7 +33,9 @@ namespace apl { namespace dnp {
 class AppLayerTest : public LogTester
 {
 	public:
-	AppLayerTest(bool aIsMaster = false, size_t aNumRetry = 0, FilterLevel aLevel = LEV_WARNING, bool aImmediate = false);
+	AppLayerTest(bool aIsMaster = false, size_t aNumRetry = 0, FilterLevel aLevel = LEV_WARNING, bool aImmediate = false, bool aAdaptiveTimeout = false);
+
+	static AppConfig MakeConfig(size_t aNumRetry, bool aAdaptiveTimeout);
 
 	void SendUp(const std::string& aBytes);
 	void SendUp(FunctionCodes aCode, bool aFIR, bool aFIN, bool aCON, bool aUNS, int aSEQ);
@@ -49,6 +51,7 @@ class AppLayerTest : public LogTester
 	MockAppUser user;
 	MockLowerLayer lower;
 	MockTimerSource mts;
+	MockTimeSource fake_time;
 	AsyncAppLayer app;
 
 	MockAppUser::State state;
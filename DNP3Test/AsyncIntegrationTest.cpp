@@ -39,12 +39,33 @@ using namespace std;
 
 namespace apl { namespace dnp {
 
-AsyncIntegrationTest::AsyncIntegrationTest(Logger* apLogger, FilterLevel aLevel, uint_16_t aStartPort, size_t aNumPairs, size_t aNumPoints) :
+AsyncIntegrationTest::AsyncIntegrationTest(Logger* apLogger, FilterLevel aLevel, uint_16_t aStartPort, size_t aNumPairs, size_t aNumPoints, Topology aTopology,
+										   millis_t aTimerWheelResolution) :
 AsyncStackManager(apLogger),
 M_START_PORT(aStartPort),
+M_TOPOLOGY(aTopology),
+M_TIMER_WHEEL_RESOLUTION(aTimerWheelResolution),
 mChange(false),
+mMaxLanesRunning(0),
 mNotifier(boost::bind(&AsyncIntegrationTest::RegisterChange, this))
 {
+	PhysLayerSettings s(aLevel, 1000, M_TIMER_WHEEL_RESOLUTION);
+	TCPSettings tcp("127.0.0.1", aStartPort);
+	tcp.mConcurrentMasters = (aTopology == TP_CONCURRENT_CHANNEL);
+
+	switch(aTopology) {
+		case(TP_LISTENER):
+			this->AddTCPListener("listener", s, tcp);
+			break;
+		case(TP_CONCURRENT_CHANNEL):
+		case(TP_SHARED_CHANNEL):
+			this->AddTCPClient("channel client", s, tcp);
+			this->AddTCPServer("channel server", s, tcp);
+			break;
+		default:
+			break;
+	}
+
 	for(size_t i=0; i<aNumPairs; ++i) AddStackPair(aLevel, aNumPoints);
 	mFanout.Add(&mLocalFDO);
 }
@@ -54,7 +75,11 @@ AsyncIntegrationTest::~AsyncIntegrationTest()
 	BOOST_FOREACH(FlexibleDataObserver* pFDO, mMasterObservers) { delete pFDO; }
 }
 
-void AsyncIntegrationTest::Next() { AsyncTestObject::Next(this->mService.Get(), 10); }
+void AsyncIntegrationTest::Next()
+{
+	AsyncTestObject::Next(this->mService.Get(), 10);
+	mMaxLanesRunning = std::max(mMaxLanesRunning, this->NumLanesRunning());
+}
 
 bool AsyncIntegrationTest::SameData()
 {
@@ -96,20 +121,30 @@ Counter AsyncIntegrationTest::RandomCounter()
 
 void AsyncIntegrationTest::AddStackPair(FilterLevel aLevel, size_t aNumPoints)
 {
-	uint_16_t port = M_START_PORT + this->mMasterObservers.size();
+	size_t index = this->mMasterObservers.size();
+	bool listener = (M_TOPOLOGY == TP_LISTENER);
+	bool channel = (M_TOPOLOGY == TP_CONCURRENT_CHANNEL || M_TOPOLOGY == TP_SHARED_CHANNEL);
+	uint_16_t port = (M_TOPOLOGY == TP_PORT_PER_PAIR) ? M_START_PORT + index : M_START_PORT;
+	uint_16_t outstation = static_cast<uint_16_t>(1024 + index); // only has to be unique with a listener or channel
+	uint_16_t master = channel ? static_cast<uint_16_t>(1 + index) : 1; // masters on a channel need an address each
 	
 	FlexibleDataObserver* pMasterFDO = new FlexibleDataObserver(); mMasterObservers.push_back(pMasterFDO);
 	pMasterFDO->AddObserver(&mNotifier);
 	
 	ostringstream oss;
 	oss << "Port: " << port;
+	if(M_TOPOLOGY != TP_PORT_PER_PAIR) oss << " Outstation: " << outstation;
 	std::string client = oss.str() + " Client ";
 	std::string server = oss.str() + " Server ";
 
-	PhysLayerSettings s(aLevel, 1000);
+	// stacks on a channel are named by outstation, but all use the channel's ports
+	std::string clientPort = channel ? "channel client" : client;
+	std::string serverPort = channel ? "channel server" : server;
+
+	PhysLayerSettings s(aLevel, 1000, M_TIMER_WHEEL_RESOLUTION);
 	TCPSettings tcp("127.0.0.1", port);
-	this->AddTCPClient(client, s, tcp);
-	this->AddTCPServer(server, s, tcp);
+	if(!channel) this->AddTCPClient(client, s, tcp);
+	if(M_TOPOLOGY == TP_PORT_PER_PAIR) this->AddTCPServer(server, s, tcp);
 
 	{
 	MasterStackConfig cfg;
@@ -118,7 +153,11 @@ void AsyncIntegrationTest::AddStackPair(FilterLevel aLevel, size_t aNumPoints)
 	cfg.master.EnableUnsol = true;
 	cfg.master.DoUnsolOnStartup = true;
 	cfg.master.UnsolClassMask = PC_ALL_EVENTS;
-	this->AddMaster(client, client, aLevel, pMasterFDO, cfg);
+	cfg.link.LocalAddr = master;
+	cfg.link.RemoteAddr = outstation;
+	// with a listener, the unsolicited startup null sent by each outstation identifies its connection
+	if(listener) this->AddMaster("listener", server, aLevel, pMasterFDO, cfg);
+	else this->AddMaster(clientPort, client, aLevel, pMasterFDO, cfg);
 	}
 
 	{
@@ -127,7 +166,10 @@ void AsyncIntegrationTest::AddStackPair(FilterLevel aLevel, size_t aNumPoints)
 	cfg.slave.mDisableUnsol = false;
 	cfg.slave.mUnsolPackDelay = 0;
 	cfg.device = DeviceTemplate(aNumPoints, aNumPoints, aNumPoints);
-	IDataObserver* pObs = this->AddSlave(server, server, aLevel, &mCmdAcceptor, cfg);
+	cfg.link.LocalAddr = outstation;
+	cfg.link.RemoteAddr = master;
+	IDataObserver* pObs = listener ?
+		this->AddSlave(client, client, aLevel, &mCmdAcceptor, cfg) : this->AddSlave(serverPort, server, aLevel, &mCmdAcceptor, cfg);
 	this->mFanout.Add(pObs);
 	}
 
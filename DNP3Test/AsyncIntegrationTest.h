@@ -68,11 +68,26 @@ class AsyncIntegrationTest : public AsyncTestObject, public AsyncStackManager
 {
 	public:
 
-		AsyncIntegrationTest(Logger* apLogger, FilterLevel aLevel, uint_16_t aStartPort, size_t aNumPairs, size_t aNumPoints);
+		/// How the stack pairs are connected
+		enum Topology {
+			TP_PORT_PER_PAIR,			/// every pair has a TCP client/server of its own, starting at aStartPort
+			TP_LISTENER,				/// every master is on a single TCPListener on aStartPort
+			TP_CONCURRENT_CHANNEL,		/// all masters share one TCP client with mConcurrentMasters set, all slaves one TCP server
+			TP_SHARED_CHANNEL			/// like TP_CONCURRENT_CHANNEL, but the masters share the task group of the client
+		};
+
+		/// @param aTimerWheelResolution	PhysLayerSettings::TimerWheelResolution of every port
+		AsyncIntegrationTest(Logger* apLogger, FilterLevel aLevel, uint_16_t aStartPort, size_t aNumPairs, size_t aNumPoints, Topology aTopology = TP_PORT_PER_PAIR,
+							 millis_t aTimerWheelResolution = 0);
 		virtual ~AsyncIntegrationTest();
 
+		using AsyncStackManager::GetPortTimerSource;
+
 		IDataObserver* GetFanout() { return &mFanout; }
 
+		/// @return the most masters seen with a request outstanding in their own task groups at once, sampled between handlers
+		size_t MaxLanesRunning() { return mMaxLanesRunning; }
+
 		bool SameData();
 
 		Binary RandomBinary();
@@ -87,9 +102,12 @@ class AsyncIntegrationTest : public AsyncTestObject, public AsyncStackManager
 
 		ObserverFanout mFanout;
 		const uint_16_t M_START_PORT;
+		const Topology M_TOPOLOGY;
+		const millis_t M_TIMER_WHEEL_RESOLUTION;
 		Logger* mpLogger;
 
 		bool mChange;
+		size_t mMaxLanesRunning;
 		BoundNotifier mNotifier;
 		std::vector<FlexibleDataObserver*> mMasterObservers;
 		FlexibleDataObserver mLocalFDO;
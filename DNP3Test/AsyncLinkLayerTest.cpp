@@ -23,8 +23,9 @@ namespace apl { namespace dnp {
 	AsyncLinkLayerTest::AsyncLinkLayerTest(LinkConfig arCfg, FilterLevel aLevel, bool aImmediate) :
 	LogTester(aImmediate),
 	mts(),
+	fake_time(),
 	upper(mLog.GetLogger(aLevel, "MockUpperLayer")),
-	link(mLog.GetLogger(aLevel, "LinkLayer"), &mts, arCfg),	
+	link(mLog.GetLogger(aLevel, "LinkLayer"), &mts, arCfg, &fake_time),	
 	mNumSend(0)
 	{
 		link.SetUpperLayer(&upper);
@@ -40,6 +40,7 @@ class AsyncLinkLayerTest : public LogTester, public ILinkRouter
 	static LinkConfig DefaultConfig();
 
 	MockTimerSource mts;
+	MockTimeSource fake_time;
 	MockUpperLayer upper;
 	AsyncLinkLayer link;
 
@@ -24,13 +24,13 @@
 
 namespace apl { namespace dnp {
 
-AsyncSlaveTestObject::AsyncSlaveTestObject(const SlaveConfig& arCfg, FilterLevel aLevel, bool aImmediate) :
+AsyncSlaveTestObject::AsyncSlaveTestObject(const SlaveConfig& arCfg, FilterLevel aLevel, bool aImmediate, BufferPoolSet* apPools) :
 LogTester(aImmediate),
 mts(),
 app(mLog.GetLogger(aLevel, "app")),
 db(mLog.GetLogger(aLevel, "db")),
 cmd_master(10000),
-slave(mLog.GetLogger(aLevel, "slave"), &app, &mts, &fakeTime, &db, &cmd_master, arCfg),
+slave(mLog.GetLogger(aLevel, "slave"), &app, &mts, &fakeTime, &db, &cmd_master, arCfg, apPools),
 mpLogger(mLog.GetLogger(aLevel, "test"))
 {
 	app.SetUser(&slave);
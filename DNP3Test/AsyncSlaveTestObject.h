@@ -35,7 +35,7 @@ namespace apl { namespace dnp {
 class AsyncSlaveTestObject : public LogTester
 {
 	public:
-	AsyncSlaveTestObject(const SlaveConfig& arCfg, FilterLevel aLevel = LEV_INFO, bool aImmediate = false);
+	AsyncSlaveTestObject(const SlaveConfig& arCfg, FilterLevel aLevel = LEV_INFO, bool aImmediate = false, BufferPoolSet* apPools = NULL);
 
 	void SendToSlave(const std::string& arData, SequenceInfo aSeq = SI_OTHER);
 	std::string Read();
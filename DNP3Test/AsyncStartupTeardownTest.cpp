@@ -21,14 +21,21 @@
 
 #include <DNP3/AsyncMasterStack.h>
 #include <APL/PhysicalLayerAsyncTCPClient.h>
+#include <APL/Thread.h>
+#include <APL/Exception.h>
 
 #include <boost/foreach.hpp>
+#include <boost/bind.hpp>
 
 namespace apl { namespace dnp {
 
-AsyncStartupTeardownTest::AsyncStartupTeardownTest(FilterLevel aLevel, bool aAutoStart) :
+AsyncStartupTeardownTest::AsyncStartupTeardownTest(FilterLevel aLevel, bool aAutoStart, size_t aNumThreads) :
 mLog(),
-mMgr(mLog.GetLogger(aLevel, "mgr"), aAutoStart)
+mMgr(mLog.GetLogger(aLevel, "mgr"), aAutoStart, aNumThreads),
+mRunning(0),
+mMaxParallel(0),
+mOverlaps(0),
+mDone(0)
 {
 
 }
@@ -48,6 +55,41 @@ void AsyncStartupTeardownTest::AddMaster(const std::string& arStackName, const s
 	mMgr.AddMaster(arPortName, arStackName, aLevel, &mFDO, cfg);
 }
 
+size_t AsyncStartupTeardownTest::CountOverlaps(const std::vector<std::string>& arPorts, size_t aPostsPerPort)
+{
+	size_t total = arPorts.size() * aPostsPerPort;
+	// handlers of the same port are queued back to back, without a strand the threads would run them together
+	BOOST_FOREACH(const std::string& port, arPorts) {
+		ITimerSource* pSrc = mMgr.GetPortTimerSource(port);
+		for(size_t i=0; i<aPostsPerPort; ++i) pSrc->Post(boost::bind(&AsyncStartupTeardownTest::OnPortHandler, this, port));
+	}
+
+	CriticalSection cs(&mLock);
+	while(mDone < total) {
+		if(!cs.TimedWait(10000)) throw Exception(LOCATION, "Timed out waiting for the port handlers");
+	}
+	return mOverlaps;
+}
+
+void AsyncStartupTeardownTest::OnPortHandler(const std::string& arPort)
+{
+	{
+		CriticalSection cs(&mLock);
+		if(++mActive[arPort] > 1) ++mOverlaps;
+		if(++mRunning > mMaxParallel) mMaxParallel = mRunning;
+	}
+
+	Thread::SleepFor(1);
+
+	{
+		CriticalSection cs(&mLock);
+		--mActive[arPort];
+		--mRunning;
+		++mDone;
+		cs.Broadcast();
+	}
+}
+
 
 
 }}
@@ -21,6 +21,7 @@
 
 #include <APL/Log.h>
 #include <APL/FlexibleDataObserver.h>
+#include <APL/Lock.h>
 #include <DNP3/AsyncStackManager.h>
 
 
@@ -36,19 +37,48 @@ class AsyncStartupTeardownTest
 {
 	public:
 
-		AsyncStartupTeardownTest(FilterLevel aLevel, bool aAutoStart);
+		AsyncStartupTeardownTest(FilterLevel aLevel, bool aAutoStart, size_t aNumThreads = 1);
 
 		void CreatePort(const std::string& arName, FilterLevel aLevel);
 		void AddMaster(const std::string& arName, const std::string& arPortName, uint_16_t aLocalAddress, FilterLevel aLevel);
 
 		void StartService() { mMgr.Start(); }
 
+		/**
+			Posts handlers to the timer source of every port and waits for them to run. Each handler
+			holds its port busy for a moment and checks that no other handler of the same port is running.
+
+			@return the number of handlers that found another handler of their own port running
+		*/
+		size_t CountOverlaps(const std::vector<std::string>& arPorts, size_t aPostsPerPort);
+
+		/// @return the most handlers that ran at the same time across all of the ports during CountOverlaps
+		size_t MaxParallel() { return mMaxParallel; }
+
 	private:
 
+		class Manager : public AsyncStackManager
+		{
+			public:
+			Manager(Logger* apLogger, bool aAutoRun, size_t aNumThreads) : AsyncStackManager(apLogger, aAutoRun, aNumThreads)
+			{}
+
+			using AsyncStackManager::GetPortTimerSource;
+		};
+
+		void OnPortHandler(const std::string& arPort);
+
 		EventLog mLog;
 		FilterLevel mLevel;
-		AsyncStackManager mMgr;
+		Manager mMgr;
 		FlexibleDataObserver mFDO;
+
+		SigLock mLock;
+		std::map<std::string, size_t> mActive;
+		size_t mRunning;
+		size_t mMaxParallel;
+		size_t mOverlaps;
+		size_t mDone;
 };
 
 }}
@@ -29,6 +29,7 @@
 #include <APLTestTools/BufferHelpers.h>
 
 #include <queue>
+#include <memory.h>
 
 using namespace std;
 using namespace apl;
@@ -44,6 +45,36 @@ using namespace apl::dnp;
 		}
 
 
+		BOOST_AUTO_TEST_CASE(SwapTakesBuffer)
+		{
+			APDU frag(100);
+			HexSequence hs("C3 01 3C 02 06 3C 03 06 3C 04 06 3C 01 06");
+			CopyableBuffer buff(100);
+			memcpy(buff, hs, hs.Size());
+			const byte_t* pStorage = buff;
+
+			frag.Swap(buff, hs.Size());
+			BOOST_REQUIRE_EQUAL(frag.GetBuffer(), pStorage);
+			BOOST_REQUIRE_EQUAL(buff.Size(), 100);
+			frag.Interpret();
+			BOOST_REQUIRE_EQUAL(frag.GetFunction(), FC_READ);
+		}
+
+		BOOST_AUTO_TEST_CASE(SwapDifferentSizeCopies)
+		{
+			APDU frag(100);
+			HexSequence hs("C3 01 3C 02 06 3C 03 06 3C 04 06 3C 01 06");
+			CopyableBuffer buff(50);
+			memcpy(buff, hs, hs.Size());
+
+			frag.Swap(buff, hs.Size());
+			BOOST_REQUIRE(frag.GetBuffer() != buff.Buffer());
+			BOOST_REQUIRE_EQUAL(buff.Size(), 50);
+			BOOST_REQUIRE_EQUAL(frag.MaxSize(), 100);
+			frag.Interpret();
+			BOOST_REQUIRE_EQUAL(frag.GetFunction(), FC_READ);
+		}
+
 		BOOST_AUTO_TEST_CASE(ClassPollRequest)
 		{
 			APDU frag;
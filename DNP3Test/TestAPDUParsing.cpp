@@ -0,0 +1,129 @@
+// 
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+//  
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+// 
+#include <boost/test/unit_test.hpp>
+#include <APLTestTools/TestHelpers.h>
+
+#include <DNP3/APDU.h>
+#include <DNP3/ObjectReadIterator.h>
+#include <APLTestTools/BufferHelpers.h>
+
+#include <vector>
+#include <string>
+#include <stdlib.h>
+
+using namespace std;
+using namespace apl;
+using namespace apl::dnp;
+
+namespace {
+
+	/// fragments captured from master/slave sessions, covering the common qualifiers and object types
+	const char* CAPTURED[] = {
+		"C3 01 3C 02 06 3C 03 06 3C 04 06 3C 01 06",
+		"C0 01 01 02 17 03 01 03 05",
+		"C4 02 50 01 00 07 07 00",
+		"C2 02 70 05 17 01 00 68 65 6C 6C 6F",
+		"C0 05 0C 01 17 01 03 41 01 64 00 00 00 64 00 00 00 00",
+		"C0 05 29 01 28 01 00 02 00 64 00 00 00 00",
+		"E3 81 96 00 02 01 28 01 00 00 00 01 02 01 28 01 00 01 00 01 02 01 28 01 00 02 00 01 02 01 28 01 00 03 00 01 20 02 28 01 00 00 00 01 00 00 20 02 28 01 00 01 00 01 00 00 01 01 01 00 00 03 00 00 1E 02 01 00 00 01 00 01 00 00 01 00 00",
+		"C0 81 00 00 01 02 00 00 09 01 01 01 01 01 01 01 01 01 01 1E 04 01 00 00 03 00 00 00 01 00 02 00 03 00"
+	};
+
+	const size_t NUM_CAPTURED = sizeof(CAPTURED)/sizeof(CAPTURED[0]);
+
+	/// walks everything a successful parse produced and checks that it stays inside the fragment
+	void CheckBounds(APDU& arFrag)
+	{
+		const byte_t* pBegin = arFrag.GetBuffer();
+		const byte_t* pEnd = pBegin + arFrag.Size();
+
+		for(HeaderReadIterator hdr = arFrag.BeginRead(); !hdr.IsEnd(); ++hdr) {
+			BOOST_REQUIRE(hdr->GetPosition() + hdr->GetHeaderSize() <= arFrag.Size());
+
+			// a read can legally ask for 2^32 objects without carrying them, don't walk those
+			if(hdr->GetCount() > arFrag.Size() * 8) continue;
+
+			for(ObjectReadIterator obj = hdr.BeginRead(); !obj.IsEnd(); ++obj) {
+				if(obj.HasData()) {
+					BOOST_REQUIRE(*obj >= pBegin);
+					BOOST_REQUIRE(*obj <= pEnd);
+				}
+			}
+		}
+	}
+
+	/// @return true if the fragment parsed, false if it was rejected with an exception
+	bool ParseAndCheck(APDU& arFrag, const byte_t* apData, size_t aLength)
+	{
+		arFrag.Write(apData, aLength);
+		try {
+			arFrag.Interpret();
+		}
+		catch(Exception&) {
+			return false;
+		}
+		CheckBounds(arFrag);
+		return true;
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(APDUParsing)
+
+	BOOST_AUTO_TEST_CASE(CapturedFragmentsParse)
+	{
+		APDU frag;
+		for(size_t i = 0; i < NUM_CAPTURED; ++i) {
+			HexSequence hs(CAPTURED[i]);
+			BOOST_REQUIRE(ParseAndCheck(frag, hs, hs.Size()));
+		}
+	}
+
+	/// Mutates the captured fragments and checks that every input is either rejected
+	/// with an exception or parses into headers/objects that lie inside the fragment
+	BOOST_AUTO_TEST_CASE(Fuzz)
+	{
+		const size_t NUM_MUTATIONS = 20000;
+
+		srand(1234);
+		APDU frag;
+		size_t num_parsed = 0;
+
+		for(size_t i = 0; i < NUM_MUTATIONS; ++i) {
+			HexSequence hs(CAPTURED[i % NUM_CAPTURED]);
+			vector<byte_t> data(hs.Buffer(), hs.Buffer() + hs.Size());
+
+			size_t num_flips = 1 + rand() % 4;
+			for(size_t j = 0; j < num_flips; ++j) {
+				data[rand() % data.size()] = static_cast<byte_t>(rand());
+			}
+
+			// sometimes truncate or extend
+			switch(rand() % 4) {
+				case(0): data.resize(rand() % data.size() + 1); break;
+				case(1): data.push_back(static_cast<byte_t>(rand())); break;
+				default: break;
+			}
+
+			if(ParseAndCheck(frag, &data[0], data.size())) ++num_parsed;
+		}
+
+		BOOST_TEST_MESSAGE(num_parsed << " of " << NUM_MUTATIONS << " mutated fragments parsed");
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -19,6 +19,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include <APL/Exception.h>
+#include <APL/MetricRegistry.h>
 #include <APLTestTools/TestHelpers.h>
 #include "AppLayerTest.h"
 
@@ -491,5 +492,40 @@ BOOST_AUTO_TEST_SUITE(AsyncAppLayerSuite)
 		BOOST_REQUIRE_EQUAL(t.lower.NumWrites(), 2);											
 	}
 
+	/** Test that an adaptive timeout follows the responses, and backs off but doesn't sample on retries */
+	BOOST_AUTO_TEST_CASE(AdaptiveTimeout)
+	{
+		AppLayerTest t(true, 1, LEV_WARNING, false, true);	// master, 1 retry, adaptive timeout
+		MetricRegistry reg;
+		t.app.SetRttMetrics(&reg, "app");
+		MetricSnapshot s;
+		BOOST_REQUIRE(reg.Read("app.timeout_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 1000);
+		t.lower.ThisLayerUp(); ++t.state.NumLayerUp;
+
+		t.SendRequest(FC_READ, true, true, false, false);
+		t.SendUp(FC_RESPONSE, true, true, false, false, 0); ++t.state.NumFinalRsp;
+		BOOST_REQUIRE(reg.Read("app.timeout_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 100); // an immediate response drops the timeout to the floor
+
+		t.SendRequest(FC_READ, true, true, false, false);
+		BOOST_REQUIRE(t.mts.DispatchOne()); // timeout the response
+		BOOST_REQUIRE_EQUAL(t.lower.NumWrites(), 3);
+		BOOST_REQUIRE(reg.Read("app.timeout_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 200);
+
+		t.SendUp(FC_RESPONSE, true, true, false, false, 1); ++t.state.NumFinalRsp;
+		BOOST_REQUIRE(reg.Read("app.timeout_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 200); // the response to a retry isn't sampled
+
+		// round trips are timed with the injected time source
+		t.SendRequest(FC_READ, true, true, false, false);
+		t.fake_time.Advance(300);
+		t.SendUp(FC_RESPONSE, true, true, false, false, 2); ++t.state.NumFinalRsp;
+		BOOST_REQUIRE(reg.Read("app.timeout_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 338); // srtt 37.5 + 4 * rttvar 75
+		BOOST_REQUIRE_EQUAL(t.state, t.user.mState);
+	}
+
 BOOST_AUTO_TEST_SUITE_END() //end suite
 
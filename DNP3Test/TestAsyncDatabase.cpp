@@ -47,7 +47,7 @@ using namespace apl::dnp;
 		
 		if(aIsEvent) {
 			BOOST_REQUIRE_EQUAL(arQueue.size(), 1);
-			BOOST_REQUIRE_EQUAL(arNewVal, arQueue.front().mValue);
+			BOOST_REQUIRE_EQUAL(arNewVal, static_cast<T>(arQueue.front().mValue));
 			BOOST_REQUIRE_EQUAL(0, arQueue.front().mIndex);
 			arQueue.pop_front();
 		}
@@ -45,6 +45,50 @@ using namespace apl::dnp;
 			b.Select(PC_CLASS_1);
 			BOOST_REQUIRE_EQUAL(b.Begin()->mValue.GetTime(), TimeStamp_t(2)); //prove the newest value was kept	
 		}
+
+		BOOST_AUTO_TEST_CASE(SingleIndexClassChange)
+		{
+			AsyncSingleEventBuffer<AnalogEvent> b(3);
+
+			b.Update(Analog(0), PC_CLASS_1, 0);
+			b.Update(Analog(1), PC_CLASS_2, 0); // same point, moved to a different class
+
+			BOOST_REQUIRE_EQUAL(b.Size(), 1);
+			BOOST_REQUIRE_FALSE(b.HasClassData(PC_CLASS_1));
+			BOOST_REQUIRE(b.HasClassData(PC_CLASS_2));
+			BOOST_REQUIRE_EQUAL(b.Select(PC_CLASS_1), 0);
+			BOOST_REQUIRE_EQUAL(b.Select(PC_CLASS_2), 1);
+		}
+
+		BOOST_AUTO_TEST_CASE(SingleIndexDeselectKeepsNewest)
+		{
+			AsyncSingleEventBuffer<AnalogEvent> b(3);
+
+			b.Update(Analog(0), PC_CLASS_1, 0);
+			BOOST_REQUIRE_EQUAL(b.Select(PC_CLASS_1), 1);
+
+			Analog a(7); a.SetTime(TimeStamp_t(2));
+			b.Update(a, PC_CLASS_1, 0); // newer value arrives while the old one is selected
+
+			BOOST_REQUIRE_EQUAL(b.Deselect(), 1);
+			BOOST_REQUIRE_EQUAL(b.Size(), 1);
+			BOOST_REQUIRE_EQUAL(b.Select(PC_CLASS_1), 1);
+			BOOST_REQUIRE_EQUAL(b.Begin()->mValue.GetValue(), 7);
+		}
+
+		BOOST_AUTO_TEST_CASE(SingleIndexSelectsOldestInIndexOrder)
+		{
+			AsyncSingleEventBuffer<AnalogEvent> b(10);
+
+			for(size_t i = 0; i < 5; ++i) b.Update(Analog(0), PC_CLASS_1, 9 - i);
+
+			// the three oldest changes (indices 9, 8, 7) are selected and reported by index
+			BOOST_REQUIRE_EQUAL(b.Select(PC_CLASS_1, 3), 3);
+			EvtItr<AnalogEvent>::Type itr = b.Begin();
+			BOOST_REQUIRE_EQUAL(itr->mIndex, 7); ++itr;
+			BOOST_REQUIRE_EQUAL(itr->mIndex, 8); ++itr;
+			BOOST_REQUIRE_EQUAL(itr->mIndex, 9);
+		}
 	BOOST_AUTO_TEST_SUITE_END()
 
 	// index is irrelevant in these tests, only insertion order matters
@@ -86,6 +130,41 @@ using namespace apl::dnp;
 			}
 				
 		}
+
+		BOOST_AUTO_TEST_CASE(InsertionOrderAcrossClasses)
+		{
+			AsyncInsertionOrderedEventBuffer<intevt> b(10);
+
+			b.Update(0, PC_CLASS_1, 0);
+			b.Update(1, PC_CLASS_2, 0);
+			b.Update(2, PC_CLASS_1, 0);
+			b.Update(3, PC_CLASS_2, 0);
+
+			BOOST_REQUIRE_EQUAL(b.Select(PC_CLASS_2, 1), 1);
+			BOOST_REQUIRE_EQUAL(b.Begin()->mValue, 1);
+
+			b.Update(4, PC_CLASS_2, 0);
+			BOOST_REQUIRE_EQUAL(b.Deselect(), 1);
+
+			// the deselected event goes back in front of newer ones
+			BOOST_REQUIRE_EQUAL(b.Select(PC_ALL_EVENTS), 5);
+			EvtItr<intevt>::Type itr = b.Begin();
+			for(int i = 0; i < 5; ++i, ++itr) BOOST_REQUIRE_EQUAL(itr->mValue, i);
+		}
+
+		BOOST_AUTO_TEST_CASE(OverflowDropsOldest)
+		{
+			AsyncInsertionOrderedEventBuffer<intevt> b(2);
+
+			b.Update(0, PC_CLASS_1, 0);
+			b.Update(1, PC_CLASS_2, 0);
+			b.Update(2, PC_CLASS_2, 0);
+
+			BOOST_REQUIRE(b.IsOverflown());
+			BOOST_REQUIRE_FALSE(b.HasClassData(PC_CLASS_1));
+			BOOST_REQUIRE_EQUAL(b.Select(PC_ALL_EVENTS), 2);
+			BOOST_REQUIRE_EQUAL(b.Begin()->mValue, 1);
+		}
 	BOOST_AUTO_TEST_SUITE_END()
 
 	BOOST_AUTO_TEST_SUITE(AsyncTimeOrderedEventBufferSuite)
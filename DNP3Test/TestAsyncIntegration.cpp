@@ -22,11 +22,36 @@
 
 #include <APL/Log.h>
 #include <APL/LogToStdio.h>
+#include <APL/TimerSourceWheel.h>
 #include "AsyncIntegrationTest.h"
 
+#include <algorithm>
+#include <boost/foreach.hpp>
+
 using namespace apl;
 using namespace apl::dnp;
 
+/// Pushes aNumChanges random change sets through the slaves and waits for every master to see each one
+/// @return elapsed milliseconds
+static millis_t ApplyChanges(AsyncIntegrationTest& arTest, size_t aNumPoints, size_t aNumChanges)
+{
+	StopWatch sw;
+	IDataObserver* pObs = arTest.GetFanout();
+
+	for(size_t j=0; j < aNumChanges; ++j) {
+		{
+			Transaction tr(pObs);
+			for(size_t i = 0; i<aNumPoints; ++i) pObs->Update(arTest.RandomBinary(), i);
+			for(size_t i = 0; i<aNumPoints; ++i) pObs->Update(arTest.RandomAnalog(), i);
+			for(size_t i = 0; i<aNumPoints; ++i) pObs->Update(arTest.RandomCounter(), i);
+		}
+
+		BOOST_REQUIRE(arTest.ProceedUntil(boost::bind(&AsyncIntegrationTest::SameData, &arTest)));
+	}
+
+	return sw.Elapsed();
+}
+
 BOOST_AUTO_TEST_SUITE(AsyncIntegrationSuite)
 
 	BOOST_AUTO_TEST_CASE(MasterToSlave)
@@ -78,5 +103,172 @@ BOOST_AUTO_TEST_SUITE(AsyncIntegrationSuite)
 		*/
 	}
 
+	BOOST_AUTO_TEST_CASE(ListenerToSlaves)
+	{
+		#ifdef WIN32
+		uint_16_t port = 50200;
+		#else
+		uint_16_t port = 30200;
+		#endif
+
+		size_t NUM_PAIRS = 20;
+		size_t NUM_POINTS = 100;
+		size_t NUM_CHANGES = 5;
+
+		EventLog log;
+		AsyncIntegrationTest t(log.GetLogger(LEV_WARNING, "test"), LEV_WARNING, port, NUM_PAIRS, NUM_POINTS, AsyncIntegrationTest::TP_LISTENER);
+		ApplyChanges(t, NUM_POINTS, NUM_CHANGES);
+
+		std::vector<std::string> ports = t.GetPortNames();
+		BOOST_REQUIRE(std::find(ports.begin(), ports.end(), "listener") != ports.end());
+		t.RemovePort("listener");
+		BOOST_REQUIRE_EQUAL(t.GetStackNames().size(), NUM_PAIRS); // only the slaves are left
+	}
+
+	BOOST_AUTO_TEST_CASE(ListenerChecksDestination)
+	{
+		#ifdef WIN32
+		uint_16_t port = 50250;
+		#else
+		uint_16_t port = 30250;
+		#endif
+
+		size_t NUM_POINTS = 10;
+
+		EventLog log;
+		AsyncIntegrationTest t(log.GetLogger(LEV_WARNING, "test"), LEV_ERROR, port, 1, NUM_POINTS, AsyncIntegrationTest::TP_LISTENER);
+
+		// an outstation with the source address the master waits for, that talks to another master
+		PhysLayerSettings s(LEV_ERROR, 1000);
+		t.AddTCPClient("misaddressed", s, TCPSettings("127.0.0.1", port));
+
+		FlexibleDataObserver fdo;
+		MasterStackConfig master;
+		master.link.LocalAddr = 1;
+		master.link.RemoteAddr = 2000;
+		t.AddMaster("listener", "master", LEV_ERROR, &fdo, master);
+
+		SlaveStackConfig slave;
+		slave.device = DeviceTemplate(NUM_POINTS, NUM_POINTS, NUM_POINTS);
+		slave.link.LocalAddr = 2000;
+		slave.link.RemoteAddr = 2;
+		t.AddSlave("misaddressed", "slave", LEV_ERROR, NULL, slave);
+
+		// the pair that is addressed correctly still works
+		ApplyChanges(t, NUM_POINTS, 2);
+
+		// the master never got a connection, so it never polled
+		MetricSnapshot tx;
+		BOOST_REQUIRE(t.GetMetrics()->Read("master.frames_tx", tx));
+		BOOST_REQUIRE_EQUAL(tx.mValue, 0);
+	}
+
+	BOOST_AUTO_TEST_CASE(ConcurrentMastersOnChannel)
+	{
+		#ifdef WIN32
+		uint_16_t port = 50300;
+		#else
+		uint_16_t port = 30300;
+		#endif
+
+		size_t NUM_PAIRS = 20;
+		size_t NUM_POINTS = 100;
+		size_t NUM_CHANGES = 5;
+
+		EventLog log;
+
+		// the same workload with the masters taking turns on the channel, as the baseline
+		millis_t shared;
+		{
+			AsyncIntegrationTest t(log.GetLogger(LEV_WARNING, "shared"), LEV_WARNING, port + 1, NUM_PAIRS, NUM_POINTS, AsyncIntegrationTest::TP_SHARED_CHANNEL);
+			ApplyChanges(t, NUM_POINTS, 1); // connects and runs the startup tasks
+			shared = ApplyChanges(t, NUM_POINTS, NUM_CHANGES);
+		}
+
+		AsyncIntegrationTest t(log.GetLogger(LEV_WARNING, "test"), LEV_WARNING, port, NUM_PAIRS, NUM_POINTS, AsyncIntegrationTest::TP_CONCURRENT_CHANNEL);
+		ApplyChanges(t, NUM_POINTS, 1);
+		millis_t concurrent = ApplyChanges(t, NUM_POINTS, NUM_CHANGES);
+
+		// the masters' requests were in flight at the same time, not taking turns
+		BOOST_REQUIRE(t.MaxLanesRunning() >= 2);
+
+		// removing a master releases its lane along with the stack
+		t.RemoveStack(t.GetStackNames().front());
+		BOOST_REQUIRE_EQUAL(t.GetStackNames().size(), 2*NUM_PAIRS - 1);
+
+		double sharedRate = (NUM_CHANGES * NUM_PAIRS * 1000.0) / std::max<millis_t>(shared, 1);
+		double concurrentRate = (NUM_CHANGES * NUM_PAIRS * 1000.0) / std::max<millis_t>(concurrent, 1);
+		BOOST_TEST_MESSAGE(NUM_PAIRS << " outstations on one channel, " << NUM_CHANGES << " change sets, shared: "
+						   << shared << "ms (" << sharedRate << " sets/s), concurrent: " << concurrent << "ms (" << concurrentRate << " sets/s), "
+						   << t.MaxLanesRunning() << " requests in flight at once");
+	}
+
+	BOOST_AUTO_TEST_CASE(StacksReportMetrics)
+	{
+		#ifdef WIN32
+		uint_16_t port = 50400;
+		#else
+		uint_16_t port = 30400;
+		#endif
+
+		size_t NUM_PAIRS = 2;
+		size_t NUM_POINTS = 10;
+
+		EventLog log;
+		AsyncIntegrationTest t(log.GetLogger(LEV_WARNING, "test"), LEV_WARNING, port, NUM_PAIRS, NUM_POINTS);
+		ApplyChanges(t, NUM_POINTS, 2);
+
+		MetricRegistry* pMetrics = t.GetMetrics();
+		std::vector<std::string> stacks = t.GetStackNames();
+		BOOST_REQUIRE_EQUAL(stacks.size(), 2*NUM_PAIRS);
+
+		BOOST_FOREACH(std::string stack, stacks) {
+			MetricSnapshot s;
+			BOOST_REQUIRE(pMetrics->Read(stack + ".frames_rx", s));
+			BOOST_REQUIRE(s.mValue > 0);
+			BOOST_REQUIRE(pMetrics->Read(stack + ".frames_tx", s));
+			BOOST_REQUIRE(s.mValue > 0);
+
+			bool master = stack.find("Client") != std::string::npos;
+			BOOST_REQUIRE_EQUAL(pMetrics->Read(stack + ".request_rtt_us", s), master);
+			if(master) BOOST_REQUIRE(s.mValue > 0);
+			BOOST_REQUIRE_EQUAL(pMetrics->Read(stack + ".fragment_build_us", s), !master);
+			if(!master) BOOST_REQUIRE(s.mValue > 0);
+			BOOST_REQUIRE_EQUAL(pMetrics->Read(stack + ".event_buffer_depth", s), !master);
+		}
+
+		// a removed stack's metrics go with it
+		t.RemoveStack(stacks.front());
+		MetricSnapshot s;
+		BOOST_REQUIRE_FALSE(pMetrics->Read(stacks.front() + ".frames_rx", s));
+	}
+
+	BOOST_AUTO_TEST_CASE(PortsOnTimerWheel)
+	{
+		#ifdef WIN32
+		uint_16_t port = 50500;
+		#else
+		uint_16_t port = 30500;
+		#endif
+
+		size_t NUM_PAIRS = 10;
+		size_t NUM_POINTS = 100;
+
+		EventLog log;
+		AsyncIntegrationTest t(log.GetLogger(LEV_WARNING, "test"), LEV_WARNING, port, NUM_PAIRS, NUM_POINTS, AsyncIntegrationTest::TP_PORT_PER_PAIR, 5);
+
+		std::vector<std::string> ports = t.GetPortNames();
+		BOOST_REQUIRE_EQUAL(ports.size(), 2*NUM_PAIRS);
+		BOOST_FOREACH(std::string name, ports) {
+			BOOST_REQUIRE(dynamic_cast<TimerSourceWheel*>(t.GetPortTimerSource(name)) != NULL);
+		}
+
+		ApplyChanges(t, NUM_POINTS, 5);
+
+		// the wheels are released with their ports
+		t.RemovePort(ports.front());
+		BOOST_REQUIRE_EQUAL(t.GetStackNames().size(), 2*NUM_PAIRS - 1);
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
 
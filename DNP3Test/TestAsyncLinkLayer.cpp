@@ -20,6 +20,7 @@
 #include <APLTestTools/TestHelpers.h>
 
 #include <APL/Exception.h>
+#include <APL/MetricRegistry.h>
 #include <DNP3/DNPConstants.h>
 #include <APLTestTools/BufferHelpers.h>
 
@@ -413,4 +414,44 @@ BOOST_AUTO_TEST_SUITE(AsyncLinkLayerSuite)
 		BOOST_REQUIRE_EQUAL(t.mLastSend, f);
 	}
 
+	BOOST_AUTO_TEST_CASE(AdaptiveTimeout)
+	{
+		LinkConfig cfg = AsyncLinkLayerTest::DefaultConfig();
+		cfg.UseConfirms = true;
+		cfg.NumRetry = 1;
+		cfg.AdaptiveTimeout = true;
+		cfg.MinTimeout = 20;
+
+		AsyncLinkLayerTest t(cfg);
+		MetricRegistry reg;
+		t.link.SetRttMetrics(&reg, "link");
+		MetricSnapshot s;
+		BOOST_REQUIRE(reg.Read("link.timeout_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, cfg.Timeout);
+		t.link.OnLowerLayerUp();
+
+		ByteStr bytes(250, 0);
+		t.link.Send(bytes, bytes.Size());
+		t.link.Ack(false, false, 1, 1024); // immediate ACK of the reset links, the timeout drops to the floor
+		BOOST_REQUIRE(reg.Read("link.timeout_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 20);
+
+		BOOST_REQUIRE(t.mts.DispatchOne()); // timeout the data, the retry waits twice as long
+		BOOST_REQUIRE_EQUAL(t.NextErrorCode(), DLERR_TIMEOUT_RETRY);
+		BOOST_REQUIRE(reg.Read("link.timeout_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 40);
+
+		t.link.Ack(false, false, 1, 1024); // the ACK of a retry isn't sampled
+		BOOST_REQUIRE(reg.Read("link.timeout_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 40);
+
+		// round trips are timed with the injected time source
+		t.link.Send(bytes, bytes.Size());
+		t.fake_time.Advance(100);
+		t.link.Ack(false, false, 1, 1024);
+		BOOST_REQUIRE(reg.Read("link.timeout_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 113); // srtt 12.5 + 4 * rttvar 25
+		BOOST_REQUIRE(t.upper.CountersEqual(2,0));
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
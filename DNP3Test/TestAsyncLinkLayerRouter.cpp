@@ -21,6 +21,8 @@
 
 #include <APL/Exception.h>
 
+#include <vector>
+
 #include "AsyncLinkLayerRouterTest.h"
 #include "MockFrameSink.h"
 
@@ -63,6 +65,30 @@ BOOST_AUTO_TEST_SUITE(AsyncLinkLayerRouterSuite)
 		BOOST_REQUIRE_EQUAL(t.NextErrorCode(), DLERR_UNKNOWN_DESTINATION);
 	}
 	
+	BOOST_AUTO_TEST_CASE(ReceiveCountersPerAddress){
+		AsyncLinkLayerRouterTest t;
+		MockFrameSink mfs1;
+		MockFrameSink mfs2;
+		t.router.AddContext(&mfs1, 1);
+		t.router.AddContext(&mfs2, 60000);
+		t.router.Start();
+		t.phys.SignalOpenSuccess();
+
+		t.phys.TriggerRead("05 64 05 C0 01 00 00 04 E9 21");
+		t.phys.TriggerRead("05 64 05 C0 01 00 00 04 E9 21");
+		BOOST_REQUIRE_EQUAL(t.router.GetRxCount(1), 2);
+		BOOST_REQUIRE_EQUAL(t.router.GetRxCount(60000), 0);
+		BOOST_REQUIRE_EQUAL(t.router.GetRxCount(2), 0);
+
+		// counters start over when an address is rebound
+		t.router.RemoveContext(1);
+		BOOST_REQUIRE_EQUAL(t.router.NumContext(), 1);
+		BOOST_REQUIRE_EQUAL(t.router.GetRxCount(1), 0);
+		t.router.AddContext(&mfs1, 1);
+		BOOST_REQUIRE_EQUAL(t.router.GetRxCount(1), 0);
+		BOOST_REQUIRE_EQUAL(t.router.NumContext(), 2);
+	}
+
 	/// Test that the router rejects sends until it is online
 	BOOST_AUTO_TEST_CASE(LayerNotOnline){
 		AsyncLinkLayerRouterTest t;
@@ -142,7 +168,39 @@ BOOST_AUTO_TEST_SUITE(AsyncLinkLayerRouterSuite)
 		t.phys.SignalSendSuccess();			
 		BOOST_REQUIRE_EQUAL(t.phys.NumWrites(), 2);
 	}
-	
 
 
+	/// Frames queued while a write is in progress go out together in a single write
+	BOOST_AUTO_TEST_CASE(QueuedFramesAreBatched){
+		AsyncLinkLayerRouterTest t;
+		MockFrameSink mfs;
+		t.router.AddContext(&mfs, 1024);
+		t.router.Start(); t.phys.SignalOpenSuccess();
+
+		LinkFrame frames[20];
+		std::vector<byte_t> expected;
+		for(size_t i = 0; i < 20; ++i) frames[i].FormatAck(true, false, static_cast<uint_16_t>(i), 1024);
+
+		t.router.Transmit(frames[0]);
+		BOOST_REQUIRE_EQUAL(t.phys.NumWrites(), 1);
+		t.phys.SignalSendSuccess();
+		t.phys.ClearBuffer();
+
+		// more frames than the initial pool holds
+		for(size_t i = 0; i < 20; ++i) {
+			t.router.Transmit(frames[i]);
+			if(i > 0) expected.insert(expected.end(), frames[i].GetBuffer(), frames[i].GetBuffer() + frames[i].GetSize());
+		}
+		BOOST_REQUIRE_EQUAL(t.phys.NumWrites(), 2);
+		BOOST_REQUIRE(t.phys.BufferEquals(frames[0].GetBuffer(), frames[0].GetSize()));
+
+		t.phys.ClearBuffer();
+		t.phys.SignalSendSuccess();
+		BOOST_REQUIRE_EQUAL(t.phys.NumWrites(), 3);
+		BOOST_REQUIRE(t.phys.BufferEquals(&expected[0], expected.size()));
+
+		t.phys.SignalSendSuccess();
+		BOOST_REQUIRE_EQUAL(t.phys.NumWrites(), 3);
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
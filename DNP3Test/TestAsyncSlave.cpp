@@ -23,14 +23,26 @@
 
 #include <DNP3/APDU.h>
 #include <DNP3/ObjectReadIterator.h>
-#include <APL/TimingTools.h>
+#include <DNP3/StackMetrics.h>
+#include <APL/MetricRegistry.h>
+#include <APL/BufferPool.h>
 #include <APL/Util.h>
 
+#include <sstream>
+
 using namespace std;
 using namespace apl;
 using namespace apl::dnp;
 using namespace boost;
 
+/// @return how many response fragments the slave "slave" has loaded
+static size_t FragmentsBuilt(MetricRegistry& arRegistry)
+{
+	MetricSnapshot s;
+	arRegistry.Read("slave.fragment_build_us", s);
+	return s.mValue;
+}
+
 
 BOOST_AUTO_TEST_SUITE(AsyncSlaveSuite)
 
@@ -246,6 +258,153 @@ BOOST_AUTO_TEST_SUITE(AsyncSlaveSuite)
 		BOOST_REQUIRE_EQUAL(t.Read(), "40 81 80 00 1E 01 00 06 07 01 00 00 00 00 01 00 00 00 00");
 	}
 
+	BOOST_AUTO_TEST_CASE(ReadClass0MultiFragLoadsAhead)
+	{
+		SlaveConfig cfg; cfg.mDisableUnsol = true;
+		cfg.mMaxFragSize = 20;
+		AsyncSlaveTestObject t(cfg);
+		t.db.Configure(DT_ANALOG, 8);
+		MetricRegistry reg;
+		StackMetrics metrics;
+		metrics.Register(&reg, "slave", false);
+		t.slave.SetMetrics(&metrics);
+		t.slave.OnLowerLayerUp();
+		t.app.DisableAutoSendCallback();
+
+		{
+			Transaction tr(&t.db);
+			for(size_t i=0; i<8; i++) t.db.Update(Analog(0,AQ_ONLINE), i);
+		}
+
+		// the second fragment is loaded while the first one waits on its confirm
+		t.SendToSlave("C0 01 3C 01 06");
+		BOOST_REQUIRE_EQUAL(t.Read(), "A0 81 80 00 1E 01 00 00 01 01 00 00 00 00 01 00 00 00 00");
+		BOOST_REQUIRE_EQUAL(FragmentsBuilt(reg), 2);
+		t.slave.OnSolSendSuccess();
+		BOOST_REQUIRE_EQUAL(t.Read(), "20 81 80 00 1E 01 00 02 03 01 00 00 00 00 01 00 00 00 00");
+		BOOST_REQUIRE_EQUAL(FragmentsBuilt(reg), 3);
+
+		// a failure throws the fragment that was loaded ahead away, the next read starts over
+		t.slave.OnSolFailure();
+		BOOST_REQUIRE_EQUAL(t.Count(), 0);
+		t.SendToSlave("C0 01 3C 01 06");
+		BOOST_REQUIRE_EQUAL(t.Read(), "A0 81 80 00 1E 01 00 00 01 01 00 00 00 00 01 00 00 00 00");
+		t.slave.OnSolSendSuccess();
+		BOOST_REQUIRE_EQUAL(t.Read(), "20 81 80 00 1E 01 00 02 03 01 00 00 00 00 01 00 00 00 00");
+		t.slave.OnSolSendSuccess();
+		BOOST_REQUIRE_EQUAL(t.Read(), "20 81 80 00 1E 01 00 04 05 01 00 00 00 00 01 00 00 00 00");
+		t.slave.OnSolSendSuccess();
+		BOOST_REQUIRE_EQUAL(t.Read(), "40 81 80 00 1E 01 00 06 07 01 00 00 00 00 01 00 00 00 00");
+		t.slave.OnSolSendSuccess();
+		BOOST_REQUIRE_EQUAL(t.Count(), 0);
+		BOOST_REQUIRE_EQUAL(FragmentsBuilt(reg), 7);
+
+		t.SendToSlave("C0 01 3C 01 06"); // the slave is idle again
+		BOOST_REQUIRE_EQUAL(t.Read(), "A0 81 80 00 1E 01 00 00 01 01 00 00 00 00 01 00 00 00 00");
+	}
+
+	BOOST_AUTO_TEST_CASE(EventFragmentsAreNotLoadedAhead)
+	{
+		SlaveConfig cfg; cfg.mDisableUnsol = true;
+		cfg.mMaxFragSize = 20; // two analog events per fragment
+		AsyncSlaveTestObject t(cfg);
+		t.db.Configure(DT_ANALOG, 8);
+		for(size_t i=0; i<8; i++) t.db.SetClass(DT_ANALOG, i, PC_CLASS_1);
+		MetricRegistry reg;
+		StackMetrics metrics;
+		metrics.Register(&reg, "slave", false);
+		t.slave.SetMetrics(&metrics);
+		t.slave.OnLowerLayerUp();
+		t.app.DisableAutoSendCallback();
+
+		{
+			Transaction tr(&t.db);
+			for(size_t i=0; i<8; i++) t.db.Update(Analog(i,AQ_ONLINE), i);
+		}
+
+		// a confirm clears every written event, so nothing is loaded ahead of an event fragment
+		t.SendToSlave("C0 01 3C 02 06 3C 01 06"); // Read class 1 and class 0
+		std::string first = t.Read();
+		BOOST_REQUIRE_EQUAL(FragmentsBuilt(reg), 1);
+
+		t.slave.OnSolFailure();
+		t.SendToSlave("C0 01 3C 02 06 3C 01 06");
+		BOOST_REQUIRE_EQUAL(t.Read(), first); // the events weren't lost
+
+		// each fragment is loaded once, the static ones ahead of the confirm
+		size_t fragments = 1;
+		for(t.slave.OnSolSendSuccess(); t.Count() > 0; t.slave.OnSolSendSuccess()) {
+			t.Read();
+			++fragments;
+		}
+		BOOST_REQUIRE_EQUAL(fragments, 8);
+		BOOST_REQUIRE_EQUAL(FragmentsBuilt(reg), fragments + 1);
+
+		t.SendToSlave("C0 01 3C 02 06");
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00"); // every event was cleared
+	}
+
+	BOOST_AUTO_TEST_CASE(ReadClass0ReflectsUpdates)
+	{
+		SlaveConfig cfg; cfg.mDisableUnsol = true;
+		AsyncSlaveTestObject t(cfg);
+		t.db.Configure(DT_ANALOG, 2);
+		t.slave.OnLowerLayerUp();
+
+		{
+			Transaction tr(&t.db);
+			t.db.Update(Analog(0, AQ_ONLINE), 0);
+			t.db.Update(Analog(0, AQ_ONLINE), 1);
+		}
+
+		t.SendToSlave("C0 01 3C 01 06");
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 1E 01 00 00 01 01 00 00 00 00 01 00 00 00 00");
+
+		{
+			Transaction tr(&t.db);
+			t.db.Update(Analog(9, AQ_COMM_LOST), 1);
+		}
+
+		t.SendToSlave("C0 01 3C 01 06"); // only the updated point is encoded again
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 1E 01 00 00 01 01 00 00 00 00 04 09 00 00 00");
+
+		t.db.Configure(DT_ANALOG, 2, true); // same size, but every point is set online
+
+		t.SendToSlave("C0 01 3C 01 06");
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 1E 01 00 00 01 01 00 00 00 00 01 09 00 00 00");
+	}
+
+	BOOST_AUTO_TEST_CASE(IntegrityPollStaticImage)
+	{
+		const size_t NUM_POINTS = 1000;	// spans several fragments
+		const size_t NUM_POLLS = 4;
+
+		SlaveConfig cfg; cfg.mDisableUnsol = true;
+		AsyncSlaveTestObject t(cfg, LEV_WARNING);
+		t.db.Configure(DT_ANALOG, NUM_POINTS, true);
+		t.slave.OnLowerLayerUp();
+
+		// a few points change between polls, then every point changes, the response is the same size either way
+		size_t bytes = 0;
+		for(size_t i = 0; i < 2*NUM_POLLS; ++i) {
+			size_t num_changes = (i < NUM_POLLS) ? 3 : NUM_POINTS;
+			{
+				Transaction tr(&t.db);
+				for(size_t j = 0; j < num_changes; ++j) t.db.Update(Analog(static_cast<double>(i), AQ_ONLINE), (i*7919 + j) % NUM_POINTS);
+			}
+
+			std::ostringstream oss;
+			oss << std::hex << std::uppercase << (0xC0 | (i % 16)) << " 01 3C 01 06"; // Read class 0
+			t.SendToSlave(oss.str());
+			size_t poll_bytes = 0, fragments = 0;
+			for(; t.Count() > 0; ++fragments) poll_bytes += t.app.Read().Size();
+
+			BOOST_REQUIRE(fragments > 1);
+			if(i == 0) bytes = poll_bytes;
+			BOOST_REQUIRE_EQUAL(poll_bytes, bytes);
+		}
+	}
+
 	BOOST_AUTO_TEST_CASE(ReadClass1)
 	{
 		SlaveConfig cfg; cfg.mDisableUnsol = true;
@@ -627,6 +786,79 @@ BOOST_AUTO_TEST_SUITE(AsyncSlaveSuite)
 		
 	}
 
+	BOOST_AUTO_TEST_CASE(ResponseBufferHeldOnlyForRepeatableResponses)
+	{
+		SlaveConfig cfg; cfg.mDisableUnsol = true;
+		BufferPoolSet pools;
+		BufferPool* pool = pools.Get(cfg.mMaxFragSize);
+		AsyncSlaveTestObject t(cfg, LEV_INFO, false, &pools);
+		t.cmd_master.BindCommand(CT_BINARY_OUTPUT, 3, 3, &t.cmd_acceptor);
+		t.slave.OnLowerLayerUp();
+
+		// the buffer goes back to the pool once the response is sent
+		t.SendToSlave("C0 01 3C 01 06");
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00");
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 0);
+
+		t.SendToSlave("C0 03 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00", SI_OTHER);
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 0);
+
+		// an operate response is kept, a repeat of the operate is answered by sending it again
+		t.cmd_acceptor.Queue(CS_SUCCESS);
+		t.SendToSlave("C1 04 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00", SI_CORRECT);
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 1);
+		t.SendToSlave("C1 04 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00", SI_PREV);
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 0C 01 17 01 03 01 01 01 00 00 00 01 00 00 00 00");
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 1);
+
+		t.SendToSlave("C2 01 3C 01 06", SI_CORRECT);
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00");
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 0);
+	}
+
+	BOOST_AUTO_TEST_CASE(FragmentAheadBufferIsPooled)
+	{
+		SlaveConfig cfg; cfg.mDisableUnsol = true;
+		cfg.mMaxFragSize = 20;
+		BufferPoolSet pools;
+		BufferPool* pool = pools.Get(cfg.mMaxFragSize);
+		AsyncSlaveTestObject t(cfg, LEV_INFO, false, &pools);
+		t.db.Configure(DT_ANALOG, 8);
+		t.slave.OnLowerLayerUp();
+		t.app.DisableAutoSendCallback();
+
+		{
+			Transaction tr(&t.db);
+			for(size_t i=0; i<8; i++) t.db.Update(Analog(0,AQ_ONLINE), i);
+		}
+
+		// the fragment in flight and the one loaded ahead of it each hold a buffer
+		t.SendToSlave("C0 01 3C 01 06");
+		BOOST_REQUIRE_EQUAL(t.Read(), "A0 81 80 00 1E 01 00 00 01 01 00 00 00 00 01 00 00 00 00");
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 2);
+		t.slave.OnSolSendSuccess();
+		BOOST_REQUIRE_EQUAL(t.Read(), "20 81 80 00 1E 01 00 02 03 01 00 00 00 00 01 00 00 00 00");
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 2);
+		t.slave.OnSolSendSuccess();
+		BOOST_REQUIRE_EQUAL(t.Read(), "20 81 80 00 1E 01 00 04 05 01 00 00 00 00 01 00 00 00 00");
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 2);
+
+		// a failure drops the fragment loaded ahead, both buffers go back
+		t.slave.OnSolFailure();
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 0);
+
+		// and once the last fragment is confirmed
+		t.SendToSlave("C0 01 3C 01 06");
+		for(size_t i=0; i<4; ++i) {
+			BOOST_REQUIRE_EQUAL(t.Count(), 1);
+			t.Read();
+			t.slave.OnSolSendSuccess();
+		}
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 0);
+	}
+
 	BOOST_AUTO_TEST_CASE(SelectOperateCROBRetryDifferent)
 	{
 		SlaveConfig cfg; cfg.mDisableUnsol = true;
@@ -901,6 +1133,104 @@ BOOST_AUTO_TEST_SUITE(AsyncSlaveSuite)
 		
 	}
 
+	BOOST_AUTO_TEST_CASE(DirectOperateDeferredResponse)
+	{
+		SlaveConfig cfg; cfg.mDisableUnsol = true;
+		AsyncSlaveTestObject t(cfg);
+		MockCommandAcceptor acceptor(false);
+		t.cmd_master.BindCommand(CT_SETPOINT, 3, 3, CM_DO_ONLY, 5000, &acceptor);
+		t.slave.OnLowerLayerUp();
+
+		acceptor.Queue(CS_HARDWARE_ERROR);
+
+		// direct operate group 41 Var 1, count = 1, index = 3
+		t.SendToSlave("C1 05 29 01 17 01 03 00 00 00 00 00");
+		BOOST_REQUIRE_EQUAL(t.Count(), 0); // the slave is waiting on user code
+		BOOST_REQUIRE_EQUAL(acceptor.NumHeld(), 1);
+
+		// requests are buffered while waiting
+		t.SendToSlave("C0 01 3C 01 06");
+		BOOST_REQUIRE_EQUAL(t.Count(), 0);
+
+		acceptor.RespondOne();
+		BOOST_REQUIRE(t.mts.DispatchOne()); // dispatch the command response event
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 29 01 17 01 03 00 00 00 00 06"); // 0x06 status == CS_HARDWARE_ERROR
+		BOOST_REQUIRE_EQUAL(t.mts.NumActive(), 0); // the response timer was canceled
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00"); // deferred integrity poll
+	}
+
+	BOOST_AUTO_TEST_CASE(DirectOperateResponseTimeout)
+	{
+		SlaveConfig cfg; cfg.mDisableUnsol = true; cfg.mCommandResponseTimeout = 1000;
+		AsyncSlaveTestObject t(cfg);
+		MockCommandAcceptor acceptor(false);
+		t.cmd_master.BindCommand(CT_SETPOINT, 3, 3, CM_DO_ONLY, 5000, &acceptor);
+		t.slave.OnLowerLayerUp();
+
+		acceptor.Queue(CS_SUCCESS);
+
+		// direct operate group 41 Var 1, count = 1, index = 3
+		t.SendToSlave("C1 05 29 01 17 01 03 00 00 00 00 00");
+		BOOST_REQUIRE_EQUAL(t.Count(), 0);
+
+		BOOST_REQUIRE(t.mts.DispatchOne()); // expire the response timer
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 29 01 17 01 03 00 00 00 00 01"); // 0x01 status == CS_TIMEOUT
+
+		// a late response is discarded
+		acceptor.RespondOne();
+		BOOST_REQUIRE(t.mts.DispatchOne());
+		BOOST_REQUIRE_EQUAL(t.Count(), 0);
+	}
+
+	BOOST_AUTO_TEST_CASE(DirectOperateDeferredResponseClosed)
+	{
+		SlaveConfig cfg; cfg.mDisableUnsol = true;
+		AsyncSlaveTestObject t(cfg);
+		MockCommandAcceptor acceptor(false);
+		t.cmd_master.BindCommand(CT_SETPOINT, 3, 3, CM_DO_ONLY, 5000, &acceptor);
+		t.slave.OnLowerLayerUp();
+
+		acceptor.Queue(CS_SUCCESS);
+
+		t.SendToSlave("C1 05 29 01 17 01 03 00 00 00 00 00");
+		t.slave.OnLowerLayerDown();
+		BOOST_REQUIRE_EQUAL(t.mts.NumActive(), 0); // the response timer was canceled
+
+		acceptor.RespondOne();
+		BOOST_REQUIRE(t.mts.DispatchOne());
+		BOOST_REQUIRE_EQUAL(t.Count(), 0);
+	}
+
+	BOOST_AUTO_TEST_CASE(DirectOperateAcceptorThrows)
+	{
+		SlaveConfig cfg; cfg.mDisableUnsol = true; cfg.mMaxControls = 2;
+		AsyncSlaveTestObject t(cfg);
+		MockCommandAcceptor held(false);
+		MockCommandAcceptor broken; // has no responses queued, so it throws
+		t.cmd_master.BindCommand(CT_SETPOINT, 3, 3, CM_DO_ONLY, 5000, &held);
+		t.cmd_master.BindCommand(CT_SETPOINT, 4, 4, CM_DO_ONLY, 5000, &broken);
+		t.slave.OnLowerLayerUp();
+
+		held.Queue(CS_SUCCESS);
+		held.Queue(CS_HARDWARE_ERROR);
+
+		// direct operate group 41 Var 1, count = 2, index = 3 and 4, the second dispatch throws
+		BOOST_REQUIRE_THROW(t.SendToSlave("C1 05 29 01 17 02 03 00 00 00 00 00 04 00 00 00 00 00"), Exception);
+		BOOST_REQUIRE_EQUAL(held.NumHeld(), 1);
+		BOOST_REQUIRE_EQUAL(t.mts.NumActive(), 0); // nothing waits on the command that was dispatched
+
+		// the late response of the dispatched command is discarded
+		held.RespondOne();
+		BOOST_REQUIRE(t.mts.DispatchOne());
+		BOOST_REQUIRE_EQUAL(t.Count(), 0);
+
+		// and the next operate is answered with its own result
+		t.SendToSlave("C2 05 29 01 17 01 03 00 00 00 00 00");
+		held.RespondOne();
+		BOOST_REQUIRE(t.mts.DispatchOne());
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 29 01 17 01 03 00 00 00 00 06"); // 0x06 status == CS_HARDWARE_ERROR
+	}
+
 	BOOST_AUTO_TEST_CASE(SelectBadObject)
 	{
 		SlaveConfig cfg; cfg.mDisableUnsol = true;
@@ -1022,16 +1352,56 @@ BOOST_AUTO_TEST_SUITE(AsyncSlaveSuite)
 	/* ---- Static data reads ----- */
 
 	
-	/*BOOST_AUTO_TEST_CASE(ReadGrp1Var1)
+	BOOST_AUTO_TEST_CASE(ReadGrp1Var1)
 	{	
-		SlaveConfig cfg; cfg.mStaticBinary = GrpVar(1,1);
+		SlaveConfig cfg; cfg.mDisableUnsol = true; cfg.mStaticBinary = GrpVar(1,1);
 		AsyncSlaveTestObject t(cfg);
 		t.db.Configure(DT_BINARY, 9);
 		t.slave.OnLowerLayerUp();
 
-		t.SendToSlave("C0 01 01 01 06");
-		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 01 01 00 00 00 00 00"); // 1 byte start/stop, 2 bytes for bitfield with 9 members
-	}*/
+		{
+			Transaction tr(&t.db);
+			for(size_t i=0; i<9; ++i) t.db.Update(Binary(i == 0 || i == 3 || i == 8, BQ_ONLINE), i);
+		}
+
+		t.SendToSlave("C0 01 01 00 06");
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 01 01 00 00 08 09 01"); // 1 byte start/stop, 2 bytes for bitfield with 9 members
+	}
+
+	BOOST_AUTO_TEST_CASE(ReadGrp1Var1Packed)
+	{	
+		SlaveConfig cfg; cfg.mDisableUnsol = true; cfg.mStaticBinary = GrpVar(1,1);
+		AsyncSlaveTestObject t(cfg);
+		t.db.Configure(DT_BINARY, 20);
+		t.slave.OnLowerLayerUp();
+
+		{
+			Transaction tr(&t.db);
+			for(size_t i=0; i<20; ++i) t.db.Update(Binary(i % 2 == 0, BQ_ONLINE), i);
+		}
+
+		t.SendToSlave("C0 01 3C 01 06");
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 01 01 00 00 13 55 55 05");
+	}
+
+	BOOST_AUTO_TEST_CASE(ReadGrp1Var1FallsBackToVar2ForFlags)
+	{	
+		SlaveConfig cfg; cfg.mDisableUnsol = true; cfg.mStaticBinary = GrpVar(1,1);
+		AsyncSlaveTestObject t(cfg);
+		t.db.Configure(DT_BINARY, 3);
+		t.slave.OnLowerLayerUp();
+
+		{
+			Transaction tr(&t.db);
+			t.db.Update(Binary(true, BQ_ONLINE), 0);
+			t.db.Update(Binary(false, BQ_COMM_LOST), 1);
+			t.db.Update(Binary(true, BQ_ONLINE), 2);
+		}
+
+		// a bitfield can't say that point 1 is offline
+		t.SendToSlave("C0 01 3C 01 06");
+		BOOST_REQUIRE_EQUAL(t.Read(), "C0 81 80 00 01 02 00 00 02 81 04 81");
+	}
 
 	BOOST_AUTO_TEST_CASE(ReadGrp1Var0)
 	{			
@@ -25,6 +25,7 @@
 #include <APL/Util.h>
 #include <APL/ProtocolUtil.h>
 #include <APL/Exception.h>
+#include <APL/BufferPool.h>
 
 #include <boost/foreach.hpp>
 
@@ -249,5 +250,32 @@ BOOST_AUTO_TEST_SUITE(AsyncTransportSuite)
 		}
 	}
 
+	BOOST_AUTO_TEST_CASE(TestPooledBuffersReturned)
+	{
+		BufferPoolSet pools;
+		BufferPool* pool = pools.Get(DEFAULT_FRAG_SIZE);
+		TransportTestObject test(true, LEV_INFO, false, &pools);
+
+		vector<string> packets;
+		string apdu = test.GeneratePacketSequence(packets, 3, 10);
+		test.lower.SendUp(packets[0]);
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 1); // held while reassembling
+		test.lower.SendUp(packets[1]);
+		test.lower.SendUp(packets[2]);
+		BOOST_REQUIRE(test.upper.BufferEquals(apdu));
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 0);
+
+		test.lower.DisableAutoSendCallback();
+		test.upper.SendDown(apdu);
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 1); // held until the last segment is sent
+		for(size_t i = 0; i < packets.size(); ++i) test.lower.SendSuccess();
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 0);
+
+		test.upper.SendDown(apdu);
+		test.lower.ThisLayerDown(); // closing mid-send gives the buffer back
+		BOOST_REQUIRE_EQUAL(pool->NumInUse(), 0);
+		BOOST_REQUIRE(test.IsLogErrorFree());
+	}
+
 
 BOOST_AUTO_TEST_SUITE_END()
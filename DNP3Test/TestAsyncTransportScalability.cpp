@@ -25,6 +25,7 @@
 #include <APLTestTools/BufferHelpers.h>
 #include <APL/ProtocolUtil.h>
 #include <APL/Exception.h>
+#include <APL/TimingTools.h>
 
 
 #include <boost/foreach.hpp>
@@ -68,9 +69,45 @@ using namespace apl::dnp;
 
 			ByteStr b(2048, 0);
 
+			StopWatch sw;
 			t.SendToAll(b, b.Size());
 
 			BOOST_REQUIRE(t.ProceedUntil(bind(&TransportScalabilityTestObject::AllLayerReceived, &t, b.Size()), 120000));
+			BOOST_TEST_MESSAGE(2*NUM_PAIRS << " transport segments of " << b.Size() << " bytes over TCP in " << sw.Elapsed() << "ms");
+			BOOST_REQUIRE(t.AllLayerEqual(b, b.Size()));
+		}
+
+		BOOST_AUTO_TEST_CASE(TestSimpleSendUDP)
+		{
+			LinkConfig client(true, true);
+			LinkConfig server(false, true);
+
+			// UDP ports don't collide with the TCP test above
+			#ifdef WIN32
+			uint_32_t port = 50000;
+			#else
+			uint_32_t port = 30000;
+			#endif
+
+			#ifdef ARM
+			size_t NUM_PAIRS = 50;
+			#else
+			size_t NUM_PAIRS = 100;
+			#endif
+
+			TransportScalabilityTestObject t(client, server, port, NUM_PAIRS, LEV_INFO, false, true);
+
+			t.Start();
+
+			BOOST_REQUIRE(t.ProceedUntil(bind(&TransportScalabilityTestObject::AllLayersUp, &t)));
+
+			ByteStr b(2048, 0);
+
+			StopWatch sw;
+			t.SendToAll(b, b.Size());
+
+			BOOST_REQUIRE(t.ProceedUntil(bind(&TransportScalabilityTestObject::AllLayerReceived, &t, b.Size()), 120000));
+			BOOST_TEST_MESSAGE(2*NUM_PAIRS << " transport segments of " << b.Size() << " bytes over UDP in " << sw.Elapsed() << "ms");
 			BOOST_REQUIRE(t.AllLayerEqual(b, b.Size()));
 		}
 
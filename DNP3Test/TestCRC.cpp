@@ -21,11 +21,13 @@
 
 #include <DNP3/DNPCrc.h>
 #include <APLTestTools/BufferHelpers.h>
+#include <APL/CRC.h>
 
 #include <iostream>
 #include <vector>
 #include <string>
 #include <sstream>
+#include <stdlib.h>
 
 
 using namespace std;
@@ -41,5 +43,35 @@ BOOST_AUTO_TEST_SUITE(CRC)
 		BOOST_REQUIRE_EQUAL(hs.Size(), 10);
 		BOOST_REQUIRE_EQUAL(DNPCrc::CalcCrc(hs, 8), 0x21E9);
 	}
-	
+
+	// the sliced implementation must agree with the byte-at-a-time reference for every length
+	BOOST_AUTO_TEST_CASE(MatchesReference)
+	{
+		unsigned int table[256];
+		apl::CRC::PrecomputeCRC(table, 0xA6BC);
+
+		ByteStr buff(64);
+		for(size_t i = 0; i < 100; ++i) {
+			for(size_t j = 0; j < buff.Size(); ++j) buff[j] = static_cast<byte_t>(rand());
+			for(size_t len = 0; len <= 64; ++len) {
+				BOOST_REQUIRE_EQUAL(DNPCrc::CalcCrc(buff, len), apl::CRC::CalcCRC(buff, len, table, 0x0000, true));
+			}
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(BodyValidation)
+	{
+		// 40 bytes of user data == two full blocks and one partial block of 8
+		HexSequence hs("00 01 02 03 04 05 06 07 08 09 0A 0B 0C 0D 0E 0F FF FF 10 11 12 13 14 15 16 17 18 19 1A 1B 1C 1D 1E 1F FF FF 20 21 22 23 24 25 26 27 FF FF");
+		DNPCrc::AddCrc(hs, 16);
+		DNPCrc::AddCrc(hs + 18, 16);
+		DNPCrc::AddCrc(hs + 36, 8);
+
+		BOOST_REQUIRE(DNPCrc::IsCorrectBodyCRC(hs, 40));
+		BOOST_REQUIRE(DNPCrc::IsCorrectBodyCRC(hs, 0));
+
+		hs[42] ^= 0x01; // corrupt the last block
+		BOOST_REQUIRE_FALSE(DNPCrc::IsCorrectBodyCRC(hs, 40));
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -21,11 +21,84 @@
 
 #include "ResponseLoaderTestObject.h"
 
+#include <APLTestTools/BufferHelpers.h>
+#include <DNP3/APDU.h>
+#include <DNP3/HeaderReadIterator.h>
+#include <DNP3/Objects.h>
+#include <DNP3/ResponseLoader.h>
+
+#include <sstream>
+#include <iomanip>
+
 
 using namespace apl;
 using namespace apl::dnp;
 using namespace boost;
 
+namespace {
+
+	/// counts how the counters arrive, everything else is ignored
+	class RunCountingObserver : public IDataObserver
+	{
+		public:
+
+		RunCountingObserver() : mNumSingle(0), mNumRuns(0), mNumPoints(0) {}
+
+		size_t mNumSingle;
+		size_t mNumRuns;
+		size_t mNumPoints;
+
+		private:
+
+		void _Start() {}
+		void _End() {}
+
+		void _Update(const Binary&, size_t) {}
+		void _Update(const Analog&, size_t) {}
+		void _Update(const Counter&, size_t) { ++mNumSingle; ++mNumPoints; }
+		void _Update(const ControlStatus&, size_t) {}
+		void _Update(const SetpointStatus&, size_t) {}
+
+		void _Update(const Counter*, size_t aNum, size_t) { ++mNumRuns; mNumPoints += aNum; }
+	};
+
+	void LoadInto(IDataObserver* apObserver, const std::string& arAPDU)
+	{
+		EventLog log;
+		HexSequence hs(arAPDU);
+		APDU f;
+		f.Write(hs, hs.Size());
+		f.Interpret();
+
+		ResponseLoader rl(log.GetLogger(LEV_INFO, "rsp"), apObserver);
+		for(HeaderReadIterator hdr = f.BeginRead(); !hdr.IsEnd(); ++hdr) rl.Process(hdr);
+	}
+
+	/// reference decode of one header, a point at a time through the single point Update
+	template <class T>
+	void LoadEach(HeaderReadIterator& arIter, StreamObject<T>* apObj, IDataObserver* apObserver)
+	{
+		for(ObjectReadIterator obj = arIter.BeginRead(); !obj.IsEnd(); ++obj) {
+			T value = apObj->Read(*obj);
+			if(!apObj->HasQuality()) value.SetQuality(T::ONLINE);
+			apObserver->Update(value, obj->Index());
+		}
+	}
+
+	/// appends a 0x01 qualified header for aNum objects of aSize bytes with varying contents
+	void AppendRange(std::ostringstream& arHex, int aGroup, int aVar, size_t aNum, size_t aSize)
+	{
+		arHex << std::hex << std::setfill('0');
+		arHex << " " << std::setw(2) << aGroup << " " << std::setw(2) << aVar << " 01 00 00 ";
+		arHex << std::setw(2) << ((aNum - 1) & 0xFF) << " " << std::setw(2) << ((aNum - 1) >> 8);
+		for(size_t i = 0; i < aNum; ++i) {
+			arHex << " 01";	// online
+			for(size_t j = 1; j < aSize; ++j) arHex << " " << std::setw(2) << ((i * 7 + j) & 0xFF);
+		}
+	}
+
+}
+
 
 	BOOST_AUTO_TEST_SUITE(ResponseLoaderSuite)
 		BOOST_AUTO_TEST_CASE(Group1Var1)
@@ -133,5 +206,49 @@ using namespace boost;
 			t.CheckSetpointStatii("C0 81 00 00 28 02 00 00 01 01 04 00 01 09 00");
 		}
 
+		BOOST_AUTO_TEST_CASE(RangedHeaderIsOneRun)
+		{
+			RunCountingObserver obs;
+			LoadInto(&obs, "C0 81 00 00 14 01 00 00 01 01 04 00 00 00 01 09 00 00 00");
+			BOOST_REQUIRE_EQUAL(obs.mNumRuns, 1);
+			BOOST_REQUIRE_EQUAL(obs.mNumSingle, 0);
+			BOOST_REQUIRE_EQUAL(obs.mNumPoints, 2);
+		}
+
+		BOOST_AUTO_TEST_CASE(IndexedHeaderIsPerPoint)
+		{
+			RunCountingObserver obs;
+			LoadInto(&obs, "C0 81 00 00 14 01 17 02 00 01 04 00 00 00 01 01 09 00 00 00");
+			BOOST_REQUIRE_EQUAL(obs.mNumRuns, 0);
+			BOOST_REQUIRE_EQUAL(obs.mNumSingle, 2);
+		}
+
+		BOOST_AUTO_TEST_CASE(RangedAndPerObjectDecodingAgree)
+		{
+			std::ostringstream hex;
+			hex << "C0 81 00 00";
+			AppendRange(hex, 1, 2, 50, 1);
+			AppendRange(hex, 20, 1, 20, 5);
+			AppendRange(hex, 30, 1, 20, 5);
+
+			FlexibleDataObserver each, range;
+			LoadInto(&range, hex.str());
+
+			HexSequence hs(hex.str());
+			APDU f;
+			f.Write(hs, hs.Size());
+			f.Interpret();
+			{
+				Transaction tr(&each);
+				HeaderReadIterator hdr = f.BeginRead();
+				LoadEach(hdr, dnp::Group1Var2::Inst(), &each); ++hdr;
+				LoadEach(hdr, dnp::Group20Var1::Inst(), &each); ++hdr;
+				LoadEach(hdr, dnp::Group30Var1::Inst(), &each);
+			}
+
+			BOOST_REQUIRE_EQUAL(range.GetTotalCount(), 90);
+			BOOST_REQUIRE(FlexibleDataObserver::StrictEquality(each, range));
+		}
+
 	BOOST_AUTO_TEST_SUITE_END() //end suite
 
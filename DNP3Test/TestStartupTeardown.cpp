@@ -22,10 +22,32 @@
 
 #include "AsyncStartupTeardownTest.h"
 
+#include <APL/Exception.h>
+
+#include <boost/foreach.hpp>
+
 using namespace std;
 using namespace apl;
 using namespace apl::dnp;
 
+/// Adds aNumPorts TCP clients with aStacksPerPort masters each
+static void AddMasters(StackBatch& arBatch, size_t aNumPorts, size_t aStacksPerPort, IDataObserver* apPublisher)
+{
+	for(size_t i=0; i<aNumPorts; ++i) {
+		ostringstream port;
+		port << "port" << i;
+		arBatch.AddTCPClient(port.str(), PhysLayerSettings(LEV_WARNING, 1000), TCPSettings("127.0.0.1", 30000));
+
+		for(size_t j=0; j<aStacksPerPort; ++j) {
+			ostringstream stack;
+			stack << port.str() << " - stack" << j;
+			MasterStackConfig cfg;
+			cfg.link.LocalAddr = static_cast<uint_16_t>(j);
+			arBatch.AddMaster(port.str(), stack.str(), LEV_WARNING, apPublisher, cfg);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE(AsyncIntegrationSuite)
 
 	/// This test aggressively starts and stops stacks
@@ -57,5 +79,169 @@ BOOST_AUTO_TEST_SUITE(AsyncIntegrationSuite)
 		// shutdown starts when the destructor is called.
 	}
 
+	/// Same as above, but the ports are driven by a pool of threads. Whatever runs on a port must
+	/// stay on its strand, while different ports run in parallel.
+	BOOST_AUTO_TEST_CASE(StackTearDownThreadPool)
+	{
+		const size_t NUM_STACKS = 10;
+		const size_t NUM_PORTS = 10;
+		const size_t NUM_THREADS = 4;
+		const size_t NUM_POSTS = 20;
+
+		FilterLevel lev = LEV_WARNING;
+
+		AsyncStartupTeardownTest t(lev, true, NUM_THREADS);
+		std::vector<std::string> ports;
+
+		for(size_t i=0; i<NUM_PORTS; ++i) {
+			ostringstream port;
+			port << "port" << i;
+
+			t.CreatePort(port.str(), lev);
+			ports.push_back(port.str());
+
+			for(size_t i=0; i<NUM_STACKS; ++i) {
+				ostringstream stack;
+				stack << port.str() << " - stack" << i;
+
+				t.AddMaster(stack.str(), port.str(), static_cast<uint_16_t>(i), LEV_WARNING);
+			}
+		}
+
+		BOOST_REQUIRE_EQUAL(t.CountOverlaps(ports, NUM_POSTS), 0);
+		BOOST_REQUIRE(t.MaxParallel() > 1);
+	}
+
+	BOOST_AUTO_TEST_CASE(BatchAddsPortsAndStacks)
+	{
+		EventLog log;
+		AsyncStackManager mgr(log.GetLogger(LEV_WARNING, "mgr"));
+		FlexibleDataObserver fdo;
+
+		StackBatch batch;
+		AddMasters(batch, 2, 3, &fdo);
+		SlaveStackConfig cfg;
+		cfg.link.LocalAddr = 10;
+		batch.AddSlave("port1", "slave", LEV_WARNING, NULL, cfg);
+		mgr.AddBatch(batch);
+
+		BOOST_REQUIRE_EQUAL(mgr.GetPortNames().size(), 2);
+		BOOST_REQUIRE_EQUAL(mgr.GetStackNames().size(), 7);
+		BOOST_FOREACH(StackBatch::MasterRecord& r, batch.mMasters) { BOOST_REQUIRE(r.mpCmdAcceptor != NULL); }
+		BOOST_REQUIRE(batch.mSlaves[0].mpDataObserver != NULL);
+
+		// a stack added later on the same port joins the batch's stacks
+		MasterStackConfig late;
+		late.link.LocalAddr = 20;
+		mgr.AddMaster("port0", "late", LEV_WARNING, &fdo, late);
+		mgr.RemovePort("port0");
+		BOOST_REQUIRE_EQUAL(mgr.GetStackNames().size(), 4);
+		mgr.RemoveStack("slave");
+		BOOST_REQUIRE_EQUAL(mgr.GetStackNames().size(), 3);
+	}
+
+	BOOST_AUTO_TEST_CASE(BatchIsCheckedBeforeAnythingIsAdded)
+	{
+		EventLog log;
+		AsyncStackManager mgr(log.GetLogger(LEV_WARNING, "mgr"));
+		FlexibleDataObserver fdo;
+
+		StackBatch unknown;
+		AddMasters(unknown, 2, 2, &fdo);
+		unknown.AddMaster("port2", "orphan", LEV_WARNING, &fdo, MasterStackConfig());
+		BOOST_REQUIRE_THROW(mgr.AddBatch(unknown), ArgumentException);
+
+		StackBatch duplicate;
+		AddMasters(duplicate, 1, 2, &fdo);
+		duplicate.AddMaster("port0", "port0 - stack1", LEV_WARNING, &fdo, MasterStackConfig());
+		BOOST_REQUIRE_THROW(mgr.AddBatch(duplicate), ArgumentException);
+
+		BOOST_REQUIRE(mgr.GetPortNames().empty());
+		BOOST_REQUIRE(mgr.GetStackNames().empty());
+
+		StackBatch batch;
+		AddMasters(batch, 1, 2, &fdo);
+		mgr.AddBatch(batch);
+		BOOST_REQUIRE_THROW(mgr.AddBatch(batch), ArgumentException);
+		BOOST_REQUIRE_THROW(mgr.AddMaster("port0", "port0 - stack0", LEV_WARNING, &fdo, MasterStackConfig()), ArgumentException);
+		BOOST_REQUIRE_EQUAL(mgr.GetStackNames().size(), 2);
+	}
+
+	BOOST_AUTO_TEST_CASE(BatchAddsListenersAndConcurrentPorts)
+	{
+		EventLog log;
+		AsyncStackManager mgr(log.GetLogger(LEV_WARNING, "mgr"));
+		FlexibleDataObserver fdo;
+
+		TCPSettings concurrent("127.0.0.1", 30000);
+		concurrent.mConcurrentMasters = true;
+		MasterStackConfig cfg;
+
+		StackBatch slaveOnListener;
+		slaveOnListener.AddTCPListener("listener", PhysLayerSettings(LEV_WARNING, 1000), TCPSettings("127.0.0.1", 30000), 1000);
+		slaveOnListener.AddSlave("listener", "slave", LEV_WARNING, NULL, SlaveStackConfig());
+		BOOST_REQUIRE_THROW(mgr.AddBatch(slaveOnListener), ArgumentException);
+		BOOST_REQUIRE(mgr.GetPortNames().empty());
+
+		StackBatch batch;
+		batch.AddTCPListener("listener", PhysLayerSettings(LEV_WARNING, 1000), TCPSettings("127.0.0.1", 30000), 1000);
+		batch.AddTCPClient("concurrent", PhysLayerSettings(LEV_WARNING, 1000), concurrent);
+		for(uint_16_t i=0; i<2; ++i) {
+			ostringstream index;
+			index << i;
+			cfg.link.LocalAddr = i;
+			batch.AddMaster("listener", "listener" + index.str(), LEV_WARNING, &fdo, cfg);
+			batch.AddMaster("concurrent", "concurrent" + index.str(), LEV_WARNING, &fdo, cfg);
+		}
+		mgr.AddBatch(batch);
+
+		BOOST_REQUIRE_EQUAL(mgr.GetPortNames().size(), 2);
+		BOOST_REQUIRE_EQUAL(mgr.GetStackNames().size(), 4);
+		BOOST_FOREACH(StackBatch::MasterRecord& r, batch.mMasters) { BOOST_REQUIRE(r.mpCmdAcceptor != NULL); }
+		BOOST_REQUIRE_THROW(mgr.AddSlave("listener", "slave", LEV_WARNING, NULL, SlaveStackConfig()), ArgumentException);
+
+		mgr.RemovePort("listener");
+		mgr.RemoveStack("concurrent0");
+		BOOST_REQUIRE_EQUAL(mgr.GetStackNames().size(), 1);
+	}
+
+	/// A stack that fails after its port is allocated leaves no index entry, lane or session port behind
+	BOOST_AUTO_TEST_CASE(FailedStackIsDiscarded)
+	{
+		EventLog log;
+		AsyncStackManager mgr(log.GetLogger(LEV_WARNING, "mgr"));
+		FlexibleDataObserver fdo;
+
+		TCPSettings concurrent("127.0.0.1", 30000);
+		concurrent.mConcurrentMasters = true;
+		mgr.AddTCPClient("concurrent", PhysLayerSettings(LEV_WARNING, 1000), concurrent);
+		mgr.AddTCPListener("listener", PhysLayerSettings(LEV_WARNING, 1000), TCPSettings("127.0.0.1", 30000), 1000);
+
+		// a metric of another type under a stack's name fails its registration, unlike a full registry
+		mgr.GetMetrics()->RegisterGauge("a.frames_rx");
+		mgr.GetMetrics()->RegisterGauge("b.frames_rx");
+		BOOST_REQUIRE_THROW(mgr.AddMaster("concurrent", "a", LEV_WARNING, &fdo, MasterStackConfig()), ArgumentException);
+		BOOST_REQUIRE_THROW(mgr.AddMaster("listener", "b", LEV_WARNING, &fdo, MasterStackConfig()), ArgumentException);
+		BOOST_REQUIRE(mgr.GetStackNames().empty());
+
+		StackBatch batch;
+		batch.AddMaster("concurrent", "c", LEV_WARNING, &fdo, MasterStackConfig());
+		mgr.GetMetrics()->RegisterGauge("d.frames_rx");
+		batch.AddMaster("concurrent", "d", LEV_WARNING, &fdo, MasterStackConfig());
+		BOOST_REQUIRE_THROW(mgr.AddBatch(batch), ArgumentException);
+		BOOST_REQUIRE_EQUAL(mgr.GetStackNames().size(), 1);	// the stacks built before the failure are kept
+
+		mgr.AddMaster("listener", "e", LEV_WARNING, &fdo, MasterStackConfig());
+		mgr.RemovePort("listener");
+		mgr.RemovePort("concurrent");
+		BOOST_REQUIRE(mgr.GetStackNames().empty());
+	}
+
+	BOOST_AUTO_TEST_CASE(ThreadPoolRequiresAThread)
+	{
+		EventLog log;
+		BOOST_REQUIRE_THROW(AsyncStackManager mgr(log.GetLogger(LEV_WARNING, "mgr"), false, 0), ArgumentException);
+	}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -32,7 +32,8 @@ TransportScalabilityTestObject::TransportScalabilityTestObject(
 	uint_16_t aPortStart,
 	uint_16_t aNumPair,
 	FilterLevel aLevel,
-	bool aImmediate) :
+	bool aImmediate,
+	bool aUseUDP) :
 
 LogTester(aImmediate),
 AsyncTestObjectASIO(),
@@ -46,8 +47,17 @@ mTimerSource(this->GetService())
 		ostringstream oss;
 		oss << "pair" << port;
 		Logger* pLogger = mpLogger->GetSubLogger(oss.str());
-		TCPSettings tcp("127.0.0.1", port);
-		TransportStackPair* pPair = new TransportStackPair(aClientCfg, aServerCfg, pLogger, this->GetService(), &mTimerSource, tcp);
+		TransportStackPair* pPair;
+		if(aUseUDP) {
+			// the servers are bound to the block of ports after the clients
+			UDPSettings client("127.0.0.1", port, "127.0.0.1", port + aNumPair);
+			UDPSettings server("127.0.0.1", port + aNumPair, "127.0.0.1", port);
+			pPair = new TransportStackPair(aClientCfg, aServerCfg, pLogger, this->GetService(), &mTimerSource, client, server);
+		}
+		else {
+			TCPSettings tcp("127.0.0.1", port);
+			pPair = new TransportStackPair(aClientCfg, aServerCfg, pLogger, this->GetService(), &mTimerSource, tcp);
+		}
 		mPairs.push_back(pPair);
 	}
 }
@@ -36,7 +36,8 @@ class TransportScalabilityTestObject : public LogTester, public AsyncTestObjectA
 			uint_16_t aPortStart,
 			uint_16_t aNumPair,
 			FilterLevel aLevel = LEV_INFO,
-			bool aImmediate = false);
+			bool aImmediate = false,
+			bool aUseUDP = false);
 
 		~TransportScalabilityTestObject();
 
@@ -31,10 +31,27 @@ TransportStackPair::TransportStackPair(
 	ITimerSource* apTimerSrc,
 	TCPSettings aTcp) :
 
-mClient(apLogger->GetSubLogger("TCPClient"), apService, aTcp),
-mServer(apLogger->GetSubLogger("TCPServer"), apService, aTcp),
-mClientStack(apLogger->GetSubLogger("ClientStack"), apTimerSrc, &mClient, aClientCfg),
-mServerStack(apLogger->GetSubLogger("ServerStack"), apTimerSrc, &mServer, aServerCfg)
+mpClient(new PhysicalLayerAsyncTCPClient(apLogger->GetSubLogger("TCPClient"), apService, aTcp)),
+mpServer(new PhysicalLayerAsyncTCPServer(apLogger->GetSubLogger("TCPServer"), apService, aTcp)),
+mClientStack(apLogger->GetSubLogger("ClientStack"), apTimerSrc, mpClient.get(), aClientCfg),
+mServerStack(apLogger->GetSubLogger("ServerStack"), apTimerSrc, mpServer.get(), aServerCfg)
+{
+
+}
+
+TransportStackPair::TransportStackPair(
+	LinkConfig aClientCfg,
+	LinkConfig aServerCfg,
+	Logger* apLogger,
+	boost::asio::io_service* apService,
+	ITimerSource* apTimerSrc,
+	UDPSettings aClientUdp,
+	UDPSettings aServerUdp) :
+
+mpClient(new PhysicalLayerAsyncUDP(apLogger->GetSubLogger("UDPClient"), apService, aClientUdp)),
+mpServer(new PhysicalLayerAsyncUDP(apLogger->GetSubLogger("UDPServer"), apService, aServerUdp)),
+mClientStack(apLogger->GetSubLogger("ClientStack"), apTimerSrc, mpClient.get(), aClientCfg),
+mServerStack(apLogger->GetSubLogger("ServerStack"), apTimerSrc, mpServer.get(), aServerCfg)
 {
 
 }
@@ -26,10 +26,13 @@ namespace boost { namespace asio {
 
 #include <APL/PhysicalLayerAsyncTCPClient.h>
 #include <APL/PhysicalLayerAsyncTCPServer.h>
+#include <APL/PhysicalLayerAsyncUDP.h>
 #include <APL/TimerInterfaces.h>
 
 #include "TransportIntegrationStack.h"
 
+#include <memory>
+
 namespace apl { namespace dnp {
 
 class TransportStackPair
@@ -43,14 +46,24 @@ class TransportStackPair
 			ITimerSource* apTimerSrc,
 			TCPSettings aTcp);
 
+		/// Pairs the stacks over two UDP layers that send to each other's ports
+		TransportStackPair(
+			LinkConfig aClientCfg,
+			LinkConfig aServerCfg,
+			Logger* apLogger,
+			boost::asio::io_service* apService,
+			ITimerSource* apTimerSrc,
+			UDPSettings aClientUdp,
+			UDPSettings aServerUdp);
+
 		void Start();
 
 		//test helper functions
 		bool BothLayersUp();
 
 	public:
-		PhysicalLayerAsyncTCPClient mClient;
-		PhysicalLayerAsyncTCPServer mServer;
+		std::auto_ptr<IPhysicalLayerAsync> mpClient;
+		std::auto_ptr<IPhysicalLayerAsync> mpServer;
 
 		TransportIntegrationStack mClientStack;
 		TransportIntegrationStack mServerStack;
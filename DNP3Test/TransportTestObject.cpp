@@ -28,10 +28,10 @@ using namespace std;
 
 namespace apl { namespace dnp {
 
-TransportTestObject::TransportTestObject(bool aOpenOnStart, FilterLevel aLevel, bool aImmediate) : 
+TransportTestObject::TransportTestObject(bool aOpenOnStart, FilterLevel aLevel, bool aImmediate, BufferPoolSet* apPools) : 
 LogTester(aImmediate),
 mpLogger(mLog.GetLogger(aLevel, "TransportTestObject")),
-transport(mpLogger),
+transport(mpLogger, DEFAULT_FRAG_SIZE, apPools),
 lower(mpLogger),
 upper(mpLogger)
 {
@@ -34,7 +34,7 @@ namespace apl { namespace dnp {
 class TransportTestObject : public LogTester
 {
 	public:
-	TransportTestObject(bool aOpenOnStart = false, FilterLevel aLevel = LEV_INFO, bool aImmediate = false);
+	TransportTestObject(bool aOpenOnStart = false, FilterLevel aLevel = LEV_INFO, bool aImmediate = false, BufferPoolSet* apPools = NULL);
 
 	/// Generate a complete packet sequence inside the vector and
 	/// return the corresponding reassembled APDU
@@ -40,6 +40,24 @@ mServerUpper(mLog.GetLogger(aLevel,"MockUpperServer"))
 	mServerAdapter.SetUpperLayer(&mServerUpper);
 }
 
+AsyncUDPTestObject::AsyncUDPTestObject(FilterLevel aLevel, bool aImmediate, size_t aMaxDatagramSize) :
+AsyncTestObjectASIO(),
+LogTester(aImmediate),
+mUDPClient(mLog.GetLogger(aLevel,"UDPClient"), this->GetService(), UDPSettings("127.0.0.1", 50010, "127.0.0.1", 50011, aMaxDatagramSize)),
+mUDPClient2(mLog.GetLogger(aLevel,"UDPClient2"), this->GetService(), UDPSettings("127.0.0.1", 50012, "127.0.0.1", 50011, aMaxDatagramSize)),
+mUDPServer(mLog.GetLogger(aLevel,"UDPServer"), this->GetService(), UDPSettings("127.0.0.1", 50011, "", 0, aMaxDatagramSize)),
+mClientAdapter(mLog.GetLogger(aLevel,"ClientAdapter"), &mUDPClient),
+mClient2Adapter(mLog.GetLogger(aLevel,"Client2Adapter"), &mUDPClient2),
+mServerAdapter(mLog.GetLogger(aLevel,"ServerAdapter"), &mUDPServer),
+mClientUpper(mLog.GetLogger(aLevel,"MockUpperClient")),
+mClient2Upper(mLog.GetLogger(aLevel,"MockUpperClient2")),
+mServerUpper(mLog.GetLogger(aLevel,"MockUpperServer"))
+{
+	mClientAdapter.SetUpperLayer(&mClientUpper);
+	mClient2Adapter.SetUpperLayer(&mClient2Upper);
+	mServerAdapter.SetUpperLayer(&mServerUpper);
+}
+
 AsyncLoopback::AsyncLoopback(Logger* apLogger, IPhysicalLayerAsync* apPhys, ITimerSource* apTimerSrc, FilterLevel aLevel, bool aImmediate) :
 Loggable(apLogger),
 AsyncPhysLayerMonitor(apLogger, apPhys, apTimerSrc, 5000),
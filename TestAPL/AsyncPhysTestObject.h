@@ -24,6 +24,7 @@
 #include <APLTestTools/LogTester.h>
 #include <APL/PhysicalLayerAsyncTCPClient.h>
 #include <APL/PhysicalLayerAsyncTCPServer.h>
+#include <APL/PhysicalLayerAsyncUDP.h>
 #include <APL/LowerLayerToPhysAdapter.h>
 #include <APL/AsyncPhysLayerMonitor.h>
 #include <APL/CopyableBuffer.h>
@@ -50,6 +51,29 @@ namespace apl {
 			MockUpperLayer mServerUpper;
 	};
 
+	/// Both clients send to the server's port, the server replies to whoever sent to it
+	class AsyncUDPTestObject : public AsyncTestObjectASIO, public LogTester
+	{
+		public:
+			AsyncUDPTestObject(FilterLevel aLevel = LEV_INFO, bool aImmediate = false, size_t aMaxDatagramSize = UDPSettings::DEFAULT_MAX_DATAGRAM_SIZE);
+
+		private:
+			Logger* mpLogger;
+
+		public:
+			PhysicalLayerAsyncUDP mUDPClient;
+			PhysicalLayerAsyncUDP mUDPClient2;
+			PhysicalLayerAsyncUDP mUDPServer;
+
+			LowerLayerToPhysAdapter mClientAdapter;
+			LowerLayerToPhysAdapter mClient2Adapter;
+			LowerLayerToPhysAdapter mServerAdapter;
+
+			MockUpperLayer mClientUpper;
+			MockUpperLayer mClient2Upper;
+			MockUpperLayer mServerUpper;
+	};
+
 	class AsyncLoopback : public AsyncPhysLayerMonitor
 	{
 		public:
@@ -31,6 +31,7 @@
 #include <boost/bind.hpp>
 #include <boost/date_time/posix_time/ptime.hpp>
 #include <queue>
+#include <map>
 
 using namespace apl;
 using namespace boost;
@@ -231,6 +232,35 @@ BOOST_AUTO_TEST_CASE(DependenciesEnforced)
 	BOOST_REQUIRE_EQUAL(mth.Front(), pT2);
 }
 
+BOOST_AUTO_TEST_CASE(PeriodicDependencyBlocksWhenDue)
+{
+	MockTaskHandler mth;
+	MockTimerSource mts;
+	MockTimeSource fake_time;
+	AsyncTaskScheduler ats(&mts, &fake_time);
+
+	fake_time.SetToNow();
+
+	AsyncTaskGroup* pGroup = ats.NewGroup();
+	AsyncTaskBase* pT1 = pGroup->Add(1000, 100, 0, mth.GetHandler());
+	AsyncTaskBase* pT2 = pGroup->Add(500, 100, 1, mth.GetHandler()); // higher priority, but depends on T1
+	pT2->AddDependency(pT1);
+
+	pGroup->Enable();
+	BOOST_REQUIRE_EQUAL(mth.Front(), pT1); mth.Complete(true);
+	BOOST_REQUIRE_EQUAL(mth.Front(), pT2); mth.Complete(true);
+
+	fake_time.Advance(500);
+	BOOST_REQUIRE(mts.DispatchOne());
+	BOOST_REQUIRE_EQUAL(mth.Front(), pT2); mth.Complete(true);
+
+	// both are due, but T1 is incomplete again so T2 has to wait for it
+	fake_time.Advance(500);
+	BOOST_REQUIRE(mts.DispatchOne());
+	BOOST_REQUIRE_EQUAL(mth.Front(), pT1); mth.Complete(true);
+	BOOST_REQUIRE_EQUAL(mth.Front(), pT2); mth.Complete(true);
+}
+
 BOOST_AUTO_TEST_CASE(TimerUsage)
 {
 	MockTaskHandler mth;
@@ -262,4 +292,43 @@ BOOST_AUTO_TEST_CASE(TimerUsage)
 	BOOST_REQUIRE_EQUAL(mth.Front(), pT2); mth.Complete(true);
 }
 
+BOOST_AUTO_TEST_CASE(ManyPeriodicTasks)
+{
+	const size_t NUM_TASKS = 100;
+	const size_t NUM_ROUNDS = 3;
+
+	MockTaskHandler mth;
+	MockTimerSource mts;
+	MockTimeSource fake_time;
+	AsyncTaskScheduler ats(&mts, &fake_time);
+
+	fake_time.SetToNow();
+
+	AsyncTaskGroup* pGroup = ats.NewGroup();
+	for(size_t i = 0; i < NUM_TASKS; ++i) pGroup->Add(1000, 100, static_cast<int>(i % 4), mth.GetHandler());
+
+	std::map<ITask*, size_t> counts;
+	size_t dispatched = 0;
+
+	pGroup->Enable();
+	for(size_t round = 0; round < NUM_ROUNDS; ++round) {
+		while(mth.Size() > 0) {
+			++counts[mth.Front()];
+			++dispatched;
+			mth.Complete(true);
+		}
+
+		// every task has run and is waiting on the same period
+		BOOST_REQUIRE_EQUAL(mts.NumActive(), 1);
+		fake_time.Advance(1000);
+		BOOST_REQUIRE(mts.DispatchOne());
+	}
+
+	BOOST_REQUIRE_EQUAL(dispatched, NUM_TASKS * NUM_ROUNDS);
+	BOOST_REQUIRE_EQUAL(counts.size(), NUM_TASKS);
+	for(std::map<ITask*, size_t>::iterator i = counts.begin(); i != counts.end(); ++i) {
+		BOOST_REQUIRE_EQUAL(i->second, NUM_ROUNDS);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
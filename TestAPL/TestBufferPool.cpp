@@ -0,0 +1,127 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+#include <APLTestTools/TestHelpers.h>
+
+#include <APL/BufferPool.h>
+#include <APL/CopyableBuffer.h>
+#include <APL/MetricRegistry.h>
+#include <APL/Exception.h>
+
+#include <string.h>
+
+using namespace apl;
+
+BOOST_AUTO_TEST_SUITE(BufferPoolSuite)
+
+	BOOST_AUTO_TEST_CASE(ReusesReleasedBuffers)
+	{
+		BufferPool pool(100, 2);
+		BOOST_REQUIRE_EQUAL(pool.NumAllocated(), 0);
+
+		byte_t* a = pool.Acquire();
+		byte_t* b = pool.Acquire();
+		byte_t* c = pool.Acquire();
+		BOOST_REQUIRE(a != b && b != c && a != c);
+		BOOST_REQUIRE_EQUAL(pool.NumInUse(), 3);
+		BOOST_REQUIRE_EQUAL(pool.NumAllocated(), 4);
+
+		pool.Release(b);
+		BOOST_REQUIRE_EQUAL(pool.NumInUse(), 2);
+		BOOST_REQUIRE_EQUAL(pool.Acquire(), b);
+
+		pool.Release(a); pool.Release(b); pool.Release(c);
+		BOOST_REQUIRE_EQUAL(pool.NumInUse(), 0);
+		BOOST_REQUIRE_EQUAL(pool.NumAllocated(), 4);
+	}
+
+	BOOST_AUTO_TEST_CASE(ReportsGauges)
+	{
+		MetricRegistry reg;
+		BufferPoolSet pools(&reg, "frag");
+		BufferPool* pool = pools.Get(2048);
+		BOOST_REQUIRE_EQUAL(pools.Get(2048), pool);
+		BOOST_REQUIRE(pools.Get(249) != pool);
+		BOOST_REQUIRE(GetPool(NULL, 2048) == NULL);
+
+		byte_t* p = pool->Acquire();
+		MetricSnapshot s;
+		BOOST_REQUIRE(reg.Read("frag.2048.in_use", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 1);
+		BOOST_REQUIRE(reg.Read("frag.2048.allocated", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, BufferPool::DEFAULT_BUFFERS_PER_SLAB);
+
+		pool->Release(p);
+		BOOST_REQUIRE(reg.Read("frag.2048.in_use", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 0);
+	}
+
+	BOOST_AUTO_TEST_CASE(PooledCopyableBuffer)
+	{
+		BufferPool pool(10);
+		BOOST_REQUIRE_THROW(CopyableBuffer(11, &pool), ArgumentException);
+
+		CopyableBuffer buff(10, &pool);
+		BOOST_REQUIRE(buff.IsPooled());
+		BOOST_REQUIRE_EQUAL(buff.Size(), 10);
+		BOOST_REQUIRE(buff.Buffer() == NULL);
+		BOOST_REQUIRE_EQUAL(pool.NumInUse(), 0);
+
+		buff.Borrow();
+		buff.Borrow();
+		BOOST_REQUIRE(buff.Buffer() != NULL);
+		BOOST_REQUIRE_EQUAL(pool.NumInUse(), 1);
+		memset(buff.WriteBuffer(), 0xAB, 10);
+
+		{
+			CopyableBuffer copy(buff);
+			BOOST_REQUIRE(copy.IsPooled());
+			BOOST_REQUIRE(copy == buff);
+			BOOST_REQUIRE(copy.Buffer() != buff.Buffer());
+			BOOST_REQUIRE_EQUAL(pool.NumInUse(), 2);
+		}
+		BOOST_REQUIRE_EQUAL(pool.NumInUse(), 1);
+
+		CopyableBuffer owned(10);
+		owned.Zero();
+		owned.Swap(buff);
+		BOOST_REQUIRE(owned.IsPooled());
+		BOOST_REQUIRE_FALSE(buff.IsPooled());
+		BOOST_REQUIRE_EQUAL(owned[0], 0xAB);
+
+		owned.Return();
+		BOOST_REQUIRE(owned.Buffer() == NULL);
+		BOOST_REQUIRE_EQUAL(pool.NumInUse(), 0);
+
+		buff.Return(); // no-op on an owned buffer
+		BOOST_REQUIRE(buff.Buffer() != NULL);
+
+		owned = buff;
+		BOOST_REQUIRE_EQUAL(pool.NumInUse(), 1);
+		BOOST_REQUIRE(owned == buff);
+
+		// assigning another size would unpool the buffer, so it's refused
+		CopyableBuffer other(11);
+		BOOST_REQUIRE_THROW(owned = other, ArgumentException);
+		BOOST_REQUIRE(owned.IsPooled());
+		BOOST_REQUIRE_EQUAL(owned.Size(), 10);
+		BOOST_REQUIRE_EQUAL(pool.NumInUse(), 1);
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
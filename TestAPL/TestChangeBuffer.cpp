@@ -0,0 +1,171 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+#include <APLTestTools/TestHelpers.h>
+
+#include <APL/ChangeBuffer.h>
+#include <APL/Lock.h>
+
+#include <vector>
+
+using namespace apl;
+
+namespace {
+
+	/// records the analog changes it receives, everything else is just counted
+	class RecordingObserver : public IDataObserver
+	{
+		public:
+
+		RecordingObserver() : mCount(0), mNumAnalogRuns(0), mpFeedback(NULL) {}
+
+		size_t mCount;
+		size_t mNumAnalogRuns;
+		std::vector< Change<Analog> > mAnalogs;
+		IDataObserver* mpFeedback;	/// if set, each analog change is echoed here as a binary
+
+		private:
+
+		void _Start() {}
+		void _End() {}
+
+		void _Update(const Binary&, size_t) { ++mCount; }
+		void _Update(const Analog& arPoint, size_t aIndex)
+		{
+			++mCount;
+			mAnalogs.push_back(Change<Analog>(arPoint, aIndex));
+			if(mpFeedback) {
+				Transaction tr(mpFeedback);
+				mpFeedback->Update(Binary(true), aIndex);
+			}
+		}
+		void _Update(const Analog* apPoints, size_t aNum, size_t aStart)
+		{
+			++mNumAnalogRuns;
+			for(size_t i = 0; i < aNum; ++i) this->_Update(apPoints[i], aStart + i);
+		}
+		void _Update(const Counter&, size_t) { ++mCount; }
+		void _Update(const ControlStatus&, size_t) { ++mCount; }
+		void _Update(const SetpointStatus&, size_t) { ++mCount; }
+	};
+
+}
+
+BOOST_AUTO_TEST_SUITE(ChangeBufferSuite)
+
+	BOOST_AUTO_TEST_CASE(FlushAndClear)
+	{
+		ChangeBuffer<SigLock> buffer;
+		RecordingObserver obs;
+
+		{
+			Transaction tr(buffer);
+			buffer.Update(Analog(1), 0);
+			buffer.Update(Analog(2), 0);
+			buffer.Update(Binary(true), 3);
+		}
+
+		BOOST_REQUIRE_EQUAL(buffer.FlushUpdates(&obs), 3);
+		BOOST_REQUIRE_EQUAL(obs.mAnalogs.size(), 2);
+		BOOST_REQUIRE_EQUAL(obs.mAnalogs[1].mValue.GetValue(), 2);
+		BOOST_REQUIRE_EQUAL(buffer.FlushUpdates(&obs), 0);
+	}
+
+	BOOST_AUTO_TEST_CASE(FlushWithoutClear)
+	{
+		ChangeBuffer<SigLock> buffer;
+		RecordingObserver obs1, obs2;
+
+		{
+			Transaction tr(buffer);
+			buffer.Update(Analog(1), 0);
+		}
+
+		BOOST_REQUIRE_EQUAL(buffer.FlushUpdates(&obs1, false), 1);
+		BOOST_REQUIRE_EQUAL(buffer.FlushUpdates(&obs2, false), 1);
+
+		{
+			Transaction tr(buffer);
+			buffer.Clear();
+		}
+
+		BOOST_REQUIRE_EQUAL(buffer.FlushUpdates(&obs1), 0);
+	}
+
+	BOOST_AUTO_TEST_CASE(Coalescing)
+	{
+		ChangeBuffer<SigLock> buffer(true);
+		RecordingObserver obs;
+
+		for(size_t i = 0; i < 2; ++i) {
+			{
+				Transaction tr(buffer);
+				buffer.Update(Analog(1), 5);
+				buffer.Update(Analog(2), 3);
+				buffer.Update(Analog(3), 5);
+			}
+
+			obs.mAnalogs.clear();
+			BOOST_REQUIRE_EQUAL(buffer.FlushUpdates(&obs), 2);
+			BOOST_REQUIRE_EQUAL(obs.mAnalogs[0].mIndex, 5);	// position of the first change
+			BOOST_REQUIRE_EQUAL(obs.mAnalogs[0].mValue.GetValue(), 3);	// value of the last
+			BOOST_REQUIRE_EQUAL(obs.mAnalogs[1].mIndex, 3);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(ConsecutiveIndicesFlushAsRuns)
+	{
+		ChangeBuffer<SigLock> buffer;
+		RecordingObserver obs;
+
+		{
+			Transaction tr(buffer);
+			buffer.Update(Analog(1), 3);
+			buffer.Update(Analog(2), 4);
+			buffer.Update(Analog(3), 5);
+			buffer.Update(Analog(4), 9);
+		}
+
+		BOOST_REQUIRE_EQUAL(buffer.FlushUpdates(&obs), 4);
+		BOOST_REQUIRE_EQUAL(obs.mNumAnalogRuns, 2);
+		BOOST_REQUIRE_EQUAL(obs.mAnalogs.size(), 4);
+		BOOST_REQUIRE_EQUAL(obs.mAnalogs[2].mIndex, 5);
+		BOOST_REQUIRE_EQUAL(obs.mAnalogs[2].mValue.GetValue(), 3);
+		BOOST_REQUIRE_EQUAL(obs.mAnalogs[3].mIndex, 9);
+	}
+
+	// the observer writes back into the buffer, which would deadlock if the lock were held during the flush
+	BOOST_AUTO_TEST_CASE(UpdatesDuringFlush)
+	{
+		ChangeBuffer<SigLock> buffer;
+		RecordingObserver obs;
+		obs.mpFeedback = &buffer;
+
+		{
+			Transaction tr(buffer);
+			buffer.Update(Analog(1), 0);
+			buffer.Update(Analog(1), 1);
+		}
+
+		BOOST_REQUIRE_EQUAL(buffer.FlushUpdates(&obs), 2);
+		BOOST_REQUIRE_EQUAL(buffer.FlushUpdates(&obs), 2);	// the echoed binaries
+		BOOST_REQUIRE_EQUAL(buffer.FlushUpdates(&obs), 0);
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
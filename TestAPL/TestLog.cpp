@@ -21,9 +21,15 @@
 #include <APLTestTools/TestHelpers.h>
 #include <APL/Log.h>
 #include <APL/LogToFile.h>
+#include <APL/DeferredLog.h>
+#include <APL/Thread.h>
+#include <APL/ToHex.h>
 #include <APLTestTools/LogTester.h>
 #include <APL/Exception.h>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+#include <sstream>
 #include <iostream>
 #include <vector>
 
@@ -131,6 +137,180 @@ using namespace apl;
 	
 	BOOST_AUTO_TEST_SUITE_END()
 
+	BOOST_AUTO_TEST_SUITE(DeferredLogSuite)
+
+		BOOST_AUTO_TEST_CASE(DeliveredInOrderWithOriginalTime)
+		{
+			EventLog log;
+			LogEntryCircularBuffer buff;
+			log.AddLogSubscriber(&buff);
+			Logger* pLogger = log.GetLogger(LEV_INTERPRET, "LogTest");
+
+			DeferredLog deferred(&log, 16, 100000);
+			Thread::SleepFor(20); // let the drain thread go to sleep
+			UTCTimeStamp_t before = TimeStamp::GetUTCTimeStamp();
+			pLogger->Log(LEV_INFO, "first", "one", 3);
+			pLogger->Log(LEV_INTERPRET, "second", "two");
+			pLogger->Log(LEV_COMM, "filtered", "three");
+			BOOST_REQUIRE_EQUAL(buff.Count(), 0);
+
+			BOOST_REQUIRE_EQUAL(deferred.Flush(), 2);
+			BOOST_REQUIRE_EQUAL(buff.Count(), 2);
+
+			LogEntry entry;
+			BOOST_REQUIRE(buff.ReadLog(entry));
+			BOOST_REQUIRE_EQUAL(entry.GetFilterLevel(), LEV_INFO);
+			BOOST_REQUIRE_EQUAL(entry.GetDeviceName(), "LogTest");
+			BOOST_REQUIRE_EQUAL(entry.GetLocation(), "first");
+			BOOST_REQUIRE_EQUAL(entry.GetMessage(), "one");
+			BOOST_REQUIRE_EQUAL(entry.GetErrorCode(), 3);
+			BOOST_REQUIRE(entry.GetTime() >= before);
+			BOOST_REQUIRE(entry.GetTime() < before + 20);
+
+			BOOST_REQUIRE(buff.ReadLog(entry));
+			BOOST_REQUIRE_EQUAL(entry.GetLocation(), "second");
+			BOOST_REQUIRE_EQUAL(entry.GetMessage(), "two");
+			BOOST_REQUIRE_EQUAL(entry.GetErrorCode(), -1);
+		}
+
+		BOOST_AUTO_TEST_CASE(BytesFormattedLikeImmediate)
+		{
+			byte_t data[] = {0x05, 0x64, 0x0A, 0xFF};
+
+			EventLog log;
+			LogEntryCircularBuffer buff;
+			log.AddLogSubscriber(&buff);
+			Logger* pLogger = log.GetLogger(LEV_COMM, "LogTest");
+
+			pLogger->LogBytes(LEV_COMM, "loc", "<~~", data, 4);
+			{
+				DeferredLog deferred(&log, 16, 100000);
+				pLogger->LogBytes(LEV_COMM, "loc", "<~~", data, 4);
+			} // destruction drains the rings
+
+			LogEntry immediate, later;
+			BOOST_REQUIRE(buff.ReadLog(immediate));
+			BOOST_REQUIRE(buff.ReadLog(later));
+			BOOST_REQUIRE_EQUAL(immediate.GetMessage(), "<~~ " + toHex(data, 4, true));
+			BOOST_REQUIRE_EQUAL(later.GetMessage(), immediate.GetMessage());
+			BOOST_REQUIRE_EQUAL(later.GetLocation(), "loc");
+		}
+
+		BOOST_AUTO_TEST_CASE(LongFramesAreLoggedWhole)
+		{
+			EventLog log;
+			LogEntryCircularBuffer buff;
+			log.AddLogSubscriber(&buff);
+			Logger* pLogger = log.GetLogger(LEV_COMM, "LogTest");
+
+			std::vector<byte_t> frame(2048);
+			for(size_t i = 0; i < frame.size(); ++i) frame[i] = static_cast<byte_t>(i);
+			std::string location(200, 'x');
+			location += "File.cpp(10)";
+
+			pLogger->LogBytes(LEV_COMM, location.c_str(), "<~~", &frame[0], frame.size());
+			{
+				DeferredLog deferred(&log, 16, 100000);
+				pLogger->LogBytes(LEV_COMM, location.c_str(), "<~~", &frame[0], frame.size());
+				pLogger->Log(LEV_INFO, "after", "msg");
+				BOOST_REQUIRE_EQUAL(deferred.Flush(), 2);
+			}
+
+			LogEntry immediate, entry;
+			BOOST_REQUIRE(buff.ReadLog(immediate));
+			BOOST_REQUIRE(buff.ReadLog(entry));
+			BOOST_REQUIRE_EQUAL(entry.GetMessage(), immediate.GetMessage());
+			BOOST_REQUIRE(entry.GetLocation().size() < location.size());
+			BOOST_REQUIRE_EQUAL(entry.GetLocation(), location.substr(location.size() - entry.GetLocation().size()));
+			BOOST_REQUIRE(buff.ReadLog(entry));
+			BOOST_REQUIRE_EQUAL(entry.GetLocation(), "after");
+		}
+
+		BOOST_AUTO_TEST_CASE(FramesCutShortByAFullRingAreMarked)
+		{
+			EventLog log;
+			LogEntryCircularBuffer buff;
+			log.AddLogSubscriber(&buff);
+			Logger* pLogger = log.GetLogger(LEV_COMM, "LogTest");
+
+			std::vector<byte_t> frame(2048, 0xAB);
+			{
+				DeferredLog deferred(&log, 4, 100000);
+				Thread::SleepFor(20); // let the drain thread go to sleep
+				pLogger->LogBytes(LEV_COMM, "loc", "<~~", &frame[0], frame.size());
+				BOOST_REQUIRE_EQUAL(deferred.Flush(), 1);
+			}
+
+			LogEntry entry;
+			BOOST_REQUIRE(buff.ReadLog(entry));
+			std::ostringstream oss;
+			oss << "<~~ " << toHex(&frame[0], 4*DeferredLog::MAX_BYTES, true) << " ... " << (frame.size() - 4*DeferredLog::MAX_BYTES) << " more bytes not logged, the ring was full";
+			BOOST_REQUIRE_EQUAL(entry.GetMessage(), oss.str());
+		}
+
+		void LogFromThread(Logger* apLogger, int aNum)
+		{
+			for(int i = 0; i < aNum; ++i) apLogger->Log(LEV_INFO, "loc", "msg", i);
+		}
+
+		BOOST_AUTO_TEST_CASE(RingsFreedWhenTheirThreadExits)
+		{
+			EventLog log;
+			LogEntryCircularBuffer buff;
+			log.AddLogSubscriber(&buff);
+			Logger* pLogger = log.GetLogger(LEV_DEBUG, "LogTest");
+
+			DeferredLog deferred(&log, 4, 100000);
+			Thread::SleepFor(20); // let the drain thread go to sleep
+			pLogger->Log(LEV_INFO, "loc", "msg");
+			boost::thread t(boost::bind(&LogFromThread, pLogger, 6));
+			t.join();
+			BOOST_REQUIRE_EQUAL(deferred.NumRings(), 2);
+
+			BOOST_REQUIRE_EQUAL(deferred.Flush(), 5);
+			BOOST_REQUIRE_EQUAL(deferred.NumRings(), 1);
+			BOOST_REQUIRE_EQUAL(deferred.NumDropped(), 2);
+		}
+
+		BOOST_AUTO_TEST_CASE(DropsWhenFull)
+		{
+			EventLog log;
+			LogEntryCircularBuffer buff;
+			log.AddLogSubscriber(&buff);
+			Logger* pLogger = log.GetLogger(LEV_DEBUG, "LogTest");
+
+			DeferredLog deferred(&log, 4, 100000);
+			Thread::SleepFor(20); // let the drain thread go to sleep
+			for(int i = 0; i < 6; ++i) pLogger->Log(LEV_INFO, "loc", "msg", i);
+
+			BOOST_REQUIRE_EQUAL(deferred.NumDropped(), 2);
+			BOOST_REQUIRE_EQUAL(deferred.Flush(), 4);
+
+			LogEntry entry;
+			for(int i = 0; i < 4; ++i) {
+				BOOST_REQUIRE(buff.ReadLog(entry));
+				BOOST_REQUIRE_EQUAL(entry.GetErrorCode(), i);
+			}
+
+			pLogger->Log(LEV_INFO, "loc", "msg", 4);
+			BOOST_REQUIRE_EQUAL(deferred.Flush(), 1);
+		}
+
+		BOOST_AUTO_TEST_CASE(DrainedInBackground)
+		{
+			EventLog log;
+			LogEntryCircularBuffer buff;
+			log.AddLogSubscriber(&buff);
+			Logger* pLogger = log.GetLogger(LEV_DEBUG, "LogTest");
+
+			DeferredLog deferred(&log, 16, 1);
+			pLogger->Log(LEV_INFO, "loc", "msg");
+			LogEntry entry;
+			BOOST_REQUIRE(buff.ReadLog(entry, 5000));
+		}
+
+	BOOST_AUTO_TEST_SUITE_END()
+
 	BOOST_AUTO_TEST_SUITE(LogToFileSuite)
 
 		BOOST_AUTO_TEST_CASE(AddRemove){
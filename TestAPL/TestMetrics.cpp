@@ -0,0 +1,229 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+#include <APLTestTools/TestHelpers.h>
+
+#include <APL/MetricRegistry.h>
+#include <APL/Exception.h>
+
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
+#include <sstream>
+
+using namespace apl;
+
+namespace
+{
+	void CountAndRecord(MetricRegistry* apRegistry, MetricHandle aCounter, MetricHandle aHistogram, size_t aNum)
+	{
+		for(size_t i = 0; i < aNum; ++i) {
+			apRegistry->Increment(aCounter);
+			apRegistry->Record(aHistogram, i);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE(MetricRegistrySuite)
+
+	BOOST_AUTO_TEST_CASE(RegistrationIsIdempotent)
+	{
+		MetricRegistry reg;
+		MetricHandle a = reg.RegisterCounter("a");
+		MetricHandle b = reg.RegisterCounter("b");
+		BOOST_REQUIRE(a != b);
+		BOOST_REQUIRE_EQUAL(reg.RegisterCounter("a"), a);
+		BOOST_REQUIRE_THROW(reg.RegisterGauge("a"), ArgumentException);
+
+		MetricSnapshot s;
+		BOOST_REQUIRE_FALSE(reg.Read("c", s));
+		BOOST_REQUIRE(reg.Read("b", s));
+		BOOST_REQUIRE_EQUAL(s.mName, "b");
+		BOOST_REQUIRE_EQUAL(s.mType, MT_COUNTER);
+		BOOST_REQUIRE_EQUAL(s.mValue, 0);
+	}
+
+	BOOST_AUTO_TEST_CASE(ExceptsWhenFull)
+	{
+		MetricRegistry reg(MetricRegistry::NUM_BUCKETS + 3, 1);
+		reg.RegisterHistogram("h");
+		reg.RegisterCounter("c");
+		BOOST_REQUIRE_THROW(reg.RegisterCounter("d"), CapacityException);
+		reg.RegisterGauge("g");
+		BOOST_REQUIRE_THROW(reg.RegisterGauge("g2"), CapacityException);
+	}
+
+	BOOST_AUTO_TEST_CASE(UnregisteredNamesStartFromZero)
+	{
+		MetricRegistry reg;
+		MetricHandle c = reg.RegisterCounter("c");
+		MetricHandle g = reg.RegisterGauge("g");
+		reg.Increment(c, 3);
+		reg.SetGauge(g, 5);
+
+		std::vector<std::string> names;
+		names.push_back("c");
+		names.push_back("g");
+		names.push_back("unknown");
+		size_t ticket = reg.Unregister(names);
+
+		MetricSnapshot s;
+		BOOST_REQUIRE_FALSE(reg.Read("c", s));
+		BOOST_REQUIRE(reg.RegisterCounter("c") != c);
+		BOOST_REQUIRE(reg.Read("c", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 0);
+
+		// the old slots are only handed out again once they're reclaimed, and then cleared
+		reg.Reclaim(ticket);
+		BOOST_REQUIRE_EQUAL(reg.RegisterCounter("d"), c);
+		BOOST_REQUIRE_EQUAL(reg.RegisterGauge("g"), g);
+		BOOST_REQUIRE(reg.Read("d", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 0);
+		BOOST_REQUIRE(reg.Read("g", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 0);
+	}
+
+	BOOST_AUTO_TEST_CASE(UnregisteringKeepsTheOthersInOrder)
+	{
+		MetricRegistry reg;
+		MetricHandle a = reg.RegisterCounter("a");
+		reg.RegisterCounter("b");
+		MetricHandle c = reg.RegisterCounter("c");
+		reg.Increment(c, 2);
+
+		std::vector<std::string> names;
+		names.push_back("b");
+		reg.Unregister(names);
+		reg.RegisterCounter("b");
+
+		std::vector<MetricSnapshot> values;
+		reg.Read(values);
+		BOOST_REQUIRE_EQUAL(values.size(), 3);
+		BOOST_REQUIRE_EQUAL(values[0].mName, "a");
+		BOOST_REQUIRE_EQUAL(values[1].mName, "c");
+		BOOST_REQUIRE_EQUAL(values[1].mValue, 2);
+		BOOST_REQUIRE_EQUAL(values[2].mName, "b");
+		BOOST_REQUIRE_EQUAL(reg.RegisterCounter("a"), a);
+		BOOST_REQUIRE_EQUAL(reg.RegisterCounter("c"), c);
+	}
+
+	BOOST_AUTO_TEST_CASE(HistogramsSpanManyBlocks)
+	{
+		const size_t NUM_HISTOGRAMS = 1000;
+
+		MetricRegistry reg;
+		std::vector<MetricHandle> handles;
+		for(size_t i = 0; i < NUM_HISTOGRAMS; ++i) {
+			std::ostringstream oss;
+			oss << "h" << i;
+			handles.push_back(reg.RegisterHistogram(oss.str()));
+			reg.Record(handles.back(), i);
+		}
+
+		std::vector<MetricSnapshot> values;
+		reg.Read(values);
+		BOOST_REQUIRE_EQUAL(values.size(), NUM_HISTOGRAMS);
+		for(size_t i = 0; i < NUM_HISTOGRAMS; ++i) {
+			BOOST_REQUIRE_EQUAL(values[i].mValue, 1);
+			BOOST_REQUIRE_EQUAL(values[i].mMax, i);
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(CountersAndGauges)
+	{
+		MetricRegistry reg;
+		MetricHandle c = reg.RegisterCounter("c");
+		MetricHandle g = reg.RegisterGauge("g");
+
+		reg.Increment(c);
+		reg.Increment(c, 4);
+		reg.SetGauge(g, 7);
+		reg.SetGauge(g, 3);
+
+		std::vector<MetricSnapshot> values;
+		reg.Read(values);
+		BOOST_REQUIRE_EQUAL(values.size(), 2);
+		BOOST_REQUIRE_EQUAL(values[0].mName, "c");
+		BOOST_REQUIRE_EQUAL(values[0].mValue, 5);
+		BOOST_REQUIRE_EQUAL(values[1].mName, "g");
+		BOOST_REQUIRE_EQUAL(values[1].mType, MT_GAUGE);
+		BOOST_REQUIRE_EQUAL(values[1].mValue, 3);
+	}
+
+	BOOST_AUTO_TEST_CASE(BucketBoundaries)
+	{
+		BOOST_REQUIRE_EQUAL(MetricRegistry::BucketFor(0), 0);
+		BOOST_REQUIRE_EQUAL(MetricRegistry::BucketFor(7), 7);
+		BOOST_REQUIRE_EQUAL(MetricRegistry::BucketFor(8), 8);
+		BOOST_REQUIRE_EQUAL(MetricRegistry::BucketFor(17), 16);
+		BOOST_REQUIRE_EQUAL(MetricRegistry::BucketFor(MetricRegistry::MAX_SAMPLE), MetricRegistry::NUM_BUCKETS - 1);
+
+		// the buckets tile the whole range and every sample lands in the bucket that covers it
+		for(size_t i = 0; i < MetricRegistry::NUM_BUCKETS; ++i) {
+			size_t lower = MetricRegistry::BucketLowerBound(i);
+			size_t upper = MetricRegistry::BucketUpperBound(i);
+			BOOST_REQUIRE(lower <= upper);
+			if(i > 0) BOOST_REQUIRE_EQUAL(lower, MetricRegistry::BucketUpperBound(i - 1) + 1);
+			BOOST_REQUIRE_EQUAL(MetricRegistry::BucketFor(lower), i);
+			BOOST_REQUIRE_EQUAL(MetricRegistry::BucketFor(upper), i);
+			BOOST_REQUIRE(upper - lower <= lower / 8);
+		}
+		BOOST_REQUIRE_EQUAL(MetricRegistry::BucketUpperBound(MetricRegistry::NUM_BUCKETS - 1), MetricRegistry::MAX_SAMPLE);
+	}
+
+	BOOST_AUTO_TEST_CASE(HistogramPercentiles)
+	{
+		MetricRegistry reg;
+		MetricHandle h = reg.RegisterHistogram("h");
+		for(size_t i = 1; i <= 1000; ++i) reg.Record(h, i);
+
+		MetricSnapshot s;
+		BOOST_REQUIRE(reg.Read("h", s));
+		BOOST_REQUIRE_EQUAL(s.mType, MT_HISTOGRAM);
+		BOOST_REQUIRE_EQUAL(s.mValue, 1000);
+		BOOST_REQUIRE_EQUAL(s.mMax, 1000);
+		BOOST_REQUIRE_EQUAL(s.Percentile(1.0), 1000);
+
+		size_t median = s.Percentile(0.5);
+		BOOST_REQUIRE(median >= 500 && median <= 500 + 500/8);
+		size_t p99 = s.Percentile(0.99);
+		BOOST_REQUIRE(p99 >= 990 && p99 <= 1000);
+	}
+
+	BOOST_AUTO_TEST_CASE(ThreadsUpdateTheirOwnShards)
+	{
+		const size_t NUM_THREADS = 4;
+		const size_t NUM_UPDATES = 100000;
+
+		MetricRegistry reg;
+		MetricHandle c = reg.RegisterCounter("c");
+		MetricHandle h = reg.RegisterHistogram("h");
+
+		boost::thread_group threads;
+		for(size_t i = 0; i < NUM_THREADS; ++i) threads.create_thread(boost::bind(&CountAndRecord, &reg, c, h, NUM_UPDATES));
+		threads.join_all();
+
+		MetricSnapshot s;
+		BOOST_REQUIRE(reg.Read("c", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, NUM_THREADS * NUM_UPDATES);
+		BOOST_REQUIRE(reg.Read("h", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, NUM_THREADS * NUM_UPDATES);
+		BOOST_REQUIRE_EQUAL(s.mMax, NUM_UPDATES - 1);
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
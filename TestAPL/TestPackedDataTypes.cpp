@@ -0,0 +1,100 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+#include <APLTestTools/TestHelpers.h>
+
+#include <APL/PackedDataTypes.h>
+#include <APL/QualityMasks.h>
+
+using namespace apl;
+
+template <class T>
+void TestRoundTrip(const T& arPoint)
+{
+	PackedPoint<T> packed(arPoint);
+	T point = packed;
+
+	BOOST_REQUIRE_EQUAL(point, arPoint);
+	BOOST_REQUIRE_EQUAL(point.GetTime(), arPoint.GetTime());
+	BOOST_REQUIRE_EQUAL(packed.GetValue(), arPoint.GetValue());
+	BOOST_REQUIRE_EQUAL(packed.GetQuality(), arPoint.GetQuality());
+	BOOST_REQUIRE_EQUAL(packed.GetType(), arPoint.GetType());
+	BOOST_REQUIRE_EQUAL(packed.ToString(), arPoint.ToString());
+}
+
+BOOST_AUTO_TEST_SUITE(PackedDataTypesSuite)
+
+	BOOST_AUTO_TEST_CASE(RoundTrip)
+	{
+		TestRoundTrip(Binary(true, BQ_ONLINE | BQ_CHATTER_FILTER));
+		TestRoundTrip(Binary(false, BQ_RESTART));
+		TestRoundTrip(ControlStatus(true, TQ_ONLINE));
+		TestRoundTrip(Analog(-12.5, AQ_ONLINE | AQ_OVERRANGE));
+		TestRoundTrip(Counter(123456, CQ_ONLINE));
+		TestRoundTrip(SetpointStatus(42.0, PQ_ONLINE));
+
+		Analog a(1.0, AQ_ONLINE);
+		a.SetTime(987654321);
+		TestRoundTrip(a);
+	}
+
+	BOOST_AUTO_TEST_CASE(DefaultMatchesMeasurement)
+	{
+		BOOST_REQUIRE_EQUAL(static_cast<Binary>(PackedBinary()), Binary());
+		BOOST_REQUIRE_EQUAL(static_cast<Analog>(PackedAnalog()), Analog());
+		BOOST_REQUIRE_EQUAL(static_cast<Counter>(PackedCounter()), Counter());
+	}
+
+	BOOST_AUTO_TEST_CASE(SetQualityKeepsState)
+	{
+		PackedBinary b(Binary(true, BQ_RESTART));
+		b.SetQuality(BQ_ONLINE);
+		BOOST_REQUIRE(b.GetValue());
+		BOOST_REQUIRE_EQUAL(b.GetQuality(), BQ_ONLINE | BQ_STATE);
+
+		b.SetValue(false);
+		BOOST_REQUIRE_EQUAL(b.GetQuality(), BQ_ONLINE);
+		BOOST_REQUIRE_EQUAL(static_cast<Binary>(b), Binary(false, BQ_ONLINE));
+	}
+
+	BOOST_AUTO_TEST_CASE(EventDetectionMatchesMeasurement)
+	{
+		Analog a1(10, AQ_ONLINE), a2(15, AQ_ONLINE);
+		BOOST_REQUIRE_EQUAL(PackedAnalog(a1).ShouldGenerateEvent(a2, 4, 10), a1.ShouldGenerateEvent(a2, 4, 10));
+		BOOST_REQUIRE_EQUAL(PackedAnalog(a1).ShouldGenerateEvent(a2, 6, 10), a1.ShouldGenerateEvent(a2, 6, 10));
+
+		Binary b1(true, BQ_ONLINE), b2(false, BQ_ONLINE);
+		BOOST_REQUIRE(PackedBinary(b1).ShouldGenerateEvent(b2, 0, 0));
+		BOOST_REQUIRE_FALSE(PackedBinary(b1).ShouldGenerateEvent(b1, 0, 0));
+	}
+
+	BOOST_AUTO_TEST_CASE(Sizes)
+	{
+		BOOST_REQUIRE(sizeof(PackedBinary) < sizeof(Binary));
+		BOOST_REQUIRE(sizeof(PackedAnalog) < sizeof(Analog));
+		BOOST_REQUIRE(sizeof(PackedCounter) < sizeof(Counter));
+
+		BOOST_TEST_MESSAGE("Binary: " << sizeof(Binary) << " -> " << sizeof(PackedBinary));
+		BOOST_TEST_MESSAGE("Analog: " << sizeof(Analog) << " -> " << sizeof(PackedAnalog));
+		BOOST_TEST_MESSAGE("Counter: " << sizeof(Counter) << " -> " << sizeof(PackedCounter));
+		BOOST_TEST_MESSAGE("ControlStatus: " << sizeof(ControlStatus) << " -> " << sizeof(PackedControlStatus));
+		BOOST_TEST_MESSAGE("SetpointStatus: " << sizeof(SetpointStatus) << " -> " << sizeof(PackedSetpointStatus));
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -26,6 +26,7 @@
 #include <APLTestTools/BufferHelpers.h>
 
 #include <memory>
+#include <vector>
 
 using namespace std;
 using namespace apl;
@@ -58,6 +59,17 @@ bool TestReadWriteDouble(typename T::Type aValue)
 	return true;
 }
 
+// reference bit at a time implementation that PackedBits must agree with
+bool ReadBit(const byte_t* apPos, size_t aIndex)
+{ return (apPos[aIndex >> 3] & (1 << (aIndex & 0x07))) != 0; }
+
+void WriteBit(byte_t* apPos, size_t aIndex, bool aValue)
+{
+	byte_t mask = static_cast<byte_t>(1 << (aIndex & 0x07));
+	if(aValue) apPos[aIndex >> 3] |= mask;
+	else apPos[aIndex >> 3] &= ~mask;
+}
+
 template <class T>
 bool TestFloatParsing(std::string aHex, typename T::Type aValue)
 {
@@ -161,4 +173,36 @@ bool TestFloatParsing(std::string aHex, typename T::Type aValue)
 			BOOST_REQUIRE(TestReadWrite<apl::UInt64BE>(5000000000ULL));
 		}
 
+		BOOST_AUTO_TEST_CASE(PackedBitsUnpack)
+		{
+			byte_t bits[16];
+			for(size_t i = 0; i < 16; ++i) bits[i] = static_cast<byte_t>(i * 37 + 11);
+
+			// every length, starting at an odd address, so the vector and tail paths are both covered
+			for(size_t num = 0; num <= 120; ++num) {
+				std::vector<byte_t> values(num + 2, 0xAA);
+				PackedBits::Unpack(bits, num, &values[1]);
+				for(size_t i = 0; i < num; ++i) BOOST_REQUIRE_EQUAL(values[i + 1], ReadBit(bits, i) ? 1 : 0);
+				BOOST_REQUIRE_EQUAL(values[0], 0xAA);
+				BOOST_REQUIRE_EQUAL(values[num + 1], 0xAA);
+			}
+		}
+
+		BOOST_AUTO_TEST_CASE(PackedBitsPack)
+		{
+			for(size_t num = 0; num <= 120; ++num) {
+				std::vector<byte_t> values(num + 1);
+				for(size_t i = 0; i < num; ++i) values[i] = ((i * 7) % 3 == 0) ? 0 : static_cast<byte_t>(i | 0x80);
+
+				byte_t expected[16]; memset(expected, 0, sizeof(expected));
+				for(size_t i = 0; i < num; ++i) WriteBit(expected, i, values[i] != 0);
+
+				byte_t packed[17]; memset(packed, 0xFF, sizeof(packed));
+				PackedBits::Pack(&values[0], num, packed);
+				size_t size = PackedBits::GetSize(num);
+				for(size_t i = 0; i < size; ++i) BOOST_REQUIRE_EQUAL(packed[i], expected[i]);
+				BOOST_REQUIRE_EQUAL(packed[size], 0xFF);
+			}
+		}
+
 	BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,175 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <APL/ASIOIncludes.h>
+#include "AsyncPhysTestObject.h"
+
+#include <boost/bind.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <APL/Exception.h>
+
+#include <APLTestTools/TestHelpers.h>
+#include <APLTestTools/BufferHelpers.h>
+
+#include <vector>
+
+using namespace apl;
+using namespace boost;
+
+namespace {
+
+	/// records the size of every read the upper layer sees
+	struct ReadSizes
+	{
+		void OnReceive(const byte_t*, size_t aNumBytes) { mSizes.push_back(aNumBytes); }
+		size_t Count() { return mSizes.size(); }
+
+		std::vector<size_t> mSizes;
+	};
+
+	void OpenBoth(AsyncUDPTestObject& t)
+	{
+		t.mUDPServer.AsyncOpen();
+		t.mUDPClient.AsyncOpen();
+		BOOST_REQUIRE(t.ProceedUntil(bind(&MockUpperLayer::IsLowerLayerUp, &t.mServerUpper)));
+		BOOST_REQUIRE(t.ProceedUntil(bind(&MockUpperLayer::IsLowerLayerUp, &t.mClientUpper)));
+	}
+
+}
+
+BOOST_AUTO_TEST_SUITE(PhysicalLayerAsyncUDPSuite)
+
+	BOOST_AUTO_TEST_CASE(TestStateClosed)
+	{
+		AsyncUDPTestObject t;
+
+		byte_t buff[100];
+		BOOST_REQUIRE_THROW(t.mUDPClient.AsyncWrite(buff,100), InvalidStateException);
+		BOOST_REQUIRE_THROW(t.mUDPClient.AsyncRead(buff,100), InvalidStateException);
+		BOOST_REQUIRE_THROW(t.mUDPClient.AsyncClose(), InvalidStateException);
+	}
+
+	BOOST_AUTO_TEST_CASE(OpenClose)
+	{
+		AsyncUDPTestObject t;
+
+		for(size_t i=0; i<3; ++i) {
+			OpenBoth(t);
+
+			// no connection, so each side has to be closed on its own
+			t.mUDPServer.AsyncClose();
+			t.mUDPClient.AsyncClose();
+			BOOST_REQUIRE(t.ProceedUntilFalse(bind(&MockUpperLayer::IsLowerLayerUp, &t.mServerUpper)));
+			BOOST_REQUIRE(t.ProceedUntilFalse(bind(&MockUpperLayer::IsLowerLayerUp, &t.mClientUpper)));
+		}
+	}
+
+	BOOST_AUTO_TEST_CASE(WriteWithoutPeerIsDropped)
+	{
+		AsyncUDPTestObject t;
+
+		t.mUDPServer.AsyncOpen();
+		BOOST_REQUIRE(t.ProceedUntil(bind(&MockUpperLayer::IsLowerLayerUp, &t.mServerUpper)));
+
+		t.mServerUpper.SendDown("01 02 03");
+		BOOST_REQUIRE(t.ProceedUntil(bind(&MockUpperLayer::CountersEqual, &t.mServerUpper, 1, 0)));
+		BOOST_REQUIRE(t.mServerUpper.IsLowerLayerUp());
+	}
+
+	BOOST_AUTO_TEST_CASE(ServerRepliesToSender)
+	{
+		AsyncUDPTestObject t;
+		OpenBoth(t);
+
+		ByteStr bs(1000, 77);
+		t.mClientUpper.SendDown(bs.Buffer(), bs.Size());
+		BOOST_REQUIRE(t.ProceedUntil(bind(&MockUpperLayer::SizeEquals, &t.mServerUpper, bs.Size())));
+		BOOST_REQUIRE(t.mServerUpper.BufferEquals(bs.Buffer(), bs.Size()));
+
+		t.mServerUpper.SendDown(bs.Buffer(), bs.Size());
+		BOOST_REQUIRE(t.ProceedUntil(bind(&MockUpperLayer::SizeEquals, &t.mClientUpper, bs.Size())));
+		BOOST_REQUIRE(t.mClientUpper.BufferEquals(bs.Buffer(), bs.Size()));
+	}
+
+	BOOST_AUTO_TEST_CASE(ServerRepliesPerLinkAddress)
+	{
+		AsyncUDPTestObject t;
+		OpenBoth(t);
+		t.mUDPClient2.AsyncOpen();
+		BOOST_REQUIRE(t.ProceedUntil(bind(&MockUpperLayer::IsLowerLayerUp, &t.mClient2Upper)));
+
+		// link headers from address 10 and 11 to address 1, the CRC isn't checked here
+		HexSequence from10("05 64 05 C0 01 00 0A 00 00 00");
+		HexSequence from11("05 64 05 C0 01 00 0B 00 00 00");
+		t.mClientUpper.SendDown(from10, from10.Size());
+		BOOST_REQUIRE(t.ProceedUntil(bind(&MockUpperLayer::SizeEquals, &t.mServerUpper, 10)));
+		t.mClient2Upper.SendDown(from11, from11.Size());
+		BOOST_REQUIRE(t.ProceedUntil(bind(&MockUpperLayer::SizeEquals, &t.mServerUpper, 20)));
+
+		// frames for 10 and 11 go back to their own senders, the rest to the last sender
+		HexSequence to10("05 64 05 44 0A 00 01 00 00 00");
+		HexSequence to11("05 64 05 44 0B 00 01 00 00 00");
+		HexSequence other("01 02 03");
+		WriteBuffer buffers[3] = { WriteBuffer(to11, to11.Size()), WriteBuffer(to10, to10.Size()), WriteBuffer(other, other.Size()) };
+		t.mUDPServer.AsyncWriteGather(buffers, 3);
+
+		BOOST_REQUIRE(t.ProceedUntil(bind(&MockUpperLayer::SizeEquals, &t.mClient2Upper, 13)));
+		BOOST_REQUIRE(t.mClient2Upper.BufferEquals("05 64 05 44 0B 00 01 00 00 00 01 02 03"));
+		BOOST_REQUIRE(t.ProceedUntil(bind(&MockUpperLayer::SizeEquals, &t.mClientUpper, 10)));
+		BOOST_REQUIRE(t.mClientUpper.BufferEquals("05 64 05 44 0A 00 01 00 00 00"));
+	}
+
+	BOOST_AUTO_TEST_CASE(GatherWritePacksWholeBuffers)
+	{
+		AsyncUDPTestObject t(LEV_INFO, false, 1000);
+		OpenBoth(t);
+
+		ReadSizes sizes;
+		t.mServerUpper.SetReceiveHandler(bind(&ReadSizes::OnReceive, &sizes, _1, _2));
+
+		ByteStr a(400, 1), b(400, 2), c(400, 3);
+		WriteBuffer buffers[3] = { WriteBuffer(a, a.Size()), WriteBuffer(b, b.Size()), WriteBuffer(c, c.Size()) };
+		t.mUDPClient.AsyncWriteGather(buffers, 3);
+
+		BOOST_REQUIRE(t.ProceedUntil(bind(&ReadSizes::Count, &sizes) == 2));
+		BOOST_REQUIRE_EQUAL(sizes.mSizes[0], 800);
+		BOOST_REQUIRE_EQUAL(sizes.mSizes[1], 400);
+		BOOST_REQUIRE(t.mServerUpper.SizeEquals(1200));
+	}
+
+	BOOST_AUTO_TEST_CASE(ManyDatagramsInOneWrite)
+	{
+		const size_t NUM = 5 * PhysicalLayerAsyncUDP::MAX_BATCH + 3;
+
+		AsyncUDPTestObject t(LEV_INFO, false, 100);
+		OpenBoth(t);
+
+		ByteStr bs(NUM * 100, 0);
+		for(size_t i = 0; i < bs.Size(); ++i) bs[i] = static_cast<byte_t>(i);
+
+		std::vector<WriteBuffer> buffers;
+		for(size_t i = 0; i < NUM; ++i) buffers.push_back(WriteBuffer(bs.Buffer() + i*100, 100));
+		t.mUDPClient.AsyncWriteGather(&buffers[0], buffers.size());
+
+		BOOST_REQUIRE(t.ProceedUntil(bind(&MockUpperLayer::SizeEquals, &t.mServerUpper, bs.Size())));
+		BOOST_REQUIRE(t.mServerUpper.BufferEquals(bs.Buffer(), bs.Size()));
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
+
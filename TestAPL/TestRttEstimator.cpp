@@ -0,0 +1,89 @@
+//
+// Licensed to Green Energy Corp (www.greenenergycorp.com) under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  Green Energy Corp licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+//
+#include <boost/test/unit_test.hpp>
+#include <APLTestTools/TestHelpers.h>
+
+#include <APL/RttEstimator.h>
+#include <APL/MetricRegistry.h>
+#include <APL/Exception.h>
+
+using namespace apl;
+
+BOOST_AUTO_TEST_SUITE(RttEstimatorSuite)
+
+	BOOST_AUTO_TEST_CASE(InitialTimeoutIsBounded)
+	{
+		BOOST_REQUIRE_EQUAL(RttEstimator(1000, 100, 5000).GetTimeout(), 1000);
+		BOOST_REQUIRE_EQUAL(RttEstimator(10, 100, 5000).GetTimeout(), 100);
+		BOOST_REQUIRE_EQUAL(RttEstimator(9000, 100, 5000).GetTimeout(), 5000);
+		BOOST_REQUIRE_THROW(RttEstimator(1000, 200, 100), ArgumentException);
+	}
+
+	BOOST_AUTO_TEST_CASE(SmoothsSamples)
+	{
+		RttEstimator rtt(1000, 0, 60000);
+		BOOST_REQUIRE_FALSE(rtt.HasSample());
+
+		rtt.Sample(100);	// srtt = 100, rttvar = 50
+		BOOST_REQUIRE(rtt.HasSample());
+		BOOST_REQUIRE_EQUAL(rtt.GetSmoothedRtt(), 100);
+		BOOST_REQUIRE_EQUAL(rtt.GetRttVar(), 50);
+		BOOST_REQUIRE_EQUAL(rtt.GetTimeout(), 300);
+
+		rtt.Sample(180);	// rttvar = 3/4*50 + 1/4*80 = 57.5, srtt = 7/8*100 + 1/8*180 = 110
+		BOOST_REQUIRE_EQUAL(rtt.GetSmoothedRtt(), 110);
+		BOOST_REQUIRE_EQUAL(rtt.GetRttVar(), 57);
+		BOOST_REQUIRE_EQUAL(rtt.GetTimeout(), 340);
+
+		for(size_t i = 0; i < 100; ++i) rtt.Sample(20);	// a steady link converges on its rtt
+		BOOST_REQUIRE_EQUAL(rtt.GetSmoothedRtt(), 20);
+		BOOST_REQUIRE(rtt.GetTimeout() <= 21);
+	}
+
+	BOOST_AUTO_TEST_CASE(BacksOffToCeiling)
+	{
+		RttEstimator rtt(1000, 50, 3000);
+		rtt.Backoff();
+		BOOST_REQUIRE_EQUAL(rtt.GetTimeout(), 2000);
+		rtt.Backoff();
+		BOOST_REQUIRE_EQUAL(rtt.GetTimeout(), 3000);
+		rtt.Sample(1);
+		BOOST_REQUIRE_EQUAL(rtt.GetTimeout(), 50);
+	}
+
+	BOOST_AUTO_TEST_CASE(ReportsGauges)
+	{
+		MetricRegistry reg;
+		RttEstimator rtt(1000, 0, 60000);
+		rtt.SetMetrics(&reg, "stack.app");
+
+		MetricSnapshot s;
+		BOOST_REQUIRE(reg.Read("stack.app.timeout_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 1000);
+
+		rtt.Sample(100);
+		BOOST_REQUIRE(reg.Read("stack.app.srtt_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 100);
+		BOOST_REQUIRE(reg.Read("stack.app.rttvar_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 50);
+		BOOST_REQUIRE(reg.Read("stack.app.timeout_ms", s));
+		BOOST_REQUIRE_EQUAL(s.mValue, 300);
+	}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -22,14 +22,18 @@
 
 
 #include <APL/TimerSourceASIO.h>
+#include <APL/TimerSourceWheel.h>
+#include <APL/TimingTools.h>
 #include <APL/Threadable.h>
 #include <APL/Thread.h>
 
 #include <map>
+#include <vector>
 #include <boost/bind.hpp>
 
 using namespace std;
 using namespace apl;
+using namespace boost::posix_time;
 
 
 	class MockTimerHandler
@@ -81,6 +85,44 @@ using namespace apl;
 		Thread mThread;
 	};
 
+	class OrderedTimerHandler
+	{
+		public:
+			OrderedTimerHandler() : mEarly(false)
+			{}
+
+			void OnExpiration(int aId, ITimer** apTimer)
+			{
+				if(boost::asio::deadline_timer::traits_type::now() < (*apTimer)->ExpiresAt()) mEarly = true;
+				mOrder.push_back(aId);
+			}
+
+			std::vector<int> mOrder;
+			bool mEarly;
+	};
+
+	/// Starts a new timer from each expiration until it's been called aNum times
+	class Restarter
+	{
+		public:
+			Restarter(ITimerSource* apSource, MockTimerHandler* apHandler, size_t aNum) :
+			mpSource(apSource), mpHandler(apHandler), mNum(aNum)
+			{}
+
+			void Restart() { mpSource->Start(1, boost::bind(&Restarter::OnExpiration, this)); }
+
+			void OnExpiration()
+			{
+				mpHandler->OnExpiration();
+				if(mpHandler->GetCount() < mNum) this->Restart();
+			}
+
+		private:
+			ITimerSource* mpSource;
+			MockTimerHandler* mpHandler;
+			size_t mNum;
+	};
+
 	BOOST_AUTO_TEST_SUITE(Timers)
 		BOOST_AUTO_TEST_CASE(TestOrderedDispatch)
 		{			
@@ -125,6 +167,22 @@ using namespace apl;
 			BOOST_REQUIRE_EQUAL(pT1, pT2);
 		}
 
+
+		BOOST_AUTO_TEST_CASE(ReleaseWaitsForOutstandingHandlers)
+		{
+			MockTimerHandler mth;
+			boost::asio::io_service srv;
+			TimerSourceASIO* pSrc = new TimerSourceASIO(&srv, new boost::asio::io_service::strand(srv), true);
+			ITimer* pT1 = pSrc->Start(1, boost::bind(&MockTimerHandler::OnExpiration, &mth));
+			pSrc->Post(boost::bind(&MockTimerHandler::OnExpiration, &mth));
+			pT1->Cancel();
+			pSrc->Release(); // the canceled timer and the post are still outstanding
+			srv.run();
+			BOOST_REQUIRE_EQUAL(1, mth.GetCount());
+
+			TimerSourceASIO* pIdle = new TimerSourceASIO(&srv);
+			pIdle->Release(); // nothing outstanding, deleted right away
+		}
 		
 		BOOST_AUTO_TEST_CASE(MultipleOutstanding)
 		{
@@ -145,5 +203,102 @@ using namespace apl;
 			BOOST_REQUIRE_EQUAL(1, mth1.GetCount());
 			BOOST_REQUIRE_EQUAL(1, mth2.GetCount());
 		}
-		
+
+		BOOST_AUTO_TEST_CASE(WheelExpirationAndReuse)
+		{
+			MockTimerHandler mth;
+			boost::asio::io_service srv;
+			TimerSourceWheel ts(&srv);
+			ITimer* pT1 = ts.Start(1, boost::bind(&MockTimerHandler::OnExpiration, &mth));
+			BOOST_REQUIRE_EQUAL(1, ts.NumActive());
+			BOOST_REQUIRE_EQUAL(1, srv.run_one());
+			BOOST_REQUIRE_EQUAL(1, mth.GetCount());
+			BOOST_REQUIRE_EQUAL(0, ts.NumActive());
+			ITimer* pT2 = ts.Start(1, boost::bind(&MockTimerHandler::OnExpiration, &mth));
+			BOOST_REQUIRE_EQUAL(pT1, pT2);
+		}
+
+		BOOST_AUTO_TEST_CASE(WheelCancelation)
+		{
+			MockTimerHandler mth1;
+			MockTimerHandler mth2;
+			boost::asio::io_service srv;
+			TimerSourceWheel ts(&srv);
+			ITimer* pT1 = ts.Start(1, boost::bind(&MockTimerHandler::OnExpiration, &mth1));
+			pT1->Cancel();
+			BOOST_REQUIRE_EQUAL(0, ts.NumActive());
+			ITimer* pT2 = ts.Start(5, boost::bind(&MockTimerHandler::OnExpiration, &mth2));
+			BOOST_REQUIRE_EQUAL(pT1, pT2);
+			srv.run();
+			BOOST_REQUIRE_EQUAL(0, mth1.GetCount());
+			BOOST_REQUIRE_EQUAL(1, mth2.GetCount());
+		}
+
+		BOOST_AUTO_TEST_CASE(WheelOrderedExpiration)
+		{
+			// 300ms is beyond the root level, so it cascades before it fires
+			const millis_t DELAYS[] = { 50, 10, 300, 30, 0, 20 };
+			const int NUM = sizeof(DELAYS)/sizeof(DELAYS[0]);
+
+			boost::asio::io_service srv;
+			TimerSourceWheel ts(&srv);
+			OrderedTimerHandler oth;
+			ITimer* timers[NUM];
+
+			for(int i = 0; i < NUM; ++i) timers[i] = ts.Start(DELAYS[i], boost::bind(&OrderedTimerHandler::OnExpiration, &oth, i, &timers[i]));
+
+			// canceling from another level doesn't disturb the rest
+			ITimer* pCanceled = ts.Start(200, boost::bind(&OrderedTimerHandler::OnExpiration, &oth, -1, &timers[0]));
+			pCanceled->Cancel();
+
+			srv.run();
+
+			const int EXPECTED[] = { 4, 1, 5, 3, 0, 2 };
+			BOOST_REQUIRE_EQUAL(oth.mOrder.size(), static_cast<size_t>(NUM));
+			for(int i = 0; i < NUM; ++i) BOOST_REQUIRE_EQUAL(oth.mOrder[i], EXPECTED[i]);
+			BOOST_REQUIRE_FALSE(oth.mEarly);
+		}
+
+		BOOST_AUTO_TEST_CASE(WheelInfiniteTimerNeverFires)
+		{
+			MockTimerHandler mth;
+			boost::asio::io_service srv;
+			TimerSourceWheel ts(&srv);
+			ITimer* pTimer = ts.StartInfinite(boost::bind(&MockTimerHandler::OnExpiration, &mth));
+			ts.Start(1, boost::bind(&MockTimerHandler::OnExpiration, &mth));
+			srv.run();
+			BOOST_REQUIRE_EQUAL(1, mth.GetCount());
+			BOOST_REQUIRE_EQUAL(1, ts.NumActive());
+			pTimer->Cancel();
+			BOOST_REQUIRE_EQUAL(0, ts.NumActive());
+		}
+
+		BOOST_AUTO_TEST_CASE(WheelRestartFromHandler)
+		{
+			const size_t NUM = 20;
+
+			boost::asio::io_service srv;
+			TimerSourceWheel ts(&srv);
+			MockTimerHandler mth;
+			Restarter r(&ts, &mth, NUM);
+			r.Restart();
+			srv.run();
+			BOOST_REQUIRE_EQUAL(NUM, mth.GetCount());
+		}
+
+		BOOST_AUTO_TEST_CASE(WheelReleaseDropsPendingTimers)
+		{
+			MockTimerHandler mth;
+			boost::asio::io_service srv;
+			TimerSourceWheel* pSrc = new TimerSourceWheel(&srv, new boost::asio::io_service::strand(srv), 1, true);
+			pSrc->Start(60000, boost::bind(&MockTimerHandler::OnExpiration, &mth));
+			pSrc->Post(boost::bind(&MockTimerHandler::OnExpiration, &mth));
+			pSrc->Release(); // the wait on the wheel is canceled, the post still runs
+
+			StopWatch sw;
+			srv.run();
+			BOOST_REQUIRE(sw.Elapsed() < 10000);
+			BOOST_REQUIRE_EQUAL(1, mth.GetCount());
+		}
+
 	BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,7 @@ $projects = {
 :dnp3xml => {:dir => 'DNP3XML'},
 :xmlbindings => {:dir => 'XMLBindings'},
 :dnp3test => {:dir => 'DNP3Test'},
+:dnp3bench => {:dir => 'DNP3Bench'},
 :testset => {:dir => 'TestSet'},
 :slavedemo => {:dir => 'SlaveDemo'},
 :tinyxml => {:dir => 'tinyxml'},
@@ -33,7 +34,7 @@ $projects = {
 
 add_projects($projects) #removes projects that are not valid for $hw_os
 
-SOURCE_PROJECTS = [:apl, :testapl, :apltesttools, :dnp3, :dnp3test, :dnp3xml, :aplxml, :testset]
+SOURCE_PROJECTS = [:apl, :testapl, :apltesttools, :dnp3, :dnp3test, :dnp3bench, :dnp3xml, :aplxml, :testset]
 SOURCE_DIRS = SOURCE_PROJECTS.collect { |p| $projects[p][:dir] }
 
 desc 'Generate doxygen html docs for the project'